@@ -0,0 +1,98 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace
+{
+std::atomic<size_t> allocations = 0;
+std::atomic<size_t> liveBytes = 0;
+
+// Each allocation is prefixed by a header that stores its size, so the number
+// of live bytes can be updated again when the allocation is freed.
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+// Writes the given string as a JSON string literal, escaping as needed.
+void writeString(std::ostream &out, std::string const &str)
+{
+    out << '"';
+
+    for (auto const chr : str)
+    {
+        if (chr == '"' || chr == '\\')
+            out << '\\';
+
+        out << chr;
+    }
+
+    out << '"';
+}
+}  // namespace
+
+void *operator new(size_t size)
+{
+    allocations++;
+
+    if (auto *ptr = static_cast<char *>(std::malloc(size + HEADER_SIZE)))
+    {
+        *reinterpret_cast<size_t *>(ptr) = size;
+        liveBytes += size;
+        return ptr + HEADER_SIZE;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    auto *base = static_cast<char *>(ptr) - HEADER_SIZE;
+    liveBytes -= *reinterpret_cast<size_t *>(base);
+    std::free(base);
+}
+
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+
+size_t bench::numAllocations() { return allocations.load(); }
+
+size_t bench::numLiveBytes() { return liveBytes.load(); }
+
+void bench::writeJson(std::ostream &out, std::vector<Result> const &results)
+{
+#ifdef PYVRP_NO_TIME_WINDOWS
+    auto const problem = "cvrp";
+#else
+    auto const problem = "vrptw";
+#endif
+
+#ifdef PYVRP_DOUBLE_PRECISION
+    auto const precision = "double";
+#else
+    auto const precision = "integer";
+#endif
+
+    out << "{\n";
+    out << "  \"problem\": \"" << problem << "\",\n";
+    out << "  \"precision\": \"" << precision << "\",\n";
+    out << "  \"results\": [";
+
+    for (size_t idx = 0; idx != results.size(); ++idx)
+    {
+        auto const &result = results[idx];
+
+        out << (idx == 0 ? "\n" : ",\n") << "    {\"benchmark\": ";
+        writeString(out, result.benchmark);
+        out << ", \"instance\": ";
+        writeString(out, result.instance);
+        out << ", \"ops\": " << result.numOps;
+        out << ", \"ns_per_op\": " << result.nsPerOp;
+        out << ", \"allocs_per_op\": " << result.allocsPerOp << "}";
+    }
+
+    out << "\n  ]\n}\n";
+}
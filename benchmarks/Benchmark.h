@@ -0,0 +1,96 @@
+#ifndef PYVRP_BENCHMARK_H
+#define PYVRP_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+/**
+ * @return Number of heap allocations made by this program so far. Linking
+ *         against the benchmark library replaces the global operator new to
+ *         count these.
+ */
+size_t numAllocations();
+
+/**
+ * @return Number of bytes currently allocated on the heap by this program,
+ *         through the global operator new.
+ */
+size_t numLiveBytes();
+
+/**
+ * Prevents the compiler from optimising away the computation of the given
+ * value, without otherwise changing the generated code.
+ */
+template <typename T> inline void doNotOptimize(T const &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Measurement of a single benchmark on a single instance.
+ */
+struct Result
+{
+    std::string benchmark;
+    std::string instance;
+    size_t numOps;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+/**
+ * Runs the given operation repeatedly, in batches of doubling size, until at
+ * least the given amount of time has passed. The operation is run once before
+ * measuring starts, to warm up caches.
+ */
+template <typename Op>
+Result measure(std::string benchmark,
+               std::string instance,
+               Op &&op,
+               std::chrono::nanoseconds minDuration
+               = std::chrono::milliseconds(200))
+{
+    op();
+
+    size_t numOps = 0;
+    size_t batchSize = 1;
+    std::chrono::nanoseconds elapsed(0);
+
+    auto const allocsBefore = numAllocations();
+
+    while (elapsed < minDuration)
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        for (size_t iter = 0; iter != batchSize; ++iter)
+            op();
+
+        elapsed += std::chrono::steady_clock::now() - start;
+        numOps += batchSize;
+        batchSize *= 2;
+    }
+
+    auto const allocs = numAllocations() - allocsBefore;
+
+    return {std::move(benchmark),
+            std::move(instance),
+            numOps,
+            static_cast<double>(elapsed.count()) / numOps,
+            static_cast<double>(allocs) / numOps};
+}
+
+/**
+ * Writes the given results as a JSON document to the given stream. Besides
+ * the results, the document records the compile-time configuration (problem
+ * type and precision), since results are only comparable between builds of
+ * the same configuration.
+ */
+void writeJson(std::ostream &out, std::vector<Result> const &results);
+}  // namespace bench
+
+#endif  // PYVRP_BENCHMARK_H
@@ -0,0 +1,288 @@
+#include "Vrplib.h"
+
+#include "Matrix.h"
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using Rows = std::vector<std::vector<double>>;
+
+struct Instance
+{
+    std::map<std::string, std::string> specs;  // KEY : VALUE lines
+    std::map<std::string, Rows> sections;      // NAME_SECTION data rows
+};
+
+std::string trim(std::string const &str)
+{
+    auto const first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return "";
+
+    auto const last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last - first + 1);
+}
+
+// Parses the given line as a row of numbers. Returns false if the line does
+// not (entirely) consist of numbers.
+bool parseRow(std::string const &line, std::vector<double> &row)
+{
+    std::istringstream stream(line);
+    double value;
+
+    row.clear();
+    while (stream >> value)
+        row.push_back(value);
+
+    return stream.eof() && !row.empty();
+}
+
+Instance parse(std::string const &path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + ".");
+
+    Instance instance;
+    Rows *section = nullptr;
+    std::vector<double> row;
+
+    for (std::string line; std::getline(file, line);)
+    {
+        line = trim(line);
+        if (line.empty() || line == "EOF")
+            continue;
+
+        if (section && parseRow(line, row))
+        {
+            section->push_back(row);
+            continue;
+        }
+
+        section = nullptr;
+
+        if (auto const colon = line.find(':'); colon != std::string::npos)
+        {
+            auto const key = trim(line.substr(0, colon));
+            instance.specs[key] = trim(line.substr(colon + 1));
+        }
+        else if (line.ends_with("_SECTION"))
+        {
+            auto const name = line.substr(0, line.size() - 8);
+            section = &instance.sections[name];
+        }
+    }
+
+    return instance;
+}
+
+// Returns the values of the given section, with the leading index column of
+// each row removed. Returns an empty vector if there is no such section.
+Rows values(Instance const &instance, std::string const &name)
+{
+    auto const it = instance.sections.find(name);
+    if (it == instance.sections.end())
+        return {};
+
+    Rows rows;
+    for (auto const &row : it->second)
+        rows.emplace_back(row.begin() + 1, row.end());
+
+    return rows;
+}
+
+// Returns the first column of the first of the given sections that exists in
+// the instance, or a vector of default values if none of them does.
+std::vector<double> column(Instance const &instance,
+                           std::vector<std::string> const &names,
+                           size_t dimension,
+                           double defaultValue = 0)
+{
+    for (auto const &name : names)
+    {
+        auto const rows = values(instance, name);
+        if (rows.empty())
+            continue;
+
+        if (rows.size() < dimension)
+            throw std::runtime_error(name + " section is too short.");
+
+        std::vector<double> result;
+        for (auto const &row : rows)
+            result.push_back(row.at(0));
+
+        return result;
+    }
+
+    return std::vector<double>(dimension, defaultValue);
+}
+
+double spec(Instance const &instance,
+            std::vector<std::string> const &keys,
+            double defaultValue)
+{
+    for (auto const &key : keys)
+        if (auto const it = instance.specs.find(key);
+            it != instance.specs.end())
+            return std::stod(it->second);
+
+    return defaultValue;
+}
+
+Matrix<double> edgeWeights(Instance const &instance, size_t dimension)
+{
+    Matrix<double> weights(dimension);
+    auto const type = instance.specs.count("EDGE_WEIGHT_TYPE")
+                          ? instance.specs.at("EDGE_WEIGHT_TYPE")
+                          : "";
+
+    if (type == "EXPLICIT")
+    {
+        if (instance.specs.count("EDGE_WEIGHT_FORMAT") == 0
+            || instance.specs.at("EDGE_WEIGHT_FORMAT") != "FULL_MATRIX")
+            throw std::runtime_error("Only FULL_MATRIX weights supported.");
+
+        std::vector<double> flat;
+        if (auto const it = instance.sections.find("EDGE_WEIGHT");
+            it != instance.sections.end())
+            for (auto const &row : it->second)
+                flat.insert(flat.end(), row.begin(), row.end());
+
+        if (flat.size() != dimension * dimension)
+            throw std::runtime_error("EDGE_WEIGHT section has wrong size.");
+
+        for (size_t idx = 0; idx != flat.size(); ++idx)
+            weights(idx / dimension, idx % dimension) = flat[idx];
+
+        return weights;
+    }
+
+    if (type != "EUC_2D")
+        throw std::runtime_error("Unsupported edge weight type: " + type);
+
+    auto const coords = values(instance, "NODE_COORD");
+    if (coords.size() != dimension)
+        throw std::runtime_error("NODE_COORD section has wrong size.");
+
+    for (size_t from = 0; from != dimension; ++from)
+        for (size_t to = 0; to != dimension; ++to)
+        {
+            auto const diffX = coords[from].at(0) - coords[to].at(0);
+            auto const diffY = coords[from].at(1) - coords[to].at(1);
+            weights(from, to) = std::hypot(diffX, diffY);
+        }
+
+    return weights;
+}
+}  // namespace
+
+ProblemData bench::readVrplib(std::string const &path)
+{
+    auto const instance = parse(path);
+
+    if (instance.specs.count("DIMENSION") == 0)
+        throw std::runtime_error(path + " does not specify a DIMENSION.");
+
+    auto const dimension = std::stoul(instance.specs.at("DIMENSION"));
+    auto const intMax = std::numeric_limits<int>::max();
+
+    auto const weights = edgeWeights(instance, dimension);
+    auto coords = values(instance, "NODE_COORD");
+    coords.resize(dimension, {0, 0});
+
+    auto const weightDemands
+        = column(instance, {"WEIGHT_DEMAND", "DEMAND"}, dimension);
+    auto const volumeDemands = column(instance, {"VOLUME_DEMAND"}, dimension);
+    auto const salvageDemands
+        = column(instance, {"SALVAGE_DEMAND"}, dimension);
+    auto const prizes = column(instance, {"PRIZE"}, dimension);
+
+    auto const hasTimeWindows = instance.sections.count("TIME_WINDOW") > 0;
+    auto timeWindows = values(instance, "TIME_WINDOW");
+    timeWindows.resize(dimension, {0, 0});
+
+    auto serviceTimes = column(instance, {"SERVICE_TIME"}, dimension);
+    if (auto const it = instance.specs.find("SERVICE_TIME");
+        it != instance.specs.end())  // uniform service time for all clients
+    {
+        auto const serviceTime = std::stod(it->second);
+        std::fill(serviceTimes.begin(), serviceTimes.end(), serviceTime);
+        serviceTimes[0] = 0;
+    }
+
+    // Clients map to orders, and orders to stores. Both sections index from
+    // the first client, not the depot.
+    auto const subOrderToOrder = column(instance, {"SUBORDER_TO_ORDER"}, 0);
+    auto const orderToStore = column(instance, {"ORDER_TO_STORE"}, 0);
+    auto const hasOrders = !subOrderToOrder.empty() && !orderToStore.empty();
+
+    std::vector<ProblemData::Client> clients;
+    clients.reserve(dimension);
+
+    for (size_t idx = 0; idx != dimension; ++idx)
+    {
+        Order order = -1;
+        Store store = -1;
+        auto salvage = salvageDemands[idx];
+
+        if (hasOrders && idx > 0)
+        {
+            auto const orderIdx
+                = static_cast<size_t>(subOrderToOrder.at(idx - 1));
+            auto const storeIdx
+                = static_cast<size_t>(orderToStore.at(orderIdx));
+
+            order = static_cast<int>(orderIdx);
+            store = static_cast<int>(storeIdx) + 1;
+            salvage = salvageDemands.at(storeIdx);
+        }
+
+        auto const service = hasTimeWindows ? serviceTimes[idx] : 0;
+        auto const twEarly = hasTimeWindows ? timeWindows[idx].at(0) : 0;
+        auto const twLate = hasTimeWindows ? timeWindows[idx].at(1) : 0;
+
+        clients.emplace_back(static_cast<int>(coords[idx].at(0)),
+                             static_cast<int>(coords[idx].at(1)),
+                             static_cast<int>(weightDemands[idx]),
+                             static_cast<int>(volumeDemands[idx]),
+                             static_cast<int>(salvage),
+                             order,
+                             store,
+                             static_cast<int>(service),
+                             static_cast<int>(twEarly),
+                             static_cast<int>(twLate),
+                             static_cast<int>(prizes[idx]),
+                             prizes[idx] == 0);
+    }
+
+    Matrix<Distance> dist(dimension);
+    Matrix<Duration> dur(dimension);
+
+    for (size_t from = 0; from != dimension; ++from)
+        for (size_t to = 0; to != dimension; ++to)
+        {
+            auto const distance = static_cast<int>(weights(from, to) / 10);
+            dist(from, to) = distance;
+            dur(from, to) = hasTimeWindows ? distance : 0;
+        }
+
+    auto const numVehicles = spec(instance, {"VEHICLES"}, dimension - 1);
+
+    return {clients,
+            static_cast<size_t>(numVehicles),
+            static_cast<int>(
+                spec(instance, {"WEIGHT_CAPACITY", "CAPACITY"}, intMax)),
+            static_cast<int>(spec(instance, {"VOLUME_CAPACITY"}, intMax)),
+            static_cast<int>(spec(instance, {"SALVAGE_CAPACITY"}, intMax)),
+            static_cast<int>(spec(instance, {"CLIENT_ROUTE_LIMIT"}, intMax)),
+            static_cast<int>(spec(instance, {"STOP_LIMIT"}, intMax)),
+            dist,
+            dur};
+}
@@ -0,0 +1,28 @@
+#ifndef PYVRP_VRPLIB_H
+#define PYVRP_VRPLIB_H
+
+#include "ProblemData.h"
+
+#include <string>
+
+namespace bench
+{
+/**
+ * Reads the VRPLIB instance at the given location. This is a minimal reader
+ * for benchmarking purposes, that mirrors what ``pyvrp.read`` does with the
+ * default (no) rounding: edge weights are divided by ten and truncated, and
+ * durations equal distances only when the instance has time windows. It
+ * supports explicit full matrix and ``EUC_2D`` edge weights, and the demand,
+ * time window, service time, prize, and order and store mapping sections.
+ * Unlike ``pyvrp.read``, it falls back to the standard ``CAPACITY`` field and
+ * ``DEMAND_SECTION`` for the weight capacity and demands, and lets orders and
+ * stores default to -1 (none) when their sections are missing, so that it can
+ * also read regular VRPLIB instances.
+ *
+ * @throws std::runtime_error When the file cannot be read, or uses features
+ *                            this reader does not support.
+ */
+ProblemData readVrplib(std::string const &path);
+}  // namespace bench
+
+#endif  // PYVRP_VRPLIB_H
@@ -0,0 +1,199 @@
+// Benchmark of computing distances and durations on demand, from the client
+// coordinates, against looking them up in dense matrices. For a range of
+// instance sizes, this measures the average time of obtaining both the
+// distance and the duration of an arc, without and with a 64-row cache in the
+// oracle, for two access patterns:
+//
+// - random arcs, which is the worst case for the cache;
+// - arcs from a small, slowly changing working set of clients to their
+//   granular neighbours, which resembles the local search: it evaluates moves
+//   around the clients of recently improved routes.
+//
+// Dense matrices are skipped for the largest instances, whose matrices would
+// not fit in memory: that is what the oracle is for.
+
+#include "Benchmark.h"
+
+#include "DistanceOracle.h"
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "XorShift128.h"
+#include "search/Neighbourhood.h"
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr size_t NUM_LOOKUPS = 1 << 23;
+constexpr size_t MAX_DENSE_CLIENTS = 8'000;
+constexpr size_t WORKING_SET_SIZE = 64;
+constexpr size_t LOOKUPS_PER_SWAP = 1 << 12;  // before swapping working client
+
+using Arcs = std::vector<std::pair<int, int>>;
+
+struct Instance
+{
+    std::vector<ProblemData::Client> clients;
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+Instance makeInstance(size_t numClients)
+{
+    XorShift128 rng(42);
+    Instance instance;
+
+    for (size_t idx = 0; idx <= numClients; ++idx)
+    {
+        auto const x = idx == 0 ? 500'000 : rng.randint(1'000'000);
+        auto const y = idx == 0 ? 500'000 : rng.randint(1'000'000);
+
+        instance.clients.emplace_back(x, y);
+        instance.x.push_back(x);
+        instance.y.push_back(y);
+    }
+
+    return instance;
+}
+
+ProblemData makeData(Instance const &instance, size_t cacheRows)
+{
+    DistanceOracleParams params;
+    params.rounding = Rounding::ROUND;
+    params.cacheRows = cacheRows;
+
+    auto const numClients = instance.clients.size() - 1;
+    return {instance.clients,
+            numClients / 10,
+            static_cast<Value>(numClients),
+            static_cast<Value>(numClients),
+            0,
+            static_cast<Order>(numClients),
+            static_cast<Store>(numClients),
+            DistanceOracle(instance.x, instance.y, params)};
+}
+
+// Copies the oracle's values into dense matrices.
+ProblemData makeDenseData(Instance const &instance, ProblemData const &data)
+{
+    auto const dim = data.numClients() + 1;
+    Matrix<Distance> dist(dim);
+    Matrix<Duration> dur(dim);
+
+    for (size_t row = 0; row != dim; ++row)
+        for (size_t col = 0; col != dim; ++col)
+        {
+            dist(row, col) = data.dist(row, col);
+            dur(row, col) = data.duration(row, col);
+        }
+
+    return {instance.clients,
+            data.numVehicles(),
+            data.weightCapacity(),
+            data.volumeCapacity(),
+            data.salvageCapacity(),
+            data.orderRouteLimit(),
+            data.routeStoreLimit(),
+            std::move(dist),
+            std::move(dur)};
+}
+
+Arcs randomArcs(size_t numClients)
+{
+    XorShift128 rng(42);
+
+    Arcs arcs;
+    arcs.reserve(NUM_LOOKUPS);
+    for (size_t idx = 0; idx != NUM_LOOKUPS; ++idx)
+        arcs.emplace_back(rng.randint(numClients + 1),
+                          rng.randint(numClients + 1));
+
+    return arcs;
+}
+
+Arcs granularArcs(ProblemData const &data)
+{
+    XorShift128 rng(42);
+    auto const neighbours = computeNeighbourhood(data, NeighbourhoodParams{});
+
+    std::vector<int> working;
+    for (size_t idx = 0; idx != WORKING_SET_SIZE; ++idx)
+        working.push_back(1 + rng.randint(data.numClients()));
+
+    Arcs arcs;
+    arcs.reserve(NUM_LOOKUPS);
+    for (size_t idx = 0; idx != NUM_LOOKUPS; ++idx)
+    {
+        if (idx % LOOKUPS_PER_SWAP == 0)
+            working[rng.randint(WORKING_SET_SIZE)]
+                = 1 + rng.randint(data.numClients());
+
+        auto const client = working[rng.randint(WORKING_SET_SIZE)];
+        auto const clientNeighbours = neighbours[client];
+        auto const other = rng.randint(clientNeighbours.size());
+        arcs.emplace_back(client, clientNeighbours[other]);
+    }
+
+    return arcs;
+}
+
+// Returns the average time in nanoseconds of obtaining the distance and
+// duration of the given arcs.
+double benchmark(ProblemData const &data, Arcs const &arcs)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    Value sum = 0;
+    for (auto const &[from, to] : arcs)
+        sum += data.dist(from, to).get() + data.duration(from, to).get();
+
+    bench::doNotOptimize(sum);
+    auto const end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::nano> const elapsed = end - start;
+    return elapsed.count() / arcs.size();
+}
+}  // namespace
+
+int main()
+{
+    std::printf("%8s %10s %12s %12s %12s\n",
+                "clients",
+                "pattern",
+                "dense (ns)",
+                "oracle (ns)",
+                "cached (ns)");
+
+    for (size_t const numClients : {1'000, 5'000, 8'000, 50'000})
+    {
+        auto const instance = makeInstance(numClients);
+        auto const uncached = makeData(instance, 0);
+        auto const cached = makeData(instance, 64);
+
+        std::vector<std::pair<char const *, Arcs>> patterns;
+        patterns.emplace_back("random", randomArcs(numClients));
+        patterns.emplace_back("granular", granularArcs(uncached));
+
+        for (auto const &[pattern, arcs] : patterns)
+        {
+            std::printf("%8zu %10s", numClients, pattern);
+
+            if (numClients <= MAX_DENSE_CLIENTS)
+            {
+                auto const dense = makeDenseData(instance, uncached);
+                std::printf(" %12.2f", benchmark(dense, arcs));
+            }
+            else
+                std::printf(" %12s", "-");
+
+            std::printf(" %12.2f", benchmark(uncached, arcs));
+            std::printf(" %12.2f\n", benchmark(cached, arcs));
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
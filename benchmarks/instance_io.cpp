@@ -0,0 +1,154 @@
+// Benchmark of loading instances. For a range of instance sizes, this writes a
+// random instance with an explicit, full distance matrix both as a VRPLIB text
+// file and in the binary instance format. It then measures how long it takes
+// to read the text file, to load the binary file, and to load the binary file
+// and touch every element of both matrices, which forces all of the mapped
+// file to be read. The text reader is the benchmark's own VRPLIB reader, which
+// is considerably faster than pyvrp.read, so the comparison is conservative.
+// Files are written to the directory given on the command line, or to the
+// system's temporary directory.
+
+#include "Benchmark.h"
+#include "Vrplib.h"
+
+#include "InstanceFile.h"
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "XorShift128.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+// Writes a random instance with the given number of clients as a VRPLIB file
+// with an explicit, full edge weight matrix, and with time windows, so that
+// the reader also fills the duration matrix.
+void writeVrplib(fs::path const &path, size_t numClients, XorShift128 &rng)
+{
+    auto const dim = numClients + 1;
+
+    std::vector<std::pair<int, int>> coords;
+    for (size_t idx = 0; idx != dim; ++idx)
+        coords.emplace_back(rng.randint(10'000), rng.randint(10'000));
+
+    std::ofstream out(path);
+    out << "NAME : random\n"
+        << "DIMENSION : " << dim << '\n'
+        << "EDGE_WEIGHT_TYPE : EXPLICIT\n"
+        << "EDGE_WEIGHT_FORMAT : FULL_MATRIX\n"
+        << "CAPACITY : " << numClients << '\n'
+        << "VEHICLES : " << numClients / 10 + 1 << '\n';
+
+    out << "NODE_COORD_SECTION\n";
+    for (size_t idx = 0; idx != dim; ++idx)
+        out << idx + 1 << ' ' << coords[idx].first << ' '
+            << coords[idx].second << '\n';
+
+    out << "EDGE_WEIGHT_SECTION\n";
+    for (size_t from = 0; from != dim; ++from)
+    {
+        for (size_t to = 0; to != dim; ++to)
+        {
+            auto const diffX = coords[from].first - coords[to].first;
+            auto const diffY = coords[from].second - coords[to].second;
+            out << std::abs(diffX) + std::abs(diffY) << ' ';
+        }
+
+        out << '\n';
+    }
+
+    out << "DEMAND_SECTION\n";
+    for (size_t idx = 0; idx != dim; ++idx)
+        out << idx + 1 << ' ' << (idx == 0 ? 0 : 1) << '\n';
+
+    out << "TIME_WINDOW_SECTION\n";
+    for (size_t idx = 0; idx != dim; ++idx)
+        out << idx + 1 << " 0 1000000\n";
+
+    out << "EOF\n";
+}
+
+// Returns the time in milliseconds that the given operation takes.
+template <typename Op> double timed(Op &&op)
+{
+    auto const start = std::chrono::steady_clock::now();
+    op();
+    auto const end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::milli> const elapsed = end - start;
+    return elapsed.count();
+}
+
+// Sums all elements of both matrices, so that all their pages are read.
+Value touch(ProblemData const &data)
+{
+    Value sum = 0;
+    auto const dim = data.numClients() + 1;
+
+    for (size_t from = 0; from != dim; ++from)
+        for (size_t to = 0; to != dim; ++to)
+            sum += data.dist(from, to).get() + data.duration(from, to).get();
+
+    return sum;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    fs::path const dir = argc > 1 ? fs::path(argv[1])
+                                  : fs::temp_directory_path();
+
+    std::printf("%8s %12s %12s %12s %12s %12s\n",
+                "clients",
+                "text (MB)",
+                "binary (MB)",
+                "text (ms)",
+                "binary (ms)",
+                "touched (ms)");
+
+    for (size_t const numClients : {500, 1'000, 2'000, 4'000})
+    {
+        XorShift128 rng(42);
+
+        auto const textPath = dir / "pyvrp_instance_io.vrp";
+        auto const binaryPath = dir / "pyvrp_instance_io.bin";
+
+        writeVrplib(textPath, numClients, rng);
+        auto const data = bench::readVrplib(textPath.string());
+        writeInstance(data, binaryPath.string());
+
+        auto const textTime = timed([&] {
+            auto const data = bench::readVrplib(textPath.string());
+            bench::doNotOptimize(data.numClients());
+        });
+
+        auto const binaryTime = timed([&] {
+            auto const data = loadInstance(binaryPath.string());
+            bench::doNotOptimize(data.numClients());
+        });
+
+        auto const touchedTime = timed([&] {
+            auto const data = loadInstance(binaryPath.string());
+            bench::doNotOptimize(touch(data));
+        });
+
+        std::printf("%8zu %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+                    numClients,
+                    fs::file_size(textPath) / 1e6,
+                    fs::file_size(binaryPath) / 1e6,
+                    textTime,
+                    binaryTime,
+                    touchedTime);
+
+        fs::remove(textPath);
+        fs::remove(binaryPath);
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Benchmark of the distance and duration matrix storage layouts. For a range
+// of instance sizes, this measures the average time of looking up both the
+// distance and the duration of a random arc, which is the access pattern of
+// operator evaluations, in each layout. Clients are spread uniformly over the
+// plane, and distances and durations are symmetric and Euclidean, so that all
+// layouts can be used.
+
+#include "Benchmark.h"
+
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "XorShift128.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using MatrixStorage = ProblemData::MatrixStorage;
+
+constexpr size_t NUM_LOOKUPS = 1 << 24;
+
+ProblemData makeData(size_t numClients, MatrixStorage storage)
+{
+    XorShift128 rng(42);
+
+    std::vector<ProblemData::Client> clients;
+    clients.emplace_back(5'000, 5'000);  // depot
+
+    for (size_t idx = 1; idx <= numClients; ++idx)
+        clients.emplace_back(rng.randint(10'000), rng.randint(10'000));
+
+    Matrix<Distance> dist(numClients + 1);
+    Matrix<Duration> dur(numClients + 1);
+
+    for (size_t row = 0; row <= numClients; ++row)
+        for (size_t col = 0; col <= numClients; ++col)
+        {
+            auto const diffX = clients[row].x.get() - clients[col].x.get();
+            auto const diffY = clients[row].y.get() - clients[col].y.get();
+            auto const euclid = std::hypot(diffX, diffY);
+            dist(row, col) = static_cast<int>(euclid);
+            dur(row, col) = static_cast<int>(euclid);
+        }
+
+    return {clients,
+            numClients / 10,
+            numClients,
+            numClients,
+            0,
+            static_cast<Order>(numClients),
+            static_cast<Store>(numClients),
+            std::move(dist),
+            std::move(dur),
+            storage};
+}
+
+// Returns the average time in nanoseconds of looking up the distance and
+// duration of a random arc.
+double benchmark(ProblemData const &data)
+{
+    XorShift128 rng(42);
+
+    std::vector<std::pair<int, int>> arcs;
+    arcs.reserve(NUM_LOOKUPS);
+    for (size_t idx = 0; idx != NUM_LOOKUPS; ++idx)
+        arcs.emplace_back(rng.randint(data.numClients() + 1),
+                          rng.randint(data.numClients() + 1));
+
+    auto const start = std::chrono::steady_clock::now();
+
+    Value sum = 0;
+    for (auto const &[from, to] : arcs)
+        sum += data.dist(from, to).get() + data.duration(from, to).get();
+
+    bench::doNotOptimize(sum);
+    auto const end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::nano> const elapsed = end - start;
+    return elapsed.count() / NUM_LOOKUPS;
+}
+}  // namespace
+
+int main()
+{
+    std::printf("%8s %12s %12s %12s %12s %12s\n",
+                "clients",
+                "dense (ns)",
+                "symm. (ns)",
+                "16-bit (ns)",
+                "32-bit (ns)",
+                "inter. (ns)");
+
+    for (size_t const numClients : {500, 2'000, 5'000, 8'000})
+    {
+        std::printf("%8zu", numClients);
+
+        for (auto const storage : {MatrixStorage::DENSE,
+                                   MatrixStorage::SYMMETRIC,
+                                   MatrixStorage::COMPACT_16,
+                                   MatrixStorage::COMPACT_32,
+                                   MatrixStorage::INTERLEAVED})
+        {
+            auto const data = makeData(numClients, storage);
+            std::printf(" %12.2f", benchmark(data));
+            std::fflush(stdout);
+        }
+
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,433 @@
+// Suite of microbenchmarks of the C++ hot paths: time window segment merges,
+// operator evaluations, route updates, solution construction, the diversity
+// measure, subpopulation management, and crossover. Each benchmark is run on
+// every instance given on the command line (directories are searched for
+// instance files); without arguments, the instances in pyvrp/tests/data are
+// used, and those in instances/ when that directory exists. Results are
+// written to stdout as JSON, and progress to stderr.
+
+#include "Benchmark.h"
+#include "Vrplib.h"
+
+#include "CostEvaluator.h"
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "Solution.h"
+#include "SubPopulation.h"
+#include "TimeWindowSegment.h"
+#include "XorShift128.h"
+#include "crossover/crossover.h"
+#include "diversity/diversity.h"
+#include "search/Exchange.h"
+#include "search/Node.h"
+#include "search/OrderIndex.h"
+#include "search/RelocateStar.h"
+#include "search/Route.h"
+#include "search/SwapStar.h"
+#include "search/TwoOpt.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+using Pairs = std::vector<std::pair<Node *, Node *>>;
+
+// Number of precomputed arguments the benchmarks cycle through. This is a
+// power of two, so the index can wrap around with a mask.
+constexpr size_t NUM_ARGS = 1024;
+
+// Local search nodes and routes of a solution, set up in the same way as
+// LocalSearch::loadSolution() does.
+struct SearchState
+{
+    std::vector<Node> clients;
+    std::vector<Node> startDepots;
+    std::vector<Node> endDepots;
+    std::vector<Route> routes;
+    OrderIndex orderIndex;
+
+    SearchState(ProblemData const &data, Solution const &solution)
+        : clients(data.numClients() + 1),
+          startDepots(data.numVehicles()),
+          endDepots(data.numVehicles()),
+          routes(data.numVehicles(), data),
+          orderIndex(data)
+    {
+        for (size_t client = 0; client <= data.numClients(); ++client)
+        {
+            auto &node = clients[client];
+            node.client = client;
+            node.route = nullptr;
+            node.tw = {static_cast<int>(client),
+                       static_cast<int>(client),
+                       data.serviceDuration(client),
+                       0,
+                       data.twEarly(client),
+                       data.twLate(client)};
+            node.seq = SequenceSegment(data.clientClass(client));
+        }
+
+        auto const &solRoutes = solution.getRoutes();
+
+        for (size_t r = 0; r != data.numVehicles(); ++r)
+        {
+            auto &route = routes[r];
+            auto *startDepot = &startDepots[r];
+            auto *endDepot = &endDepots[r];
+
+            route.idx = r;
+            route.depot = startDepot;
+
+            for (auto *depot : {startDepot, endDepot})
+            {
+                depot->client = 0;
+                depot->route = &route;
+                depot->tw = clients[0].tw;
+                depot->twBefore = clients[0].tw;
+                depot->twAfter = clients[0].tw;
+                depot->seq = {};
+                depot->seqBefore = {};
+            }
+
+            startDepot->next = endDepot;
+            startDepot->prev = endDepot;
+            endDepot->next = startDepot;
+            endDepot->prev = startDepot;
+
+            if (r < solRoutes.size())
+                for (auto const client : solRoutes[r])
+                    clients[client].insertAfter(endDepot->prev);
+
+            route.update();
+            orderIndex.update(route);
+        }
+    }
+
+    // Returns random pairs of distinct clients that are both in a route.
+    Pairs randomPairs(ProblemData const &data, XorShift128 &rng)
+    {
+        Pairs pairs;
+
+        while (pairs.size() != NUM_ARGS)
+        {
+            auto *U = &clients[1 + rng.randint(data.numClients())];
+            auto *V = &clients[1 + rng.randint(data.numClients())];
+
+            if (U != V && U->route && V->route)
+                pairs.emplace_back(U, V);
+        }
+
+        return pairs;
+    }
+};
+
+// Returns a solution improved by applying improving relocate moves to random
+// client pairs until no improving pair is found for a while. The benchmarks
+// use this, rather than random solutions, so that they evaluate moves on
+// solutions that look like those the local search actually works on.
+Solution improve(ProblemData const &data,
+                 CostEvaluator const &costEvaluator,
+                 XorShift128 &rng)
+{
+    Solution solution(data, rng);
+    SearchState state(data, solution);
+
+    Exchange<1, 0> relocate(data);
+    relocate.setOrderIndex(&state.orderIndex);
+
+    for (size_t numFailures = 0; numFailures < 50 * data.numClients();)
+    {
+        auto *U = &state.clients[1 + rng.randint(data.numClients())];
+        auto *V = &state.clients[1 + rng.randint(data.numClients())];
+
+        if (U == V || !U->route || !V->route
+            || relocate.evaluate(U, V, costEvaluator) >= 0)
+        {
+            numFailures++;
+            continue;
+        }
+
+        auto *routeU = U->route;
+        auto *routeV = V->route;
+
+        relocate.apply(U, V);
+
+        for (auto *route : {routeU, routeV})
+        {
+            route->update();
+            state.orderIndex.update(*route);
+        }
+
+        numFailures = 0;
+    }
+
+    std::vector<std::vector<int>> routes;
+    for (auto const &route : state.routes)
+    {
+        std::vector<int> visits;
+        for (size_t pos = 1; pos <= route.size(); ++pos)
+            visits.push_back(route[pos]->client);
+
+        routes.push_back(visits);
+    }
+
+    return {data, routes};
+}
+
+// Arguments shared by the operator benchmarks.
+struct OpArgs
+{
+    std::string const &instance;
+    ProblemData const &data;
+    Solution const &solution;
+    CostEvaluator const &costEvaluator;
+};
+
+template <typename Op>
+void benchmarkNodeOp(std::vector<bench::Result> &results,
+                     std::string const &name,
+                     OpArgs const &args)
+{
+    auto const &[instance, data, solution, costEvaluator] = args;
+
+    XorShift128 rng(42);
+    SearchState state(data, solution);
+    auto const pairs = state.randomPairs(data, rng);
+
+    Op op(data);
+    op.setOrderIndex(&state.orderIndex);
+
+    size_t idx = 0;
+    results.push_back(bench::measure(name, instance, [&] {
+        auto const [U, V] = pairs[idx++ & (NUM_ARGS - 1)];
+        bench::doNotOptimize(op.evaluate(U, V, costEvaluator));
+    }));
+}
+
+// The operator's caches (if any) are warm after the first evaluation of each
+// route pair, which is also the common case during the search.
+template <typename Op>
+void benchmarkRouteOp(std::vector<bench::Result> &results,
+                      std::string const &name,
+                      OpArgs const &args)
+{
+    auto const &[instance, data, solution, costEvaluator] = args;
+
+    XorShift128 rng(42);
+    SearchState state(data, solution);
+    std::vector<std::pair<Route *, Route *>> pairs;
+
+    for (size_t idx = 0; idx != NUM_ARGS; ++idx)
+    {
+        auto *U = &state.routes[rng.randint(data.numVehicles())];
+        auto *V = &state.routes[rng.randint(data.numVehicles())];
+
+        if (U == V || U->empty() || V->empty())
+            continue;
+
+        pairs.emplace_back(U, V);
+    }
+
+    if (pairs.empty())
+        return;
+
+    Op op(data);
+    op.setOrderIndex(&state.orderIndex);
+    op.init(solution);
+
+    size_t idx = 0;
+    results.push_back(bench::measure(name, instance, [&] {
+        auto const [U, V] = pairs[idx++ % pairs.size()];
+        bench::doNotOptimize(op.evaluate(U, V, costEvaluator));
+    }));
+}
+
+void benchmarkInstance(std::vector<bench::Result> &results,
+                       std::string const &instance,
+                       ProblemData const &data)
+{
+    XorShift128 rng(42);
+    CostEvaluator const costEvaluator(20, 20, 20, 20, 20, 20, 6);
+
+    auto const solution = improve(data, costEvaluator, rng);
+    auto const other = improve(data, costEvaluator, rng);
+
+    // Time window segment merges of random client pairs.
+    {
+        std::vector<std::pair<TimeWindowSegment, TimeWindowSegment>> args;
+        SearchState state(data, solution);
+
+        for (size_t idx = 0; idx != NUM_ARGS; ++idx)
+        {
+            auto const first = 1 + rng.randint(data.numClients());
+            auto const second = 1 + rng.randint(data.numClients());
+            args.emplace_back(state.clients[first].tw,
+                              state.clients[second].tw);
+        }
+
+        size_t idx = 0;
+        results.push_back(bench::measure("tws_merge", instance, [&] {
+            auto const &[first, second] = args[idx++ & (NUM_ARGS - 1)];
+            auto const merged
+                = TimeWindowSegment::merge(data.durations(), first, second);
+            bench::doNotOptimize(merged.totalTimeWarp());
+        }));
+    }
+
+    // Node operator evaluations, for a representative set of (N, M).
+    OpArgs const args = {instance, data, solution, costEvaluator};
+    benchmarkNodeOp<Exchange<1, 0>>(results, "exchange10", args);
+    benchmarkNodeOp<Exchange<2, 0>>(results, "exchange20", args);
+    benchmarkNodeOp<Exchange<1, 1>>(results, "exchange11", args);
+    benchmarkNodeOp<Exchange<2, 1>>(results, "exchange21", args);
+    benchmarkNodeOp<Exchange<3, 3>>(results, "exchange33", args);
+    benchmarkNodeOp<TwoOpt>(results, "two_opt", args);
+
+    // Route operator evaluations of random route pairs.
+    benchmarkRouteOp<SwapStar>(results, "swap_star", args);
+    benchmarkRouteOp<RelocateStar>(results, "relocate_star", args);
+
+    // Route updates after moving a random client to a random position in the
+    // same route.
+    {
+        SearchState state(data, solution);
+        auto const pairs = state.randomPairs(data, rng);
+
+        size_t idx = 0;
+        results.push_back(bench::measure("route_update", instance, [&] {
+            auto const [U, V] = pairs[idx++ & (NUM_ARGS - 1)];
+            auto *routeU = U->route;
+            auto *routeV = V->route;
+
+            U->insertAfter(V);
+            routeU->update();
+
+            if (routeU != routeV)
+                routeV->update();
+        }));
+    }
+
+    // Solution construction, both from random routes and given routes.
+    {
+        std::vector<std::vector<int>> routes;
+        for (auto const &route : solution.getRoutes())
+            routes.push_back(route.visits());
+
+        results.push_back(bench::measure("solution_random", instance, [&] {
+            bench::doNotOptimize(Solution(data, rng).distance());
+        }));
+
+        results.push_back(bench::measure("solution_routes", instance, [&] {
+            bench::doNotOptimize(Solution(data, routes).distance());
+        }));
+    }
+
+    results.push_back(bench::measure("broken_pairs_distance", instance, [&] {
+        bench::doNotOptimize(brokenPairsDistance(solution, other));
+    }));
+
+    // Adding solutions to a subpopulation. Every so often this triggers a
+    // purge, which is thus included in the (amortised) cost of adding.
+    {
+        std::vector<Solution> solutions;
+        for (size_t idx = 0; idx != 64; ++idx)
+            solutions.emplace_back(data, rng);
+
+        PopulationParams const params;
+        SubPopulation subPop(brokenPairsDistance, params);
+
+        size_t idx = 0;
+        results.push_back(bench::measure("subpopulation_add", instance, [&] {
+            subPop.add(&solutions[idx++ % solutions.size()], costEvaluator);
+        }));
+    }
+
+    results.push_back(bench::measure("srex", instance, [&] {
+        auto const numRoutesFirst = solution.numRoutes();
+        auto const numRoutesSecond = other.numRoutes();
+        auto const numMoved = std::min(numRoutesFirst, numRoutesSecond);
+
+        auto const offspring = selectiveRouteExchange(
+            {&solution, &other},
+            data,
+            costEvaluator,
+            {rng.randint(numRoutesFirst), rng.randint(numRoutesSecond)},
+            1 + rng.randint(numMoved));
+
+        bench::doNotOptimize(offspring.distance());
+    }));
+}
+
+// Returns the instance files at the given path: the path itself if it is a
+// file, or all instance files in it (recursively) if it is a directory.
+std::vector<fs::path> instanceFiles(fs::path const &path)
+{
+    if (!fs::is_directory(path))
+        return {path};
+
+    std::vector<fs::path> files;
+    for (auto const &entry : fs::recursive_directory_iterator(path))
+    {
+        auto const ext = entry.path().extension();
+        if (entry.is_regular_file() && (ext == ".vrp" || ext == ".txt"))
+            files.push_back(entry.path());
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<fs::path> paths(argv + 1, argv + argc);
+
+    if (paths.empty())
+    {
+        paths = {"pyvrp/tests/data/OkSmall.txt",
+                 "pyvrp/tests/data/E-n22-k4.txt",
+                 "pyvrp/tests/data/p06-2-50.vrp"};
+
+        if (fs::is_directory("instances"))
+            paths.emplace_back("instances");
+    }
+
+    std::vector<bench::Result> results;
+
+    for (auto const &path : paths)
+        for (auto const &file : instanceFiles(path))
+        {
+            std::unique_ptr<ProblemData> data;
+
+            try
+            {
+                data = std::make_unique<ProblemData>(
+                    bench::readVrplib(file.string()));
+            }
+            catch (std::exception const &error)
+            {
+                std::cerr << "Skipping " << file << ": " << error.what()
+                          << '\n';
+                continue;
+            }
+
+            if (data->numClients() < 2 || data->numVehicles() < 2)
+            {
+                std::cerr << "Skipping " << file << ": too small.\n";
+                continue;
+            }
+
+            std::cerr << "Benchmarking " << file << '\n';
+            benchmarkInstance(results, file.filename().string(), *data);
+        }
+
+    bench::writeJson(std::cout, results);
+    return 0;
+}
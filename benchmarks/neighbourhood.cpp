@@ -0,0 +1,140 @@
+// Benchmark of the granular neighbourhood computation. For a range of instance
+// sizes, this computes the neighbourhood exactly, by evaluating the proximity
+// of all client pairs, and using a k-d tree that only evaluates the proximity
+// to nearby candidate clients. It reports the time both take, and the fraction
+// of the exact neighbourhood that the candidate-based neighbourhood recovers.
+// Clients are spread uniformly over the plane, with time windows of varying
+// width, and distances are Euclidean.
+
+#include "Benchmark.h"
+
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "XorShift128.h"
+#include "search/Neighbourhood.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+ProblemData makeData(size_t numClients, XorShift128 &rng)
+{
+    std::vector<ProblemData::Client> clients;
+    clients.emplace_back(5'000, 5'000, 0, 0, 0, -1, -1, 0, 0, 100'000);
+
+    for (size_t idx = 1; idx <= numClients; ++idx)
+    {
+        auto const twEarly = rng.randint(50'000);
+        auto const twLate = twEarly + 2'000 + rng.randint(48'000);
+
+        clients.emplace_back(rng.randint(10'000),
+                             rng.randint(10'000),
+                             1,        // weight
+                             1,        // volume
+                             0,        // salvage
+                             -1,       // no order
+                             -1,       // no store
+                             10,       // service duration
+                             twEarly,  // tw early
+                             twLate);  // tw late
+    }
+
+    Matrix<Distance> dist(numClients + 1);
+    Matrix<Duration> dur(numClients + 1);
+
+    for (size_t row = 0; row <= numClients; ++row)
+        for (size_t col = 0; col <= numClients; ++col)
+        {
+            auto const diffX = clients[row].x.get() - clients[col].x.get();
+            auto const diffY = clients[row].y.get() - clients[col].y.get();
+            auto const euclid = std::hypot(diffX, diffY);
+            dist(row, col) = static_cast<int>(euclid);
+            dur(row, col) = static_cast<int>(euclid);
+        }
+
+    return {clients,
+            numClients / 10,
+            numClients,
+            numClients,
+            0,
+            static_cast<Order>(numClients),
+            static_cast<Store>(numClients),
+            dist,
+            dur};
+}
+
+// Returns the time in milliseconds it takes to compute the neighbourhood with
+// the given parameters, and the neighbourhood itself.
+std::pair<double, Neighbourhood> timed(ProblemData const &data,
+                                       NeighbourhoodParams const &params)
+{
+    auto const start = std::chrono::steady_clock::now();
+    auto neighbourhood = computeNeighbourhood(data, params);
+    auto const end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::milli> const elapsed = end - start;
+    return {elapsed.count(), std::move(neighbourhood)};
+}
+
+// Returns the fraction of neighbours in the exact neighbourhood that are also
+// in the approximate neighbourhood.
+double recovered(Neighbourhood const &exact, Neighbourhood const &approx)
+{
+    size_t numRecovered = 0;
+
+    for (size_t client = 0; client != exact.size(); ++client)
+    {
+        auto const approxNeighbours = approx[client];
+        for (auto const neighbour : exact[client])
+            numRecovered += std::count(approxNeighbours.begin(),
+                                       approxNeighbours.end(),
+                                       neighbour);
+    }
+
+    return static_cast<double>(numRecovered) / exact.numNeighbours();
+}
+}  // namespace
+
+int main()
+{
+    std::printf("%8s %12s %12s %12s %12s %12s\n",
+                "clients",
+                "exact (ms)",
+                "kd 100 (ms)",
+                "recovered",
+                "kd 200 (ms)",
+                "recovered");
+
+    for (size_t const numClients : {1'000, 2'000, 4'000, 8'000})
+    {
+        XorShift128 rng(42);
+        auto const data = makeData(numClients, rng);
+
+        NeighbourhoodParams const exact;
+
+        NeighbourhoodParams small;
+        small.numCandidates = 100;
+
+        NeighbourhoodParams large;
+        large.numCandidates = 200;
+
+        auto const [exactTime, exactNeighbourhood] = timed(data, exact);
+        auto const [smallTime, smallNeighbourhood] = timed(data, small);
+        auto const [largeTime, largeNeighbourhood] = timed(data, large);
+
+        std::printf("%8zu %12.1f %12.1f %12.3f %12.1f %12.3f\n",
+                    numClients,
+                    exactTime,
+                    smallTime,
+                    recovered(exactNeighbourhood, smallNeighbourhood),
+                    largeTime,
+                    recovered(exactNeighbourhood, largeNeighbourhood));
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+// Benchmark of renumbering the clients along a space-filling curve. For large
+// instances with randomly placed clients, this compares the original client
+// order with the Hilbert and Morton orders on two workloads:
+//
+// - a scan over each client's granular neighbours, reading the distance and
+//   duration of each arc. This is the access pattern of the node operators;
+// - node-based local search from the same random solutions, which reports
+//   both the time taken and the cost of the resulting solution.
+//
+// The solutions are mapped to the internal ids of each renumbered instance, so
+// that every ordering starts from the same solutions. The local search visits
+// the clients in order of their internal ids, so the resulting costs differ a
+// little between orderings.
+
+#include "Benchmark.h"
+
+#include "CostEvaluator.h"
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "Solution.h"
+#include "XorShift128.h"
+#include "search/Exchange.h"
+#include "search/LocalSearch.h"
+#include "search/Neighbourhood.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr size_t NUM_SCANS = 20;
+constexpr size_t NUM_SOLUTIONS = 2;
+
+using Routes = std::vector<std::vector<int>>;
+
+ProblemData makeData(size_t numClients, size_t numVehicles)
+{
+    XorShift128 rng(42);
+
+    std::vector<ProblemData::Client> clients;
+    clients.emplace_back(50'000, 50'000);  // depot, in the centre
+
+    for (size_t idx = 1; idx <= numClients; ++idx)
+        clients.emplace_back(rng.randint(100'000),
+                             rng.randint(100'000),
+                             1 + rng.randint(10),  // weight
+                             1 + rng.randint(10),  // volume
+                             0,                    // salvage
+                             -1,                   // no order
+                             -1,                   // no store
+                             10,                   // service duration
+                             0,                    // tw early
+                             100'000'000);         // tw late
+
+    Matrix<Distance> dist(numClients + 1);
+    Matrix<Duration> dur(numClients + 1);
+
+    for (size_t row = 0; row <= numClients; ++row)
+        for (size_t col = 0; col <= numClients; ++col)
+        {
+            auto const diffX = clients[row].x.get() - clients[col].x.get();
+            auto const diffY = clients[row].y.get() - clients[col].y.get();
+            dist(row, col) = std::abs(diffX) + std::abs(diffY);
+            dur(row, col) = dist(row, col).get();
+        }
+
+    Load const capacity = 6 * numClients / numVehicles;
+    Order const orderLimit = numClients;
+    Store const storeLimit = numClients;
+
+    return {clients,
+            numVehicles,
+            capacity,
+            capacity,
+            0,
+            orderLimit,
+            storeLimit,
+            std::move(dist),
+            std::move(dur)};
+}
+
+// Returns random routes in terms of the original client ids.
+Routes makeRoutes(ProblemData const &data, XorShift128 &rng)
+{
+    std::vector<int> clients(data.numClients());
+    for (size_t idx = 0; idx != clients.size(); ++idx)
+        clients[idx] = static_cast<int>(idx + 1);
+
+    std::shuffle(clients.begin(), clients.end(), rng);
+
+    Routes routes(data.numVehicles());
+    for (size_t idx = 0; idx != clients.size(); ++idx)
+        routes[idx % routes.size()].push_back(clients[idx]);
+
+    return routes;
+}
+
+// Maps routes in original client ids to the internal ids of the given data.
+Routes toInternal(ProblemData const &data, Routes routes)
+{
+    for (auto &route : routes)
+        for (auto &client : route)
+            client = data.internalId(client);
+
+    return routes;
+}
+
+// Returns the average time in nanoseconds of obtaining the distance and
+// duration of an arc, when scanning over all clients' granular neighbours.
+double scan(ProblemData const &data, Neighbourhood const &neighbours)
+{
+    size_t numArcs = 0;
+    Value sum = 0;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    for (size_t rep = 0; rep != NUM_SCANS; ++rep)
+        for (size_t client = 1; client <= data.numClients(); ++client)
+            for (auto const other : neighbours[client])
+            {
+                sum += data.dist(client, other).get();
+                sum += data.duration(other, client).get();
+                ++numArcs;
+            }
+
+    bench::doNotOptimize(sum);
+    auto const end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::nano> const elapsed = end - start;
+    return elapsed.count() / numArcs;
+}
+
+struct SearchResult
+{
+    double seconds;  // average time per search
+    double cost;     // average penalised cost of the searched solutions
+};
+
+SearchResult search(ProblemData const &data,
+                    Neighbourhood neighbours,
+                    std::vector<Routes> const &solutions)
+{
+    CostEvaluator const costEvaluator(20, 20, 20, 20, 20, 20, 6);
+    LocalSearch ls(data, std::move(neighbours));
+
+    Exchange<1, 0> relocate(data);
+    Exchange<1, 1> swap(data);
+    ls.addNodeOperator(relocate);
+    ls.addNodeOperator(swap);
+
+    double seconds = 0;
+    double cost = 0;
+
+    for (auto const &routes : solutions)
+    {
+        Solution const solution(data, toInternal(data, routes));
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const improved = ls.search(solution, costEvaluator);
+        auto const end = std::chrono::steady_clock::now();
+
+        seconds += std::chrono::duration<double>(end - start).count();
+        cost += costEvaluator.penalisedCost(improved).get();
+    }
+
+    return {seconds / solutions.size(), cost / solutions.size()};
+}
+}  // namespace
+
+int main()
+{
+    std::printf("%8s %9s %10s %10s %12s %14s\n",
+                "clients",
+                "ordering",
+                "setup (s)",
+                "scan (ns)",
+                "search (s)",
+                "cost");
+
+    for (auto const &[numClients, numVehicles] :
+         {std::pair<size_t, size_t>{5'000, 250}, {10'000, 500}})
+    {
+        auto const original = makeData(numClients, numVehicles);
+
+        XorShift128 rng(42);
+        std::vector<Routes> solutions;
+        for (size_t idx = 0; idx != NUM_SOLUTIONS; ++idx)
+            solutions.push_back(makeRoutes(original, rng));
+
+        using Ordering = std::optional<ProblemData::ClientOrdering>;
+        std::pair<char const *, Ordering> const orderings[]
+            = {{"original", std::nullopt},
+               {"hilbert", ProblemData::ClientOrdering::HILBERT},
+               {"morton", ProblemData::ClientOrdering::MORTON}};
+
+        for (auto const &[name, ordering] : orderings)
+        {
+            // Only one renumbered copy is alive at a time, to bound the
+            // memory held by the dense matrices.
+            auto const setupStart = std::chrono::steady_clock::now();
+            std::optional<ProblemData> renumbered;
+            if (ordering)
+                renumbered.emplace(original.renumbered(*ordering));
+            auto const setupEnd = std::chrono::steady_clock::now();
+
+            auto const &data = renumbered ? *renumbered : original;
+            auto neighbours = computeNeighbourhood(data, {});
+
+            auto const perArc = scan(data, neighbours);
+            auto const result = search(data, std::move(neighbours), solutions);
+
+            std::chrono::duration<double> const setup = setupEnd - setupStart;
+            std::printf("%8zu %9s %10.2f %10.2f %12.2f %14.0f\n",
+                        numClients,
+                        name,
+                        setup.count(),
+                        perArc,
+                        result.seconds,
+                        result.cost);
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Microbenchmark of Route::update(), which runs after every applied local
+// search move. For a range of route lengths, this repeatedly relocates a random
+// client within a single route, and measures the average time and number of
+// heap allocations per update.
+
+#include "Benchmark.h"
+
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "XorShift128.h"
+#include "search/Node.h"
+#include "search/Route.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+ProblemData makeData(size_t numClients, XorShift128 &rng)
+{
+    std::vector<ProblemData::Client> clients;
+    clients.emplace_back(0, 0);  // depot
+
+    for (size_t idx = 1; idx <= numClients; ++idx)
+    {
+        Order const order = rng.randint(numClients / 4 + 1);
+        Store const store = rng.randint(numClients / 8 + 1);
+        clients.emplace_back(rng.randint(1000),
+                             rng.randint(1000),
+                             1 + rng.randint(10),  // weight
+                             1 + rng.randint(10),  // volume
+                             0,                    // salvage
+                             order,
+                             store,
+                             10,                   // service duration
+                             0,                    // tw early
+                             1'000'000);           // tw late
+    }
+
+    Matrix<Distance> dist(numClients + 1);
+    Matrix<Duration> dur(numClients + 1);
+
+    for (size_t row = 0; row <= numClients; ++row)
+        for (size_t col = 0; col <= numClients; ++col)
+        {
+            auto const diffX = clients[row].x.get() - clients[col].x.get();
+            auto const diffY = clients[row].y.get() - clients[col].y.get();
+            dist(row, col) = std::abs(diffX) + std::abs(diffY);
+            dur(row, col) = dist(row, col).get();
+        }
+
+    return {clients, 1, 1000, 1000, 0, 1, 10, dist, dur};
+}
+
+// Returns the average time (in nanoseconds) and number of allocations of a
+// single route update, for a route of the given length.
+std::pair<double, double> benchmark(size_t length, size_t numUpdates)
+{
+    XorShift128 rng(42);
+    auto const data = makeData(length, rng);
+
+    std::vector<Node> clients(length + 1);
+    Node startDepot = {};
+    Node endDepot = {};
+
+    Route route(data);
+    route.idx = 0;
+    route.depot = &startDepot;
+
+    auto const setup = [&](Node &node, int client) {
+        auto const &clientData = data.client(client);
+        node.client = client;
+        node.route = &route;
+        node.tw = {client,
+                   client,
+                   clientData.serviceDuration,
+                   0,
+                   clientData.twEarly,
+                   clientData.twLate};
+        node.twBefore = node.tw;
+        node.twAfter = node.tw;
+    };
+
+    setup(startDepot, 0);
+    setup(endDepot, 0);
+    startDepot.next = &endDepot;
+    endDepot.prev = &startDepot;
+
+    for (size_t client = 1; client <= length; ++client)
+    {
+        setup(clients[client], client);
+        clients[client].route = nullptr;
+        clients[client].insertAfter(endDepot.prev);
+    }
+
+    route.update();
+
+    auto const relocate = [&](size_t count) {
+        for (size_t iter = 0; iter != count; ++iter)
+        {
+            auto *U = &clients[1 + rng.randint(length)];
+            auto *V = &clients[1 + rng.randint(length)];
+
+            if (U != V)
+                U->insertAfter(V);
+
+            route.update();
+        }
+    };
+
+    // The route's buffers grow during the first few updates, and are reused
+    // after that. We measure the latter, which is what the local search sees.
+    relocate(length);
+
+    auto const allocationsBefore = bench::numAllocations();
+    auto const start = std::chrono::steady_clock::now();
+
+    relocate(numUpdates);
+
+    auto const end = std::chrono::steady_clock::now();
+    auto const allocations = bench::numAllocations() - allocationsBefore;
+
+    std::chrono::duration<double, std::nano> const elapsed = end - start;
+    return {elapsed.count() / numUpdates,
+            static_cast<double>(allocations) / numUpdates};
+}
+}  // namespace
+
+int main()
+{
+    std::printf("%8s %14s %16s\n", "length", "ns / update", "allocs / update");
+
+    for (size_t length : {10, 25, 50, 100, 200, 400, 800, 1600})
+    {
+        auto const numUpdates = 2'000'000 / length;
+        auto const [nanos, allocs] = benchmark(length, numUpdates);
+        std::printf("%8zu %14.1f %16.3f\n", length, nanos, allocs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+// Benchmark of sharing an instance between worker processes. For a range of
+// instance sizes, this writes a random VRPLIB instance with Euclidean edge
+// weights, and starts a number of worker processes that each obtain the
+// problem data in one of two ways:
+//
+// - by reading the VRPLIB file, as every worker of a multi-process batch run
+//   does when it solves the instance by itself;
+// - by attaching to the instance, after the parent process has read it once
+//   and published it in shared memory.
+//
+// Each worker then touches every element of both matrices, as a solver would
+// over a run, and reports the time taken, and its resident and private memory.
+// Private memory is what each additional worker costs. The text reader is the
+// benchmark's own VRPLIB reader, which is considerably faster than pyvrp.read,
+// so the comparison of times is conservative. This benchmark uses fork() and
+// /proc/self/smaps_rollup, and so only runs on Linux.
+
+#include "Benchmark.h"
+#include "Vrplib.h"
+
+#include "InstanceFile.h"
+#include "ProblemData.h"
+#include "XorShift128.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr size_t NUM_WORKERS = 4;
+
+struct WorkerResult
+{
+    double ms;         // time to obtain the data and touch its matrices
+    double rssMB;      // resident memory of the worker afterwards
+    double privateMB;  // part of the resident memory not shared with others
+};
+
+// Writes a random instance with the given number of clients as a VRPLIB file
+// with EUC_2D edge weights, and with time windows, so that the reader also
+// fills the duration matrix.
+void writeVrplib(fs::path const &path, size_t numClients, XorShift128 &rng)
+{
+    auto const dim = numClients + 1;
+
+    std::ofstream out(path);
+    out << "NAME : random\n"
+        << "DIMENSION : " << dim << '\n'
+        << "EDGE_WEIGHT_TYPE : EUC_2D\n"
+        << "CAPACITY : " << numClients << '\n'
+        << "VEHICLES : " << numClients / 10 + 1 << '\n';
+
+    out << "NODE_COORD_SECTION\n";
+    for (size_t idx = 0; idx != dim; ++idx)
+        out << idx + 1 << ' ' << rng.randint(100'000) << ' '
+            << rng.randint(100'000) << '\n';
+
+    out << "DEMAND_SECTION\n";
+    for (size_t idx = 0; idx != dim; ++idx)
+        out << idx + 1 << ' ' << (idx == 0 ? 0 : 1) << '\n';
+
+    out << "TIME_WINDOW_SECTION\n";
+    for (size_t idx = 0; idx != dim; ++idx)
+        out << idx + 1 << " 0 1000000\n";
+
+    out << "EOF\n";
+}
+
+// Sums all elements of both matrices, so that all their pages are read.
+Value touch(ProblemData const &data)
+{
+    Value sum = 0;
+    auto const dim = data.numClients() + 1;
+
+    for (size_t from = 0; from != dim; ++from)
+        for (size_t to = 0; to != dim; ++to)
+            sum += data.dist(from, to).get() + data.duration(from, to).get();
+
+    return sum;
+}
+
+// Returns the resident and private memory of this process, in megabytes.
+std::pair<double, double> memoryUsage()
+{
+    std::ifstream in("/proc/self/smaps_rollup");
+
+    std::string line;
+    std::getline(in, line);  // skip the header, which describes the mappings
+
+    double rss = 0;
+    double priv = 0;
+
+    std::string key;
+    double kB;
+    std::string unit;
+    while (in >> key >> kB >> unit)
+    {
+        if (key == "Rss:")
+            rss += kB;
+        else if (key == "Private_Clean:" || key == "Private_Dirty:")
+            priv += kB;
+    }
+
+    return {rss / 1024, priv / 1024};
+}
+
+// Runs the given way of obtaining the data in a number of worker processes,
+// one after the other, and returns their average result.
+template <typename Obtain> WorkerResult runWorkers(Obtain &&obtain)
+{
+    WorkerResult total = {0, 0, 0};
+
+    for (size_t worker = 0; worker != NUM_WORKERS; ++worker)
+    {
+        int fds[2];
+        if (pipe(fds) == -1)
+            throw std::runtime_error("Could not create pipe.");
+
+        auto const pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+
+            auto const start = std::chrono::steady_clock::now();
+            auto const data = obtain();
+            bench::doNotOptimize(touch(data));
+            auto const end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double, std::milli> const elapsed
+                = end - start;
+            auto const [rss, priv] = memoryUsage();
+
+            WorkerResult const result = {elapsed.count(), rss, priv};
+            auto const written = write(fds[1], &result, sizeof(result));
+            _exit(written == sizeof(result) ? 0 : 1);
+        }
+
+        close(fds[1]);
+
+        WorkerResult result;
+        auto const numRead = read(fds[0], &result, sizeof(result));
+        close(fds[0]);
+        waitpid(pid, nullptr, 0);
+
+        if (numRead != sizeof(result))
+            throw std::runtime_error("Worker did not report a result.");
+
+        total.ms += result.ms;
+        total.rssMB += result.rssMB;
+        total.privateMB += result.privateMB;
+    }
+
+    return {total.ms / NUM_WORKERS,
+            total.rssMB / NUM_WORKERS,
+            total.privateMB / NUM_WORKERS};
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    fs::path const dir = argc > 1 ? fs::path(argv[1])
+                                  : fs::temp_directory_path();
+
+    std::printf("%8s %8s %12s %10s %10s %12s\n",
+                "clients",
+                "workers",
+                "source",
+                "time (ms)",
+                "RSS (MB)",
+                "private (MB)");
+
+    for (size_t const numClients : {1'000, 2'000, 5'000})
+    {
+        XorShift128 rng(42);
+
+        auto const path = dir / "pyvrp_shared_instance.vrp";
+        writeVrplib(path, numClients, rng);
+
+        auto const parsed = runWorkers(
+            [&] { return bench::readVrplib(path.string()); });
+
+        // The parent reads the instance once, and publishes it. Its own copy
+        // of the data is not needed after that.
+        auto const name = "pyvrp-bench-" + std::to_string(getpid());
+        auto const segment
+            = publishInstance(bench::readVrplib(path.string()), name);
+
+        auto const attached = runWorkers([&] { return attachInstance(name); });
+
+        for (auto const &[source, result] :
+             {std::pair{"read", parsed}, {"attached", attached}})
+            std::printf("%8zu %8zu %12s %10.1f %10.1f %12.1f\n",
+                        numClients,
+                        NUM_WORKERS,
+                        source,
+                        result.ms,
+                        result.rssMB,
+                        result.privateMB);
+
+        std::fflush(stdout);
+        fs::remove(path);
+    }
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+// Memory benchmark of the SWAP* operator's caches. For a range of instance
+// sizes, this runs SWAP* intensification on a solution with routes formed by a
+// sweep around the depot, and reports the heap memory held by the operator
+// afterwards. This is compared to the memory the previous dense cache layout
+// needed, which stored an entry for every combination of vehicle and client.
+// Intensification runs both with the default overlap tolerance of zero, and
+// with a tolerance of 360 degrees, where all pairs of routes are evaluated.
+
+#include "Benchmark.h"
+
+#include "CostEvaluator.h"
+#include "Matrix.h"
+#include "ProblemData.h"
+#include "Solution.h"
+#include "XorShift128.h"
+#include "search/LocalSearch.h"
+#include "search/SwapStar.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+// Mirrors an entry of the previous dense layout, which stored the three best
+// insertion points, and the removal cost, of each client in each route.
+struct DenseInsertionPoints
+{
+    bool shouldUpdate;
+    std::array<Cost, 3> costs;
+    std::array<void *, 3> locs;
+};
+
+ProblemData makeData(size_t numClients, size_t numVehicles, XorShift128 &rng)
+{
+    std::vector<ProblemData::Client> clients;
+    clients.emplace_back(500, 500);  // depot, in the centre
+
+    for (size_t idx = 1; idx <= numClients; ++idx)
+        clients.emplace_back(rng.randint(1000),
+                             rng.randint(1000),
+                             1 + rng.randint(10),  // weight
+                             1 + rng.randint(10),  // volume
+                             0,                    // salvage
+                             -1,                   // no order
+                             -1,                   // no store
+                             10,                   // service duration
+                             0,                    // tw early
+                             1'000'000);           // tw late
+
+    Matrix<Distance> dist(numClients + 1);
+    Matrix<Duration> dur(numClients + 1);
+
+    for (size_t row = 0; row <= numClients; ++row)
+        for (size_t col = 0; col <= numClients; ++col)
+        {
+            auto const diffX = clients[row].x.get() - clients[col].x.get();
+            auto const diffY = clients[row].y.get() - clients[col].y.get();
+            dist(row, col) = std::abs(diffX) + std::abs(diffY);
+            dur(row, col) = dist(row, col).get();
+        }
+
+    // Some slack over the average route load, so most routes can be feasible.
+    Load const capacity = 7 * numClients / numVehicles;
+    Order const orderLimit = numClients;
+    Store const storeLimit = numClients;
+
+    return {clients,
+            numVehicles,
+            capacity,
+            capacity,
+            0,
+            orderLimit,
+            storeLimit,
+            dist,
+            dur};
+}
+
+// Forms routes by sweeping around the depot, like a reasonable solution would.
+Solution makeSolution(ProblemData const &data)
+{
+    auto const &depot = data.depot();
+    auto const angle = [&](int client) {
+        auto const &clientData = data.client(client);
+        auto const diffX = clientData.x.get() - depot.x.get();
+        auto const diffY = clientData.y.get() - depot.y.get();
+        return std::atan2(static_cast<double>(diffY),
+                          static_cast<double>(diffX));
+    };
+
+    std::vector<int> clients(data.numClients());
+    for (size_t idx = 0; idx != clients.size(); ++idx)
+        clients[idx] = static_cast<int>(idx + 1);
+
+    std::sort(clients.begin(), clients.end(), [&](int first, int second) {
+        return angle(first) < angle(second);
+    });
+
+    auto const perRoute = data.numClients() / data.numVehicles();
+    std::vector<std::vector<int>> routes(data.numVehicles());
+
+    for (size_t idx = 0; idx != clients.size(); ++idx)
+        routes[std::min(idx / perRoute, routes.size() - 1)].push_back(
+            clients[idx]);
+
+    return {data, routes};
+}
+
+// Each client's only neighbour is the next client. That suffices, since only
+// the route operator is used.
+std::vector<std::vector<int>> makeNeighbours(ProblemData const &data)
+{
+    std::vector<std::vector<int>> neighbours(data.numClients() + 1);
+
+    for (size_t client = 1; client <= data.numClients(); ++client)
+        neighbours[client].push_back(client % data.numClients() + 1);
+
+    return neighbours;
+}
+
+// Returns the number of bytes held by a new SWAP* operator, and by that
+// operator after intensifying the given solution.
+std::pair<size_t, size_t> benchmark(ProblemData const &data,
+                                    Solution const &solution,
+                                    int overlapToleranceDegrees)
+{
+    CostEvaluator const costEvaluator(20, 20, 20, 20, 20, 20, 6);
+    LocalSearch ls(data, makeNeighbours(data));
+
+    auto const before = bench::numLiveBytes();
+
+    SwapStar swapStar(data);
+    ls.addRouteOperator(swapStar);
+
+    auto const afterConstruction = bench::numLiveBytes() - before;
+
+    {
+        auto const improved
+            = ls.intensify(solution, costEvaluator, overlapToleranceDegrees);
+        bench::doNotOptimize(improved.distance());
+    }
+
+    return {afterConstruction, bench::numLiveBytes() - before};
+}
+}  // namespace
+
+int main()
+{
+    std::printf("%8s %8s %12s %12s %12s %12s\n",
+                "clients",
+                "vehicles",
+                "dense (kB)",
+                "new (kB)",
+                "tol 0 (kB)",
+                "tol 360 (kB)");
+
+    for (auto const &[numClients, numVehicles] :
+         {std::pair<size_t, size_t>{250, 25},
+          {1000, 50},
+          {2000, 100},
+          {4000, 200}})
+    {
+        XorShift128 rng(42);
+        auto const data = makeData(numClients, numVehicles, rng);
+        auto const solution = makeSolution(data);
+
+        auto const dense = numVehicles * (numClients + 1)
+                           * (sizeof(DenseInsertionPoints) + sizeof(Cost));
+        auto const [created, overlapping] = benchmark(data, solution, 0);
+        auto const all = benchmark(data, solution, 360).second;
+
+        std::printf("%8zu %8zu %12.1f %12.1f %12.1f %12.1f\n",
+                    numClients,
+                    numVehicles,
+                    dense / 1024.0,
+                    created / 1024.0,
+                    overlapping / 1024.0,
+                    all / 1024.0);
+    }
+
+    return 0;
+}
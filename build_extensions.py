@@ -31,6 +31,22 @@ def parse_args():
         choices=["integer", "double"],
         help="Double is more precise, integer faster. Defaults to 'integer'.",
     )
+    parser.add_argument(
+        "--trace",
+        default="none",
+        choices=["none", "info", "debug"],
+        help="Trace level to compile. Defaults to 'none' (no tracing).",
+    )
+    parser.add_argument(
+        "--benchmarks",
+        action="store_true",
+        help="Whether to also build the C++ microbenchmarks. Default False.",
+    )
+    parser.add_argument(
+        "--operator_timing",
+        action="store_true",
+        help="Whether to time local search operators. Default False.",
+    )
     parser.add_argument(
         "--clean",
         action="store_true",
@@ -86,6 +102,9 @@ def build(
     build_type: str,
     problem: str,
     precision: str,
+    trace: str,
+    benchmarks: bool,
+    operator_timing: bool,
     additional: List[str],
 ):
     cwd = pathlib.Path.cwd()
@@ -96,6 +115,9 @@ def build(
         f"-Dproblem={problem}",
         f"-Dstrip={'true' if build_type == 'release' else 'false'}",
         f"-Dprecision={precision}",
+        f"-Dtrace={trace}",
+        f"-Dbenchmarks={'true' if benchmarks else 'false'}",
+        f"-Doperator_timing={'true' if operator_timing else 'false'}",
         *additional,
         # fmt: on
     ]
@@ -122,6 +144,9 @@ def main():
         args.build_type,
         args.problem,
         args.precision,
+        args.trace,
+        args.benchmarks,
+        args.operator_timing,
         args.additional,
     )
 
@@ -1,6 +1,6 @@
 import time
 from dataclasses import dataclass
-from typing import Callable, Collection, Tuple
+from typing import Callable, Collection, List, Tuple
 
 from pyvrp.search.LocalSearch import LocalSearch
 from pyvrp.stop import StoppingCriterion
@@ -22,11 +22,22 @@ CrossoverOperator = Callable[
 
 @dataclass
 class GeneticAlgorithmParams:
+    """
+    Parameters for the genetic algorithm.
+
+    When ``batch_size`` is larger than one, each iteration generates that many
+    offspring, and improves them in parallel using ``num_threads`` threads
+    (zero means one thread per hardware thread). An iteration then counts as
+    a single iteration for the stopping criterion and restarts.
+    """
+
     repair_probability: float = 0.80
     collect_statistics: bool = False
     intensify_probability: float = 0.15
     intensify_on_best: bool = True
     nb_iter_no_improvement: int = 20_000
+    batch_size: int = 1
+    num_threads: int = 0
 
     def __post_init__(self):
         if not 0 <= self.repair_probability <= 1:
@@ -38,6 +49,12 @@ class GeneticAlgorithmParams:
         if self.nb_iter_no_improvement < 0:
             raise ValueError("nb_iter_no_improvement < 0 not understood.")
 
+        if self.batch_size < 1:
+            raise ValueError("batch_size < 1 not understood.")
+
+        if self.num_threads < 0:
+            raise ValueError("num_threads < 0 not understood.")
+
 
 class GeneticAlgorithm:
     """
@@ -119,6 +136,8 @@ class GeneticAlgorithm:
         iters = 0
         iters_no_improvement = 1
 
+        self._ls.reset_statistics()
+
         for sol in self._initial_solutions:
             self._pop.add(sol, self._cost_evaluator)
 
@@ -134,16 +153,15 @@ class GeneticAlgorithm:
 
             curr_best = self._cost_evaluator.cost(self._best)
 
-            print("BEFORE SELECT")
-            parents = self._pop.select(self._rng, self._cost_evaluator)
-            print("BEFORE CROSSOVER")
-            offspring = self._op(
-                parents, self._data, self._cost_evaluator, self._rng
-            )
-            print("BEFORE LOCALSEARCH")
-            self._search(offspring)
+            if self._params.batch_size > 1:
+                self._search_batch(self._generate(self._params.batch_size))
+            else:
+                parents = self._pop.select(self._rng, self._cost_evaluator)
+                offspring = self._op(
+                    parents, self._data, self._cost_evaluator, self._rng
+                )
+                self._search(offspring)
 
-            print("BEFORE COSTEVALUATOR") 
             new_best = self._cost_evaluator.cost(self._best)
 
             if new_best < curr_best:
@@ -151,69 +169,114 @@ class GeneticAlgorithm:
             else:
                 iters_no_improvement += 1
 
-            print("BEFORE COLLECT")
             if self._params.collect_statistics:
                 stats.collect_from(self._pop, self._cost_evaluator)
 
+        if self._params.collect_statistics:
+            stats.collect_operator_statistics(self._ls.statistics())
+
         end = time.perf_counter() - start
         return Result(self._best, stats, iters, end, self._data)
 
-    def _search(self, sol: Solution):
-        def is_new_best(sol):
-            cost = self._cost_evaluator.cost(sol)
-            best_cost = self._cost_evaluator.cost(self._best)
-            return cost < best_cost
+    def _generate(self, num_offspring: int) -> List[Solution]:
+        offspring = []
 
-        def add_and_register(sol):
-            self._pop.add(sol, self._cost_evaluator)
-            self._pm.register_weight_feasible(not sol.has_excess_weight())
-            self._pm.register_volume_feasible(not sol.has_excess_volume())
-            self._pm.register_volume_feasible(not sol.has_excess_salvage())
-            self._pm.register_time_feasible(not sol.has_time_warp())
+        for _ in range(num_offspring):
+            parents = self._pop.select(self._rng, self._cost_evaluator)
+            offspring.append(
+                self._op(parents, self._data, self._cost_evaluator, self._rng)
+            )
 
-        intensify_prob = self._params.intensify_probability
-        should_intensify = self._rng.rand() < intensify_prob
+        return offspring
+
+    def _is_new_best(self, sol: Solution) -> bool:
+        cost = self._cost_evaluator.cost(sol)
+        best_cost = self._cost_evaluator.cost(self._best)
+        return cost < best_cost
+
+    def _add_and_register(self, sol: Solution):
+        self._pop.add(sol, self._cost_evaluator)
+        self._pm.register_weight_feasible(not sol.has_excess_weight())
+        self._pm.register_volume_feasible(not sol.has_excess_volume())
+        self._pm.register_salvage_feasible(not sol.has_excess_salvage())
+        self._pm.register_time_feasible(not sol.has_time_warp())
+
+    def _update_best(
+        self, sol: Solution, cost_evaluator: CostEvaluator
+    ) -> Solution:
+        if not self._is_new_best(sol):
+            return sol
+
+        self._best = sol
+
+        # Only intensify feasible, new best solutions. See also the repair
+        # step. TODO Refactor to on_best callback (see issue #111)
+        if self._params.intensify_on_best:
+            sol = self._ls.intensify(
+                sol, cost_evaluator, overlap_tolerance_degrees=360
+            )
 
-        sol = self._ls.run(sol, self._cost_evaluator, should_intensify)
+            if self._is_new_best(sol):
+                self._best = sol
 
-        if is_new_best(sol):
-            self._best = sol
+        return sol
 
-            # Only intensify feasible, new best solutions. See also the repair
-            # step below. TODO Refactor to on_best callback (see issue #111)
-            if self._params.intensify_on_best:
-                sol = self._ls.intensify(
-                    sol, self._cost_evaluator, overlap_tolerance_degrees=360
-                )
+    def _should_intensify(self) -> bool:
+        return self._rng.rand() < self._params.intensify_probability
 
-                if is_new_best(sol):
-                    self._best = sol
+    def _should_repair(self, sol: Solution) -> bool:
+        return (
+            not sol.is_feasible()
+            and self._rng.rand() < self._params.repair_probability
+        )
 
-        add_and_register(sol)
+    def _search(self, sol: Solution):
+        cost_evaluator = self._cost_evaluator
+        sol = self._ls.run(sol, cost_evaluator, self._should_intensify())
+        sol = self._update_best(sol, cost_evaluator)
+        self._add_and_register(sol)
 
         # Possibly repair if current solution is infeasible. In that case, we
         # penalise infeasibility more using a penalty booster.
-        if (
-            not sol.is_feasible()
-            and self._rng.rand() < self._params.repair_probability
-        ):
-            should_intensify = self._rng.rand() < intensify_prob
-            sol = self._ls.run(
-                sol, self._pm.get_booster_cost_evaluator(), should_intensify
-            )
+        if self._should_repair(sol):
+            booster = self._pm.get_booster_cost_evaluator()
+            sol = self._ls.run(sol, booster, self._should_intensify())
+            sol = self._update_best(sol, booster)
 
-            if is_new_best(sol):
-                self._best = sol
+            if sol.is_feasible():
+                self._add_and_register(sol)
+
+    def _search_batch(self, offspring: List[Solution]):
+        # Same as _search(), but improves all offspring in one parallel local
+        # search call, and then repairs the infeasible ones in another. All
+        # offspring are searched using the penalties from before the batch.
+        cost_evaluator = self._cost_evaluator
+        num_threads = self._params.num_threads
+
+        intensify = [self._should_intensify() for _ in offspring]
+        improved = self._ls.run_batch(
+            offspring, cost_evaluator, intensify, num_threads
+        )
+
+        to_repair = []
+        for sol in improved:
+            sol = self._update_best(sol, cost_evaluator)
+            self._add_and_register(sol)
+
+            if self._should_repair(sol):
+                to_repair.append(sol)
+
+        if not to_repair:
+            return
 
-                if self._params.intensify_on_best:
-                    sol = self._ls.intensify(
-                        sol,
-                        self._pm.get_booster_cost_evaluator(),
-                        overlap_tolerance_degrees=360,
-                    )
+        booster = self._pm.get_booster_cost_evaluator()
+        intensify = [self._should_intensify() for _ in to_repair]
+        repaired = self._ls.run_batch(
+            to_repair, booster, intensify, num_threads
+        )
 
-                    if is_new_best(sol):
-                        self._best = sol
+        for sol in repaired:
+            sol = self._update_best(sol, booster)
 
             if sol.is_feasible():
-                add_and_register(sol)
+                self._add_and_register(sol)
@@ -0,0 +1,152 @@
+from dataclasses import asdict, dataclass
+from typing import Collection
+
+from pyvrp.search.LocalSearch import LocalSearch
+from pyvrp.stop import StoppingCriterion
+
+from .GeneticAlgorithm import GeneticAlgorithmParams
+from .PenaltyManager import PenaltyParams
+from .Result import Result
+from .Statistics import Statistics
+from ._GeneticAlgorithm import GeneticAlgorithmParams as _GAParams
+from ._GeneticAlgorithm import IslandModel as _IslandModel
+from ._GeneticAlgorithm import IslandModelParams as _IslandModelParams
+from ._GeneticAlgorithm import PenaltyParams as _PenaltyParams
+from ._ProblemData import ProblemData
+from ._Solution import Solution
+from ._SubPopulation import PopulationParams
+from ._XorShift128 import XorShift128
+
+
+@dataclass
+class IslandModelParams:
+    """
+    Parameters for the island model.
+
+    Each of the ``num_islands`` islands runs on its own thread. Every
+    ``migration_interval`` iterations, each island sends its best solution to
+    the next island, if that solution improved since the previous migration.
+    """
+
+    num_islands: int = 4
+    migration_interval: int = 500
+
+    def __post_init__(self):
+        if self.num_islands < 1:
+            raise ValueError("num_islands < 1 not understood.")
+
+        if self.migration_interval < 1:
+            raise ValueError("migration_interval < 1 not understood.")
+
+
+class IslandGeneticAlgorithm:
+    """
+    Creates an IslandGeneticAlgorithm instance. This runs several independent
+    copies of the :class:`~pyvrp.NativeGeneticAlgorithm.NativeGeneticAlgorithm`
+    in parallel, one per thread. Each of these islands has its own population,
+    penalties, random number stream, and a copy of the given local search. The
+    islands are arranged in a ring, and periodically pass their best solution
+    on to the next island. This helps on long runs, where a single population
+    tends to stagnate.
+
+    Parameters
+    ----------
+    data
+        Data object describing the problem to be solved.
+    rng
+        Random number generator. This is used to seed the random number
+        generators of the islands.
+    local_search
+        Local search instance to use. Each island uses its own copy, so
+        operators should be added to the local search before it is passed in.
+    initial_solutions
+        Initial solutions to use to initialise the population of each island.
+    params
+        Genetic algorithm parameters, used by each island. If not provided, a
+        default will be used.
+    island_params
+        Island model parameters. If not provided, a default will be used.
+    penalty_params
+        Penalty manager parameters. If not provided, a default will be used.
+    population_params
+        Population parameters. If not provided, a default will be used.
+
+    Raises
+    ------
+    ValueError
+        When the population is empty.
+    """
+
+    def __init__(
+        self,
+        data: ProblemData,
+        rng: XorShift128,
+        local_search: LocalSearch,
+        initial_solutions: Collection[Solution],
+        params: GeneticAlgorithmParams = GeneticAlgorithmParams(),
+        island_params: IslandModelParams = IslandModelParams(),
+        penalty_params: PenaltyParams = PenaltyParams(),
+        population_params: PopulationParams = PopulationParams(),
+    ):
+        self._data = data
+        self._ls = local_search
+        self._params = params
+
+        self._model = _IslandModel(
+            data,
+            _PenaltyParams(**asdict(penalty_params)),
+            population_params,
+            rng,
+            local_search._ls,
+            list(initial_solutions),
+            _GAParams(**asdict(params)),
+            _IslandModelParams(**asdict(island_params)),
+        )
+
+    @property
+    def num_islands(self) -> int:
+        """
+        Returns the number of islands.
+        """
+        return self._model.num_islands()
+
+    def run(
+        self, stop: StoppingCriterion, callback_interval: int = 1
+    ) -> Result:
+        """
+        Runs the islands with the provided stopping criterion.
+
+        .. note::
+
+           The stopping criterion is called by the first island only, once
+           every ``callback_interval`` iterations of that island, and is passed
+           the cost of the best solution over all islands. Criteria that count
+           iterations, like :class:`~pyvrp.stop.MaxIterations.MaxIterations`,
+           thus count blocks of ``callback_interval`` iterations of the first
+           island. The other islands stop when the first island stops.
+
+        Parameters
+        ----------
+        stop
+            Stopping criterion to use. The algorithm runs until the first time
+            the stopping criterion returns ``True``.
+        callback_interval
+            Number of iterations between calls to the stopping criterion.
+            Default 1.
+
+        Returns
+        -------
+        Result
+            A Result object, containing the best found solution. The number of
+            iterations is summed over all islands. Only operator statistics are
+            collected.
+        """
+        res = self._model.run(stop, callback_interval)
+        stats = Statistics()
+
+        if self._params.collect_statistics:
+            stats.collect_operator_statistics(self._ls.statistics())
+
+        return Result(
+            res.best, stats, res.num_iterations, res.runtime, self._data
+        )
@@ -265,12 +265,12 @@ class Model:
             NODE_OPERATORS,
             ROUTE_OPERATORS,
             LocalSearch,
-            compute_neighbours,
+            compute_neighbourhood,
         )
 
         data = self.data()
         rng = XorShift128(seed=seed)
-        ls = LocalSearch(data, rng, compute_neighbours(data))
+        ls = LocalSearch(data, rng, compute_neighbourhood(data))
 
         for op in NODE_OPERATORS:
             ls.add_node_operator(op(data))
@@ -0,0 +1,143 @@
+from dataclasses import asdict
+from typing import Callable, Collection, Optional
+
+from pyvrp.search.LocalSearch import LocalSearch
+from pyvrp.stop import StoppingCriterion
+
+from .GeneticAlgorithm import GeneticAlgorithmParams
+from .PenaltyManager import PenaltyParams
+from .Result import Result
+from .Statistics import Statistics, _Datum
+from ._CostEvaluator import CostEvaluator
+from ._GeneticAlgorithm import GeneticAlgorithm as _GeneticAlgorithm
+from ._GeneticAlgorithm import GeneticAlgorithmParams as _GAParams
+from ._GeneticAlgorithm import PenaltyParams as _PenaltyParams
+from ._GeneticAlgorithm import Progress
+from ._ProblemData import ProblemData
+from ._Solution import Solution
+from ._SubPopulation import PopulationParams
+from ._XorShift128 import XorShift128
+
+
+class NativeGeneticAlgorithm:
+    """
+    Creates a NativeGeneticAlgorithm instance. This runs the same algorithm as
+    :class:`~pyvrp.GeneticAlgorithm.GeneticAlgorithm`, but the entire search
+    loop runs natively. That avoids the overhead of calling into native code
+    several times per iteration, which is significant on small and medium
+    instances. The native algorithm always uses selective route exchange
+    crossover, and the broken pairs distance diversity measure. It manages its
+    own population and penalties.
+
+    Parameters
+    ----------
+    data
+        Data object describing the problem to be solved.
+    rng
+        Random number generator.
+    local_search
+        Local search instance to use.
+    initial_solutions
+        Initial solutions to use to initialise the population.
+    params
+        Genetic algorithm parameters. If not provided, a default will be used.
+    penalty_params
+        Penalty manager parameters. If not provided, a default will be used.
+    population_params
+        Population parameters. If not provided, a default will be used.
+
+    Raises
+    ------
+    ValueError
+        When the population is empty.
+    """
+
+    def __init__(
+        self,
+        data: ProblemData,
+        rng: XorShift128,
+        local_search: LocalSearch,
+        initial_solutions: Collection[Solution],
+        params: GeneticAlgorithmParams = GeneticAlgorithmParams(),
+        penalty_params: PenaltyParams = PenaltyParams(),
+        population_params: PopulationParams = PopulationParams(),
+    ):
+        self._data = data
+        self._ls = local_search
+        self._params = params
+
+        self._algo = _GeneticAlgorithm(
+            data,
+            _PenaltyParams(**asdict(penalty_params)),
+            population_params,
+            rng,
+            local_search._ls,
+            list(initial_solutions),
+            _GAParams(**asdict(params)),
+        )
+
+    @property
+    def cost_evaluator(self) -> CostEvaluator:
+        """
+        Returns a cost evaluator for the current penalty values.
+        """
+        return self._algo.cost_evaluator()
+
+    def run(
+        self,
+        stop: StoppingCriterion,
+        callback: Optional[Callable[[Progress], None]] = None,
+        callback_interval: int = 1,
+    ) -> Result:
+        """
+        Runs the genetic algorithm with the provided stopping criterion.
+
+        .. note::
+
+           The stopping criterion and callback are called only once every
+           ``callback_interval`` iterations. Criteria that count iterations,
+           like :class:`~pyvrp.stop.MaxIterations.MaxIterations`, thus count
+           blocks of ``callback_interval`` iterations. Increase the interval
+           to reduce overhead with time-based criteria.
+
+        Parameters
+        ----------
+        stop
+            Stopping criterion to use. The algorithm runs until the first time
+            the stopping criterion returns ``True``.
+        callback
+            Optional progress callback. This is passed a progress object with
+            the number of iterations, runtime (in seconds), best cost, and
+            number of feasible and infeasible solutions in the population.
+        callback_interval
+            Number of iterations between calls to the stopping criterion and
+            progress callback. Default 1.
+
+        Returns
+        -------
+        Result
+            A Result object, containing statistics and the best found solution.
+        """
+        res = self._algo.run(stop, callback, callback_interval)
+        stats = Statistics()
+
+        if self._params.collect_statistics:
+            stats.runtimes = list(res.runtimes)
+            stats.num_iterations = len(res.runtimes)
+
+            def to_datum(datum) -> _Datum:
+                return _Datum(
+                    size=datum.size,
+                    avg_diversity=datum.avg_diversity,
+                    best_cost=datum.best_cost,
+                    avg_cost=datum.avg_cost,
+                    avg_num_routes=datum.avg_num_routes,
+                )
+
+            stats.feas_stats = [to_datum(d) for d in res.feas_stats]
+            stats.infeas_stats = [to_datum(d) for d in res.infeas_stats]
+            stats.collect_operator_statistics(self._ls.statistics())
+
+        return Result(
+            res.best, stats, res.num_iterations, res.runtime, self._data
+        )
@@ -23,6 +23,19 @@ class PenaltyParams:
     init_salvage_penalty
         Initial penalty on nonterminal salvage pickups. This is a function of 
         number of salvage pickups that occur before the last delivery stop.
+    init_stores_penalty
+        Initial penalty on excess stores. This is the amount by which each
+        store a route visits beyond the route store limit is penalised in the
+        objective, at the start of the search.
+    init_orders_penalty
+        Initial penalty on order splits. This is the amount by which each route
+        an order spans beyond the order route limit is penalised in the
+        objective, at the start of the search.
+    init_sequence_penalty
+        Initial penalty on sequence violations. This is the amount by which
+        each pair of clients that is visited out of the delivery, both,
+        salvage sequence is penalised in the objective. The default is large,
+        so that the search strongly prefers feasible sequences.
     init_time_warp_penalty
         Initial penalty on time warp. This is the amount by which one unit of
         time warp (time window violations) is penalised in the objective, at
@@ -67,6 +80,12 @@ class PenaltyParams:
         Initial penalty on excess volume capacity.
     init_salvage_penalty
 	Initial penalty on nonterminal salvage pickups.
+    init_stores_penalty
+        Initial penalty on excess stores.
+    init_orders_penalty
+        Initial penalty on order splits.
+    init_sequence_penalty
+        Initial penalty on sequence violations.
     init_time_warp_penalty
         Initial penalty on time warp.
     repair_booster
@@ -92,6 +111,9 @@ class PenaltyParams:
     init_weight_capacity_penalty: int = 20
     init_volume_capacity_penalty: int = 20
     init_salvage_penalty: int = 20
+    init_stores_penalty: int = 20
+    init_orders_penalty: int = 20
+    init_sequence_penalty: int = 1000
     init_time_warp_penalty: int = 6
     repair_booster: int = 12
     num_registrations_between_penalty_updates: int = 50
@@ -140,33 +162,34 @@ class PenaltyManager:
         self._weight_capacity_penalty = params.init_weight_capacity_penalty
         self._volume_capacity_penalty = params.init_volume_capacity_penalty
         self._salvage_penalty = params.init_salvage_penalty
+        self._stores_penalty = params.init_stores_penalty
+        self._orders_penalty = params.init_orders_penalty
+        self._sequence_penalty = params.init_sequence_penalty
         self._tw_penalty = params.init_time_warp_penalty
-        self._cost_evaluator = CostEvaluator(
-            self._weight_capacity_penalty, 
-            self._volume_capacity_penalty,
-            self._salvage_penalty,
-            self._tw_penalty
-        )
-        self._booster_cost_evaluator = CostEvaluator(
-            self._weight_capacity_penalty * self._params.repair_booster,
-            self._volume_capacity_penalty * self._params.repair_booster,
-            self._salvage_penalty * self._params.repair_booster,
-            self._tw_penalty * self._params.repair_booster,
-        )
+        self._update_cost_evaluators()
 
     def _update_cost_evaluators(self):
-        # Updates the cost evaluators given new penalty values
+        # Updates the cost evaluators given new penalty values. The penalties
+        # are passed by keyword since the evaluator takes several of them.
         self._cost_evaluator = CostEvaluator(
-            self._weight_capacity_penalty, 
-            self._volume_capacity_penalty,
-            self._salvage_penalty,
-            self._tw_penalty
+            weight_capacity_penalty=self._weight_capacity_penalty,
+            volume_capacity_penalty=self._volume_capacity_penalty,
+            salvage_penalty=self._salvage_penalty,
+            stores_penalty=self._stores_penalty,
+            orders_penalty=self._orders_penalty,
+            sequence_penalty=self._sequence_penalty,
+            tw_penalty=self._tw_penalty,
         )
+
+        booster = self._params.repair_booster
         self._booster_cost_evaluator = CostEvaluator(
-            self._weight_capacity_penalty * self._params.repair_booster,
-            self._volume_capacity_penalty * self._params.repair_booster,
-            self._salvage_penalty * self._params.repair_booster,
-            self._tw_penalty * self._params.repair_booster,
+            weight_capacity_penalty=self._weight_capacity_penalty * booster,
+            volume_capacity_penalty=self._volume_capacity_penalty * booster,
+            salvage_penalty=self._salvage_penalty * booster,
+            stores_penalty=self._stores_penalty * booster,
+            orders_penalty=self._orders_penalty * booster,
+            sequence_penalty=self._sequence_penalty * booster,
+            tw_penalty=self._tw_penalty * booster,
         )
 
     def _compute(self, penalty: int, feas_percentage: float) -> int:
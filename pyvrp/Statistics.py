@@ -4,10 +4,11 @@ from math import nan
 from pathlib import Path
 from statistics import fmean
 from time import perf_counter
-from typing import List, Union
+from typing import Dict, List, Union
 
 from .Population import Population, SubPopulation
 from ._CostEvaluator import CostEvaluator
+from .search.LocalSearch import OperatorStatistics
 
 _FEAS_CSV_PREFIX = "feas_"
 _INFEAS_CSV_PREFIX = "infeas_"
@@ -38,6 +39,9 @@ class Statistics:
     num_iterations: int = 0
     feas_stats: List[_Datum] = field(default_factory=list)
     infeas_stats: List[_Datum] = field(default_factory=list)
+    operator_stats: Dict[str, OperatorStatistics] = field(
+        default_factory=dict
+    )
 
     def __post_init__(self):
         self._clock = perf_counter()
@@ -72,6 +76,22 @@ class Statistics:
         infeas_datum = self._collect_from_subpop(infeas_subpop, cost_evaluator)
         self.infeas_stats.append(infeas_datum)
 
+    def collect_operator_statistics(
+        self, operator_stats: Dict[str, OperatorStatistics]
+    ):
+        """
+        Adds the given local search operator statistics to those collected so
+        far. See :meth:`~pyvrp.search.LocalSearch.LocalSearch.statistics`.
+
+        Parameters
+        ----------
+        operator_stats
+            Statistics for each operator, keyed by operator name.
+        """
+        for name, op_stats in operator_stats.items():
+            self.operator_stats.setdefault(name, OperatorStatistics())
+            self.operator_stats[name] += op_stats
+
     def _collect_from_subpop(
         self, subpop: SubPopulation, cost_evaluator: CostEvaluator
     ) -> _Datum:
@@ -21,6 +21,11 @@ class CostEvaluator:
         The penalty for each excess salvage store in route.
     tw_penalty
         The penalty for each unit of time warp.
+    orders_penalty
+        The penalty for each route an order spans beyond the order route limit.
+    sequence_penalty
+        The penalty for each pair of clients that is visited out of the
+        delivery, both, salvage sequence.
     """
 
     def __init__(
@@ -29,12 +34,18 @@ class CostEvaluator:
         volume_capacity_penalty: int = 0, 
         salvage_penalty: int = 0, 
         stores_penalty: int = 0, 
-        tw_penalty: int = 0
+        tw_penalty: int = 0, 
+        orders_penalty: int = 0, 
+        sequence_penalty: int = 0
     ) -> None: ...
     def weight_penalty(self, weight: int, weight_capacity: int) -> int: ...
     def volume_penalty(self, volume: int, volume_capacity: int) -> int: ...
     def salvage_penalty(self, salvage: int, salvage_capacity: int) -> int: ...
     def stores_penalty(self, stores: int, stores_limit: int) -> int: ...
+    def orders_penalty(
+        self, num_routes: int, order_route_limit: int
+    ) -> int: ...
+    def sequence_penalty(self, violations: int) -> int: ...
     def tw_penalty(self, time_warp: int) -> int: ...
     def penalised_cost(self, solution: Solution) -> int: ...
     def cost(self, solution: Solution) -> int:
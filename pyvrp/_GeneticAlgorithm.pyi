@@ -0,0 +1,130 @@
+from typing import Callable, List, Optional
+
+from pyvrp._CostEvaluator import CostEvaluator
+from pyvrp._ProblemData import ProblemData
+from pyvrp._Solution import Solution
+from pyvrp._SubPopulation import PopulationParams
+from pyvrp._XorShift128 import XorShift128
+from pyvrp.search._LocalSearch import LocalSearch
+
+class PenaltyParams:
+    def __init__(
+        self,
+        init_weight_capacity_penalty: int = 20,
+        init_volume_capacity_penalty: int = 20,
+        init_salvage_penalty: int = 20,
+        init_stores_penalty: int = 20,
+        init_orders_penalty: int = 20,
+        init_sequence_penalty: int = 1000,
+        init_time_warp_penalty: int = 6,
+        repair_booster: int = 12,
+        num_registrations_between_penalty_updates: int = 50,
+        penalty_increase: float = 1.34,
+        penalty_decrease: float = 0.32,
+        target_feasible: float = 0.43,
+    ) -> None: ...
+
+class GeneticAlgorithmParams:
+    def __init__(
+        self,
+        repair_probability: float = 0.8,
+        collect_statistics: bool = False,
+        intensify_probability: float = 0.15,
+        intensify_on_best: bool = True,
+        nb_iter_no_improvement: int = 20000,
+        batch_size: int = 1,
+        num_threads: int = 0,
+    ) -> None: ...
+
+class SubPopulationStatistics:
+    @property
+    def size(self) -> int: ...
+    @property
+    def avg_diversity(self) -> float: ...
+    @property
+    def best_cost(self) -> float: ...
+    @property
+    def avg_cost(self) -> float: ...
+    @property
+    def avg_num_routes(self) -> float: ...
+
+class Progress:
+    @property
+    def num_iterations(self) -> int: ...
+    @property
+    def runtime(self) -> float: ...
+    @property
+    def best_cost(self) -> float: ...
+    @property
+    def num_feasible(self) -> int: ...
+    @property
+    def num_infeasible(self) -> int: ...
+
+class Result:
+    @property
+    def best(self) -> Solution: ...
+    @property
+    def num_iterations(self) -> int: ...
+    @property
+    def runtime(self) -> float: ...
+    @property
+    def runtimes(self) -> List[float]: ...
+    @property
+    def feas_stats(self) -> List[SubPopulationStatistics]: ...
+    @property
+    def infeas_stats(self) -> List[SubPopulationStatistics]: ...
+
+class GeneticAlgorithm:
+    def __init__(
+        self,
+        data: ProblemData,
+        penalty_params: PenaltyParams,
+        population_params: PopulationParams,
+        rng: XorShift128,
+        local_search: LocalSearch,
+        initial_solutions: List[Solution],
+        params: GeneticAlgorithmParams = ...,
+    ) -> None: ...
+    def run(
+        self,
+        stop: Callable[[float], bool],
+        progress: Optional[Callable[[Progress], None]] = None,
+        callback_interval: int = 1,
+    ) -> Result: ...
+    def cost_evaluator(self) -> CostEvaluator: ...
+
+class IslandModelParams:
+    def __init__(
+        self,
+        num_islands: int = 4,
+        migration_interval: int = 500,
+    ) -> None: ...
+
+class IslandResult:
+    @property
+    def best(self) -> Solution: ...
+    @property
+    def num_iterations(self) -> int: ...
+    @property
+    def runtime(self) -> float: ...
+    @property
+    def island_iterations(self) -> List[int]: ...
+
+class IslandModel:
+    def __init__(
+        self,
+        data: ProblemData,
+        penalty_params: PenaltyParams,
+        population_params: PopulationParams,
+        rng: XorShift128,
+        local_search: LocalSearch,
+        initial_solutions: List[Solution],
+        params: GeneticAlgorithmParams = ...,
+        island_params: IslandModelParams = ...,
+    ) -> None: ...
+    def run(
+        self,
+        stop: Callable[[float], bool],
+        callback_interval: int = 1,
+    ) -> IslandResult: ...
+    def num_islands(self) -> int: ...
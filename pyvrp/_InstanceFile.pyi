@@ -0,0 +1,128 @@
+from pathlib import Path
+from typing import Union
+
+from pyvrp._ProblemData import ProblemData
+
+INSTANCE_FILE_VERSION: int
+
+def write_instance(data: ProblemData, where: Union[str, Path]) -> None:
+    """
+    Writes the given problem data to the given location, in PyVRP's versioned
+    binary instance format. The file stores the client table, the fleet,
+    capacity, order and store limits, and the distance and duration matrices.
+    Values are stored in the precision of this build, and in the byte order of
+    this machine.
+
+    Parameters
+    ----------
+    data
+        Problem data to write.
+    where
+        File location to write to. An existing file is overwritten.
+
+    Raises
+    ------
+    RuntimeError
+        When the file cannot be written.
+    """
+
+def load_instance(where: Union[str, Path]) -> ProblemData:
+    """
+    Loads an instance written by :func:`~write_instance`. The file is mapped
+    into memory, and the distance and duration matrices are not copied: they
+    are read straight from the mapped file, when they are first accessed. This
+    is much faster than parsing a text instance with :func:`~pyvrp.read.read`,
+    particularly for large instances. Since the pages of the mapped file are
+    shared, processes that load the same file also share its memory.
+
+    Parameters
+    ----------
+    where
+        File location to load.
+
+    Returns
+    -------
+    ProblemData
+        Data instance constructed from the loaded file.
+
+    Raises
+    ------
+    RuntimeError
+        When the file cannot be mapped, or is not a valid instance file of the
+        current version, precision, and byte order.
+    """
+
+class SharedMemory:
+    """
+    A named shared memory segment, as returned by :func:`~publish_instance`.
+    The segment is removed once this object is garbage collected. Processes
+    that attached to it before then can keep using their data.
+    """
+
+    @property
+    def name(self) -> str:
+        """
+        Name of the segment, to pass to :func:`~attach_instance`.
+        """
+    @property
+    def size(self) -> int:
+        """
+        Size of the segment, in bytes.
+        """
+
+def publish_instance(data: ProblemData, name: str) -> SharedMemory:
+    """
+    Publishes the given problem data in a new shared memory segment with the
+    given name, in the format of :func:`~write_instance`. Other processes on
+    the same machine can then attach to the instance with
+    :func:`~attach_instance`, without reading the instance themselves and
+    without their own copies of the distance and duration matrices.
+
+    Parameters
+    ----------
+    data
+        Problem data to publish.
+    name
+        Name of the new segment. This must be unique on the machine, so it is
+        best to include, for example, the process id.
+
+    Returns
+    -------
+    SharedMemory
+        The published segment. The segment is removed when this object is
+        garbage collected, so it must be kept alive until all processes have
+        attached.
+
+    Raises
+    ------
+    RuntimeError
+        When the segment cannot be created, for example because a segment with
+        the given name already exists.
+    """
+
+def attach_instance(name: str) -> ProblemData:
+    """
+    Attaches to the instance published under the given name by
+    :func:`~publish_instance`, possibly in another process. Like
+    :func:`~load_instance`, this does not copy the distance and duration
+    matrices: they are read straight from the shared memory, which all
+    attached processes share. Attached processes cannot change the published
+    instance.
+
+    Parameters
+    ----------
+    name
+        Name of the published segment.
+
+    Returns
+    -------
+    ProblemData
+        Data instance backed by the shared memory.
+
+    Raises
+    ------
+    RuntimeError
+        When there is no segment with the given name, or when it does not
+        contain a valid instance of the current version, precision, and byte
+        order.
+    """
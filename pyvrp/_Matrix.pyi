@@ -1,12 +1,24 @@
-from typing import List, Tuple, overload
+from typing import List, Tuple, Union, overload
+
+import numpy as np
 
 class Matrix:
+    """
+    Two-dimensional matrix of integers, stored in row-major order. Matrices
+    support the buffer protocol, so ``np.asarray(matrix)`` returns a view of
+    the matrix without copying it.
+
+    A matrix created from a C-contiguous, writeable NumPy array of ``int32``
+    does not copy the array: both share the same memory. Other data, such as
+    lists of lists, is first converted to such an array.
+    """
+
     @overload
     def __init__(self, dimension: int) -> None: ...
     @overload
     def __init__(self, n_rows: int, n_cols: int) -> None: ...
     @overload
-    def __init__(self, data: List[List[int]]) -> None: ...
+    def __init__(self, data: Union[List[List[int]], np.ndarray]) -> None: ...
     @property
     def num_cols(self) -> int: ...
     @property
@@ -1,4 +1,6 @@
-from typing import List, Tuple
+from typing import ClassVar, List, Tuple, Union, overload
+
+import numpy as np
 
 class Client:
     """
@@ -66,6 +68,133 @@ class Client:
         required: bool = True,
     ) -> None: ...
 
+class ClientClass:
+    """
+    Delivery/salvage class of a client, which determines where the client may
+    be visited in a route's delivery and salvage sequence.
+
+    Attributes
+    ----------
+    NONE
+        Neither a delivery nor a salvage pickup.
+    DELIVERY
+        A client with a nonzero weight or volume demand.
+    BOTH
+        A delivery that is also a salvage pickup.
+    SALVAGE
+        A client with a salvage demand of exactly one.
+    """
+
+    NONE: ClassVar[ClientClass]
+    DELIVERY: ClassVar[ClientClass]
+    BOTH: ClassVar[ClientClass]
+    SALVAGE: ClassVar[ClientClass]
+
+class MatrixStorage:
+    """
+    Layout in which :class:`ProblemData` stores its distance and duration
+    matrices. All layouts return the same values, but the compact ones need
+    less memory, and thus less memory bandwidth per lookup.
+
+    Attributes
+    ----------
+    DENSE
+        Both matrices are stored in full. This is the default.
+    SYMMETRIC
+        Only the lower triangles are stored. Requires symmetric matrices.
+    COMPACT_16
+        Both matrices are stored as 16-bit unsigned integers, multiplied by a
+        common factor. Only accepts non-negative whole numbers that fit in 16
+        bits after dividing by the greatest common divisor of all values.
+        Fractional values, as may occur in double precision builds, must be
+        rounded beforehand.
+    COMPACT_32
+        As ``COMPACT_16``, but with 32-bit unsigned integers.
+    INTERLEAVED
+        One matrix of (distance, duration) pairs is stored, so that the
+        distance and duration of an arc share a cache line.
+    ON_DEMAND
+        No matrices are stored: distances and durations are computed from the
+        client coordinates by a :class:`DistanceOracle`. Selected by passing
+        a ``distance_oracle`` to :class:`ProblemData`.
+    """
+
+    DENSE: ClassVar[MatrixStorage]
+    SYMMETRIC: ClassVar[MatrixStorage]
+    COMPACT_16: ClassVar[MatrixStorage]
+    COMPACT_32: ClassVar[MatrixStorage]
+    INTERLEAVED: ClassVar[MatrixStorage]
+    ON_DEMAND: ClassVar[MatrixStorage]
+
+class ClientOrdering:
+    """
+    Space-filling curve along which :meth:`ProblemData.renumbered` orders the
+    clients.
+
+    Attributes
+    ----------
+    HILBERT
+        The Hilbert curve, which best keeps nearby clients together.
+    MORTON
+        The Morton (Z-order) curve, which is cheaper to compute.
+    """
+
+    HILBERT: ClassVar[ClientOrdering]
+    MORTON: ClassVar[ClientOrdering]
+
+class DistanceOracle:
+    """
+    Computes distances and durations on demand from location coordinates,
+    instead of storing them in matrices. This allows solving instances whose
+    matrices do not fit in memory.
+
+    The distance between two locations is their Euclidean distance, divided
+    by ``divisor`` and then rounded with the given rounding function. These
+    are the same computations, with the same results, as :func:`~pyvrp.read`
+    performs on instances with Euclidean edge weights.
+
+    Parameters
+    ----------
+    x
+        Horizontal coordinates of the depot and clients.
+    y
+        Vertical coordinates of the depot and clients.
+    round_func
+        Name of the rounding function, one of ``'none'`` (default),
+        ``'round'``, ``'trunc'``, ``'trunc1'`` and ``'dimacs'``. See
+        :func:`~pyvrp.read`. Both ``'none'`` and ``'trunc'`` truncate.
+    divisor
+        Value by which Euclidean distances are divided before rounding.
+        Default 10.
+    durations
+        Whether durations are equal to distances. If not, all durations are
+        zero. Default True.
+    cache_rows
+        Number of rows each thread caches: each row holds the values computed
+        so far from one location, and the least recently used row is evicted
+        when needed. Default 0, which disables the cache. Caching only pays
+        off when computing a value is slower than a cache miss.
+    """
+
+    def __init__(
+        self,
+        x: List[float],
+        y: List[float],
+        round_func: str = "none",
+        divisor: float = 10,
+        durations: bool = True,
+        cache_rows: int = 0,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def distance(self, first: int, second: int) -> int:
+        """
+        Returns the distance from the first to the second location.
+        """
+    def duration(self, first: int, second: int) -> int:
+        """
+        Returns the duration from the first to the second location.
+        """
+
 class ProblemData:
     """
     Creates a problem data instance. This instance contains all information
@@ -87,11 +216,33 @@ class ProblemData:
         Homogenous route nonterminal pickup stops capacity for all routes in the problem instance.
     store_lim 
         Limit on the number of stores that can be associated with a route.
+    distance_matrix
+        A matrix that gives the distances between clients (and the depot at
+        index 0).
     duration_matrix
         A matrix that gives the travel times between clients (and the depot at
         index 0).
+    matrix_storage
+        Layout in which to store the distance and duration matrices. Default
+        :attr:`MatrixStorage.DENSE`. Raises :class:`ValueError` when the
+        matrices cannot be stored in the given layout.
+    distance_oracle
+        Instead of the matrices and their storage layout, a
+        :class:`DistanceOracle` over the depot and client locations may be
+        given. Distances and durations are then computed on demand, and the
+        matrix storage is :attr:`MatrixStorage.ON_DEMAND`.
+
+    .. note::
+
+       Matrices that are C-contiguous NumPy arrays with the element type used
+       by this build (``int32``, or ``float64`` in double precision builds)
+       are not copied: the problem data shares their memory. Such arrays must
+       not be modified afterwards. Other matrices are converted first. With
+       any storage layout other than ``DENSE``, the problem data stores its
+       own compact copies instead.
     """
 
+    @overload
     def __init__(
         self,
         clients: List[Client],
@@ -99,9 +250,32 @@ class ProblemData:
         vehicle_cap: int,
         salvage_cap: int,
         store_lim: int,
-        distance_matrix: List[List[int]],
-        duration_matrix: List[List[int]],
+        distance_matrix: Union[List[List[int]], np.ndarray],
+        duration_matrix: Union[List[List[int]], np.ndarray],
+        matrix_storage: MatrixStorage = MatrixStorage.DENSE,
+    ): ...
+    @overload
+    def __init__(
+        self,
+        clients: List[Client],
+        num_vehicles: int,
+        weight_cap: int,
+        volume_cap: int,
+        salvage_cap: int,
+        order_route_lim: int,
+        route_store_lim: int,
+        distance_oracle: DistanceOracle,
     ): ...
+    @property
+    def matrix_storage(self) -> MatrixStorage:
+        """
+        Layout in which the distance and duration matrices are stored.
+
+        Returns
+        -------
+        MatrixStorage
+            The matrix storage layout of this problem data instance.
+        """
     def client(self, client: int) -> Client:
         """
         Returns client data for the given client.
@@ -126,6 +300,52 @@ class ProblemData:
         Client
             A simple data object containing the depot's information.
         """
+    def client_class(self, client: int) -> ClientClass:
+        """
+        Returns the delivery/salvage class of the given client.
+
+        Parameters
+        ----------
+        client
+            Client number whose class to retrieve.
+
+        Returns
+        -------
+        ClientClass
+            The client's delivery/salvage class.
+        """
+    def renumbered(self, ordering: ClientOrdering) -> ProblemData:
+        """
+        Returns a copy of this instance, in which the clients are renumbered
+        in the order that the given space-filling curve visits their
+        locations. The depot stays at index 0. Clients that are close together
+        then have nearby indices, and thus nearby rows in the distance and
+        duration matrices, which are permuted accordingly.
+
+        Solutions of the returned instance use the new indices, but
+        :meth:`~pyvrp._Solution.Solution.original_routes` and their string
+        representation report the clients' original ids.
+
+        Parameters
+        ----------
+        ordering
+            Space-filling curve to order the clients by.
+
+        Returns
+        -------
+        ProblemData
+            The renumbered problem data.
+        """
+    def original_id(self, client: int) -> int:
+        """
+        Returns the id of the given client before the clients were
+        renumbered. This is the client itself if they were not.
+        """
+    def internal_id(self, original: int) -> int:
+        """
+        Returns the index of the client with the given original id. This is
+        the inverse of :meth:`original_id`.
+        """
     def centroid(self) -> Tuple[float, float]:
         """
         Center point of all client locations (excluding the depot).
@@ -17,6 +17,7 @@ class Route:
     def has_excess_volume(self) -> bool: ...
     def has_excess_salvage(self) -> bool: ...
     def has_excess_stores(self) -> bool: ...
+    def has_sequence_violations(self) -> bool: ...
     def has_time_warp(self) -> bool: ...
     def demandWeight(self) -> int:
         """
@@ -54,6 +55,10 @@ class Route:
         """
         Number of stores above the stores limit.
         """
+    def sequence_violations(self) -> int:
+        """
+        Number of client pairs visited out of delivery/salvage sequence.
+        """
     def distance(self) -> int:
         """
         Total distance travelled on this route.
@@ -155,6 +160,19 @@ class Solution:
             ends at the depot (0), but that is implicit: the depot is not part
             of the returned routes.
         """
+    def original_routes(self) -> List[List[int]]:
+        """
+        The visits of the solution's routes, in terms of the clients' original
+        ids. These differ from the visits of :meth:`get_routes` only when the
+        clients have been renumbered, with
+        :meth:`~pyvrp._ProblemData.ProblemData.renumbered`. The string
+        representation of this solution also uses the original ids.
+
+        Returns
+        -------
+        list
+            A list of routes, each a list of original client ids.
+        """
     def has_excess_weight(self) -> bool:
         """
         Returns whether this solution violates weight capacity constraints.
@@ -191,6 +209,26 @@ class Solution:
         bool
             True if the solution is not stores feasible, False otherwise.
         """
+    def has_excess_orders(self) -> bool:
+        """
+        Returns whether this solution splits an order over more routes than
+        the order route limit allows.
+
+        Returns
+        -------
+        bool
+            True if the solution is not order feasible, False otherwise.
+        """
+    def has_sequence_violations(self) -> bool:
+        """
+        Returns whether this solution visits clients out of the required
+        delivery, both, salvage sequence on some route.
+
+        Returns
+        -------
+        bool
+            True if the solution is not sequence feasible, False otherwise.
+        """
     def has_time_warp(self) -> bool:
         """
         Returns whether this solution violates time window constraints.
@@ -246,6 +284,26 @@ class Solution:
         int
             Total excess stores over all routes
         """
+    def excess_orders(self) -> int:
+        """
+        Returns the total number of routes that orders span in excess of the
+        order route limit.
+
+        Returns
+        -------
+        int
+            Total excess order splits over all orders.
+        """
+    def sequence_violations(self) -> int:
+        """
+        Returns the total number of client pairs that are visited out of the
+        required delivery, both, salvage sequence.
+
+        Returns
+        -------
+        int
+            Total sequence violations over all routes.
+        """
     def time_warp(self) -> int:
         """
         Returns the total time warp load over all routes.
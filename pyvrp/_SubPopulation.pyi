@@ -38,6 +38,13 @@ class SubPopulation:
         the solution itself, a fitness score (higher is worse), and a list
         of proximity values to the other solutions in the subpopulation.
 
+        .. note::
+
+           The :meth:`~add`, :meth:`~purge`, and :meth:`~update_fitness`
+           methods release the GIL. A subpopulation must not be used from
+           more than one thread at the same time. If ``diversity_op`` is a
+           Python function, it is called with the GIL held.
+
         Parameters
         ----------
         diversity_op
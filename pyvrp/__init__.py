@@ -1,12 +1,28 @@
 from .GeneticAlgorithm import GeneticAlgorithm, GeneticAlgorithmParams
+from .IslandGeneticAlgorithm import IslandGeneticAlgorithm, IslandModelParams
 from .Model import Model
+from .NativeGeneticAlgorithm import NativeGeneticAlgorithm
 from .PenaltyManager import PenaltyManager, PenaltyParams
 from .Population import Population, PopulationParams
 from .Result import Result
 from .Statistics import Statistics
 from ._CostEvaluator import CostEvaluator
+from ._InstanceFile import (
+    SharedMemory,
+    attach_instance,
+    load_instance,
+    publish_instance,
+    write_instance,
+)
 from ._Matrix import Matrix
-from ._ProblemData import Client, ProblemData
+from ._ProblemData import (
+    Client,
+    ClientClass,
+    ClientOrdering,
+    DistanceOracle,
+    MatrixStorage,
+    ProblemData,
+)
 from ._Solution import Route, Solution
 from ._XorShift128 import XorShift128
 from .read import read, read_solution
@@ -1,12 +1,16 @@
 import argparse
+import os
+from collections import deque
+from concurrent.futures import ProcessPoolExecutor
 from functools import partial
 from pathlib import Path
-from typing import List, Optional
+from typing import List, Optional, Tuple
 
 import numpy as np
 
 try:
     import tomli
+    from tqdm.auto import tqdm
     from tqdm.contrib.concurrent import process_map
 except ModuleNotFoundError:
     msg = "Install 'tqdm' and 'tomli' to use the command line program."
@@ -14,15 +18,19 @@ except ModuleNotFoundError:
 
 import pyvrp.search
 from pyvrp import (
+    ClientOrdering,
     GeneticAlgorithm,
     GeneticAlgorithmParams,
     PenaltyManager,
     PenaltyParams,
     Population,
     PopulationParams,
+    ProblemData,
     Result,
     Solution,
     XorShift128,
+    attach_instance,
+    publish_instance,
 )
 from pyvrp.crossover import selective_route_exchange as srex
 from pyvrp.diversity import broken_pairs_distance as bpd
@@ -32,7 +40,7 @@ from pyvrp.search import (
     ROUTE_OPERATORS,
     LocalSearch,
     NeighbourhoodParams,
-    compute_neighbours,
+    compute_neighbourhood,
 )
 from pyvrp.stop import MaxIterations, MaxRuntime
 
@@ -66,6 +74,26 @@ def maybe_mkdir(where: str):
         stats_dir.mkdir(parents=True, exist_ok=True)
 
 
+def load_data(
+    data_loc: str,
+    instance_format: str,
+    round_func: str,
+    renumber: Optional[str],
+) -> ProblemData:
+    """
+    Reads the instance at the given location, and renumbers its clients along
+    the given space-filling curve, if any.
+    """
+    data = read(data_loc, instance_format, round_func)
+
+    if renumber:
+        # Solutions still report, and are written with, the original ids.
+        ordering = ClientOrdering.__members__[renumber.upper()]
+        data = data.renumbered(ordering)
+
+    return data
+
+
 def solve(
     data_loc: str,
     instance_format: str,
@@ -103,6 +131,10 @@ def solve(
         collection when passed.
     sol_dir
         The directory to write the best found solutions to.
+    shared_name, optional
+        Name of the shared memory segment in which the instance has been
+        published, with :func:`~pyvrp._InstanceFile.publish_instance`. When
+        given, the instance is attached instead of read from ``data_loc``.
 
     Returns
     -------
@@ -126,12 +158,18 @@ def solve(
     pop_params = PopulationParams(**config.get("population", {}))
     nb_params = NeighbourhoodParams(**config.get("neighbourhood", {}))
 
-    data = read(data_loc, instance_format, round_func)
+    if kwargs.get("shared_name"):
+        # Published by the parent process, which already renumbered it.
+        data = attach_instance(kwargs["shared_name"])
+    else:
+        renumber = kwargs.get("renumber")
+        data = load_data(data_loc, instance_format, round_func, renumber)
+
     rng = XorShift128(seed=seed)
     pen_manager = PenaltyManager(pen_params)
     pop = Population(bpd, params=pop_params)
 
-    neighbours = compute_neighbours(data, nb_params)
+    neighbours = compute_neighbourhood(data, nb_params)
     ls = LocalSearch(data, rng, neighbours)
 
     node_ops = NODE_OPERATORS
@@ -163,13 +201,15 @@ def solve(
 
     result = algo.run(stop)
 
+    instance_name = Path(data_loc).stem
+    if kwargs.get("num_seeds", 1) > 1:
+        instance_name += f"-{seed}"  # each seed gets its own output files
+
     if stats_dir:
-        instance_name = Path(data_loc).stem
         where = Path(stats_dir) / (instance_name + ".csv")
         result.stats.to_csv(where)
 
     if sol_dir:
-        instance_name = Path(data_loc).stem
         where = Path(sol_dir) / (instance_name + ".sol")
 
         with open(where, "w") as fh:
@@ -179,17 +219,21 @@ def solve(
     return result
 
 
-def benchmark_solve(instance: str, **kwargs):
+def benchmark_solve(task: Tuple[str, int, Optional[str]], **kwargs):
     """
     Small wrapper script around ``solve()`` that translates result objects into
     a few key statistics, and returns those. This is needed because the result
-    solution (of type ``Solution``) cannot be pickled.
+    solution (of type ``Solution``) cannot be pickled. The task consists of
+    the instance location, the seed, and the name of the shared memory segment
+    the instance was published in, if any.
     """
-    res = solve(instance, **kwargs)
+    instance, seed, shared_name = task
+    res = solve(instance, seed=seed, shared_name=shared_name, **kwargs)
     instance_name = Path(instance).stem
 
     return (
         instance_name,
+        seed,
         "Y" if res.is_feasible() else "N",
         round(res.cost(), 2),
         res.num_iterations,
@@ -197,6 +241,62 @@ def benchmark_solve(instance: str, **kwargs):
     )
 
 
+def solve_shared(
+    func, instances: List[str], seeds: List[int], num_procs: int, kwargs
+) -> list:
+    """
+    Calls ``func`` for each instance and seed in ``num_procs`` processes, and
+    returns the results in that order. Each instance is read once and
+    published in shared memory, to which the processes attach. That avoids
+    reading the instance again in each process, and the processes share one
+    copy of the distance and duration matrices.
+
+    An instance's segment is removed once all its runs are done, and at most
+    ``num_procs`` instances are published at any time. That bounds the shared
+    memory in use (on Linux, in /dev/shm), no matter how many instances are
+    solved, while still queueing enough runs to keep all processes busy.
+    """
+    results = []
+    published = deque()  # (segment, futures) per instance, oldest first
+
+    def collect_oldest():
+        segment, futures = published.popleft()
+        results.extend(future.result() for future in futures)
+        del segment  # removes the segment; all its runs are done
+
+    total = len(instances) * len(seeds)
+    with ProcessPoolExecutor(num_procs) as executor, tqdm(
+        total=total, unit="run"
+    ) as pbar:
+        for idx, instance in enumerate(instances):
+            if len(published) == num_procs:
+                collect_oldest()
+
+            data = load_data(
+                instance,
+                kwargs["instance_format"],
+                kwargs["round_func"],
+                kwargs.get("renumber"),
+            )
+
+            segment = publish_instance(data, f"pyvrp-{os.getpid()}-{idx}")
+            futures = [
+                executor.submit(func, (instance, seed, segment.name))
+                for seed in seeds
+            ]
+
+            for future in futures:
+                future.add_done_callback(lambda _: pbar.update())
+
+            published.append((segment, futures))
+            del data, segment
+
+        while published:
+            collect_oldest()
+
+    return results
+
+
 def benchmark(instances: List[str], **kwargs):
     """
     Solves a list of instances, and prints a table with the results. Any
@@ -210,19 +310,33 @@ def benchmark(instances: List[str], **kwargs):
     maybe_mkdir(kwargs.get("stats_dir", ""))
     maybe_mkdir(kwargs.get("sol_dir", ""))
 
-    if len(instances) == 1:
-        res = solve(instances[0], **kwargs)
+    seed = kwargs.pop("seed")
+    num_seeds = kwargs.get("num_seeds", 1)
+    num_procs = kwargs.get("num_procs", 1)
+
+    if len(instances) == 1 and num_seeds == 1:
+        res = solve(instances[0], seed=seed, **kwargs)
         print(res)
         return
 
     func = partial(benchmark_solve, **kwargs)
-    func_args = sorted(instances)
+    seeds = [seed + offset for offset in range(num_seeds)]
 
-    tqdm_kwargs = dict(max_workers=kwargs.get("num_procs", 1), unit="instance")
-    data = process_map(func, func_args, **tqdm_kwargs)
+    if num_procs > 1 and num_seeds > 1:
+        data = solve_shared(func, sorted(instances), seeds, num_procs, kwargs)
+    else:
+        func_args = [
+            (instance, seed, None)
+            for instance in sorted(instances)
+            for seed in seeds
+        ]
+
+        tqdm_kwargs = dict(max_workers=num_procs, unit="run")
+        data = process_map(func, func_args, **tqdm_kwargs)
 
     dtypes = [
         ("inst", "U37"),
+        ("seed", int),
         ("ok", "U1"),
         ("obj", float),
         ("iters", int),
@@ -230,7 +344,7 @@ def benchmark(instances: List[str], **kwargs):
     ]
 
     data = np.asarray(data, dtype=dtypes)
-    headers = ["Instance", "OK", "Obj.", "Iters. (#)", "Time (s)"]
+    headers = ["Instance", "Seed", "OK", "Obj.", "Iters. (#)", "Time (s)"]
 
     print("\n", tabulate(headers, data), "\n", sep="")
     print(f"      Avg. objective: {data['obj'].mean():.0f}")
@@ -277,6 +391,13 @@ def main():
         help="Round function to apply for non-integral data. Default 'none'.",
     )
 
+    msg = """
+    Renumber the clients along the given space-filling curve before solving,
+    so that nearby clients have nearby indices. This improves memory locality
+    on large instances. Solutions are reported with the original client ids.
+    """
+    parser.add_argument("--renumber", choices=["hilbert", "morton"], help=msg)
+
     msg = """
     Optional parameter configuration file (in TOML format). These arguments
     replace the defaults if a file is passed; default parameters are used when
@@ -287,6 +408,13 @@ def main():
     msg = "Seed to use for reproducible results."
     parser.add_argument("--seed", required=True, type=int, help=msg)
 
+    msg = """
+    Number of seeds to solve each instance with, starting from the given seed
+    and counting up. Default 1. When multiple processors are used, each
+    instance is read only once, and shared by the processes that solve it.
+    """
+    parser.add_argument("--num_seeds", type=int, default=1, help=msg)
+
     msg = "Number of processors to use for solving instances. Default 1."
     parser.add_argument("--num_procs", type=int, default=1, help=msg)
 
@@ -0,0 +1,262 @@
+#ifndef PYVRP_COMPACTMATRIX_H
+#define PYVRP_COMPACTMATRIX_H
+
+#include "Matrix.h"
+#include "Measure.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Square, symmetric matrix that only stores its lower triangle, including the
+ * diagonal. That takes about half the memory of a full matrix.
+ */
+template <typename T> class SymmetricMatrix
+{
+    size_t dim_;           // The number of rows (and columns) of the matrix
+    std::vector<T> data_;  // Lower triangle, row by row
+
+    [[nodiscard]] static size_t index(size_t row, size_t col);
+
+public:
+    SymmetricMatrix() : dim_(0) {}
+
+    /**
+     * Creates a symmetric matrix from the given matrix. The data is copied
+     * into the created matrix.
+     *
+     * @throws std::invalid_argument When the given matrix is not symmetric.
+     */
+    explicit SymmetricMatrix(Matrix<T> const &matrix);
+
+    [[nodiscard]] T operator()(size_t row, size_t col) const;
+
+    [[nodiscard]] size_t numCols() const;
+
+    [[nodiscard]] size_t numRows() const;
+};
+
+/**
+ * Matrix that stores its elements as unsigned integers of type Q, scaled by a
+ * common factor. The factor is the greatest common divisor of all elements, so
+ * the elements are stored exactly. Elements of type uint16_t take half the
+ * memory of 32-bit integer elements, and a quarter of that of doubles.
+ */
+template <typename T, typename Q> class QuantisedMatrix
+{
+    static_assert(std::is_unsigned_v<Q>);
+
+    size_t cols_;          // The number of columns of the matrix
+    size_t rows_;          // The number of rows of the matrix
+    Value scale_;          // Common factor of all elements
+    std::vector<Q> data_;  // Elements divided by scale_, in row-major order
+
+public:
+    QuantisedMatrix() : cols_(0), rows_(0), scale_(1) {}
+
+    /**
+     * Creates a quantised matrix from the given matrix.
+     *
+     * @throws std::invalid_argument When the elements cannot be stored
+     *                               exactly, because an element is negative
+     *                               or not a whole number, or because the
+     *                               largest element divided by the common
+     *                               factor does not fit in Q.
+     */
+    explicit QuantisedMatrix(Matrix<T> const &matrix);
+
+    [[nodiscard]] T operator()(size_t row, size_t col) const;
+
+    [[nodiscard]] size_t numCols() const;
+
+    [[nodiscard]] size_t numRows() const;
+
+    /**
+     * @return Common factor by which all stored elements are multiplied.
+     */
+    [[nodiscard]] Value scale() const;
+};
+
+/**
+ * Pair of equally sized matrices, stored interleaved: the two elements at the
+ * same position are adjacent in memory, so a lookup in one matrix brings the
+ * element of the other into the cache as well.
+ */
+template <typename A, typename B> class PairedMatrix
+{
+    struct Elements
+    {
+        A first;
+        B second;
+    };
+
+    size_t cols_;                 // The number of columns of the matrix
+    size_t rows_;                 // The number of rows of the matrix
+    std::vector<Elements> data_;  // Pairs of elements, in row-major order
+
+public:
+    PairedMatrix() : cols_(0), rows_(0) {}
+
+    /**
+     * Creates a paired matrix from the given two matrices. The data is copied
+     * into the created matrix.
+     *
+     * @throws std::invalid_argument When the matrices differ in size.
+     */
+    PairedMatrix(Matrix<A> const &first, Matrix<B> const &second);
+
+    [[nodiscard]] A first(size_t row, size_t col) const;
+
+    [[nodiscard]] B second(size_t row, size_t col) const;
+
+    [[nodiscard]] size_t numCols() const;
+
+    [[nodiscard]] size_t numRows() const;
+};
+
+template <typename T>
+size_t SymmetricMatrix<T>::index(size_t row, size_t col)
+{
+    auto const high = std::max(row, col);
+    auto const low = std::min(row, col);
+    return high * (high + 1) / 2 + low;
+}
+
+template <typename T>
+SymmetricMatrix<T>::SymmetricMatrix(Matrix<T> const &matrix)
+    : dim_(matrix.numRows())
+{
+    if (matrix.numCols() != dim_)
+        throw std::invalid_argument("Symmetric matrix must be square.");
+
+    data_.reserve(dim_ * (dim_ + 1) / 2);
+
+    for (size_t row = 0; row != dim_; ++row)
+        for (size_t col = 0; col <= row; ++col)
+        {
+            if (matrix(row, col) != matrix(col, row))
+                throw std::invalid_argument("Matrix is not symmetric.");
+
+            data_.push_back(matrix(row, col));
+        }
+}
+
+template <typename T>
+T SymmetricMatrix<T>::operator()(size_t row, size_t col) const
+{
+    return data_[index(row, col)];
+}
+
+template <typename T> size_t SymmetricMatrix<T>::numCols() const
+{
+    return dim_;
+}
+
+template <typename T> size_t SymmetricMatrix<T>::numRows() const
+{
+    return dim_;
+}
+
+template <typename T, typename Q>
+QuantisedMatrix<T, Q>::QuantisedMatrix(Matrix<T> const &matrix)
+    : cols_(matrix.numCols()), rows_(matrix.numRows()), scale_(1)
+{
+    // Largest whole number that all integer and floating point values
+    // represent exactly.
+    constexpr auto maxWhole = static_cast<double>(1LL << 53);
+
+    auto const wholeAt = [&](size_t idx) {
+        auto const value = static_cast<double>(matrix.data()[idx]);
+        if (!(value >= 0 && value <= maxWhole) || std::floor(value) != value)
+            throw std::invalid_argument("Quantised matrix elements must be "
+                                        "non-negative whole numbers.");
+
+        return static_cast<long long>(value);
+    };
+
+    // First pass determines the common factor and checks that all elements
+    // fit. The second pass then stores them.
+    long long divisor = 0;
+    long long largest = 0;
+
+    for (size_t idx = 0; idx != matrix.size(); ++idx)
+    {
+        auto const whole = wholeAt(idx);
+        divisor = std::gcd(divisor, whole);
+        largest = std::max(largest, whole);
+    }
+
+    if (divisor != 0)
+        scale_ = static_cast<Value>(divisor);
+
+    auto const maxStored = std::numeric_limits<Q>::max();
+    if (largest / scale_ > static_cast<long long>(maxStored))
+        throw std::invalid_argument("Quantised matrix elements do not fit.");
+
+    data_.reserve(matrix.size());
+    for (size_t idx = 0; idx != matrix.size(); ++idx)
+        data_.push_back(static_cast<Q>(wholeAt(idx) / scale_));
+}
+
+template <typename T, typename Q>
+T QuantisedMatrix<T, Q>::operator()(size_t row, size_t col) const
+{
+    return static_cast<Value>(data_[cols_ * row + col]) * scale_;
+}
+
+template <typename T, typename Q> size_t QuantisedMatrix<T, Q>::numCols() const
+{
+    return cols_;
+}
+
+template <typename T, typename Q> size_t QuantisedMatrix<T, Q>::numRows() const
+{
+    return rows_;
+}
+
+template <typename T, typename Q> Value QuantisedMatrix<T, Q>::scale() const
+{
+    return scale_;
+}
+
+template <typename A, typename B>
+PairedMatrix<A, B>::PairedMatrix(Matrix<A> const &first,
+                                 Matrix<B> const &second)
+    : cols_(first.numCols()), rows_(first.numRows())
+{
+    if (second.numCols() != cols_ || second.numRows() != rows_)
+        throw std::invalid_argument("Paired matrices must have equal size.");
+
+    data_.reserve(first.size());
+    for (size_t idx = 0; idx != first.size(); ++idx)
+        data_.push_back({first.data()[idx], second.data()[idx]});
+}
+
+template <typename A, typename B>
+A PairedMatrix<A, B>::first(size_t row, size_t col) const
+{
+    return data_[cols_ * row + col].first;
+}
+
+template <typename A, typename B>
+B PairedMatrix<A, B>::second(size_t row, size_t col) const
+{
+    return data_[cols_ * row + col].second;
+}
+
+template <typename A, typename B> size_t PairedMatrix<A, B>::numCols() const
+{
+    return cols_;
+}
+
+template <typename A, typename B> size_t PairedMatrix<A, B>::numRows() const
+{
+    return rows_;
+}
+
+#endif  // PYVRP_COMPACTMATRIX_H
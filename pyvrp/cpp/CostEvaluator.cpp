@@ -6,11 +6,15 @@ CostEvaluator::CostEvaluator(Cost weightCapacityPenalty,
                              Cost volumeCapacityPenalty, 
                              Cost salvageCapacityPenalty, 
                              Cost storesLimitPenalty, 
+                             Cost ordersLimitPenalty, 
+                             Cost sequenceViolationPenalty,
                              Cost timeWarpPenalty)
     : weightCapacityPenalty(weightCapacityPenalty), 
       volumeCapacityPenalty(volumeCapacityPenalty), 
       salvageCapacityPenalty(salvageCapacityPenalty), 
       storesLimitPenalty(storesLimitPenalty), 
+      ordersLimitPenalty(ordersLimitPenalty), 
+      sequenceViolationPenalty(sequenceViolationPenalty),
       timeWarpPenalty(timeWarpPenalty)
 {
 }
@@ -24,6 +28,8 @@ Cost CostEvaluator::penalisedCost(Solution const &solution) const
            + volumePenaltyExcess(solution.excessVolume())
            + salvagePenaltyExcess(solution.excessSalvage())
            + storesPenaltyExcess(solution.excessStores())
+           + ordersPenaltyExcess(solution.excessOrders())
+           + sequencePenalty(solution.sequenceViolations())
            + twPenalty(solution.timeWarp());
     return cur_cost;
 }
@@ -13,6 +13,8 @@ class CostEvaluator
     Cost volumeCapacityPenalty;
     Cost salvageCapacityPenalty;
     Cost storesLimitPenalty;
+    Cost ordersLimitPenalty;
+    Cost sequenceViolationPenalty;
     Cost timeWarpPenalty;
 
 public:
@@ -20,6 +22,8 @@ public:
                   Cost volumeCapacityPenalty, 
                   Cost salvageCapacityPenalty, 
                   Cost storesLimitPenalty,
+                  Cost ordersLimitPenalty,
+                  Cost sequenceViolationPenalty,
                   Cost timeWarpPenalty);
 
     /**
@@ -64,6 +68,24 @@ public:
      */
     [[nodiscard]] inline Cost storesPenaltyExcess(Store excessStores) const;
 
+    /**
+     * Computes the order split penalty for an order that is spread over the
+     * given number of routes.
+     */
+    [[nodiscard]] inline Cost ordersPenalty(Order routes, Order routeLimit) const;
+
+    /**
+     * Computes the order split penalty for the given number of routes that
+     * orders span in excess of the order route limit.
+     */
+    [[nodiscard]] inline Cost ordersPenaltyExcess(Order excessOrders) const;
+
+    /**
+     * Computes the sequence penalty for the given number of client pairs that
+     * are visited out of delivery/salvage sequence.
+     */
+    [[nodiscard]] inline Cost sequencePenalty(Sequence violations) const;
+
     /**
      * Computes the time warp penalty for the given time warp.
      */
@@ -139,6 +161,21 @@ Cost CostEvaluator::storesPenalty(Store stores, Store storesLimit) const
     return Cost(stores > storesLimit) * penalty;
 }
 
+Cost CostEvaluator::ordersPenaltyExcess(Order excessOrders) const
+{
+    return static_cast<Cost>(excessOrders) * ordersLimitPenalty;
+}
+
+Cost CostEvaluator::ordersPenalty(Order routes, Order routeLimit) const
+{
+    Cost penalty = ordersPenaltyExcess(routes - routeLimit);
+    return Cost(routes > routeLimit) * penalty;
+}
+
+Cost CostEvaluator::sequencePenalty(Sequence violations) const
+{
+    return static_cast<Cost>(violations) * sequenceViolationPenalty;
+}
 
 Cost CostEvaluator::twPenalty([[maybe_unused]] Duration timeWarp) const
 {
@@ -11,14 +11,19 @@ PYBIND11_MODULE(_CostEvaluator, m)
                          unsigned int volumeCapacityPenalty, 
                          unsigned int salvageCapacityPenalty, 
                          unsigned int storesLimitPenalty, 
-                         unsigned int twPenalty) {
-                 return CostEvaluator(weightCapacityPenalty, volumeCapacityPenalty, salvageCapacityPenalty, storesLimitPenalty, twPenalty);
+                         unsigned int twPenalty, 
+                         unsigned int ordersLimitPenalty, 
+                         unsigned int sequencePenalty) {
+                 return CostEvaluator(weightCapacityPenalty, volumeCapacityPenalty, salvageCapacityPenalty, storesLimitPenalty, ordersLimitPenalty, sequencePenalty, twPenalty);
              }),
              py::arg("weight_capacity_penalty") = 0,
              py::arg("volume_capacity_penalty") = 0,
              py::arg("salvage_penalty") = 0,
              py::arg("stores_penalty") = 0,
-             py::arg("tw_penalty") = 0)
+             py::arg("tw_penalty") = 0,
+             // These come last, so that existing positional calls still work.
+             py::arg("orders_penalty") = 0,
+             py::arg("sequence_penalty") = 0)
         .def(
             "load_weight_penalty",
             [](CostEvaluator const &evaluator,
@@ -55,6 +60,21 @@ PYBIND11_MODULE(_CostEvaluator, m)
             },
             py::arg("load_stores"),
             py::arg("stores_limit"))
+        .def(
+            "orders_penalty",
+            [](CostEvaluator const &evaluator,
+               Value num_routes,
+               Value order_route_limit) {
+                return evaluator.ordersPenalty(num_routes, order_route_limit).get();
+            },
+            py::arg("num_routes"),
+            py::arg("order_route_limit"))
+        .def(
+            "sequence_penalty",
+            [](CostEvaluator const &evaluator, Value violations) {
+                return evaluator.sequencePenalty(violations).get();
+            },
+            py::arg("violations"))
         .def(
             "tw_penalty",
             [](CostEvaluator const &evaluator, Value const timeWarp) {
@@ -0,0 +1,157 @@
+#include "DistanceOracle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+// Source of oracle identifiers. Zero identifies no oracle at all.
+std::atomic<uint64_t> nextId = 1;
+
+// Cache of recently used rows of one oracle. Each thread has its own cache,
+// so that lookups do not need to be synchronised. Rows are filled lazily: an
+// entry is only valid when its stamp matches that of its slot, so that a new
+// row can be loaded into a slot without clearing the slot's old values.
+struct RowCache
+{
+    struct Entry
+    {
+        Value value;
+        uint32_t stamp;
+    };
+
+    uint64_t owner = 0;               // Identifier of the cached oracle
+    size_t numRows = 0;               // Length of each cached row
+    uint64_t tick = 0;                // Incremented on every row load
+    uint32_t stamp = 0;               // Stamp of the most recently loaded row
+    size_t lastRow = 0;               // Row of the most recent lookup, and
+    size_t lastSlot = 0;              // its slot
+    std::vector<int> slotOf;          // Slot of each row, or -1 if uncached
+    std::vector<size_t> rowOf;        // Row stored in each slot
+    std::vector<uint64_t> lastUsed;   // Tick of the last lookup in each slot
+    std::vector<uint32_t> slotStamp;  // Stamp of the row in each slot
+    std::vector<Entry> entries;       // Cached rows, one per slot
+
+    // Empties the cache, and sizes it for rows of the given oracle.
+    void reset(uint64_t id, size_t rows, size_t slots)
+    {
+        owner = id;
+        numRows = rows;
+        tick = 0;
+        stamp = 0;
+        slotOf.assign(rows, -1);
+        rowOf.assign(slots, 0);
+        lastUsed.assign(slots, 0);
+        slotStamp.assign(slots, 0);
+        entries.assign(slots * rows, {0, 0});
+
+        lastRow = rows;  // no row is cached yet, so there is no last row
+    }
+
+    // Returns the entries of the given row, evicting the least recently used
+    // row if it is not yet cached. The returned row's stamp is in lastSlot.
+    Entry *row(size_t row)
+    {
+        if (row != lastRow)
+        {
+            auto slot = slotOf[row];
+
+            if (slot < 0)
+            {
+                // Stamps are about to wrap around, after which old entries
+                // could match again. So the cache is emptied instead.
+                if (stamp == std::numeric_limits<uint32_t>::max())
+                    reset(owner, numRows, lastUsed.size());
+
+                auto const lru = std::min_element(lastUsed.begin(),
+                                                  lastUsed.end());
+                slot = static_cast<int>(lru - lastUsed.begin());
+
+                if (*lru != 0)  // slot is in use, so evict its row
+                    slotOf[rowOf[slot]] = -1;
+
+                slotOf[row] = slot;
+                rowOf[slot] = row;
+                slotStamp[slot] = ++stamp;
+            }
+
+            lastUsed[slot] = ++tick;
+            lastRow = row;
+            lastSlot = slot;
+        }
+
+        return entries.data() + lastSlot * numRows;
+    }
+};
+
+thread_local RowCache cache;
+}  // namespace
+
+DistanceOracle::DistanceOracle(std::vector<double> x,
+                               std::vector<double> y,
+                               DistanceOracleParams const &params)
+    : x_(std::move(x)), y_(std::move(y)), params_(params), id_(nextId++)
+{
+    if (x_.size() != y_.size())
+        throw std::invalid_argument("Coordinate vectors must be equal size.");
+
+    if (!(params_.divisor > 0))
+        throw std::invalid_argument("Divisor must be > 0.");
+}
+
+Value DistanceOracle::distance(size_t first, size_t second) const
+{
+    if (params_.cacheRows == 0)
+        return compute(first, second);
+
+    if (cache.owner != id_)
+        cache.reset(id_, size(), std::min(params_.cacheRows, size()));
+
+    auto &entry = cache.row(first)[second];
+    auto const stamp = cache.slotStamp[cache.lastSlot];
+
+    if (entry.stamp != stamp)
+        entry = {compute(first, second), stamp};
+
+    return entry.value;
+}
+
+Value DistanceOracle::duration(size_t first, size_t second) const
+{
+    return params_.durations ? distance(first, second) : 0;
+}
+
+Value DistanceOracle::compute(size_t first, size_t second) const
+{
+    // This follows pyvrp.read: the Euclidean distance is computed from the
+    // squared differences, then divided by the divisor, and finally rounded.
+    // Each step is a separate statement, so that no step is contracted into
+    // a fused operation that rounds differently.
+    double const diffX = x_[first] - x_[second];
+    double const diffY = y_[first] - y_[second];
+    double const sqX = diffX * diffX;
+    double const sqY = diffY * diffY;
+    double const scaled = std::sqrt(sqX + sqY) / params_.divisor;
+
+    switch (params_.rounding)
+    {
+    case Rounding::ROUND:
+        return static_cast<Value>(std::nearbyint(scaled));
+    case Rounding::TRUNC1:
+        return static_cast<Value>(std::trunc(scaled * 10));
+    default:  // NONE and TRUNC both truncate to a whole number
+        return static_cast<Value>(std::trunc(scaled));
+    }
+}
+
+size_t DistanceOracle::size() const { return x_.size(); }
+
+DistanceOracleParams const &DistanceOracle::params() const { return params_; }
+
+std::vector<double> const &DistanceOracle::x() const { return x_; }
+
+std::vector<double> const &DistanceOracle::y() const { return y_; }
@@ -0,0 +1,102 @@
+#ifndef PYVRP_DISTANCEORACLE_H
+#define PYVRP_DISTANCEORACLE_H
+
+#include "Measure.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Rounding of computed distances. These mirror the rounding functions of
+ * pyvrp.read: NONE and TRUNC truncate, ROUND rounds to the nearest integer
+ * (with ties to even), and TRUNC1 truncates after scaling by ten. The "dimacs"
+ * rounding function of pyvrp.read is TRUNC1.
+ */
+enum class Rounding
+{
+    NONE,
+    ROUND,
+    TRUNC,
+    TRUNC1
+};
+
+struct DistanceOracleParams
+{
+    Rounding rounding = Rounding::NONE;
+    double divisor = 10;     // Euclidean distances are divided by this
+    bool durations = true;   // durations equal distances (or are all zero)
+    size_t cacheRows = 0;    // rows in each thread's cache (0 = no cache)
+};
+
+/**
+ * Computes distances and durations on demand, from the coordinates of the
+ * clients (+depot), rather than storing them in matrices. The distance
+ * between two locations is their Euclidean distance, divided by the divisor
+ * and then rounded. These are the same floating point operations, in the same
+ * order, as pyvrp.read performs on the coordinates in an instance file, so
+ * both compute exactly the same values. Durations are equal to distances, or
+ * all zero, which is again what pyvrp.read does for instances with and
+ * without time windows, respectively.
+ *
+ * Optionally, each thread keeps a cache of recently used rows: each cached
+ * row holds the values computed so far, from one location to all others, and
+ * the least recently used row is evicted when a new row is needed. The cache
+ * is used for one oracle (and its copies) at a time. It is disabled by
+ * default, since computing a Euclidean distance is about as fast as a cache
+ * hit, and faster than a miss: see benchmarks/distance_oracle.cpp.
+ */
+class DistanceOracle
+{
+    std::vector<double> x_;
+    std::vector<double> y_;
+    DistanceOracleParams params_;
+    uint64_t id_ = 0;  // Identifies this oracle (and its copies) to caches
+
+public:
+    DistanceOracle() = default;
+
+    /**
+     * @throws std::invalid_argument When the coordinate vectors differ in
+     *                               size, or the divisor is not positive.
+     */
+    DistanceOracle(std::vector<double> x,
+                   std::vector<double> y,
+                   DistanceOracleParams const &params = {});
+
+    /**
+     * @return Distance from the first to the second location, from the cache
+     *         of the calling thread, if possible.
+     */
+    [[nodiscard]] Value distance(size_t first, size_t second) const;
+
+    /**
+     * @return Duration from the first to the second location.
+     */
+    [[nodiscard]] Value duration(size_t first, size_t second) const;
+
+    /**
+     * @return Distance from the first to the second location, computed
+     *         without using the cache.
+     */
+    [[nodiscard]] Value compute(size_t first, size_t second) const;
+
+    /**
+     * @return Number of locations.
+     */
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] DistanceOracleParams const &params() const;
+
+    /**
+     * @return Horizontal coordinates of the locations.
+     */
+    [[nodiscard]] std::vector<double> const &x() const;
+
+    /**
+     * @return Vertical coordinates of the locations.
+     */
+    [[nodiscard]] std::vector<double> const &y() const;
+};
+
+#endif  // PYVRP_DISTANCEORACLE_H
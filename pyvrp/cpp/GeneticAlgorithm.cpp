@@ -0,0 +1,385 @@
+#include "GeneticAlgorithm.h"
+#include "crossover/crossover.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+}  // namespace
+
+GeneticAlgorithm::GeneticAlgorithm(ProblemData const &data,
+                                   PenaltyParams const &penaltyParams,
+                                   PopulationParams const &populationParams,
+                                   XorShift128 &rng,
+                                   LocalSearch &localSearch,
+                                   std::vector<Solution> initialSolutions,
+                                   GeneticAlgorithmParams params)
+    : data(data),
+      penaltyManager_(penaltyParams),
+      population(brokenPairsDistance, populationParams),
+      rng(rng),
+      localSearch(localSearch),
+      initialSolutions(std::move(initialSolutions)),
+      params(params)
+{
+    if (this->initialSolutions.empty())
+        throw std::invalid_argument("Expected at least one initial solution.");
+
+    // Find best feasible initial solution if any exist, else set a random
+    // infeasible solution (with infinite cost) as the initial best.
+    auto const &costEvaluator = penaltyManager_.costEvaluator();
+    auto const cmp = [&](auto const &first, auto const &second) {
+        return costEvaluator.cost(first) < costEvaluator.cost(second);
+    };
+
+    best.emplace(*std::min_element(
+        this->initialSolutions.begin(), this->initialSolutions.end(), cmp));
+}
+
+GeneticAlgorithm::Result GeneticAlgorithm::run(StoppingCriterion const &stop,
+                                               ProgressCallback const &progress,
+                                               size_t callbackInterval)
+{
+    if (callbackInterval == 0)
+        throw std::invalid_argument("callback_interval < 1 not understood.");
+
+    auto const start = Clock::now();
+    auto lastCollected = start;
+
+    std::vector<double> runtimes;
+    std::vector<SubPopulationStatistics> feasStats;
+    std::vector<SubPopulationStatistics> infeasStats;
+
+    size_t iters = 0;
+    size_t itersNoImprovement = 1;
+
+    localSearch.resetStatistics();
+
+    for (auto const &sol : initialSolutions)
+        population.add(sol, costEvaluator());
+
+    while (true)
+    {
+        if (iters % callbackInterval == 0)
+        {
+            auto const bestCost = costEvaluator().cost(*best).get();
+
+            if (progress)
+                progress({iters,
+                          secondsSince(start),
+                          bestCost,
+                          population.feasibleSubPopulation().size(),
+                          population.infeasibleSubPopulation().size()});
+
+            if (stop(bestCost))
+                break;
+        }
+
+        iters++;
+
+        if (itersNoImprovement == params.nbIterNoImprovement)
+        {
+            itersNoImprovement = 1;
+            population.clear();
+
+            for (auto const &sol : initialSolutions)
+                population.add(sol, costEvaluator());
+        }
+
+        auto const currBest = costEvaluator().cost(*best);
+
+        if (params.batchSize > 1)
+        {
+            std::vector<Solution> offspring;
+            offspring.reserve(params.batchSize);
+
+            for (size_t idx = 0; idx != params.batchSize; ++idx)
+                offspring.push_back(crossover());
+
+            searchBatch(offspring);
+        }
+        else
+            search(crossover());
+
+        auto const newBest = costEvaluator().cost(*best);
+
+        if (newBest < currBest)
+            itersNoImprovement = 1;
+        else
+            itersNoImprovement++;
+
+        if (params.collectStatistics)
+        {
+            auto const now = Clock::now();
+            runtimes.push_back(
+                std::chrono::duration<double>(now - lastCollected).count());
+            lastCollected = now;
+
+            auto const &feas = population.feasibleSubPopulation();
+            auto const &infeas = population.infeasibleSubPopulation();
+            feasStats.push_back(collectFrom(feas));
+            infeasStats.push_back(collectFrom(infeas));
+        }
+    }
+
+    return {*best,
+            iters,
+            secondsSince(start),
+            std::move(runtimes),
+            std::move(feasStats),
+            std::move(infeasStats)};
+}
+
+PenaltyManager const &GeneticAlgorithm::penaltyManager() const
+{
+    return penaltyManager_;
+}
+
+Solution const &GeneticAlgorithm::bestSolution() const { return *best; }
+
+void GeneticAlgorithm::addImmigrant(Solution const &solution)
+{
+    population.add(solution, costEvaluator());
+
+    if (isNewBest(solution))
+        best.emplace(solution);
+}
+
+CostEvaluator const &GeneticAlgorithm::costEvaluator() const
+{
+    return penaltyManager_.costEvaluator();
+}
+
+Solution GeneticAlgorithm::crossover()
+{
+    auto const parents = population.select(rng, costEvaluator());
+    auto const &[first, second] = parents;
+
+    // This mirrors how the Python selective_route_exchange wrapper draws the
+    // start indices and the number of routes to move.
+    auto const numRoutes1 = first->numRoutes();
+    auto const numRoutes2 = second->numRoutes();
+
+    auto const idx1 = numRoutes1 == 0 ? 0 : rng.randint(numRoutes1);
+    auto const idx2 = idx1 < numRoutes2 ? idx1 : 0;
+    auto const maxRoutesToMove = std::min(numRoutes1, numRoutes2);
+    auto const numRoutesToMove
+        = maxRoutesToMove == 0 ? 1 : rng.randint(maxRoutesToMove) + 1;
+
+    return selectiveRouteExchange(
+        parents, data, costEvaluator(), {idx1, idx2}, numRoutesToMove);
+}
+
+Solution GeneticAlgorithm::improve(Solution const &solution,
+                                   CostEvaluator const &costEvaluator,
+                                   bool shouldIntensify)
+{
+    localSearch.shuffle(rng);
+    auto improved = localSearch.search(solution, costEvaluator);
+
+    if (!shouldIntensify)
+        return improved;
+
+    localSearch.shuffle(rng);
+    auto intensified = localSearch.intensify(improved, costEvaluator);
+
+    auto const currentCost = costEvaluator.penalisedCost(improved);
+    auto const newCost = costEvaluator.penalisedCost(intensified);
+
+    return newCost < currentCost ? intensified : improved;
+}
+
+std::vector<Solution>
+GeneticAlgorithm::improveBatch(std::vector<Solution> const &solutions,
+                               CostEvaluator const &costEvaluator,
+                               std::vector<bool> const &shouldIntensify)
+{
+    auto const numThreads = params.numThreads;
+
+    localSearch.shuffle(rng);
+    auto improved
+        = localSearch.searchBatch(solutions, costEvaluator, numThreads);
+
+    std::vector<size_t> indices;
+    std::vector<Solution> toIntensify;
+    for (size_t idx = 0; idx != improved.size(); ++idx)
+        if (shouldIntensify[idx])
+        {
+            indices.push_back(idx);
+            toIntensify.push_back(improved[idx]);
+        }
+
+    localSearch.shuffle(rng);
+    auto intensified = localSearch.intensifyBatch(
+        toIntensify, costEvaluator, 0, numThreads);
+
+    std::vector<Solution> result;
+    result.reserve(improved.size());
+
+    for (size_t idx = 0, next = 0; idx != improved.size(); ++idx)
+    {
+        if (next != indices.size() && indices[next] == idx)
+        {
+            auto const &candidate = intensified[next++];
+            auto const currentCost = costEvaluator.penalisedCost(improved[idx]);
+            auto const newCost = costEvaluator.penalisedCost(candidate);
+
+            if (newCost < currentCost)
+            {
+                result.push_back(candidate);
+                continue;
+            }
+        }
+
+        result.push_back(improved[idx]);
+    }
+
+    return result;
+}
+
+bool GeneticAlgorithm::isNewBest(Solution const &solution) const
+{
+    return costEvaluator().cost(solution) < costEvaluator().cost(*best);
+}
+
+Solution GeneticAlgorithm::updateBest(Solution const &solution,
+                                      CostEvaluator const &costEvaluator)
+{
+    if (!isNewBest(solution))
+        return solution;
+
+    best.emplace(solution);
+
+    // Only intensify feasible, new best solutions. See also the repair step.
+    if (!params.intensifyOnBest)
+        return solution;
+
+    localSearch.shuffle(rng);
+    auto intensified = localSearch.intensify(solution, costEvaluator, 360);
+
+    if (isNewBest(intensified))
+        best.emplace(intensified);
+
+    return intensified;
+}
+
+void GeneticAlgorithm::addAndRegister(Solution const &solution)
+{
+    population.add(solution, costEvaluator());
+    penaltyManager_.registerWeightFeasible(!solution.hasExcessWeight());
+    penaltyManager_.registerVolumeFeasible(!solution.hasExcessVolume());
+    penaltyManager_.registerSalvageFeasible(!solution.hasExcessSalvage());
+    penaltyManager_.registerTimeFeasible(!solution.hasTimeWarp());
+}
+
+bool GeneticAlgorithm::shouldIntensify()
+{
+    return rng.rand<double>() < params.intensifyProbability;
+}
+
+bool GeneticAlgorithm::shouldRepair(Solution const &solution)
+{
+    return !solution.isFeasible()
+           && rng.rand<double>() < params.repairProbability;
+}
+
+void GeneticAlgorithm::search(Solution const &offspring)
+{
+    // Copy, since registering the solution may change the penalties.
+    auto const costEvaluator = this->costEvaluator();
+
+    auto const improved = improve(offspring, costEvaluator, shouldIntensify());
+    auto const sol = updateBest(improved, costEvaluator);
+    addAndRegister(sol);
+
+    // Possibly repair if current solution is infeasible. In that case, we
+    // penalise infeasibility more using a penalty booster.
+    if (shouldRepair(sol))
+    {
+        auto const booster = penaltyManager_.boosterCostEvaluator();
+        auto const repaired = improve(sol, booster, shouldIntensify());
+        auto const repairedSol = updateBest(repaired, booster);
+
+        if (repairedSol.isFeasible())
+            addAndRegister(repairedSol);
+    }
+}
+
+void GeneticAlgorithm::searchBatch(std::vector<Solution> const &offspring)
+{
+    // All offspring are improved using the penalties from before the batch.
+    auto const costEvaluator = this->costEvaluator();
+
+    std::vector<bool> intensify;
+    for (size_t idx = 0; idx != offspring.size(); ++idx)
+        intensify.push_back(shouldIntensify());
+
+    auto const improved = improveBatch(offspring, costEvaluator, intensify);
+
+    std::vector<Solution> toRepair;
+    for (auto const &candidate : improved)
+    {
+        auto const sol = updateBest(candidate, costEvaluator);
+        addAndRegister(sol);
+
+        if (shouldRepair(sol))
+            toRepair.push_back(sol);
+    }
+
+    if (toRepair.empty())
+        return;
+
+    auto const booster = penaltyManager_.boosterCostEvaluator();
+
+    intensify.clear();
+    for (size_t idx = 0; idx != toRepair.size(); ++idx)
+        intensify.push_back(shouldIntensify());
+
+    for (auto const &candidate : improveBatch(toRepair, booster, intensify))
+    {
+        auto const sol = updateBest(candidate, booster);
+
+        if (sol.isFeasible())
+            addAndRegister(sol);
+    }
+}
+
+GeneticAlgorithm::SubPopulationStatistics
+GeneticAlgorithm::collectFrom(SubPopulation const &subPop) const
+{
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+
+    if (subPop.size() == 0)  // empty, so many statistics cannot be collected
+        return {0, nan, nan, nan, nan};
+
+    double bestCost = std::numeric_limits<double>::max();
+    double sumCost = 0;
+    double sumDiversity = 0;
+    double sumNumRoutes = 0;
+
+    for (auto item = subPop.cbegin(); item != subPop.cend(); ++item)
+    {
+        auto const cost = static_cast<double>(
+            costEvaluator().penalisedCost(*item->solution).get());
+
+        bestCost = std::min(bestCost, cost);
+        sumCost += cost;
+        sumDiversity += item->avgDistanceClosest();
+        sumNumRoutes += static_cast<double>(item->solution->numRoutes());
+    }
+
+    auto const size = static_cast<double>(subPop.size());
+    return {subPop.size(),
+            sumDiversity / size,
+            bestCost,
+            sumCost / size,
+            sumNumRoutes / size};
+}
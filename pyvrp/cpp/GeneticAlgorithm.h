@@ -0,0 +1,224 @@
+#ifndef PYVRP_GENETICALGORITHM_H
+#define PYVRP_GENETICALGORITHM_H
+
+#include "CostEvaluator.h"
+#include "Measure.h"
+#include "PenaltyManager.h"
+#include "Population.h"
+#include "ProblemData.h"
+#include "Solution.h"
+#include "SubPopulation.h"
+#include "XorShift128.h"
+#include "search/LocalSearch.h"
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Genetic algorithm parameters. See the Python
+ * <code>GeneticAlgorithmParams</code> class for a description of each
+ * parameter.
+ */
+struct GeneticAlgorithmParams
+{
+    double repairProbability;
+    bool collectStatistics;
+    double intensifyProbability;
+    bool intensifyOnBest;
+    size_t nbIterNoImprovement;
+    size_t batchSize;
+    size_t numThreads;
+
+    GeneticAlgorithmParams(double repairProbability = 0.80,
+                           bool collectStatistics = false,
+                           double intensifyProbability = 0.15,
+                           bool intensifyOnBest = true,
+                           size_t nbIterNoImprovement = 20'000,
+                           size_t batchSize = 1,
+                           size_t numThreads = 0)
+        : repairProbability(repairProbability),
+          collectStatistics(collectStatistics),
+          intensifyProbability(intensifyProbability),
+          intensifyOnBest(intensifyOnBest),
+          nbIterNoImprovement(nbIterNoImprovement),
+          batchSize(batchSize),
+          numThreads(numThreads)
+    {
+        if (repairProbability < 0 || repairProbability > 1)
+        {
+            auto const msg = "repair_probability must be in [0, 1].";
+            throw std::invalid_argument(msg);
+        }
+
+        if (intensifyProbability < 0 || intensifyProbability > 1)
+        {
+            auto const msg = "intensify_probability must be in [0, 1].";
+            throw std::invalid_argument(msg);
+        }
+
+        if (batchSize == 0)
+            throw std::invalid_argument("batch_size < 1 not understood.");
+    }
+};
+
+/**
+ * Native implementation of the genetic algorithm. This is the same algorithm
+ * as the Python <code>GeneticAlgorithm</code>, using selective route exchange
+ * crossover, the broken pairs distance diversity measure, and the given local
+ * search. The entire search loop runs natively: the stopping criterion and
+ * progress callback are the only calls back into Python, and these are made
+ * only every so many iterations.
+ */
+class GeneticAlgorithm
+{
+public:
+    /**
+     * Statistics of a single subpopulation, collected after an iteration. All
+     * but the size are NaN when the subpopulation is empty.
+     */
+    struct SubPopulationStatistics
+    {
+        size_t size;
+        double avgDiversity;
+        double bestCost;
+        double avgCost;
+        double avgNumRoutes;
+    };
+
+    /**
+     * Progress of the search, passed to the progress callback.
+     */
+    struct Progress
+    {
+        size_t numIterations;
+        double runtime;  // in seconds
+        Value bestCost;  // cost of the best feasible solution, or max value
+        size_t numFeasible;
+        size_t numInfeasible;
+    };
+
+    /**
+     * Outcome of a single run.
+     */
+    struct Result
+    {
+        Solution best;
+        size_t numIterations;
+        double runtime;  // in seconds
+
+        // These are only collected when statistics collection is enabled, and
+        // are empty otherwise. There is one entry for each iteration.
+        std::vector<double> runtimes;
+        std::vector<SubPopulationStatistics> feasStats;
+        std::vector<SubPopulationStatistics> infeasStats;
+    };
+
+    using StoppingCriterion = std::function<bool(Value)>;
+    using ProgressCallback = std::function<void(Progress const &)>;
+
+private:
+    ProblemData const &data;
+    PenaltyManager penaltyManager_;
+    Population population;
+    XorShift128 &rng;
+    LocalSearch &localSearch;
+    std::vector<Solution> initialSolutions;
+    GeneticAlgorithmParams params;
+
+    std::optional<Solution> best;
+
+    [[nodiscard]] CostEvaluator const &costEvaluator() const;
+
+    // Generates an offspring from two parents selected from the population.
+    [[nodiscard]] Solution crossover();
+
+    // Runs the local search on the given solution: a search, optionally
+    // followed by an intensification. Mirrors LocalSearch.run in Python.
+    [[nodiscard]] Solution improve(Solution const &solution,
+                                   CostEvaluator const &costEvaluator,
+                                   bool shouldIntensify);
+
+    // Batch version of improve(), using the local search's batch methods.
+    [[nodiscard]] std::vector<Solution>
+    improveBatch(std::vector<Solution> const &solutions,
+                 CostEvaluator const &costEvaluator,
+                 std::vector<bool> const &shouldIntensify);
+
+    [[nodiscard]] bool isNewBest(Solution const &solution) const;
+
+    // Updates the best solution if the given solution is a new best, and then
+    // possibly intensifies it further. Returns the (possibly intensified)
+    // solution.
+    [[nodiscard]] Solution updateBest(Solution const &solution,
+                                      CostEvaluator const &costEvaluator);
+
+    void addAndRegister(Solution const &solution);
+
+    [[nodiscard]] bool shouldIntensify();
+
+    [[nodiscard]] bool shouldRepair(Solution const &solution);
+
+    // Improves the given offspring, and adds it to the population. Possibly
+    // also repairs it, if it is infeasible.
+    void search(Solution const &offspring);
+
+    // Same as search(), but improves and repairs all offspring in batches.
+    void searchBatch(std::vector<Solution> const &offspring);
+
+    [[nodiscard]] SubPopulationStatistics
+    collectFrom(SubPopulation const &subPop) const;
+
+public:
+    /**
+     * Creates the genetic algorithm. The algorithm keeps references to the
+     * given data, random number generator, and local search, which should thus
+     * outlive it.
+     *
+     * @throws std::invalid_argument When there are no initial solutions.
+     */
+    GeneticAlgorithm(ProblemData const &data,
+                     PenaltyParams const &penaltyParams,
+                     PopulationParams const &populationParams,
+                     XorShift128 &rng,
+                     LocalSearch &localSearch,
+                     std::vector<Solution> initialSolutions,
+                     GeneticAlgorithmParams params = GeneticAlgorithmParams());
+
+    /**
+     * Runs the genetic algorithm until the stopping criterion returns true.
+     * The stopping criterion is passed the cost of the best solution, and,
+     * like the progress callback, is only called once every
+     * <code>callbackInterval</code> iterations (starting before the first
+     * iteration). Criteria that count calls thus count blocks of that many
+     * iterations.
+     *
+     * @throws std::invalid_argument When the callback interval is zero.
+     */
+    Result run(StoppingCriterion const &stop,
+               ProgressCallback const &progress = {},
+               size_t callbackInterval = 1);
+
+    /**
+     * @return The penalty manager used by this algorithm.
+     */
+    [[nodiscard]] PenaltyManager const &penaltyManager() const;
+
+    /**
+     * @return The best solution found so far.
+     */
+    [[nodiscard]] Solution const &bestSolution() const;
+
+    /**
+     * Adds a solution found elsewhere (for example, by another algorithm
+     * instance) to the population, and updates the best solution if it is a
+     * new best. Unlike solutions found by this algorithm, immigrants are not
+     * registered with the penalty manager. This should only be called before
+     * or during a run, from the stopping criterion or progress callback.
+     */
+    void addImmigrant(Solution const &solution);
+};
+
+#endif  // PYVRP_GENETICALGORITHM_H
@@ -0,0 +1,146 @@
+#include "GeneticAlgorithm.h"
+#include "IslandModel.h"
+
+#include <pybind11/functional.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(_GeneticAlgorithm, m)
+{
+    py::class_<PenaltyParams>(m, "PenaltyParams")
+        .def(py::init<unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      size_t,
+                      double,
+                      double,
+                      double>(),
+             py::arg("init_weight_capacity_penalty") = 20,
+             py::arg("init_volume_capacity_penalty") = 20,
+             py::arg("init_salvage_penalty") = 20,
+             py::arg("init_stores_penalty") = 20,
+             py::arg("init_orders_penalty") = 20,
+             py::arg("init_sequence_penalty") = 1000,
+             py::arg("init_time_warp_penalty") = 6,
+             py::arg("repair_booster") = 12,
+             py::arg("num_registrations_between_penalty_updates") = 50,
+             py::arg("penalty_increase") = 1.34,
+             py::arg("penalty_decrease") = 0.32,
+             py::arg("target_feasible") = 0.43);
+
+    py::class_<GeneticAlgorithmParams>(m, "GeneticAlgorithmParams")
+        .def(py::init<double, bool, double, bool, size_t, size_t, size_t>(),
+             py::arg("repair_probability") = 0.80,
+             py::arg("collect_statistics") = false,
+             py::arg("intensify_probability") = 0.15,
+             py::arg("intensify_on_best") = true,
+             py::arg("nb_iter_no_improvement") = 20'000,
+             py::arg("batch_size") = 1,
+             py::arg("num_threads") = 0);
+
+    py::class_<GeneticAlgorithm::SubPopulationStatistics>(
+        m, "SubPopulationStatistics")
+        .def_readonly("size", &GeneticAlgorithm::SubPopulationStatistics::size)
+        .def_readonly("avg_diversity",
+                      &GeneticAlgorithm::SubPopulationStatistics::avgDiversity)
+        .def_readonly("best_cost",
+                      &GeneticAlgorithm::SubPopulationStatistics::bestCost)
+        .def_readonly("avg_cost",
+                      &GeneticAlgorithm::SubPopulationStatistics::avgCost)
+        .def_readonly("avg_num_routes",
+                      &GeneticAlgorithm::SubPopulationStatistics::avgNumRoutes);
+
+    py::class_<GeneticAlgorithm::Progress>(m, "Progress")
+        .def_readonly("num_iterations",
+                      &GeneticAlgorithm::Progress::numIterations)
+        .def_readonly("runtime", &GeneticAlgorithm::Progress::runtime)
+        .def_readonly("best_cost", &GeneticAlgorithm::Progress::bestCost)
+        .def_readonly("num_feasible", &GeneticAlgorithm::Progress::numFeasible)
+        .def_readonly("num_infeasible",
+                      &GeneticAlgorithm::Progress::numInfeasible);
+
+    py::class_<GeneticAlgorithm::Result>(m, "Result")
+        .def_readonly("best", &GeneticAlgorithm::Result::best)
+        .def_readonly("num_iterations",
+                      &GeneticAlgorithm::Result::numIterations)
+        .def_readonly("runtime", &GeneticAlgorithm::Result::runtime)
+        .def_readonly("runtimes", &GeneticAlgorithm::Result::runtimes)
+        .def_readonly("feas_stats", &GeneticAlgorithm::Result::feasStats)
+        .def_readonly("infeas_stats", &GeneticAlgorithm::Result::infeasStats);
+
+    py::class_<GeneticAlgorithm>(m, "GeneticAlgorithm")
+        .def(py::init<ProblemData const &,
+                      PenaltyParams const &,
+                      PopulationParams const &,
+                      XorShift128 &,
+                      LocalSearch &,
+                      std::vector<Solution>,
+                      GeneticAlgorithmParams>(),
+             py::arg("data"),
+             py::arg("penalty_params"),
+             py::arg("population_params"),
+             py::arg("rng"),
+             py::arg("local_search"),
+             py::arg("initial_solutions"),
+             py::arg("params") = GeneticAlgorithmParams(),
+             py::keep_alive<1, 2>(),  // keep data alive
+             py::keep_alive<1, 5>(),  // keep rng alive
+             py::keep_alive<1, 6>())  // keep local search alive
+        .def("run",
+             &GeneticAlgorithm::run,
+             py::arg("stop"),
+             py::arg("progress") = GeneticAlgorithm::ProgressCallback(),
+             py::arg("callback_interval") = 1,
+             py::call_guard<py::gil_scoped_release>())
+        .def(
+            "cost_evaluator",
+            [](GeneticAlgorithm const &algo) {
+                return algo.penaltyManager().costEvaluator();
+            },
+            py::return_value_policy::copy);
+
+    py::class_<IslandModelParams>(m, "IslandModelParams")
+        .def(py::init<size_t, size_t>(),
+             py::arg("num_islands") = 4,
+             py::arg("migration_interval") = 500);
+
+    py::class_<IslandModel::Result>(m, "IslandResult")
+        .def_readonly("best", &IslandModel::Result::best)
+        .def_readonly("num_iterations", &IslandModel::Result::numIterations)
+        .def_readonly("runtime", &IslandModel::Result::runtime)
+        .def_readonly("island_iterations",
+                      &IslandModel::Result::islandIterations);
+
+    py::class_<IslandModel>(m, "IslandModel")
+        .def(py::init<ProblemData const &,
+                      PenaltyParams const &,
+                      PopulationParams const &,
+                      XorShift128 &,
+                      LocalSearch &,
+                      std::vector<Solution> const &,
+                      GeneticAlgorithmParams const &,
+                      IslandModelParams>(),
+             py::arg("data"),
+             py::arg("penalty_params"),
+             py::arg("population_params"),
+             py::arg("rng"),
+             py::arg("local_search"),
+             py::arg("initial_solutions"),
+             py::arg("params") = GeneticAlgorithmParams(),
+             py::arg("island_params") = IslandModelParams(),
+             py::keep_alive<1, 2>(),  // keep data alive
+             py::keep_alive<1, 6>())  // keep local search alive
+        .def("run",
+             &IslandModel::run,
+             py::arg("stop"),
+             py::arg("callback_interval") = 1,
+             py::call_guard<py::gil_scoped_release>())
+        .def("num_islands", &IslandModel::numIslands);
+}
@@ -0,0 +1,323 @@
+#include "InstanceFile.h"
+#include "MappedFile.h"
+#include "SharedMemory.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+constexpr char MAGIC[8] = {'P', 'Y', 'V', 'R', 'P', 'I', 'N', 'S'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr size_t ALIGNMENT = 64;  // sections start at multiples of this
+
+// The matrices are stored as arrays of Value, and borrowed as arrays of
+// Distance and Duration. That only works if these measures are laid out
+// exactly like the value they wrap.
+static_assert(sizeof(Distance) == sizeof(Value));
+static_assert(sizeof(Duration) == sizeof(Value));
+static_assert(std::is_trivially_copyable_v<Distance>);
+static_assert(std::is_trivially_copyable_v<Duration>);
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;     // BYTE_ORDER_MARK, in the writer's byte order
+    uint32_t valueSize;     // sizeof(Value) of the writer
+    uint32_t valueIsFloat;  // whether Value is a floating point type
+    uint64_t numLocations;  // number of clients, including the depot
+    uint64_t numVehicles;
+    uint64_t clientsOffset;  // offsets of the sections, in bytes
+    uint64_t idsOffset;
+    uint64_t distOffset;
+    uint64_t durOffset;
+    uint64_t fileSize;
+    Value weightCapacity;
+    Value volumeCapacity;
+    Value salvageCapacity;
+    Value orderRouteLimit;
+    Value routeStoreLimit;
+};
+
+struct ClientRecord
+{
+    Value x;
+    Value y;
+    Value demandWeight;
+    Value demandVolume;
+    Value demandSalvage;
+    Value clientOrder;
+    Value clientStore;
+    Value serviceDuration;
+    Value twEarly;
+    Value twLate;
+    Value prize;
+    Value required;
+};
+
+size_t align(size_t offset)
+{
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+// Returns the header of an instance file with the given number of locations,
+// with all sizes and offsets filled in.
+Header makeHeader(size_t numLocations)
+{
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = INSTANCE_FILE_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.valueSize = sizeof(Value);
+    header.valueIsFloat = std::is_floating_point_v<Value>;
+    header.numLocations = numLocations;
+
+    auto const matrixSize = numLocations * numLocations * sizeof(Value);
+    header.clientsOffset = align(sizeof(Header));
+    header.idsOffset
+        = align(header.clientsOffset + numLocations * sizeof(ClientRecord));
+    header.distOffset
+        = align(header.idsOffset + numLocations * sizeof(int32_t));
+    header.durOffset = align(header.distOffset + matrixSize);
+    header.fileSize = header.durOffset + matrixSize;
+
+    return header;
+}
+
+[[noreturn]] void invalid(std::string const &reason)
+{
+    throw std::runtime_error("Invalid instance file: " + reason + ".");
+}
+
+// Checks that the given header describes a file that can be loaded by this
+// build, and that matches the given file size.
+void validate(Header const &header, size_t size)
+{
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        invalid("not a PyVRP instance file");
+
+    if (header.version != INSTANCE_FILE_VERSION)
+        invalid("unsupported version " + std::to_string(header.version)
+                + ", expected " + std::to_string(INSTANCE_FILE_VERSION));
+
+    if (header.byteOrder != BYTE_ORDER_MARK)
+        invalid("written on a machine with a different byte order");
+
+    if (header.valueSize != sizeof(Value)
+        || static_cast<bool>(header.valueIsFloat)
+               != std::is_floating_point_v<Value>)
+        invalid("written by a build with a different precision");
+
+    // The number of locations determines all offsets. We check it against the
+    // file size first, so that computing the offsets cannot overflow.
+    auto const numLocations = header.numLocations;
+    if (numLocations == 0 || numLocations > size / sizeof(ClientRecord)
+        || numLocations > size / sizeof(Value) / numLocations)
+        invalid("number of locations does not match the file size");
+
+    auto const expected = makeHeader(numLocations);
+    if (header.clientsOffset != expected.clientsOffset
+        || header.idsOffset != expected.idsOffset
+        || header.distOffset != expected.distOffset
+        || header.durOffset != expected.durOffset
+        || header.fileSize != expected.fileSize || header.fileSize != size)
+        invalid("section offsets do not match the file size");
+}
+
+// Returns the header of the instance file of the given data.
+Header makeHeader(ProblemData const &data)
+{
+    auto header = makeHeader(data.numClients() + 1);
+    header.numVehicles = data.numVehicles();
+    header.weightCapacity = data.weightCapacity().get();
+    header.volumeCapacity = data.volumeCapacity().get();
+    header.salvageCapacity = data.salvageCapacity().get();
+    header.orderRouteLimit = data.orderRouteLimit().get();
+    header.routeStoreLimit = data.routeStoreLimit().get();
+    return header;
+}
+
+// Serialises the given data in the instance format. The given function is
+// called with the offset, start and size of consecutive pieces of the
+// instance, in order of increasing offset. Gaps between pieces are padding.
+template <typename Write>
+void serialise(ProblemData const &data, Header const &header, Write &&write)
+{
+    auto const numLocations = header.numLocations;
+    write(0, &header, sizeof(Header));
+
+    for (size_t idx = 0; idx != numLocations; ++idx)
+    {
+        auto const &client = data.client(idx);
+        ClientRecord const record = {client.x.get(),
+                                     client.y.get(),
+                                     client.demandWeight.get(),
+                                     client.demandVolume.get(),
+                                     client.demandSalvage.get(),
+                                     client.clientOrder.get(),
+                                     client.clientStore.get(),
+                                     client.serviceDuration.get(),
+                                     client.twEarly.get(),
+                                     client.twLate.get(),
+                                     client.prize.get(),
+                                     static_cast<Value>(client.required)};
+
+        auto const offset = header.clientsOffset + idx * sizeof(ClientRecord);
+        write(offset, &record, sizeof(ClientRecord));
+    }
+
+    std::vector<int32_t> ids;
+    for (size_t idx = 0; idx != numLocations; ++idx)
+        ids.push_back(data.originalId(idx));
+
+    write(header.idsOffset, ids.data(), ids.size() * sizeof(int32_t));
+
+    // The matrices are written row by row, since they need not be stored
+    // densely in the problem data.
+    std::vector<Value> row(numLocations);
+    auto const rowSize = numLocations * sizeof(Value);
+
+    for (size_t from = 0; from != numLocations; ++from)
+    {
+        for (size_t to = 0; to != numLocations; ++to)
+            row[to] = data.dist(from, to).get();
+
+        write(header.distOffset + from * rowSize, row.data(), rowSize);
+    }
+
+    for (size_t from = 0; from != numLocations; ++from)
+    {
+        for (size_t to = 0; to != numLocations; ++to)
+            row[to] = data.duration(from, to).get();
+
+        write(header.durOffset + from * rowSize, row.data(), rowSize);
+    }
+}
+}  // namespace
+
+void writeInstance(ProblemData const &data, std::string const &path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Could not open " + path + " for writing.");
+
+    size_t position = 0;
+    auto const write = [&](size_t offset, void const *piece, size_t size) {
+        // Pads the output with zeroes, up to the piece's offset.
+        std::vector<char> const zeroes(offset - position, 0);
+        out.write(zeroes.data(), static_cast<std::streamsize>(zeroes.size()));
+        out.write(static_cast<char const *>(piece),
+                  static_cast<std::streamsize>(size));
+        position = offset + size;
+    };
+
+    serialise(data, makeHeader(data), write);
+
+    out.close();
+    if (!out)
+        throw std::runtime_error("Could not write " + path + ".");
+}
+
+std::shared_ptr<SharedMemory> publishInstance(ProblemData const &data,
+                                              std::string const &name)
+{
+    auto const header = makeHeader(data);
+    auto segment = std::make_shared<SharedMemory>(name, header.fileSize);
+
+    // The segment is zero-initialised, so the padding need not be written.
+    auto *begin = segment->data();
+    auto const write = [&](size_t offset, void const *piece, size_t size) {
+        std::memcpy(begin + offset, piece, size);
+    };
+
+    serialise(data, header, write);
+    return segment;
+}
+
+ProblemData attachInstance(std::string const &name)
+{
+    auto segment = std::make_shared<SharedMemory const>(name);
+    return loadInstance(segment->data(), segment->size(), segment);
+}
+
+ProblemData loadInstance(std::string const &path)
+{
+    auto file = std::make_shared<MappedFile const>(path);
+    return loadInstance(file->data(), file->size(), file);
+}
+
+ProblemData loadInstance(std::byte *begin,
+                         size_t size,
+                         std::shared_ptr<void const> owner)
+{
+    if (reinterpret_cast<uintptr_t>(begin) % ALIGNMENT != 0)
+        invalid("memory region is not aligned");
+
+    if (size < sizeof(Header))
+        invalid("too small to contain a header");
+
+    Header header;
+    std::memcpy(&header, begin, sizeof(Header));
+    validate(header, size);
+
+    auto const numLocations = header.numLocations;
+    auto const *records = reinterpret_cast<ClientRecord const *>(
+        begin + header.clientsOffset);
+
+    std::vector<ProblemData::Client> clients;
+    clients.reserve(numLocations);
+
+    for (size_t idx = 0; idx != numLocations; ++idx)
+    {
+        auto const &record = records[idx];
+        clients.emplace_back(record.x,
+                             record.y,
+                             record.demandWeight,
+                             record.demandVolume,
+                             record.demandSalvage,
+                             record.clientOrder,
+                             record.clientStore,
+                             record.serviceDuration,
+                             record.twEarly,
+                             record.twLate,
+                             record.prize,
+                             static_cast<bool>(record.required));
+    }
+
+    auto *dist = reinterpret_cast<Distance *>(begin + header.distOffset);
+    auto *dur = reinterpret_cast<Duration *>(begin + header.durOffset);
+
+    ProblemData data(clients,
+                     header.numVehicles,
+                     header.weightCapacity,
+                     header.volumeCapacity,
+                     header.salvageCapacity,
+                     header.orderRouteLimit,
+                     header.routeStoreLimit,
+                     Matrix<Distance>(numLocations, numLocations, dist, owner),
+                     Matrix<Duration>(numLocations, numLocations, dur, owner));
+
+    auto const *ids
+        = reinterpret_cast<int32_t const *>(begin + header.idsOffset);
+
+    bool isRenumbered = false;
+    for (size_t idx = 0; idx != numLocations; ++idx)
+        isRenumbered |= ids[idx] != static_cast<int32_t>(idx);
+
+    if (!isRenumbered)
+        return data;
+
+    // The copy shares the borrowed matrices, so this is cheap.
+    try
+    {
+        return data.withOriginalIds({ids, ids + numLocations});
+    }
+    catch (std::invalid_argument const &)
+    {
+        invalid("original ids are not a permutation");
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef PYVRP_INSTANCEFILE_H
+#define PYVRP_INSTANCEFILE_H
+
+#include "ProblemData.h"
+#include "SharedMemory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Version of the binary instance format written by writeInstance(). Files of
+ * other versions are rejected by loadInstance().
+ */
+constexpr uint32_t INSTANCE_FILE_VERSION = 2;
+
+/**
+ * Writes the given problem data to the given path, in PyVRP's binary instance
+ * format. The file consists of
+ * <ul>
+ * <li>a header with a magic string, the format version, a byte order mark,
+ *     the size and type of the stored values, the number of locations and
+ *     vehicles, the vehicle capacities and the order and store limits, and
+ *     the offsets of the sections below;</li>
+ * <li>the client table, with one fixed-size record per location (depot
+ *     first);</li>
+ * <li>the original id of each location, as 32-bit integers, which differ
+ *     from the location's index if the clients were renumbered;</li>
+ * <li>the distance matrix, and</li>
+ * <li>the duration matrix, both as dense arrays in row-major order.</li>
+ * </ul>
+ * Each section starts at an offset that is a multiple of 64 bytes. All values
+ * are stored in the native byte order and precision, so a file can only be
+ * loaded by a build with the same precision, on a machine with the same byte
+ * order.
+ *
+ * @throws std::runtime_error When the file cannot be written.
+ */
+void writeInstance(ProblemData const &data, std::string const &path);
+
+/**
+ * Loads the instance at the given path, which should have been written by
+ * writeInstance(). The file is mapped into memory, and the distance and
+ * duration matrices of the returned problem data borrow the mapped memory:
+ * they are not copied, and their pages are only read from disk once they are
+ * accessed. The file stays mapped for as long as the problem data, or a copy
+ * of one of its matrices, exists. If the clients were renumbered before the
+ * instance was written, the returned problem data has their original ids.
+ *
+ * @throws std::runtime_error When the file cannot be mapped, or is not a valid
+ *                            instance file of the current version, precision
+ *                            and byte order.
+ */
+ProblemData loadInstance(std::string const &path);
+
+/**
+ * Loads an instance in the binary instance format from the given memory
+ * region. The matrices of the returned problem data borrow the region, which
+ * must be aligned to at least 64 bytes. The owner keeps it alive.
+ *
+ * @throws std::runtime_error When the region does not contain a valid
+ *                            instance.
+ */
+ProblemData loadInstance(std::byte *begin,
+                         size_t size,
+                         std::shared_ptr<void const> owner);
+
+/**
+ * Publishes the given problem data in a new shared memory segment with the
+ * given name, in the binary instance format. Other processes can then attach
+ * to the instance with attachInstance(), without parsing the instance or
+ * copying its matrices. The segment is removed once the returned object is
+ * destroyed, but processes that attached before then can keep using it.
+ *
+ * @throws std::runtime_error When the segment cannot be created.
+ */
+std::shared_ptr<SharedMemory> publishInstance(ProblemData const &data,
+                                              std::string const &name);
+
+/**
+ * Attaches to the instance published under the given name. Like
+ * loadInstance(), the matrices of the returned problem data borrow the shared
+ * memory, which is shared by all attached processes until one of them writes
+ * to it. The segment stays attached for as long as the problem data, or a
+ * copy of one of its matrices, exists.
+ *
+ * @throws std::runtime_error When there is no such segment, or when it does
+ *                            not contain a valid instance.
+ */
+ProblemData attachInstance(std::string const &name);
+
+#endif  // PYVRP_INSTANCEFILE_H
@@ -0,0 +1,47 @@
+#include "InstanceFile.h"
+#include "SharedMemory.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl/filesystem.h>
+
+#include <filesystem>
+#include <memory>
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(_InstanceFile, m)
+{
+    m.attr("INSTANCE_FILE_VERSION") = INSTANCE_FILE_VERSION;
+
+    m.def(
+        "write_instance",
+        [](ProblemData const &data, std::filesystem::path const &path) {
+            writeInstance(data, path.string());
+        },
+        py::arg("data"),
+        py::arg("where"),
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def(
+        "load_instance",
+        [](std::filesystem::path const &path) {
+            return loadInstance(path.string());
+        },
+        py::arg("where"),
+        py::call_guard<py::gil_scoped_release>());
+
+    py::class_<SharedMemory, std::shared_ptr<SharedMemory>>(m, "SharedMemory")
+        .def_property_readonly("name", &SharedMemory::name)
+        .def_property_readonly("size", &SharedMemory::size);
+
+    m.def("publish_instance",
+          &publishInstance,
+          py::arg("data"),
+          py::arg("name"),
+          py::call_guard<py::gil_scoped_release>());
+
+    m.def("attach_instance",
+          &attachInstance,
+          py::arg("name"),
+          py::call_guard<py::gil_scoped_release>());
+}
@@ -0,0 +1,203 @@
+#include "IslandModel.h"
+
+#include <chrono>
+#include <exception>
+#include <thread>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+}  // namespace
+
+IslandModel::Mailbox::~Mailbox() { delete slot.load(); }
+
+void IslandModel::Mailbox::send(Solution const &solution)
+{
+    // Any message that was not yet received is outdated, so we drop it.
+    delete slot.exchange(new Solution(solution), std::memory_order_acq_rel);
+}
+
+std::unique_ptr<Solution> IslandModel::Mailbox::receive()
+{
+    return std::unique_ptr<Solution>(
+        slot.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+IslandModel::Island::Island(ProblemData const &data,
+                            PenaltyParams const &penaltyParams,
+                            PopulationParams const &populationParams,
+                            uint32_t seed,
+                            std::unique_ptr<LocalSearch> localSearch,
+                            std::vector<Solution> const &initialSolutions,
+                            GeneticAlgorithmParams const &params)
+    : rng(seed),
+      localSearch(std::move(localSearch)),
+      algo(data,
+           penaltyParams,
+           populationParams,
+           rng,
+           *this->localSearch,
+           initialSolutions,
+           params),
+      lastSentCost(algo.penaltyManager().costEvaluator().cost(
+          algo.bestSolution()))
+{
+}
+
+IslandModel::IslandModel(ProblemData const &data,
+                         PenaltyParams const &penaltyParams,
+                         PopulationParams const &populationParams,
+                         XorShift128 &rng,
+                         LocalSearch &localSearch,
+                         std::vector<Solution> const &initialSolutions,
+                         GeneticAlgorithmParams const &gaParams,
+                         IslandModelParams params)
+    : localSearch(localSearch), params(params)
+{
+    islands.reserve(params.numIslands);
+
+    for (size_t idx = 0; idx != params.numIslands; ++idx)
+        islands.emplace_back(std::make_unique<Island>(data,
+                                                      penaltyParams,
+                                                      populationParams,
+                                                      rng(),
+                                                      localSearch.clone(),
+                                                      initialSolutions,
+                                                      gaParams));
+
+    // All islands start from the same initial solutions, and thus have the
+    // same initial best solution.
+    auto const &island = *islands.front();
+    best.emplace(island.algo.bestSolution());
+    bestCost = island.lastSentCost.get();
+}
+
+IslandModel::Result IslandModel::run(StoppingCriterion const &stop,
+                                     size_t callbackInterval)
+{
+    if (callbackInterval == 0)
+        throw std::invalid_argument("callback_interval < 1 not understood.");
+
+    auto const start = Clock::now();
+
+    std::atomic<bool> shouldStop = false;
+    std::vector<std::optional<GeneticAlgorithm::Result>> results(
+        islands.size());
+    std::vector<std::exception_ptr> errors(islands.size());
+
+    auto work = [&](size_t idx) {
+        auto &island = *islands[idx];
+        size_t iters = 0;
+
+        // The island's algorithm calls this before every iteration. This is
+        // where islands migrate, offer their best solution, and where the
+        // first island checks the user's stopping criterion.
+        auto const islandStop = [&](Value) {
+            if (iters != 0 && iters % params.migrationInterval == 0)
+                migrate(idx);
+
+            auto const &penaltyManager = island.algo.penaltyManager();
+            auto const &islandBest = island.algo.bestSolution();
+            offer(islandBest, penaltyManager.costEvaluator().cost(islandBest));
+
+            if (idx == 0 && iters % callbackInterval == 0
+                && stop(bestCost.load()))
+                shouldStop = true;
+
+            iters++;
+            return shouldStop.load(std::memory_order_relaxed);
+        };
+
+        try
+        {
+            results[idx].emplace(island.algo.run(islandStop));
+        }
+        catch (...)
+        {
+            errors[idx] = std::current_exception();
+            shouldStop = true;  // stops the other islands early
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(islands.size() - 1);
+
+        try
+        {
+            for (size_t idx = 1; idx != islands.size(); ++idx)
+                threads.emplace_back(work, idx);
+        }
+        catch (...)
+        {
+            // The islands that did start would otherwise never stop, and we
+            // would wait on them forever when the threads are joined.
+            shouldStop = true;
+            throw;
+        }
+
+        work(0);  // the calling thread runs the first island
+    }             // all threads are joined here
+
+    for (auto const &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    localSearch.resetStatistics();
+    for (auto const &island : islands)
+        localSearch.addStatistics(*island->localSearch);
+
+    size_t numIterations = 0;
+    std::vector<size_t> islandIterations;
+    islandIterations.reserve(islands.size());
+
+    for (auto const &result : results)
+    {
+        numIterations += result->numIterations;
+        islandIterations.push_back(result->numIterations);
+    }
+
+    auto const runtime
+        = std::chrono::duration<double>(Clock::now() - start).count();
+
+    return {*best, numIterations, runtime, std::move(islandIterations)};
+}
+
+size_t IslandModel::numIslands() const { return islands.size(); }
+
+void IslandModel::migrate(size_t island)
+{
+    auto &from = *islands[island];
+
+    if (islands.size() > 1)
+    {
+        auto &to = *islands[(island + 1) % islands.size()];
+        auto const &costEvaluator = from.algo.penaltyManager().costEvaluator();
+        auto const &islandBest = from.algo.bestSolution();
+        auto const cost = costEvaluator.cost(islandBest);
+
+        // Only send solutions the next island has not yet seen from us.
+        if (cost < from.lastSentCost)
+        {
+            to.inbox.send(islandBest);
+            from.lastSentCost = cost;
+        }
+    }
+
+    if (auto const immigrant = from.inbox.receive())
+        from.algo.addImmigrant(*immigrant);
+}
+
+void IslandModel::offer(Solution const &solution, Cost cost)
+{
+    if (cost.get() >= bestCost.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard const lock(bestMutex);
+
+    if (cost.get() < bestCost.load(std::memory_order_relaxed))
+    {
+        best.emplace(solution);
+        bestCost = cost.get();
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef PYVRP_ISLANDMODEL_H
+#define PYVRP_ISLANDMODEL_H
+
+#include "GeneticAlgorithm.h"
+#include "Measure.h"
+#include "PenaltyManager.h"
+#include "ProblemData.h"
+#include "Solution.h"
+#include "SubPopulation.h"
+#include "XorShift128.h"
+#include "search/LocalSearch.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Island model parameters. See the Python <code>IslandModelParams</code> class
+ * for a description of each parameter.
+ */
+struct IslandModelParams
+{
+    size_t numIslands;
+    size_t migrationInterval;
+
+    IslandModelParams(size_t numIslands = 4, size_t migrationInterval = 500)
+        : numIslands(numIslands), migrationInterval(migrationInterval)
+    {
+        if (numIslands == 0)
+            throw std::invalid_argument("num_islands < 1 not understood.");
+
+        if (migrationInterval == 0)
+        {
+            auto const msg = "migration_interval < 1 not understood.";
+            throw std::invalid_argument(msg);
+        }
+    }
+};
+
+/**
+ * Island model around the native genetic algorithm. Each island is an
+ * independent genetic algorithm with its own population, penalty manager,
+ * random number stream, and local search, and runs on its own thread. The
+ * islands are arranged in a ring: every so many iterations, each island sends
+ * its best solution to the next island, if that solution improved since the
+ * previous migration. The best solution over all islands is tracked as well.
+ */
+class IslandModel
+{
+public:
+    /**
+     * Outcome of a single run.
+     */
+    struct Result
+    {
+        Solution best;
+        size_t numIterations;  // summed over all islands
+        double runtime;        // in seconds
+        std::vector<size_t> islandIterations;
+    };
+
+    using StoppingCriterion = GeneticAlgorithm::StoppingCriterion;
+
+private:
+    // Single-slot mailbox that can be used without locks. A newer message
+    // replaces an older one that has not yet been received; only the most
+    // recent best solution matters to the receiving island anyway.
+    class Mailbox
+    {
+        std::atomic<Solution *> slot = nullptr;
+
+    public:
+        ~Mailbox();
+
+        void send(Solution const &solution);
+
+        [[nodiscard]] std::unique_ptr<Solution> receive();
+    };
+
+    struct Island
+    {
+        XorShift128 rng;
+        std::unique_ptr<LocalSearch> localSearch;
+        GeneticAlgorithm algo;
+        Mailbox inbox;
+
+        Cost lastSentCost;
+
+        Island(ProblemData const &data,
+               PenaltyParams const &penaltyParams,
+               PopulationParams const &populationParams,
+               uint32_t seed,
+               std::unique_ptr<LocalSearch> localSearch,
+               std::vector<Solution> const &initialSolutions,
+               GeneticAlgorithmParams const &params);
+    };
+
+    LocalSearch &localSearch;
+    IslandModelParams params;
+    std::vector<std::unique_ptr<Island>> islands;
+
+    // Best solution over all islands. The cost is also stored separately, so
+    // islands can cheaply check whether they have a new best solution without
+    // taking the lock.
+    std::mutex bestMutex;
+    std::optional<Solution> best;
+    std::atomic<Value> bestCost;
+
+    // Sends the island's best solution to the next island in the ring, and
+    // adds any solution it has received itself to its population.
+    void migrate(size_t island);
+
+    // Updates the best solution if the given solution is better.
+    void offer(Solution const &solution, Cost cost);
+
+public:
+    /**
+     * Creates the island model. Each island gets its own random number
+     * generator, seeded from the given one, and a clone of the given local
+     * search; operators added to the local search afterwards are thus not
+     * used by the islands. All islands start from the same initial solutions.
+     * The island model keeps a reference to the given data and local search,
+     * which should thus outlive it.
+     *
+     * @throws std::invalid_argument When there are no initial solutions.
+     */
+    IslandModel(ProblemData const &data,
+                PenaltyParams const &penaltyParams,
+                PopulationParams const &populationParams,
+                XorShift128 &rng,
+                LocalSearch &localSearch,
+                std::vector<Solution> const &initialSolutions,
+                GeneticAlgorithmParams const &gaParams
+                = GeneticAlgorithmParams(),
+                IslandModelParams params = IslandModelParams());
+
+    /**
+     * Runs all islands until the stopping criterion returns true. The first
+     * island runs on the calling thread, and calls the stopping criterion with
+     * the cost of the best solution over all islands, once every
+     * <code>callbackInterval</code> of its iterations. The other islands each
+     * run on their own thread, and stop once the first island stops. The
+     * statistics of the islands' local searches are afterwards collected into
+     * the local search passed to the constructor.
+     *
+     * @throws std::invalid_argument When the callback interval is zero.
+     */
+    Result run(StoppingCriterion const &stop, size_t callbackInterval = 1);
+
+    /**
+     * @return The number of islands.
+     */
+    [[nodiscard]] size_t numIslands() const;
+};
+
+#endif  // PYVRP_ISLANDMODEL_H
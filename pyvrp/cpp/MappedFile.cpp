@@ -0,0 +1,134 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+int lastError() { return static_cast<int>(GetLastError()); }
+#else
+int lastError() { return errno; }
+#endif
+
+// Throws an error for the given operation on the given path. The error code
+// must be retrieved before cleaning up, since cleaning up may overwrite it.
+[[noreturn]] void
+fail(std::string const &what, std::string const &path, int error)
+{
+#ifdef _WIN32
+    auto const reason = "error code " + std::to_string(error);
+#else
+    std::string const reason = std::strerror(error);
+#endif
+    throw std::runtime_error(what + " " + path + ": " + reason + ".");
+}
+}  // namespace
+
+std::byte *MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+#ifdef _WIN32
+MappedFile::MappedFile(std::string const &path)
+{
+    auto *file = CreateFileA(path.c_str(),
+                             GENERIC_READ,
+                             FILE_SHARE_READ,
+                             nullptr,
+                             OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL,
+                             nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        fail("Could not open", path, lastError());
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        auto const error = lastError();
+        CloseHandle(file);
+        fail("Could not determine the size of", path, error);
+    }
+
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ == 0)  // empty files cannot be mapped, but there is no need to
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    auto *mapping
+        = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    auto error = lastError();
+    CloseHandle(file);  // the mapping keeps the file open
+
+    if (!mapping)
+        fail("Could not map", path, error);
+
+    auto *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    error = lastError();
+    CloseHandle(mapping);  // the view keeps the mapping alive
+
+    if (!view)
+        fail("Could not map", path, error);
+
+    data_ = static_cast<std::byte *>(view);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+}
+#else
+MappedFile::MappedFile(std::string const &path)
+{
+    auto const fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        fail("Could not open", path, lastError());
+
+    struct stat info;
+    if (fstat(fd, &info) == -1)
+    {
+        auto const error = lastError();
+        close(fd);
+        fail("Could not determine the size of", path, error);
+    }
+
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0)  // empty files cannot be mapped, but there is no need to
+    {
+        close(fd);
+        return;
+    }
+
+    auto *addr
+        = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    auto const error = lastError();
+    close(fd);  // the mapping keeps the file open
+
+    if (addr == MAP_FAILED)
+        fail("Could not map", path, error);
+
+    data_ = static_cast<std::byte *>(addr);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        munmap(data_, size_);
+}
+#endif
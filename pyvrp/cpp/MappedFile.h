@@ -0,0 +1,45 @@
+#ifndef PYVRP_MAPPEDFILE_H
+#define PYVRP_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A whole file, mapped into memory. The operating system loads pages of the
+ * file lazily, when they are first accessed, and pages can be shared between
+ * all processes that map the same file. The mapping is copy-on-write: writes
+ * to the mapped memory are private to this mapping, and never reach the file.
+ * The file is unmapped when this object is destroyed.
+ */
+class MappedFile
+{
+    std::byte *data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    /**
+     * @return Pointer to the start of the mapped file. This is aligned to (at
+     *         least) the page size. Null if the file is empty.
+     */
+    [[nodiscard]] std::byte *data() const;
+
+    /**
+     * @return Size of the mapped file, in bytes.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * Maps the file at the given path into memory.
+     *
+     * @throws std::runtime_error When the file cannot be opened or mapped.
+     */
+    explicit MappedFile(std::string const &path);
+
+    MappedFile(MappedFile const &other) = delete;
+
+    MappedFile &operator=(MappedFile const &other) = delete;
+
+    ~MappedFile();
+};
+
+#endif  // PYVRP_MAPPEDFILE_H
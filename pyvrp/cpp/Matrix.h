@@ -2,15 +2,21 @@
 #define PYVRP_MATRIX_H
 
 #include <algorithm>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 template <typename T> class Matrix
 {
-    size_t cols_;          // The number of columns of the matrix
-    size_t rows_;          // The number of rows of the matrix
-    std::vector<T> data_;  // Data vector
+    size_t cols_;           // The number of columns of the matrix
+    size_t rows_;           // The number of rows of the matrix
+    std::vector<T> owned_;  // Data vector, if the matrix owns its data
+
+    // Keeps borrowed data alive, if the matrix does not own its data.
+    std::shared_ptr<void const> owner_;
+    T *data_;  // Matrix elements, either owned_ or borrowed, in row-major order
 
 public:
     /**
@@ -36,6 +42,32 @@ public:
      */
     explicit Matrix(std::vector<std::vector<T>> const &data);
 
+    /**
+     * Creates a matrix of size nRows * nCols over the given data, which is
+     * stored in row-major order. The data is not copied: the matrix borrows
+     * it, and the given owner keeps it alive for as long as the matrix (or any
+     * copy of it) exists. Copies of a borrowing matrix share its data.
+     *
+     * @param nRows Number of rows.
+     * @param nCols Number of columns.
+     * @param data  Pointer to the first of nRows * nCols elements.
+     * @param owner Owner of the data.
+     *
+     * @throws std::invalid_argument When the owner or data is null.
+     */
+    Matrix(size_t nRows,
+           size_t nCols,
+           T *data,
+           std::shared_ptr<void const> owner);
+
+    Matrix(Matrix const &other);
+
+    Matrix(Matrix &&other) = default;
+
+    Matrix &operator=(Matrix const &other);
+
+    Matrix &operator=(Matrix &&other) = default;
+
     [[nodiscard]] decltype(auto) operator()(size_t row, size_t col);
 
     [[nodiscard]] decltype(auto) operator()(size_t row, size_t col) const;
@@ -44,6 +76,21 @@ public:
 
     [[nodiscard]] size_t numRows() const;
 
+    /**
+     * @return Pointer to the matrix elements, in row-major order.
+     */
+    [[nodiscard]] T *data();
+
+    /**
+     * @return Pointer to the matrix elements, in row-major order.
+     */
+    [[nodiscard]] T const *data() const;
+
+    /**
+     * @return True if this matrix borrows its data, false if it owns it.
+     */
+    [[nodiscard]] bool isBorrowed() const;
+
     /**
      * @return Maximum element in the matrix.
      */
@@ -56,17 +103,54 @@ public:
 };
 
 template <typename T>
-Matrix<T>::Matrix(size_t dimension)
-    : cols_(dimension), rows_(dimension), data_(dimension * dimension)
+Matrix<T>::Matrix(size_t dimension) : Matrix(dimension, dimension)
 {
 }
 
 template <typename T>
 Matrix<T>::Matrix(size_t nRows, size_t nCols)
-    : cols_(nCols), rows_(nRows), data_(nRows * nCols)
+    : cols_(nCols), rows_(nRows), owned_(nRows * nCols), data_(owned_.data())
 {
 }
 
+template <typename T>
+Matrix<T>::Matrix(size_t nRows,
+                  size_t nCols,
+                  T *data,
+                  std::shared_ptr<void const> owner)
+    : cols_(nCols), rows_(nRows), owner_(std::move(owner)), data_(data)
+{
+    if (!owner_)
+        throw std::invalid_argument("Borrowed data must have an owner.");
+
+    if (!data_ && nRows * nCols != 0)
+        throw std::invalid_argument("Borrowed data must not be null.");
+}
+
+template <typename T>
+Matrix<T>::Matrix(Matrix const &other)
+    : cols_(other.cols_),
+      rows_(other.rows_),
+      owned_(other.owned_),
+      owner_(other.owner_),
+      data_(other.isBorrowed() ? other.data_ : owned_.data())
+{
+}
+
+template <typename T> Matrix<T> &Matrix<T>::operator=(Matrix const &other)
+{
+    if (this != &other)
+    {
+        cols_ = other.cols_;
+        rows_ = other.rows_;
+        owned_ = other.owned_;
+        owner_ = other.owner_;
+        data_ = other.isBorrowed() ? other.data_ : owned_.data();
+    }
+
+    return *this;
+}
+
 template <typename T>
 Matrix<T>::Matrix(std::vector<std::vector<T>> const &data)
     : Matrix(data.size(), data.empty() ? 0 : data[0].size())
@@ -103,11 +187,20 @@ template <typename T> size_t Matrix<T>::numCols() const { return cols_; }
 
 template <typename T> size_t Matrix<T>::numRows() const { return rows_; }
 
+template <typename T> T *Matrix<T>::data() { return data_; }
+
+template <typename T> T const *Matrix<T>::data() const { return data_; }
+
+template <typename T> bool Matrix<T>::isBorrowed() const
+{
+    return owner_ != nullptr;
+}
+
 template <typename T> T Matrix<T>::max() const
 {
-    return *std::max_element(data_.begin(), data_.end());
+    return *std::max_element(data_, data_ + size());
 }
 
-template <typename T> size_t Matrix<T>::size() const { return data_.size(); }
+template <typename T> size_t Matrix<T>::size() const { return rows_ * cols_; }
 
 #endif  // PYVRP_MATRIX_H
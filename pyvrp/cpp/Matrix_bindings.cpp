@@ -1,4 +1,5 @@
 #include "Matrix.h"
+#include "NumpyMatrix.h"
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -7,10 +8,14 @@ namespace py = pybind11;
 
 PYBIND11_MODULE(_Matrix, m)
 {
-    py::class_<Matrix<int>>(m, "Matrix")
+    py::class_<Matrix<int>>(m, "Matrix", py::buffer_protocol())
         .def(py::init<size_t>(), py::arg("dimension"))
         .def(py::init<size_t, size_t>(), py::arg("n_rows"), py::arg("n_cols"))
-        .def(py::init<std::vector<std::vector<int>>>(), py::arg("data"))
+        .def(py::init([](py::object const &data) {
+                 return matrixFromArray<int, int>(data, true);
+             }),
+             py::arg("data"))
+        .def_buffer(&matrixBuffer<int, int>)
         .def_property_readonly("num_cols", &Matrix<int>::numCols)
         .def_property_readonly("num_rows", &Matrix<int>::numRows)
         .def(
@@ -23,7 +23,8 @@ enum class MeasureType
     LOAD,
     SALVAGE,
     ORDER,
-    STORE
+    STORE,
+    SEQUENCE
 };
 
 // Forward declaration so we can define the relevant type aliases early.
@@ -38,6 +39,7 @@ using Load = Measure<MeasureType::LOAD>;
 using Salvage = Measure<MeasureType::SALVAGE>;
 using Order = Measure<MeasureType::ORDER>;
 using Store = Measure<MeasureType::STORE>;
+using Sequence = Measure<MeasureType::SEQUENCE>;
 
 //
 //                 EVERYTHING BELOW THIS IS IMPLEMENTATION
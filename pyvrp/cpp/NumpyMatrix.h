@@ -0,0 +1,83 @@
+#ifndef PYVRP_NUMPYMATRIX_H
+#define PYVRP_NUMPYMATRIX_H
+
+#include "Matrix.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Creates a matrix over the elements of the given two-dimensional array-like
+ * Python object. A C-contiguous NumPy array (or other buffer) with elements of
+ * type V is not copied: the matrix borrows its memory, and keeps the array
+ * alive. Anything else, including lists of lists, is first converted to such
+ * an array, which the matrix then adopts.
+ *
+ * Type T must be laid out exactly like V, so that e.g. Matrix<Distance> can
+ * borrow an array of Value. When writeable is set, read-only arrays are copied
+ * so that the matrix can be modified.
+ *
+ * @throws std::invalid_argument When the data cannot be converted to a
+ *                               two-dimensional array of V.
+ */
+template <typename T, typename V>
+Matrix<T> matrixFromArray(pybind11::object const &data, bool writeable)
+{
+    namespace py = pybind11;
+    using Array = py::array_t<V, py::array::c_style | py::array::forcecast>;
+
+    static_assert(sizeof(T) == sizeof(V) && alignof(T) == alignof(V));
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    auto array = Array::ensure(data);  // no-op if already an array of V
+    if (!array || array.ndim() != 2)
+        throw std::invalid_argument("Expected a two-dimensional array.");
+
+    if (writeable && !array.writeable())
+        array = Array::ensure(array.attr("copy")());
+
+    // The owner releases its reference to the array when the last matrix that
+    // borrows it is destroyed. That can happen without holding the GIL, so the
+    // deleter acquires it.
+    std::shared_ptr<void const> owner(new py::object(array),
+                                      [](py::object *ref) {
+                                          py::gil_scoped_acquire gil;
+                                          delete ref;
+                                      });
+
+    // The array may be read-only here, but then the matrix is only read: when
+    // it should be writeable, a read-only array is copied above.
+    auto *elements = reinterpret_cast<T *>(const_cast<V *>(array.data()));
+    auto const nRows = static_cast<size_t>(array.shape(0));
+    auto const nCols = static_cast<size_t>(array.shape(1));
+
+    return Matrix<T>(nRows, nCols, elements, std::move(owner));
+}
+
+/**
+ * Describes the elements of the given matrix as a two-dimensional, row-major
+ * buffer of type V, for the buffer protocol.
+ */
+template <typename V, typename T>
+pybind11::buffer_info matrixBuffer(Matrix<T> &matrix)
+{
+    namespace py = pybind11;
+
+    auto const nRows = static_cast<py::ssize_t>(matrix.numRows());
+    auto const nCols = static_cast<py::ssize_t>(matrix.numCols());
+    auto const itemSize = static_cast<py::ssize_t>(sizeof(V));
+
+    return py::buffer_info(reinterpret_cast<V *>(matrix.data()),
+                           itemSize,
+                           py::format_descriptor<V>::format(),
+                           2,
+                           {nRows, nCols},
+                           {itemSize * nCols, itemSize});
+}
+
+#endif  // PYVRP_NUMPYMATRIX_H
@@ -0,0 +1,104 @@
+#include "PenaltyManager.h"
+
+#include <algorithm>
+
+PenaltyManager::PenaltyManager(PenaltyParams params)
+    : params(params),
+      weightCapacity({params.initWeightCapacityPenalty}),
+      volumeCapacity({params.initVolumeCapacityPenalty}),
+      salvage({params.initSalvagePenalty}),
+      timeWarp({params.initTimeWarpPenalty}),
+      storesPenalty(params.initStoresPenalty),
+      ordersPenalty(params.initOrdersPenalty),
+      sequencePenalty(params.initSequencePenalty),
+      costEvaluator_(0, 0, 0, 0, 0, 0, 0),
+      boosterCostEvaluator_(0, 0, 0, 0, 0, 0, 0)
+{
+    updateCostEvaluators();
+}
+
+void PenaltyManager::updateCostEvaluators()
+{
+    costEvaluator_ = {weightCapacity.value,
+                      volumeCapacity.value,
+                      salvage.value,
+                      storesPenalty,
+                      ordersPenalty,
+                      sequencePenalty,
+                      timeWarp.value};
+
+    auto const booster = params.repairBooster;
+    boosterCostEvaluator_ = {weightCapacity.value * booster,
+                             volumeCapacity.value * booster,
+                             salvage.value * booster,
+                             storesPenalty * booster,
+                             ordersPenalty * booster,
+                             sequencePenalty * booster,
+                             timeWarp.value * booster};
+}
+
+unsigned int PenaltyManager::compute(unsigned int penalty,
+                                     double feasPercentage) const
+{
+    auto const diff = params.targetFeasible - feasPercentage;
+
+    if (-0.05 < diff && diff < 0.05)
+        return penalty;
+
+    // +- 1 to ensure we do not get stuck at the same integer values, bounded
+    // to [1, 1000] to avoid overflow in cost computations.
+    auto const newPenalty
+        = diff > 0 ? std::min(params.penaltyIncrease * penalty + 1, 1000.0)
+                   : std::max(params.penaltyDecrease * penalty - 1, 1.0);
+
+    return static_cast<unsigned int>(newPenalty);
+}
+
+void PenaltyManager::registerFeasible(Penalty &penalty, bool isFeasible)
+{
+    penalty.numRegistrations++;
+    penalty.numFeasible += isFeasible;
+
+    if (penalty.numRegistrations
+        == params.numRegistrationsBetweenPenaltyUpdates)
+    {
+        auto const avg = static_cast<double>(penalty.numFeasible)
+                         / static_cast<double>(penalty.numRegistrations);
+
+        penalty.value = compute(penalty.value, avg);
+        penalty.numRegistrations = 0;
+        penalty.numFeasible = 0;
+
+        updateCostEvaluators();
+    }
+}
+
+void PenaltyManager::registerWeightFeasible(bool isWeightFeasible)
+{
+    registerFeasible(weightCapacity, isWeightFeasible);
+}
+
+void PenaltyManager::registerVolumeFeasible(bool isVolumeFeasible)
+{
+    registerFeasible(volumeCapacity, isVolumeFeasible);
+}
+
+void PenaltyManager::registerSalvageFeasible(bool isSalvageFeasible)
+{
+    registerFeasible(salvage, isSalvageFeasible);
+}
+
+void PenaltyManager::registerTimeFeasible(bool isTimeFeasible)
+{
+    registerFeasible(timeWarp, isTimeFeasible);
+}
+
+CostEvaluator const &PenaltyManager::costEvaluator() const
+{
+    return costEvaluator_;
+}
+
+CostEvaluator const &PenaltyManager::boosterCostEvaluator() const
+{
+    return boosterCostEvaluator_;
+}
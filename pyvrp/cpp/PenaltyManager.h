@@ -0,0 +1,144 @@
+#ifndef PYVRP_PENALTYMANAGER_H
+#define PYVRP_PENALTYMANAGER_H
+
+#include "CostEvaluator.h"
+
+#include <stdexcept>
+
+/**
+ * Penalty manager parameters. See the Python <code>PenaltyParams</code> class
+ * for a description of each parameter.
+ */
+struct PenaltyParams
+{
+    unsigned int initWeightCapacityPenalty;
+    unsigned int initVolumeCapacityPenalty;
+    unsigned int initSalvagePenalty;
+    unsigned int initStoresPenalty;
+    unsigned int initOrdersPenalty;
+    unsigned int initSequencePenalty;
+    unsigned int initTimeWarpPenalty;
+    unsigned int repairBooster;
+    size_t numRegistrationsBetweenPenaltyUpdates;
+    double penaltyIncrease;
+    double penaltyDecrease;
+    double targetFeasible;
+
+    PenaltyParams(unsigned int initWeightCapacityPenalty = 20,
+                  unsigned int initVolumeCapacityPenalty = 20,
+                  unsigned int initSalvagePenalty = 20,
+                  unsigned int initStoresPenalty = 20,
+                  unsigned int initOrdersPenalty = 20,
+                  unsigned int initSequencePenalty = 1000,
+                  unsigned int initTimeWarpPenalty = 6,
+                  unsigned int repairBooster = 12,
+                  size_t numRegistrationsBetweenPenaltyUpdates = 50,
+                  double penaltyIncrease = 1.34,
+                  double penaltyDecrease = 0.32,
+                  double targetFeasible = 0.43)
+        : initWeightCapacityPenalty(initWeightCapacityPenalty),
+          initVolumeCapacityPenalty(initVolumeCapacityPenalty),
+          initSalvagePenalty(initSalvagePenalty),
+          initStoresPenalty(initStoresPenalty),
+          initOrdersPenalty(initOrdersPenalty),
+          initSequencePenalty(initSequencePenalty),
+          initTimeWarpPenalty(initTimeWarpPenalty),
+          repairBooster(repairBooster),
+          numRegistrationsBetweenPenaltyUpdates(
+              numRegistrationsBetweenPenaltyUpdates),
+          penaltyIncrease(penaltyIncrease),
+          penaltyDecrease(penaltyDecrease),
+          targetFeasible(targetFeasible)
+    {
+        if (penaltyIncrease < 1)
+            throw std::invalid_argument("Expected penalty_increase >= 1.");
+
+        if (penaltyDecrease < 0 || penaltyDecrease > 1)
+            throw std::invalid_argument("Expected penalty_decrease in [0, 1].");
+
+        if (targetFeasible < 0 || targetFeasible > 1)
+            throw std::invalid_argument("Expected target_feasible in [0, 1].");
+
+        if (repairBooster < 1)
+            throw std::invalid_argument("Expected repair_booster >= 1.");
+    }
+};
+
+/**
+ * Native counterpart of the Python <code>PenaltyManager</code>, used by the
+ * native genetic algorithm. It manages the penalty terms, and updates these
+ * based on recent feasibility registrations, in exactly the same way. Rather
+ * than storing recent registrations, it only counts them.
+ */
+class PenaltyManager
+{
+    // Tracks recent feasibility registrations of a single constraint, and
+    // the corresponding penalty value.
+    struct Penalty
+    {
+        unsigned int value;
+        size_t numRegistrations = 0;
+        size_t numFeasible = 0;
+    };
+
+    PenaltyParams params;
+
+    Penalty weightCapacity;
+    Penalty volumeCapacity;
+    Penalty salvage;
+    Penalty timeWarp;
+
+    unsigned int storesPenalty;
+    unsigned int ordersPenalty;
+    unsigned int sequencePenalty;
+
+    CostEvaluator costEvaluator_;
+    CostEvaluator boosterCostEvaluator_;
+
+    // Recomputes both cost evaluators from the current penalty values.
+    void updateCostEvaluators();
+
+    // Computes the new penalty value, given the current value and the
+    // fraction of feasible registrations since the last update.
+    [[nodiscard]] unsigned int compute(unsigned int penalty,
+                                       double feasPercentage) const;
+
+    // Registers the given feasibility result, and updates the penalty value
+    // once sufficiently many results have been gathered.
+    void registerFeasible(Penalty &penalty, bool isFeasible);
+
+public:
+    explicit PenaltyManager(PenaltyParams params = PenaltyParams());
+
+    /**
+     * Registers another weight capacity feasibility result.
+     */
+    void registerWeightFeasible(bool isWeightFeasible);
+
+    /**
+     * Registers another volume capacity feasibility result.
+     */
+    void registerVolumeFeasible(bool isVolumeFeasible);
+
+    /**
+     * Registers another salvage feasibility result.
+     */
+    void registerSalvageFeasible(bool isSalvageFeasible);
+
+    /**
+     * Registers another time feasibility result.
+     */
+    void registerTimeFeasible(bool isTimeFeasible);
+
+    /**
+     * @return A cost evaluator for the current penalty values.
+     */
+    [[nodiscard]] CostEvaluator const &costEvaluator() const;
+
+    /**
+     * @return A cost evaluator for the boosted current penalty values.
+     */
+    [[nodiscard]] CostEvaluator const &boosterCostEvaluator() const;
+};
+
+#endif  // PYVRP_PENALTYMANAGER_H
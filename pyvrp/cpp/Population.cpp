@@ -0,0 +1,88 @@
+#include "Population.h"
+
+#include <stdexcept>
+
+Population::Population(DiversityMeasure divOp, PopulationParams const &params)
+    : divOp(divOp),
+      params(params),
+      feasible(std::make_unique<SubPopulation>(divOp, this->params)),
+      infeasible(std::make_unique<SubPopulation>(divOp, this->params))
+{
+}
+
+size_t Population::size() const
+{
+    return feasible->size() + infeasible->size();
+}
+
+SubPopulation const &Population::feasibleSubPopulation() const
+{
+    return *feasible;
+}
+
+SubPopulation const &Population::infeasibleSubPopulation() const
+{
+    return *infeasible;
+}
+
+void Population::add(Solution const &solution,
+                     CostEvaluator const &costEvaluator)
+{
+    // Note: the feasible subpopulation does not depend on the penalty values,
+    // but we use the same implementation.
+    if (solution.isFeasible())
+        feasible->add(&solution, costEvaluator);
+    else
+        infeasible->add(&solution, costEvaluator);
+}
+
+void Population::clear()
+{
+    feasible = std::make_unique<SubPopulation>(divOp, params);
+    infeasible = std::make_unique<SubPopulation>(divOp, params);
+}
+
+std::pair<Solution const *, Solution const *> Population::select(
+    XorShift128 &rng, CostEvaluator const &costEvaluator, size_t k)
+{
+    if (k == 0)
+        throw std::invalid_argument("Expected k > 0; got k = 0.");
+
+    feasible->updateFitness(costEvaluator);
+    infeasible->updateFitness(costEvaluator);
+
+    auto const *first = getTournament(rng, k);
+    auto const *second = getTournament(rng, k);
+
+    auto diversity = divOp(*first, *second);
+    auto const lb = params.lbDiversity;
+    auto const ub = params.ubDiversity;
+
+    size_t tries = 1;
+    while (!(lb <= diversity && diversity <= ub) && tries <= 10)
+    {
+        tries++;
+        second = getTournament(rng, k);
+        diversity = divOp(*first, *second);
+    }
+
+    return {first, second};
+}
+
+Solution const *Population::getTournament(XorShift128 &rng, size_t k) const
+{
+    auto const numFeas = feasible->size();
+
+    SubPopulation::Item const *fittest = nullptr;
+    for (size_t count = 0; count != k; ++count)
+    {
+        auto const idx = rng.randint(size());
+        auto const &item = idx < numFeas ? (*feasible)[idx]
+                                         : (*infeasible)[idx - numFeas];
+
+        if (!fittest || item.fitness < fittest->fitness)
+            fittest = &item;
+    }
+
+    return fittest->solution;
+}
@@ -0,0 +1,77 @@
+#ifndef PYVRP_POPULATION_H
+#define PYVRP_POPULATION_H
+
+#include "CostEvaluator.h"
+#include "Solution.h"
+#include "SubPopulation.h"
+#include "XorShift128.h"
+#include "diversity/diversity.h"
+
+#include <memory>
+#include <utility>
+
+/**
+ * Native counterpart of the Python <code>Population</code>, used by the native
+ * genetic algorithm. It maintains a feasible and an infeasible subpopulation,
+ * and selects parents from these in exactly the same way.
+ */
+class Population
+{
+    DiversityMeasure divOp;
+    PopulationParams params;  // referenced by the subpopulations
+
+    std::unique_ptr<SubPopulation> feasible;
+    std::unique_ptr<SubPopulation> infeasible;
+
+    // Selects a solution by k-ary tournament, based on the current fitness
+    // values of the drawn solutions.
+    [[nodiscard]] Solution const *getTournament(XorShift128 &rng,
+                                                size_t k) const;
+
+public:
+    Population(DiversityMeasure divOp, PopulationParams const &params);
+
+    // The subpopulations reference the parameters owned by this object, so it
+    // cannot be copied or moved.
+    Population(Population const &other) = delete;
+    Population &operator=(Population const &other) = delete;
+
+    /**
+     * @return The current population size.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @return The feasible subpopulation.
+     */
+    [[nodiscard]] SubPopulation const &feasibleSubPopulation() const;
+
+    /**
+     * @return The infeasible subpopulation.
+     */
+    [[nodiscard]] SubPopulation const &infeasibleSubPopulation() const;
+
+    /**
+     * Adds the given solution to the feasible or infeasible subpopulation,
+     * depending on whether the solution is feasible. Survivor selection is
+     * automatically triggered when the subpopulation reaches its maximum size.
+     */
+    void add(Solution const &solution, CostEvaluator const &costEvaluator);
+
+    /**
+     * Removes all solutions from the population.
+     */
+    void clear();
+
+    /**
+     * Selects two (if possible non-identical) parents by tournament, subject
+     * to a diversity restriction. The returned pointers remain valid until
+     * the next solution is added to the population.
+     *
+     * @throws std::invalid_argument When k is zero.
+     */
+    std::pair<Solution const *, Solution const *>
+    select(XorShift128 &rng, CostEvaluator const &costEvaluator, size_t k = 2);
+};
+
+#endif  // PYVRP_POPULATION_H
@@ -1,11 +1,78 @@
 #include "ProblemData.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace
+{
+// Client locations are scaled onto a square grid of this many cells along
+// each axis, whose cells are then ordered by a space-filling curve.
+constexpr uint32_t GRID_SIZE = 1 << 16;
+
+// Returns the index of the given cell along the Hilbert curve through the grid.
+uint64_t hilbertIndex(uint32_t x, uint32_t y)
+{
+    uint64_t index = 0;
+
+    for (uint32_t side = GRID_SIZE / 2; side > 0; side /= 2)
+    {
+        uint32_t const right = (x & side) > 0;
+        uint32_t const top = (y & side) > 0;
+        index += static_cast<uint64_t>(side) * side * ((3 * right) ^ top);
+
+        // Rotates the quadrant, so that the curve within it is traversed in
+        // the right orientation.
+        if (top == 0)
+        {
+            if (right == 1)
+            {
+                x = GRID_SIZE - 1 - x;
+                y = GRID_SIZE - 1 - y;
+            }
+
+            std::swap(x, y);
+        }
+    }
+
+    return index;
+}
+
+// Returns the index of the given cell along the Morton (Z-order) curve through
+// the grid, which interleaves the bits of the cell's coordinates.
+uint64_t mortonIndex(uint32_t x, uint32_t y)
+{
+    auto const spread = [](uint64_t bits) {
+        bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFF;
+        bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FF;
+        bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0F;
+        bits = (bits | (bits << 2)) & 0x3333333333333333;
+        bits = (bits | (bits << 1)) & 0x5555555555555555;
+        return bits;
+    };
+
+    return spread(x) | (spread(y) << 1);
+}
+
+// Returns whether all elements of the given matrix are non-negative whole
+// numbers, which the COMPACT layouts require.
+template <typename T> bool isWhole(Matrix<T> const &matrix)
+{
+    return std::all_of(
+        matrix.data(), matrix.data() + matrix.size(), [](T element) {
+            auto const value = static_cast<double>(element);
+            return value >= 0 && std::floor(value) == value;
+        });
+}
+}  // namespace
+
 ProblemData::Client::Client(Coordinate x,
                             Coordinate y,
                             Load demandWeight,
@@ -63,9 +130,182 @@ std::pair<double, double> const &ProblemData::centroid() const
     return centroid_;
 }
 
-Matrix<Distance> const &ProblemData::distanceMatrix() const { return dist_; }
+Matrix<Distance> const &ProblemData::distanceMatrix() const
+{
+    auto const *dense = std::get_if<DenseMatrices>(&matrices_);
+    if (!dense)
+        throw std::logic_error("Distance matrix is not stored densely.");
+
+    return dense->dist;
+}
+
+Matrix<Duration> const &ProblemData::durationMatrix() const
+{
+    auto const *dense = std::get_if<DenseMatrices>(&matrices_);
+    if (!dense)
+        throw std::logic_error("Duration matrix is not stored densely.");
+
+    return dense->dur;
+}
+
+ProblemData::MatrixStorage ProblemData::matrixStorage() const
+{
+    return static_cast<MatrixStorage>(matrices_.index());
+}
+
+int ProblemData::originalId(size_t client) const
+{
+    return originalIds_ ? (*originalIds_)[client] : static_cast<int>(client);
+}
+
+int ProblemData::internalId(size_t original) const
+{
+    return internalIds_.empty() ? static_cast<int>(original)
+                                : internalIds_[original];
+}
+
+std::shared_ptr<std::vector<int> const> const &ProblemData::originalIds() const
+{
+    return originalIds_;
+}
+
+void ProblemData::setOriginalIds(std::vector<int> ids)
+{
+    if (ids.size() != clients_.size() || ids[0] != 0)
+        throw std::invalid_argument("Original ids must keep the depot at 0.");
+
+    std::vector<int> internalIds(ids.size(), -1);
+    for (size_t idx = 0; idx != ids.size(); ++idx)
+    {
+        auto const original = ids[idx];
+        if (original < 0 || static_cast<size_t>(original) >= ids.size()
+            || internalIds[original] != -1)
+            throw std::invalid_argument("Original ids must be a permutation.");
+
+        internalIds[original] = static_cast<int>(idx);
+    }
+
+    originalIds_ = std::make_shared<std::vector<int> const>(std::move(ids));
+    internalIds_ = std::move(internalIds);
+}
+
+ProblemData ProblemData::renumbered(ClientOrdering ordering) const
+{
+    // The locations' bounding box is scaled onto the grid, with the same
+    // scale along both axes, so that the curve follows their geometry.
+    auto minX = std::numeric_limits<double>::max();
+    auto minY = std::numeric_limits<double>::max();
+    auto maxX = std::numeric_limits<double>::lowest();
+    auto maxY = std::numeric_limits<double>::lowest();
+
+    for (auto const &client : clients_)
+    {
+        minX = std::min(minX, static_cast<double>(client.x));
+        minY = std::min(minY, static_cast<double>(client.y));
+        maxX = std::max(maxX, static_cast<double>(client.x));
+        maxY = std::max(maxY, static_cast<double>(client.y));
+    }
+
+    auto const extent = std::max(maxX - minX, maxY - minY);
+    auto const scale = extent > 0 ? (GRID_SIZE - 1) / extent : 0;
+
+    std::vector<uint64_t> curveIndices;
+    curveIndices.reserve(clients_.size());
+
+    for (auto const &client : clients_)
+    {
+        auto const x = (static_cast<double>(client.x) - minX) * scale;
+        auto const y = (static_cast<double>(client.y) - minY) * scale;
+        auto const cellX = static_cast<uint32_t>(x);
+        auto const cellY = static_cast<uint32_t>(y);
+
+        switch (ordering)
+        {
+        case ClientOrdering::HILBERT:
+            curveIndices.push_back(hilbertIndex(cellX, cellY));
+            break;
+        case ClientOrdering::MORTON:
+            curveIndices.push_back(mortonIndex(cellX, cellY));
+            break;
+        default:
+            throw std::invalid_argument("Unknown client ordering.");
+        }
+    }
+
+    // The depot stays at index 0. Clients in the same cell keep their order.
+    std::vector<int> order(clients_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin() + 1, order.end(), [&](int a, int b) {
+        return curveIndices[a] < curveIndices[b];
+    });
+
+    std::vector<Client> clients;
+    clients.reserve(order.size());
+    for (auto const idx : order)
+        clients.push_back(clients_[idx]);
+
+    auto const makeData = [&]() {
+        if (auto const *current = std::get_if<DistanceOracle>(&matrices_))
+        {
+            std::vector<double> x;
+            std::vector<double> y;
+            for (auto const idx : order)
+            {
+                x.push_back(current->x()[idx]);
+                y.push_back(current->y()[idx]);
+            }
+
+            DistanceOracle oracle(
+                std::move(x), std::move(y), current->params());
+            return ProblemData(clients,
+                               numVehicles_,
+                               weightCapacity_,
+                               volumeCapacity_,
+                               salvageCapacity_,
+                               orderRouteLimit_,
+                               routeStoreLimit_,
+                               std::move(oracle));
+        }
+
+        Matrix<Distance> distMat(order.size());
+        Matrix<Duration> durMat(order.size());
+        for (size_t row = 0; row != order.size(); ++row)
+            for (size_t col = 0; col != order.size(); ++col)
+            {
+                distMat(row, col) = dist(order[row], order[col]);
+                durMat(row, col) = duration(order[row], order[col]);
+            }
+
+        return ProblemData(clients,
+                           numVehicles_,
+                           weightCapacity_,
+                           volumeCapacity_,
+                           salvageCapacity_,
+                           orderRouteLimit_,
+                           routeStoreLimit_,
+                           std::move(distMat),
+                           std::move(durMat),
+                           matrixStorage());
+    };
 
-Matrix<Duration> const &ProblemData::durationMatrix() const { return dur_; }
+    auto data = makeData();
+
+    // Ids are composed with this instance's, in case it was renumbered too.
+    std::vector<int> ids;
+    ids.reserve(order.size());
+    for (auto const idx : order)
+        ids.push_back(originalId(idx));
+
+    data.setOriginalIds(std::move(ids));
+    return data;
+}
+
+ProblemData ProblemData::withOriginalIds(std::vector<int> ids) const
+{
+    ProblemData data(*this);
+    data.setOriginalIds(std::move(ids));
+    return data;
+}
 
 size_t ProblemData::numClients() const { return numClients_; }
 
@@ -81,6 +321,34 @@ Order ProblemData::orderRouteLimit() const { return orderRouteLimit_; }
 
 Store ProblemData::routeStoreLimit() const { return routeStoreLimit_; }
 
+size_t ProblemData::numStores() const { return numStores_; }
+
+size_t ProblemData::numOrders() const { return numOrders_; }
+
+ProblemData::ProblemData(std::vector<Client> const &clients,
+                         size_t numVehicles,
+                         Load weightCap,
+                         Load volumeCap,
+                         Salvage salvageCap,
+                         Order orderRouteLim,
+                         Store routeStoreLim,
+                         Matrix<Distance> distMat,
+                         Matrix<Duration> durMat,
+                         MatrixStorage storage)
+    : ProblemData(clients,
+                  numVehicles,
+                  weightCap,
+                  volumeCap,
+                  salvageCap,
+                  orderRouteLim,
+                  routeStoreLim,
+                  std::move(distMat),
+                  std::move(durMat),
+                  DistanceOracle(),
+                  storage)
+{
+}
+
 ProblemData::ProblemData(std::vector<Client> const &clients,
                          size_t numVehicles,
                          Load weightCap,
@@ -88,11 +356,99 @@ ProblemData::ProblemData(std::vector<Client> const &clients,
                          Salvage salvageCap,
                          Order orderRouteLim,
                          Store routeStoreLim,
-                         Matrix<Distance> const distMat,
-                         Matrix<Duration> const durMat)
+                         DistanceOracle oracle)
+    : ProblemData(clients,
+                  numVehicles,
+                  weightCap,
+                  volumeCap,
+                  salvageCap,
+                  orderRouteLim,
+                  routeStoreLim,
+                  Matrix<Distance>(0),
+                  Matrix<Duration>(0),
+                  std::move(oracle),
+                  MatrixStorage::ON_DEMAND)
+{
+}
+
+ProblemData::Matrices ProblemData::makeMatrices(size_t numLocations,
+                                                Matrix<Distance> distMat,
+                                                Matrix<Duration> durMat,
+                                                DistanceOracle oracle,
+                                                MatrixStorage storage)
+{
+    if (storage == MatrixStorage::ON_DEMAND)
+    {
+        // The matrix constructor passes an empty oracle, so this also rejects
+        // ON_DEMAND storage when matrices are given instead.
+        if (oracle.size() != numLocations)
+            throw std::invalid_argument("Distance oracle does not match the "
+                                        "number of clients.");
+
+        return oracle;
+    }
+
+    auto const hasShape = [&](auto const &mat) {
+        return mat.numRows() == numLocations && mat.numCols() == numLocations;
+    };
+
+    if (!hasShape(distMat) || !hasShape(durMat))
+        throw std::invalid_argument("Matrix dimensions do not match the "
+                                    "number of clients.");
+
+    // Checked here rather than when quantising, so that the error names the
+    // layout that was asked for.
+    auto const isCompact = storage == MatrixStorage::COMPACT_16
+                           || storage == MatrixStorage::COMPACT_32;
+    if (isCompact && (!isWhole(distMat) || !isWhole(durMat)))
+        throw std::invalid_argument("COMPACT matrix storage requires "
+                                    "non-negative, whole distances and "
+                                    "durations.");
+
+    // Each layout other than DENSE copies the matrices, which are freed once
+    // this returns.
+    switch (storage)
+    {
+    case MatrixStorage::DENSE:
+        return DenseMatrices{std::move(distMat), std::move(durMat)};
+    case MatrixStorage::SYMMETRIC:
+        return MatrixPair<SymmetricMatrix<Distance>,
+                          SymmetricMatrix<Duration>>{
+            SymmetricMatrix<Distance>(distMat),
+            SymmetricMatrix<Duration>(durMat)};
+    case MatrixStorage::COMPACT_16:
+        return QuantisedMatrices<uint16_t>{
+            QuantisedMatrix<Distance, uint16_t>(distMat),
+            QuantisedMatrix<Duration, uint16_t>(durMat)};
+    case MatrixStorage::COMPACT_32:
+        return QuantisedMatrices<uint32_t>{
+            QuantisedMatrix<Distance, uint32_t>(distMat),
+            QuantisedMatrix<Duration, uint32_t>(durMat)};
+    case MatrixStorage::INTERLEAVED:
+        return InterleavedMatrices{
+            PairedMatrix<Distance, Duration>(distMat, durMat)};
+    default:
+        throw std::invalid_argument("Unknown matrix storage.");
+    }
+}
+
+ProblemData::ProblemData(std::vector<Client> const &clients,
+                         size_t numVehicles,
+                         Load weightCap,
+                         Load volumeCap,
+                         Salvage salvageCap,
+                         Order orderRouteLim,
+                         Store routeStoreLim,
+                         Matrix<Distance> distMat,
+                         Matrix<Duration> durMat,
+                         DistanceOracle oracle,
+                         MatrixStorage storage)
     : centroid_({0, 0}),
-      dist_(std::move(distMat)),
-      dur_(std::move(durMat)),
+      matrices_(makeMatrices(clients.size(),
+                             std::move(distMat),
+                             std::move(durMat),
+                             std::move(oracle),
+                             storage)),
       clients_(clients),
       numClients_(std::max<size_t>(clients.size(), 1) - 1),
       numVehicles_(numVehicles),
@@ -107,4 +463,48 @@ ProblemData::ProblemData(std::vector<Client> const &clients,
         centroid_.first += static_cast<double>(clients[idx].x) / numClients();
         centroid_.second += static_cast<double>(clients[idx].y) / numClients();
     }
+
+    auto const numLocations = clients_.size();
+    classes_.reserve(numLocations);
+    stores_.reserve(numLocations);
+    orders_.reserve(numLocations);
+    weights_.reserve(numLocations);
+    volumes_.reserve(numLocations);
+    salvages_.reserve(numLocations);
+    serviceDurations_.reserve(numLocations);
+    twEarlies_.reserve(numLocations);
+    twLates_.reserve(numLocations);
+
+    for (auto const &client : clients_)
+    {
+        // Any weight or volume demand makes a delivery, but only a salvage
+        // demand of exactly one makes a salvage pickup.
+        bool const isDelivery
+            = client.demandWeight != 0 || client.demandVolume != 0;
+        bool const isSalvage = client.demandSalvage == 1;
+
+        if (isDelivery && isSalvage)
+            classes_.push_back(ClientClass::BOTH);
+        else if (isDelivery)
+            classes_.push_back(ClientClass::DELIVERY);
+        else if (isSalvage)
+            classes_.push_back(ClientClass::SALVAGE);
+        else
+            classes_.push_back(ClientClass::NONE);
+
+        stores_.push_back(client.clientStore);
+        orders_.push_back(client.clientOrder);
+        weights_.push_back(client.demandWeight);
+        volumes_.push_back(client.demandVolume);
+        salvages_.push_back(client.demandSalvage);
+        serviceDurations_.push_back(client.serviceDuration);
+        twEarlies_.push_back(client.twEarly);
+        twLates_.push_back(client.twLate);
+
+        auto const store = static_cast<size_t>(client.clientStore.get() + 1);
+        numStores_ = std::max(numStores_, store);
+
+        auto const order = static_cast<size_t>(client.clientOrder.get() + 1);
+        numOrders_ = std::max(numOrders_, order);
+    }
 }
@@ -1,16 +1,76 @@
 #ifndef PYVRP_PROBLEMDATA_H
 #define PYVRP_PROBLEMDATA_H
 
+#include "CompactMatrix.h"
+#include "DistanceOracle.h"
 #include "Matrix.h"
 #include "Measure.h"
 #include "XorShift128.h"
 
+#include <cstdint>
 #include <iosfwd>
+#include <memory>
+#include <variant>
 #include <vector>
 
 class ProblemData
 {
 public:
+    /**
+     * Delivery/salvage class of a client. Clients with a nonzero weight or
+     * volume demand are deliveries, and clients with a salvage demand of
+     * exactly one are salvage pickups. A client can be both, or neither.
+     */
+    enum class ClientClass : uint8_t
+    {
+        NONE,
+        DELIVERY,
+        BOTH,
+        SALVAGE
+    };
+
+    /**
+     * Layout in which the distance and duration matrices are stored. All
+     * layouts return the same values, but the compact ones need less memory,
+     * and thus less memory bandwidth per lookup.
+     * <ul>
+     * <li>DENSE stores both as full matrices. This is the default.</li>
+     * <li>SYMMETRIC stores only the lower triangle of both, which requires
+     *     both matrices to be symmetric.</li>
+     * <li>COMPACT_16 and COMPACT_32 store both as full matrices of 16 or 32
+     *     bit unsigned integers, multiplied by a common factor. These layouts
+     *     only accept non-negative whole numbers, which must fit after
+     *     dividing by the factor. Fractional distances or durations, as may
+     *     occur with double precision, must be rounded beforehand.</li>
+     * <li>INTERLEAVED stores one full matrix of (distance, duration) pairs, so
+     *     that looking up the distance of an arc also brings its duration into
+     *     the cache, and vice versa.</li>
+     * <li>ON_DEMAND stores no matrices at all, but computes distances and
+     *     durations from the client coordinates with a DistanceOracle. This
+     *     storage is selected by constructing from an oracle.</li>
+     * </ul>
+     */
+    enum class MatrixStorage : uint8_t
+    {
+        DENSE,
+        SYMMETRIC,
+        COMPACT_16,
+        COMPACT_32,
+        INTERLEAVED,
+        ON_DEMAND
+    };
+
+    /**
+     * Space-filling curve along which clients can be renumbered, so that
+     * clients that are close together also have nearby indices. HILBERT
+     * preserves locality better, but MORTON (Z-order) is cheaper to compute.
+     */
+    enum class ClientOrdering : uint8_t
+    {
+        HILBERT,
+        MORTON
+    };
+
     struct Client
     {
         Coordinate const x;
@@ -40,12 +100,91 @@ public:
                bool required = true);
     };
 
+    /**
+     * Matrix-like view of the travel durations that does not depend on how
+     * they are stored. This is what is passed to TimeWindowSegment::merge().
+     */
+    class Durations
+    {
+        ProblemData const &data;
+
+    public:
+        explicit Durations(ProblemData const &data) : data(data) {}
+
+        [[nodiscard]] Duration operator()(size_t first, size_t second) const
+        {
+            return data.duration(first, second);
+        }
+    };
+
 private:
+    // Distance and duration matrices (+depot) of one storage layout.
+    template <typename DistMat, typename DurMat> struct MatrixPair
+    {
+        DistMat dist;
+        DurMat dur;
+
+        [[nodiscard]] Distance distance(size_t first, size_t second) const
+        {
+            return dist(first, second);
+        }
+
+        [[nodiscard]] Duration duration(size_t first, size_t second) const
+        {
+            return dur(first, second);
+        }
+    };
+
+    struct InterleavedMatrices
+    {
+        PairedMatrix<Distance, Duration> arcs;
+
+        [[nodiscard]] Distance distance(size_t first, size_t second) const
+        {
+            return arcs.first(first, second);
+        }
+
+        [[nodiscard]] Duration duration(size_t first, size_t second) const
+        {
+            return arcs.second(first, second);
+        }
+    };
+
+    using DenseMatrices = MatrixPair<Matrix<Distance>, Matrix<Duration>>;
+
+    template <typename Q>
+    using QuantisedMatrices = MatrixPair<QuantisedMatrix<Distance, Q>,
+                                         QuantisedMatrix<Duration, Q>>;
+
+    // The matrices in each storage layout. The alternatives are in the same
+    // order as the MatrixStorage values, so the index of the held alternative
+    // is the layout.
+    using Matrices
+        = std::variant<DenseMatrices,
+                       MatrixPair<SymmetricMatrix<Distance>,
+                                  SymmetricMatrix<Duration>>,
+                       QuantisedMatrices<uint16_t>,
+                       QuantisedMatrices<uint32_t>,
+                       InterleavedMatrices,
+                       DistanceOracle>;
+
     std::pair<double, double> centroid_;  // Centroid of client locations
-    Matrix<Distance> const dist_;         // Distance matrix (+depot)
-    Matrix<Duration> const dur_;          // Duration matrix (+depot)
+    Matrices matrices_;                   // Distance and duration matrices
     std::vector<Client> clients_;         // Client (+depot) information
 
+    // Copies of the client attributes that are read in the local search's
+    // inner loops, stored as dense arrays indexed by client (+depot). The
+    // Client structs above also hold the rarely used coordinates and prizes.
+    std::vector<ClientClass> classes_;
+    std::vector<Store> stores_;
+    std::vector<Order> orders_;
+    std::vector<Load> weights_;
+    std::vector<Load> volumes_;
+    std::vector<Salvage> salvages_;
+    std::vector<Duration> serviceDurations_;
+    std::vector<Duration> twEarlies_;
+    std::vector<Duration> twLates_;
+
     size_t const numClients_;
     size_t const numVehicles_;
     Load const weightCapacity_;
@@ -53,6 +192,38 @@ private:
     Salvage const salvageCapacity_;
     Order const orderRouteLimit_;
     Store const routeStoreLimit_;
+    size_t numStores_ = 0;  // One more than the largest store index
+    size_t numOrders_ = 0;  // One more than the largest order index
+
+    // Original ids of the clients (+depot), and the reverse mapping, once the
+    // clients are renumbered. Both are empty while they have not been. The
+    // original ids are shared with solutions, so that these can report them.
+    std::shared_ptr<std::vector<int> const> originalIds_;
+    std::vector<int> internalIds_;
+
+    // Sets the original ids of the clients, after validating that they are a
+    // permutation that keeps the depot at index 0.
+    void setOriginalIds(std::vector<int> ids);
+
+    // Stores the given matrices in the given layout, after validating that
+    // they can be. ON_DEMAND storage uses the oracle instead.
+    [[nodiscard]] static Matrices makeMatrices(size_t numLocations,
+                                               Matrix<Distance> distMat,
+                                               Matrix<Duration> durMat,
+                                               DistanceOracle oracle,
+                                               MatrixStorage storage);
+
+    ProblemData(std::vector<Client> const &clients,
+                size_t numVehicles,
+                Load weightCap,
+                Load volumeCap,
+                Salvage salvageCap,
+                Order orderRouteLim,
+                Store routeStoreLim,
+                Matrix<Distance> distMat,
+                Matrix<Duration> durMat,
+                DistanceOracle oracle,
+                MatrixStorage storage);
 
 public:
     /**
@@ -66,6 +237,51 @@ public:
      */
     [[nodiscard]] Client const &depot() const;
 
+    /**
+     * @return Delivery/salvage class of the given client.
+     */
+    [[nodiscard]] inline ClientClass clientClass(size_t client) const;
+
+    /**
+     * @return Store index of the given client.
+     */
+    [[nodiscard]] inline Store clientStore(size_t client) const;
+
+    /**
+     * @return Order index of the given client.
+     */
+    [[nodiscard]] inline Order clientOrder(size_t client) const;
+
+    /**
+     * @return Weight demand of the given client.
+     */
+    [[nodiscard]] inline Load demandWeight(size_t client) const;
+
+    /**
+     * @return Volume demand of the given client.
+     */
+    [[nodiscard]] inline Load demandVolume(size_t client) const;
+
+    /**
+     * @return Salvage demand of the given client.
+     */
+    [[nodiscard]] inline Salvage demandSalvage(size_t client) const;
+
+    /**
+     * @return Service duration of the given client.
+     */
+    [[nodiscard]] inline Duration serviceDuration(size_t client) const;
+
+    /**
+     * @return Earliest possible start of service of the given client.
+     */
+    [[nodiscard]] inline Duration twEarly(size_t client) const;
+
+    /**
+     * @return Latest possible start of service of the given client.
+     */
+    [[nodiscard]] inline Duration twLate(size_t client) const;
+
     /**
      * @return Centroid of client locations.
      */
@@ -89,16 +305,69 @@ public:
      */
     [[nodiscard]] inline Duration duration(size_t first, size_t second) const;
 
+    /**
+     * @return Matrix-like view of the travel durations.
+     */
+    [[nodiscard]] inline Durations durations() const;
+
     /**
      * @return The full travel distance matrix.
+     * @throws std::logic_error When the matrices are not stored as DENSE.
      */
     [[nodiscard]] Matrix<Distance> const &distanceMatrix() const;
 
     /**
      * @return The full travel duration matrix.
+     * @throws std::logic_error When the matrices are not stored as DENSE.
      */
     [[nodiscard]] Matrix<Duration> const &durationMatrix() const;
 
+    /**
+     * @return Layout in which the distance and duration matrices are stored.
+     */
+    [[nodiscard]] MatrixStorage matrixStorage() const;
+
+    /**
+     * @return Id of the given client in the instance's original numbering,
+     *         before it was renumbered.
+     */
+    [[nodiscard]] int originalId(size_t client) const;
+
+    /**
+     * @return Index of the client with the given original id.
+     */
+    [[nodiscard]] int internalId(size_t original) const;
+
+    /**
+     * @return Original ids of all clients (+depot), or null when the clients
+     *         have not been renumbered, and their ids are thus unchanged.
+     */
+    [[nodiscard]] std::shared_ptr<std::vector<int> const> const &
+    originalIds() const;
+
+    /**
+     * Returns a copy of this instance in which the clients are renumbered in
+     * the order in which the given space-filling curve visits their locations.
+     * The depot stays at index 0. Clients that are close together then have
+     * nearby indices, so that their rows in the matrices, and their entries in
+     * other per-client arrays, are also close together in memory. The matrices
+     * are permuted accordingly, and keep their storage layout.
+     *
+     * The copy remembers the clients' original ids, which solutions report.
+     * While it is built, both instances' matrices are in memory.
+     */
+    [[nodiscard]] ProblemData renumbered(ClientOrdering ordering) const;
+
+    /**
+     * Returns a copy of this instance, whose clients have the given original
+     * ids. This is meant for instances that were renumbered before they were
+     * stored: see InstanceFile.h.
+     *
+     * @throws std::invalid_argument When the ids are not a permutation of the
+     *                               client indices that maps the depot to 0.
+     */
+    [[nodiscard]] ProblemData withOriginalIds(std::vector<int> ids) const;
+
     /**
      * @return Total number of clients in this instance.
      */
@@ -134,6 +403,19 @@ public:
      */        
     [[nodiscard]] Order orderRouteLimit() const;
 
+    /**
+     * @return Number of store indices in use. Client store indices lie in the
+     *         range [-1, numStores()), where -1 is the default store index.
+     */
+    [[nodiscard]] size_t numStores() const;
+
+    /**
+     * @return Number of order indices in use. Client order indices lie in the
+     *         range [-1, numOrders()), where -1 means the client is not part
+     *         of any order.
+     */
+    [[nodiscard]] size_t numOrders() const;
+
     /**
      * Constructs a ProblemData object with the given data. Assumes the list of
      * clients contains the depot, such that each vector is one longer than the
@@ -148,6 +430,16 @@ public:
      * @param routeStoreLim        Max number of stores per route.
      * @param distMat              Distance matrix.
      * @param durMat               Duration matrix.
+     * @param storage              Layout in which to store the matrices.
+     *
+     * The matrices are moved into the constructed object, so passing them as
+     * rvalues avoids copying them.
+     *
+     * @throws std::invalid_argument When a matrix is not square, with one row
+     *                               and column for each client (+depot), or
+     *                               when the matrices cannot be stored in the
+     *                               given layout. ON_DEMAND storage requires
+     *                               an oracle, and thus cannot be given here.
      */
     ProblemData(std::vector<Client> const &clients,
                 size_t numVehicles,
@@ -156,8 +448,28 @@ public:
                 Salvage salvageCap,
                 Order const orderRouteLim,
                 Store const routeStoreLim,
-                Matrix<Distance> const distMat,
-                Matrix<Duration> const durMat);
+                Matrix<Distance> distMat,
+                Matrix<Duration> durMat,
+                MatrixStorage storage = MatrixStorage::DENSE);
+
+    /**
+     * Constructs a ProblemData object that stores no distance and duration
+     * matrices, but computes their values on demand with the given oracle.
+     * Its storage layout is ON_DEMAND. The other parameters are as above.
+     *
+     * @param oracle               Distance oracle over the client locations.
+     *
+     * @throws std::invalid_argument When the oracle does not have a location
+     *                               for each client (+depot).
+     */
+    ProblemData(std::vector<Client> const &clients,
+                size_t numVehicles,
+                Load weightCap,
+                Load volumeCap,
+                Salvage salvageCap,
+                Order const orderRouteLim,
+                Store const routeStoreLim,
+                DistanceOracle oracle);
 };
 
 ProblemData::Client const &ProblemData::client(size_t client) const
@@ -165,14 +477,65 @@ ProblemData::Client const &ProblemData::client(size_t client) const
     return clients_[client];
 }
 
+ProblemData::ClientClass ProblemData::clientClass(size_t client) const
+{
+    return classes_[client];
+}
+
+Store ProblemData::clientStore(size_t client) const { return stores_[client]; }
+
+Order ProblemData::clientOrder(size_t client) const { return orders_[client]; }
+
+Load ProblemData::demandWeight(size_t client) const { return weights_[client]; }
+
+Load ProblemData::demandVolume(size_t client) const { return volumes_[client]; }
+
+Salvage ProblemData::demandSalvage(size_t client) const
+{
+    return salvages_[client];
+}
+
+Duration ProblemData::serviceDuration(size_t client) const
+{
+    return serviceDurations_[client];
+}
+
+Duration ProblemData::twEarly(size_t client) const
+{
+    return twEarlies_[client];
+}
+
+Duration ProblemData::twLate(size_t client) const { return twLates_[client]; }
+
 Distance ProblemData::dist(size_t first, size_t second) const
 {
-    return dist_(first, second);
+    // Dense storage is the default, and checked before dispatching on the
+    // other layouts, so that the common case costs a single comparison.
+    if (auto const *dense = std::get_if<DenseMatrices>(&matrices_)) [[likely]]
+        return dense->distance(first, second);
+
+    return std::visit(
+        [&](auto const &matrices) -> Distance {
+            return matrices.distance(first, second);
+        },
+        matrices_);
 }
 
 Duration ProblemData::duration(size_t first, size_t second) const
 {
-    return dur_(first, second);
+    if (auto const *dense = std::get_if<DenseMatrices>(&matrices_)) [[likely]]
+        return dense->duration(first, second);
+
+    return std::visit(
+        [&](auto const &matrices) -> Duration {
+            return matrices.duration(first, second);
+        },
+        matrices_);
+}
+
+ProblemData::Durations ProblemData::durations() const
+{
+    return Durations(*this);
 }
 
 #endif  // PYVRP_PROBLEMDATA_H
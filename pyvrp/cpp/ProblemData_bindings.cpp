@@ -1,8 +1,14 @@
+#include "DistanceOracle.h"
+#include "NumpyMatrix.h"
 #include "ProblemData.h"
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 namespace py = pybind11;
 
 PYBIND11_MODULE(_ProblemData, m)
@@ -65,6 +71,66 @@ PYBIND11_MODULE(_ProblemData, m)
                                })
         .def_readonly("required", &ProblemData::Client::required);
 
+    py::enum_<ProblemData::ClientClass>(m, "ClientClass")
+        .value("NONE", ProblemData::ClientClass::NONE)
+        .value("DELIVERY", ProblemData::ClientClass::DELIVERY)
+        .value("BOTH", ProblemData::ClientClass::BOTH)
+        .value("SALVAGE", ProblemData::ClientClass::SALVAGE);
+
+    py::enum_<ProblemData::MatrixStorage>(m, "MatrixStorage")
+        .value("DENSE", ProblemData::MatrixStorage::DENSE)
+        .value("SYMMETRIC", ProblemData::MatrixStorage::SYMMETRIC)
+        .value("COMPACT_16", ProblemData::MatrixStorage::COMPACT_16)
+        .value("COMPACT_32", ProblemData::MatrixStorage::COMPACT_32)
+        .value("INTERLEAVED", ProblemData::MatrixStorage::INTERLEAVED)
+        .value("ON_DEMAND", ProblemData::MatrixStorage::ON_DEMAND);
+
+    py::enum_<ProblemData::ClientOrdering>(m, "ClientOrdering")
+        .value("HILBERT", ProblemData::ClientOrdering::HILBERT)
+        .value("MORTON", ProblemData::ClientOrdering::MORTON);
+
+    py::class_<DistanceOracle>(m, "DistanceOracle")
+        .def(py::init([](std::vector<double> x,
+                         std::vector<double> y,
+                         std::string const &roundFunc,
+                         double divisor,
+                         bool durations,
+                         size_t cacheRows) {
+                 // These are the names of pyvrp.read's rounding functions.
+                 DistanceOracleParams params;
+                 if (roundFunc == "none")
+                     params.rounding = Rounding::NONE;
+                 else if (roundFunc == "round")
+                     params.rounding = Rounding::ROUND;
+                 else if (roundFunc == "trunc")
+                     params.rounding = Rounding::TRUNC;
+                 else if (roundFunc == "trunc1" || roundFunc == "dimacs")
+                     params.rounding = Rounding::TRUNC1;
+                 else
+                     throw std::invalid_argument("Unknown round_func.");
+
+                 params.divisor = divisor;
+                 params.durations = durations;
+                 params.cacheRows = cacheRows;
+
+                 return DistanceOracle(std::move(x), std::move(y), params);
+             }),
+             py::arg("x"),
+             py::arg("y"),
+             py::arg("round_func") = "none",
+             py::arg("divisor") = 10,
+             py::arg("durations") = true,
+             py::arg("cache_rows") = 0)
+        .def("__len__", &DistanceOracle::size)
+        .def("distance",
+             &DistanceOracle::distance,
+             py::arg("first"),
+             py::arg("second"))
+        .def("duration",
+             &DistanceOracle::duration,
+             py::arg("first"),
+             py::arg("second"));
+
     py::class_<ProblemData>(m, "ProblemData")
         .def(py::init([](std::vector<ProblemData::Client> const &clients,
                          int numVehicles,
@@ -73,20 +139,24 @@ PYBIND11_MODULE(_ProblemData, m)
                          Value salvageCap,
                          Value orderRouteLim,
                          Value routeStoreLim,
-                         std::vector<std::vector<Value>> const &dist,
-                         std::vector<std::vector<Value>> const &dur) {
-                 Matrix<Distance> distMat(clients.size());
-                 Matrix<Duration> durMat(clients.size());
-
-                 for (size_t row = 0; row != clients.size(); ++row)
-                     for (size_t col = 0; col != clients.size(); ++col)
-                     {
-                         distMat(row, col) = dist[row][col];
-                         durMat(row, col) = dur[row][col];
-                     }
+                         py::object const &dist,
+                         py::object const &dur,
+                         ProblemData::MatrixStorage storage) {
+                 // Contiguous arrays of Value are borrowed, not copied. The
+                 // matrices are then moved into the problem data.
+                 auto distMat = matrixFromArray<Distance, Value>(dist, false);
+                 auto durMat = matrixFromArray<Duration, Value>(dur, false);
 
-                 return ProblemData(
-                     clients, numVehicles, weightCap, volumeCap, salvageCap, orderRouteLim, routeStoreLim, distMat, durMat);
+                 return ProblemData(clients,
+                                    numVehicles,
+                                    weightCap,
+                                    volumeCap,
+                                    salvageCap,
+                                    orderRouteLim,
+                                    routeStoreLim,
+                                    std::move(distMat),
+                                    std::move(durMat),
+                                    storage);
              }),
              py::arg("clients"),
              py::arg("num_vehicles"),
@@ -96,8 +166,26 @@ PYBIND11_MODULE(_ProblemData, m)
              py::arg("order_route_lim"),
              py::arg("route_store_lim"),
              py::arg("distance_matrix"),
-             py::arg("duration_matrix"))
+             py::arg("duration_matrix"),
+             py::arg("matrix_storage") = ProblemData::MatrixStorage::DENSE)
+        .def(py::init<std::vector<ProblemData::Client> const &,
+                      size_t,
+                      Value,
+                      Value,
+                      Value,
+                      Value,
+                      Value,
+                      DistanceOracle>(),
+             py::arg("clients"),
+             py::arg("num_vehicles"),
+             py::arg("weight_cap"),
+             py::arg("volume_cap"),
+             py::arg("salvage_cap"),
+             py::arg("order_route_lim"),
+             py::arg("route_store_lim"),
+             py::arg("distance_oracle"))
         .def_property_readonly("num_clients", &ProblemData::numClients)
+        .def_property_readonly("matrix_storage", &ProblemData::matrixStorage)
         .def_property_readonly("num_vehicles", &ProblemData::numVehicles)
         .def_property_readonly("weight_capacity",
                                [](ProblemData const &data) {
@@ -126,6 +214,13 @@ PYBIND11_MODULE(_ProblemData, m)
         .def("depot",
              &ProblemData::depot,
              py::return_value_policy::reference_internal)
+        .def("client_class", &ProblemData::clientClass, py::arg("client"))
+        .def("renumbered",
+             &ProblemData::renumbered,
+             py::arg("ordering"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("original_id", &ProblemData::originalId, py::arg("client"))
+        .def("internal_id", &ProblemData::internalId, py::arg("original"))
         .def("centroid",
              &ProblemData::centroid,
              py::return_value_policy::reference_internal)
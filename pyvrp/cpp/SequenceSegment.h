@@ -0,0 +1,137 @@
+#ifndef PYVRP_SEQUENCESEGMENT_H
+#define PYVRP_SEQUENCESEGMENT_H
+
+#include "Measure.h"
+#include "ProblemData.h"
+
+#include <utility>
+
+/**
+ * Summarises the delivery and salvage sequence of a route segment, based on
+ * the clients' ProblemData::ClientClass. A route must first visit all
+ * delivery-only clients, followed by either a single client that is both, or
+ * any number of salvage-only clients. Clients of neither class can be
+ * visited anywhere.
+ * <br />
+ * The segment counts the pairs of clients that are visited in the wrong order,
+ * both for the segment as-is and for the segment in reverse. These counts can
+ * be combined in O(1) time when segments are concatenated, so the sequence
+ * violations of a route after a move can be evaluated from a few segments.
+ */
+class SequenceSegment
+{
+    using SS = SequenceSegment;
+
+    int numDelivery = 0;  // Number of delivery-only clients in the segment
+    int numBoth = 0;      // Number of delivery and salvage clients
+    int numSalvage = 0;   // Number of salvage-only clients
+    Sequence violations_ = 0;         // Out of sequence client pairs
+    Sequence reverseViolations_ = 0;  // Idem, when the segment is reversed
+
+    // Number of out of sequence pairs (u, v) with u in first, and v in second.
+    [[nodiscard]] inline static Sequence violationsBetween(SS const &first,
+                                                           SS const &second);
+
+    [[nodiscard]] inline SS merge(SS const &other) const;
+
+public:
+    template <typename... Args>
+    [[nodiscard]] inline static SS
+    merge(SS const &first, SS const &second, Args... args);
+
+    /**
+     * Returns the segment that remains of this segment when the given prefix
+     * of it is removed. Runs in O(1) time.
+     */
+    [[nodiscard]] inline SS withoutPrefix(SS const &prefix) const;
+
+    /**
+     * Returns this segment in reverse visit order.
+     */
+    [[nodiscard]] inline SS reversed() const;
+
+    /**
+     * Number of client pairs in this segment that are visited out of sequence.
+     */
+    [[nodiscard]] inline Sequence violations() const;
+
+    SequenceSegment() = default;  // empty segment
+
+    /**
+     * Segment consisting of just a client of the given class.
+     */
+    inline explicit SequenceSegment(ProblemData::ClientClass clientClass);
+};
+
+Sequence SequenceSegment::violationsBetween(SS const &first, SS const &second)
+{
+    // A both client may not be followed by any client with demand, and a
+    // salvage-only client may not be followed by a client with a delivery.
+    auto const afterBoth
+        = second.numDelivery + second.numBoth + second.numSalvage;
+    auto const afterSalvage = second.numDelivery + second.numBoth;
+
+    return first.numBoth * afterBoth + first.numSalvage * afterSalvage;
+}
+
+SequenceSegment SequenceSegment::merge(SS const &other) const
+{
+    SS res;
+    res.numDelivery = numDelivery + other.numDelivery;
+    res.numBoth = numBoth + other.numBoth;
+    res.numSalvage = numSalvage + other.numSalvage;
+
+    // Reversing the concatenation reverses both segments and swaps them.
+    res.violations_ = violations_ + other.violations_
+                      + violationsBetween(*this, other);
+    res.reverseViolations_ = reverseViolations_ + other.reverseViolations_
+                             + violationsBetween(other, *this);
+
+    return res;
+}
+
+template <typename... Args>
+SequenceSegment
+SequenceSegment::merge(SS const &first, SS const &second, Args... args)
+{
+    auto const res = first.merge(second);
+
+    if constexpr (sizeof...(args) == 0)
+        return res;
+    else
+        return merge(res, args...);
+}
+
+SequenceSegment SequenceSegment::withoutPrefix(SS const &prefix) const
+{
+    SS res;
+    res.numDelivery = numDelivery - prefix.numDelivery;
+    res.numBoth = numBoth - prefix.numBoth;
+    res.numSalvage = numSalvage - prefix.numSalvage;
+
+    // This is merge() solved for the second segment.
+    res.violations_ = violations_ - prefix.violations_
+                      - violationsBetween(prefix, res);
+    res.reverseViolations_ = reverseViolations_ - prefix.reverseViolations_
+                             - violationsBetween(res, prefix);
+
+    return res;
+}
+
+SequenceSegment SequenceSegment::reversed() const
+{
+    SS res = *this;
+    std::swap(res.violations_, res.reverseViolations_);
+    return res;
+}
+
+Sequence SequenceSegment::violations() const { return violations_; }
+
+SequenceSegment::SequenceSegment(ProblemData::ClientClass clientClass)
+    : numDelivery(clientClass == ProblemData::ClientClass::DELIVERY),
+      numBoth(clientClass == ProblemData::ClientClass::BOTH),
+      numSalvage(clientClass == ProblemData::ClientClass::SALVAGE)
+{
+}
+
+#endif  // PYVRP_SEQUENCESEGMENT_H
@@ -0,0 +1,248 @@
+#include "SharedMemory.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// The segment starts with a prefix that stores the size of its usable memory,
+// since Windows only reports the size of a mapping rounded up to whole pages.
+// The prefix's size keeps the usable memory aligned to 64 bytes.
+constexpr size_t PREFIX_SIZE = 64;
+
+#ifdef _WIN32
+int lastError() { return static_cast<int>(GetLastError()); }
+#else
+int lastError() { return errno; }
+#endif
+
+// Throws an error for the given operation on the given segment. The error
+// code must be retrieved before cleaning up, since cleaning up may overwrite
+// it.
+[[noreturn]] void
+fail(std::string const &what, std::string const &name, int error)
+{
+#ifdef _WIN32
+    auto const reason = "error code " + std::to_string(error);
+#else
+    std::string const reason = std::strerror(error);
+#endif
+    throw std::runtime_error(what + " " + name + ": " + reason + ".");
+}
+
+[[noreturn]] void invalid(std::string const &name)
+{
+    throw std::runtime_error("Shared memory segment " + name
+                             + " was not created by PyVRP.");
+}
+
+// Returns the size stored in the prefix of a mapping of the given size, or
+// throws if the mapping cannot hold that many bytes after the prefix.
+size_t storedSize(std::byte const *base,
+                  size_t mappedSize,
+                  std::string const &name)
+{
+    if (mappedSize < PREFIX_SIZE)
+        invalid(name);
+
+    uint64_t size;
+    std::memcpy(&size, base, sizeof(size));
+
+    if (size > mappedSize - PREFIX_SIZE)
+        invalid(name);
+
+    return size;
+}
+}  // namespace
+
+std::byte *SharedMemory::data() const { return base_ + PREFIX_SIZE; }
+
+size_t SharedMemory::size() const { return size_; }
+
+std::string const &SharedMemory::name() const { return name_; }
+
+#ifdef _WIN32
+SharedMemory::SharedMemory(std::string name, size_t size)
+    : name_(std::move(name)),
+      mappedSize_(PREFIX_SIZE + size),
+      size_(size)
+{
+    auto const bytes = static_cast<uint64_t>(mappedSize_);
+    auto *mapping = CreateFileMappingA(INVALID_HANDLE_VALUE,
+                                       nullptr,
+                                       PAGE_READWRITE,
+                                       static_cast<DWORD>(bytes >> 32),
+                                       static_cast<DWORD>(bytes),
+                                       name_.c_str());
+    auto error = lastError();
+
+    if (!mapping)
+        fail("Could not create shared memory segment", name_, error);
+
+    if (error == ERROR_ALREADY_EXISTS)
+    {
+        CloseHandle(mapping);
+        fail("Could not create shared memory segment", name_, error);
+    }
+
+    auto *view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    error = lastError();
+
+    if (!view)
+    {
+        CloseHandle(mapping);
+        fail("Could not map shared memory segment", name_, error);
+    }
+
+    // The segment only exists for as long as a handle to it is open, so this
+    // handle is kept until the segment is no longer needed.
+    mapping_ = mapping;
+    base_ = static_cast<std::byte *>(view);
+
+    uint64_t const stored = size_;
+    std::memcpy(base_, &stored, sizeof(stored));
+}
+
+SharedMemory::SharedMemory(std::string name) : name_(std::move(name))
+{
+    auto *mapping = OpenFileMappingA(FILE_MAP_COPY, FALSE, name_.c_str());
+    if (!mapping)
+        fail("Could not open shared memory segment", name_, lastError());
+
+    auto *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    auto const error = lastError();
+    CloseHandle(mapping);  // the view keeps the mapping alive
+
+    if (!view)
+        fail("Could not map shared memory segment", name_, error);
+
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(view, &info, sizeof(info));
+
+    base_ = static_cast<std::byte *>(view);
+    mappedSize_ = info.RegionSize;
+
+    try
+    {
+        size_ = storedSize(base_, mappedSize_, name_);
+    }
+    catch (...)
+    {
+        UnmapViewOfFile(view);
+        throw;
+    }
+}
+
+SharedMemory::~SharedMemory()
+{
+    UnmapViewOfFile(base_);
+
+    if (mapping_)
+        CloseHandle(mapping_);
+}
+#else
+SharedMemory::SharedMemory(std::string name, size_t size)
+    : name_(std::move(name)),
+      mappedSize_(PREFIX_SIZE + size),
+      size_(size),
+      creator_(getpid())
+{
+    // POSIX names of shared memory segments start with a single slash.
+    auto const path = "/" + name_;
+    auto const fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd == -1)
+        fail("Could not create shared memory segment", name_, lastError());
+
+    // Resizing the new, empty segment fills it with zeroes.
+    if (ftruncate(fd, static_cast<off_t>(mappedSize_)) == -1)
+    {
+        auto const error = lastError();
+        close(fd);
+        shm_unlink(path.c_str());
+        fail("Could not resize shared memory segment", name_, error);
+    }
+
+    auto *addr = mmap(
+        nullptr, mappedSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto const error = lastError();
+    close(fd);  // the mapping keeps the segment open
+
+    if (addr == MAP_FAILED)
+    {
+        shm_unlink(path.c_str());
+        fail("Could not map shared memory segment", name_, error);
+    }
+
+    base_ = static_cast<std::byte *>(addr);
+
+    uint64_t const stored = size_;
+    std::memcpy(base_, &stored, sizeof(stored));
+}
+
+SharedMemory::SharedMemory(std::string name) : name_(std::move(name))
+{
+    auto const path = "/" + name_;
+    auto const fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        fail("Could not open shared memory segment", name_, lastError());
+
+    struct stat info;
+    if (fstat(fd, &info) == -1)
+    {
+        auto const error = lastError();
+        close(fd);
+        fail("Could not determine the size of", name_, error);
+    }
+
+    mappedSize_ = static_cast<size_t>(info.st_size);
+    if (mappedSize_ < PREFIX_SIZE)  // too small to have been created by us
+    {
+        close(fd);
+        invalid(name_);
+    }
+
+    // Like MappedFile, this mapping is private and copy-on-write: the segment
+    // is opened read-only, so writes never reach it.
+    auto *addr = mmap(
+        nullptr, mappedSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    auto const error = lastError();
+    close(fd);  // the mapping keeps the segment open
+
+    if (addr == MAP_FAILED)
+        fail("Could not map shared memory segment", name_, error);
+
+    base_ = static_cast<std::byte *>(addr);
+
+    try
+    {
+        size_ = storedSize(base_, mappedSize_, name_);
+    }
+    catch (...)
+    {
+        munmap(addr, mappedSize_);
+        throw;
+    }
+}
+
+SharedMemory::~SharedMemory()
+{
+    munmap(base_, mappedSize_);
+
+    if (creator_ == getpid())
+        shm_unlink(("/" + name_).c_str());
+}
+#endif
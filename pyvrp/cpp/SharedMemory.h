@@ -0,0 +1,74 @@
+#ifndef PYVRP_SHAREDMEMORY_H
+#define PYVRP_SHAREDMEMORY_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A named shared memory segment. One process creates the segment and fills
+ * it, after which other processes can attach to it by name. Attached
+ * processes cannot change the segment: like MappedFile, their mapping is
+ * copy-on-write, so writes to the mapped memory stay private to the mapping.
+ * Pages that are only read are shared by all processes.
+ *
+ * The segment's name is removed when the object that created it is destroyed
+ * (on Windows, once no process maps the segment anymore). Processes that are
+ * still attached at that time keep their mapping, which remains valid until
+ * they are done with it. Forked child processes inherit the object, but only
+ * the process that created the segment removes it.
+ */
+class SharedMemory
+{
+    std::string name_;
+    std::byte *base_ = nullptr;  // start of the mapping, including the prefix
+    size_t mappedSize_ = 0;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void *mapping_ = nullptr;  // handle that keeps a created segment alive
+#else
+    long creator_ = 0;  // id of the process that created the segment, if any
+#endif
+
+public:
+    /**
+     * @return Pointer to the start of the segment's usable memory. This is
+     *         aligned to at least 64 bytes.
+     */
+    [[nodiscard]] std::byte *data() const;
+
+    /**
+     * @return Size of the segment's usable memory, in bytes.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @return The segment's name.
+     */
+    [[nodiscard]] std::string const &name() const;
+
+    /**
+     * Creates a new segment with the given name, with room for the given
+     * number of bytes. The memory is zero-initialised.
+     *
+     * @throws std::runtime_error When the segment cannot be created, for
+     *                            example because a segment with the same name
+     *                            already exists.
+     */
+    SharedMemory(std::string name, size_t size);
+
+    /**
+     * Attaches to the existing segment with the given name.
+     *
+     * @throws std::runtime_error When there is no such segment, or when it
+     *                            cannot be mapped.
+     */
+    explicit SharedMemory(std::string name);
+
+    SharedMemory(SharedMemory const &other) = delete;
+
+    SharedMemory &operator=(SharedMemory const &other) = delete;
+
+    ~SharedMemory();
+};
+
+#endif  // PYVRP_SHAREDMEMORY_H
@@ -1,5 +1,6 @@
 #include "Solution.h"
 #include "ProblemData.h"
+#include "SequenceSegment.h"
 
 #include <fstream>
 #include <numeric>
@@ -27,8 +28,33 @@ void Solution::evaluate(ProblemData const &data)
         excessVolume_ += route.excessVolume();
         excessSalvage_ += route.excessSalvage();
         excessStores_ += route.excessStores();
+        sequenceViolations_ += route.sequenceViolations();
     }
 
+    // Order splits are a property of the solution as a whole: we count, for
+    // each order, the number of distinct routes its clients are visited on.
+    std::vector<size_t> spannedRoutes(data.numOrders(), 0);
+    std::vector<size_t> lastRoute(data.numOrders(), routes_.size());
+
+    for (size_t idx = 0; idx != routes_.size(); ++idx)
+        for (auto const client : routes_[idx])
+        {
+            auto const order = data.client(client).clientOrder;
+            if (order < 0)
+                continue;
+
+            auto const orderIdx = static_cast<size_t>(order.get());
+            if (lastRoute[orderIdx] != idx)  // first visit on this route
+            {
+                lastRoute[orderIdx] = idx;
+                spannedRoutes[orderIdx]++;
+            }
+        }
+
+    for (auto const spanned : spannedRoutes)
+        if (data.orderRouteLimit() < spanned)
+            excessOrders_ += Order(spanned) - data.orderRouteLimit();
+
     uncollectedPrizes_ = allPrizes - prizes_;
 }
 
@@ -38,17 +64,35 @@ size_t Solution::numClients() const { return numClients_; }
 
 Routes const &Solution::getRoutes() const { return routes_; }
 
+std::vector<std::vector<Client>> Solution::originalRoutes() const
+{
+    std::vector<std::vector<Client>> routes;
+    routes.reserve(routes_.size());
+
+    for (auto const &route : routes_)
+    {
+        auto &visits = routes.emplace_back(route.visits());
+        if (originalIds_)
+            for (auto &client : visits)
+                client = (*originalIds_)[client];
+    }
+
+    return routes;
+}
+
 std::vector<std::pair<Client, Client>> const &Solution::getNeighbours() const
 {
     return neighbours;
 }
 
-bool Solution::isFeasible() const { return !hasExcessWeight() && !hasExcessVolume() && !hasExcessSalvage() && !hasExcessStores() && !hasTimeWarp(); }
+bool Solution::isFeasible() const { return !hasExcessWeight() && !hasExcessVolume() && !hasExcessSalvage() && !hasExcessStores() && !hasExcessOrders() && !hasSequenceViolations() && !hasTimeWarp(); }
 
 bool Solution::hasExcessWeight() const { return excessWeight_ > 0; }
 bool Solution::hasExcessVolume() const { return excessVolume_ > 0; }
 bool Solution::hasExcessSalvage() const { return excessSalvage_ > 0; }
 bool Solution::hasExcessStores() const { return excessStores_ > 0; }
+bool Solution::hasExcessOrders() const { return excessOrders_ > 0; }
+bool Solution::hasSequenceViolations() const { return sequenceViolations_ > 0; }
 bool Solution::hasTimeWarp() const { return timeWarp_ > 0; }
 
 Distance Solution::distance() const { return distance_; }
@@ -57,6 +101,8 @@ Load Solution::excessWeight() const { return excessWeight_; }
 Load Solution::excessVolume() const { return excessVolume_; }
 Salvage Solution::excessSalvage() const { return excessSalvage_; }
 Store Solution::excessStores() const { return excessStores_; }
+Order Solution::excessOrders() const { return excessOrders_; }
+Sequence Solution::sequenceViolations() const { return sequenceViolations_; }
 
 Cost Solution::prizes() const { return prizes_; }
 
@@ -83,6 +129,8 @@ bool Solution::operator==(Solution const &other) const
         && excessVolume_ == other.excessVolume_
         && excessSalvage_ == other.excessSalvage_
         && excessStores_ == other.excessStores_
+        && excessOrders_ == other.excessOrders_
+        && sequenceViolations_ == other.sequenceViolations_
         && timeWarp_ == other.timeWarp_
         && routes_.size() == other.routes_.size()
         && neighbours == other.neighbours;
@@ -90,7 +138,8 @@ bool Solution::operator==(Solution const &other) const
 }
 
 Solution::Solution(ProblemData const &data, XorShift128 &rng)
-    : neighbours(data.numClients() + 1, {0, 0})
+    : neighbours(data.numClients() + 1, {0, 0}),
+      originalIds_(data.originalIds())
 {
     // Shuffle clients (to create random routes)
     auto clients = std::vector<int>(data.numClients());
@@ -119,7 +168,8 @@ Solution::Solution(ProblemData const &data, XorShift128 &rng)
 
 Solution::Solution(ProblemData const &data,
                    std::vector<std::vector<Client>> const &routes)
-    : neighbours(data.numClients() + 1, {0, 0})
+    : neighbours(data.numClients() + 1, {0, 0}),
+      originalIds_(data.originalIds())
 {
     if (routes.size() > data.numVehicles())
     {
@@ -168,6 +218,7 @@ Solution::Route::Route(ProblemData const &data, Visits const visits)
     Duration time = data.depot().twEarly;
     int prevClient = 0;
     std::set<int> uniqueStores; 
+    SequenceSegment sequence;
 
     for (size_t idx = 0; idx != size(); ++idx)
     {
@@ -179,6 +230,8 @@ Solution::Route::Route(ProblemData const &data, Visits const visits)
         demandVolume_ += clientData.demandVolume;
         demandSalvage_ += clientData.demandSalvage;
         uniqueStores.insert(static_cast<int>(clientData.clientStore));
+        sequence = SequenceSegment::merge(
+            sequence, SequenceSegment(data.clientClass(visits_[idx])));
         service_ += clientData.serviceDuration;
         prizes_ += clientData.prize;
     
@@ -204,6 +257,7 @@ Solution::Route::Route(ProblemData const &data, Visits const visits)
     }
 
     routeStores_ = uniqueStores.size();  // Set routeStores to the number of unique store IDs
+    sequenceViolations_ = sequence.violations();
 
     Client const last = visits_.back();  // last client has depot as successor
     distance_ += data.dist(last, 0);
@@ -338,6 +392,11 @@ Salvage Solution::Route::excessSalvage() const { return excessSalvage_; }
 
 Store Solution::Route::excessStores() const { return excessStores_; }
 
+Sequence Solution::Route::sequenceViolations() const
+{
+    return sequenceViolations_;
+}
+
 Duration Solution::Route::duration() const { return duration_; }
 
 Duration Solution::Route::serviceDuration() const { return service_; }
@@ -355,7 +414,8 @@ std::pair<double, double> const &Solution::Route::centroid() const
 
 bool Solution::Route::isFeasible() const
 {
-    return !hasExcessWeight() && !hasExcessVolume() && !hasExcessSalvage() && !hasTimeWarp();
+    return !hasExcessWeight() && !hasExcessVolume() && !hasExcessSalvage()
+           && !hasSequenceViolations() && !hasTimeWarp();
 }
 
 bool Solution::Route::hasExcessWeight() const { return excessWeight_ > 0; }
@@ -366,15 +426,25 @@ bool Solution::Route::hasExcessSalvage() const { return excessSalvage_ > 0; }
 
 bool Solution::Route::hasExcessStores() const { return excessStores_ > 0; }
 
+bool Solution::Route::hasSequenceViolations() const
+{
+    return sequenceViolations_ > 0;
+}
+
 bool Solution::Route::hasTimeWarp() const { return timeWarp_ > 0; }
 
 std::ostream &operator<<(std::ostream &out, Solution const &sol)
 {
     auto const &routes = sol.getRoutes();
 
+    auto const originalRoutes = sol.originalRoutes();
+
     for (size_t idx = 0; idx != routes.size(); ++idx)
     {
-        out << "Route #" << idx + 1 << ": " << routes[idx] << '\n';
+        out << "Route #" << idx + 1 << ": ";
+        for (auto const client : originalRoutes[idx])
+            out << client << ' ';
+        out << '\n';
 
         if (routes[idx].hasExcessWeight())
             out << "Excess weight: " << routes[idx].excessWeight() << '\n';
@@ -387,6 +457,10 @@ std::ostream &operator<<(std::ostream &out, Solution const &sol)
 
         if (routes[idx].hasExcessStores())
             out << "Excess stores: " << routes[idx].excessStores() << '\n';
+
+        if (routes[idx].hasSequenceViolations())
+            out << "Sequence violations: " << routes[idx].sequenceViolations()
+                << '\n';
     }
 
     return out;
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 class Solution
@@ -32,8 +33,8 @@ public:
         Load excessWeight_ = 0;    // Excess weight demand (wrt vehicle weight capacity)
         Load excessVolume_ = 0;    // Excess volume demand (wrt vehicle volume capacity)
         Salvage excessSalvage_ = 0; // Number of excess salvage stops on this route above max (0)
-        Order excessOrders_ = 0; // Contribution of a routes number of order splits above limit
         Store excessStores_ = 0; // Number of delivery stops on this route above limit
+        Sequence sequenceViolations_ = 0;  // Out of sequence client pairs
         Duration duration_ = 0;  // Total travel duration on this route
         Duration service_ = 0;   // Total service duration on this route
         Duration timeWarp_ = 0;  // Total time warp on this route
@@ -61,8 +62,8 @@ public:
         [[nodiscard]] Load excessWeight() const;
         [[nodiscard]] Load excessVolume() const;
         [[nodiscard]] Salvage excessSalvage() const;
-        [[nodiscard]] Order excessOrders() const;
         [[nodiscard]] Store excessStores() const;
+        [[nodiscard]] Sequence sequenceViolations() const;
         [[nodiscard]] Duration duration() const;
         [[nodiscard]] Duration serviceDuration() const;
         [[nodiscard]] Duration timeWarp() const;
@@ -76,6 +77,7 @@ public:
         [[nodiscard]] bool hasExcessVolume() const;
         [[nodiscard]] bool hasExcessSalvage() const;
         [[nodiscard]] bool hasExcessStores() const;
+        [[nodiscard]] bool hasSequenceViolations() const;
         [[nodiscard]] bool hasTimeWarp() const;
 
         Route() = default;  // default is empty
@@ -91,6 +93,8 @@ private:
     Load excessVolume_ = 0;         // Total excess volume load over all routes
     Salvage excessSalvage_ = 0; // Total excess salvage stop over all routes
     Store excessStores_ = 0; // Total excess stores on route
+    Order excessOrders_ = 0; // Total order splits over the order route limit
+    Sequence sequenceViolations_ = 0;  // Total out of sequence client pairs
     Cost prizes_ = 0;             // Total collected prize value
     Cost uncollectedPrizes_ = 0;  // Total uncollected prize value
     Duration timeWarp_ = 0;       // Total time warp over all routes
@@ -98,6 +102,10 @@ private:
     Routes routes_;  // Routes - only includes non-empty routes
     std::vector<std::pair<Client, Client>> neighbours;  // pairs of [pred, succ]
 
+    // Original ids of the clients, if the problem data's clients have been
+    // renumbered. See ProblemData::renumbered().
+    std::shared_ptr<std::vector<int> const> originalIds_;
+
     // Determines the [pred, succ] pairs for each client.
     void makeNeighbours();
 
@@ -121,6 +129,13 @@ public:
      */
     [[nodiscard]] Routes const &getRoutes() const;
 
+    /**
+     * Returns the visits of each route, in terms of the clients' original ids.
+     * These differ from the visits of the routes returned by ``getRoutes``
+     * only if the problem data's clients have been renumbered.
+     */
+    [[nodiscard]] std::vector<std::vector<Client>> originalRoutes() const;
+
     /**
      * Returns a vector of [pred, succ] clients for each client (index) in this
      * solutions's routes. Includes the depot at index 0.
@@ -153,6 +168,18 @@ public:
      */
     [[nodiscard]] bool hasExcessStores() const;
 
+    /**
+     * @return True if the solution splits an order over more routes than the
+     *         order route limit allows.
+     */
+    [[nodiscard]] bool hasExcessOrders() const;
+
+    /**
+     * @return True if the solution visits clients out of the required
+     *         delivery/salvage sequence on some route.
+     */
+    [[nodiscard]] bool hasSequenceViolations() const;
+
     /**
      * @return True if the solution violates time window constraints.
      */
@@ -178,6 +205,18 @@ public:
      */
     [[nodiscard]] Store excessStores() const;
 
+    /**
+     * @return Total number of routes that orders span in excess of the order
+     *         route limit, summed over all orders.
+     */
+    [[nodiscard]] Order excessOrders() const;
+
+    /**
+     * @return Total number of client pairs that are visited out of the
+     *         required delivery/salvage sequence, summed over all routes.
+     */
+    [[nodiscard]] Sequence sequenceViolations() const;
+
     /**
      * @return Total excess load volume over all routes.
      */
@@ -240,6 +279,8 @@ template <> struct hash<Solution>
         res = res * 31 + std::hash<Load>()(sol.excessVolume_);
         res = res * 31 + std::hash<Salvage>()(sol.excessSalvage_);
         res = res * 31 + std::hash<Store>()(sol.excessStores_);
+        res = res * 31 + std::hash<Order>()(sol.excessOrders_);
+        res = res * 31 + std::hash<Sequence>()(sol.sequenceViolations_);
         res = res * 31 + std::hash<Duration>()(sol.timeWarp_);
 
         return res;
@@ -44,6 +44,10 @@ PYBIND11_MODULE(_Solution, m)
              [](Solution::Route const &route) {
                  return route.excessStores().get();
              })
+        .def("sequence_violations",
+             [](Solution::Route const &route) {
+                 return route.sequenceViolations().get();
+             })
         .def(
             "duration",
             [](Solution::Route const &route) { return route.duration().get(); })
@@ -65,6 +69,8 @@ PYBIND11_MODULE(_Solution, m)
         .def("has_excess_weight", &Solution::Route::hasExcessWeight)
         .def("has_excess_volume", &Solution::Route::hasExcessVolume)
         .def("has_excess_salvage", &Solution::Route::hasExcessSalvage)
+        .def("has_sequence_violations",
+             &Solution::Route::hasSequenceViolations)
         .def("has_time_warp", &Solution::Route::hasTimeWarp)
         .def("__len__", &Solution::Route::size)
         .def(
@@ -93,7 +99,8 @@ PYBIND11_MODULE(_Solution, m)
         .def(py::init<ProblemData const &,
                       std::vector<std::vector<int>> const &>(),
              py::arg("data"),
-             py::arg("routes"))
+             py::arg("routes"),
+             py::call_guard<py::gil_scoped_release>())
         .def_property_readonly_static(
             "make_random",                // this is a bit of a workaround for
             [](py::object)                // classmethods, because pybind does
@@ -103,13 +110,15 @@ PYBIND11_MODULE(_Solution, m)
                         return Solution(data, rng);
                     },
                     py::arg("data"),
-                    py::arg("rng"));
+                    py::arg("rng"),
+                    py::call_guard<py::gil_scoped_release>());
             })
         .def("num_routes", &Solution::numRoutes)
         .def("num_clients", &Solution::numClients)
         .def("get_routes",
              &Solution::getRoutes,
              py::return_value_policy::reference_internal)
+        .def("original_routes", &Solution::originalRoutes)
         .def("get_neighbours",
              &Solution::getNeighbours,
              py::return_value_policy::reference_internal)
@@ -117,6 +126,8 @@ PYBIND11_MODULE(_Solution, m)
         .def("has_excess_weight", &Solution::hasExcessWeight)
         .def("has_excess_volume", &Solution::hasExcessVolume)
         .def("has_excess_salvage", &Solution::hasExcessSalvage)
+        .def("has_excess_orders", &Solution::hasExcessOrders)
+        .def("has_sequence_violations", &Solution::hasSequenceViolations)
         .def("has_time_warp", &Solution::hasTimeWarp)
         .def("distance",
              [](Solution const &sol) { return sol.distance().get(); })
@@ -128,6 +139,10 @@ PYBIND11_MODULE(_Solution, m)
              [](Solution const &sol) { return sol.excessSalvage().get(); })
         .def("excess_stores",
              [](Solution const &sol) { return sol.excessStores().get(); })
+        .def("excess_orders",
+             [](Solution const &sol) { return sol.excessOrders().get(); })
+        .def("sequence_violations",
+             [](Solution const &sol) { return sol.sequenceViolations().get(); })
         .def("time_warp",
              [](Solution const &sol) { return sol.timeWarp().get(); })
         .def("prizes", [](Solution const &sol) { return sol.prizes().get(); })
@@ -39,7 +39,8 @@ PYBIND11_MODULE(_SubPopulation, m)
         .def("add",
              &SubPopulation::add,
              py::arg("solution"),
-             py::arg("cost_evaluator"))
+             py::arg("cost_evaluator"),
+             py::call_guard<py::gil_scoped_release>())
         .def("__len__", &SubPopulation::size)
         .def(
             "__getitem__",
@@ -58,8 +59,12 @@ PYBIND11_MODULE(_SubPopulation, m)
                 return py::make_iterator(subPop.cbegin(), subPop.cend());
             },
             py::return_value_policy::reference_internal)
-        .def("purge", &SubPopulation::purge, py::arg("cost_evaluator"))
+        .def("purge",
+             &SubPopulation::purge,
+             py::arg("cost_evaluator"),
+             py::call_guard<py::gil_scoped_release>())
         .def("update_fitness",
              &SubPopulation::updateFitness,
-             py::arg("cost_evaluator"));
+             py::arg("cost_evaluator"),
+             py::call_guard<py::gil_scoped_release>());
 }
@@ -0,0 +1,80 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t numThreads)
+{
+    threads_.reserve(numThreads);
+    for (size_t thread = 1; thread <= numThreads; ++thread)
+        threads_.emplace_back(&ThreadPool::work, this, thread);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+
+    wake_.notify_all();
+}
+
+size_t ThreadPool::size() const { return threads_.size() + 1; }
+
+void ThreadPool::run(size_t numThreads, Job const &job)
+{
+    numThreads = std::clamp<size_t>(numThreads, 1, size());
+
+    if (numThreads == 1)  // no need to wake any threads
+    {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        job_ = &job;
+        numActive_ = numThreads;
+        numBusy_ = numThreads - 1;
+        generation_++;
+    }
+
+    wake_.notify_all();
+    job(0);
+
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [&] { return numBusy_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::work(size_t thread)
+{
+    size_t seen = 0;  // last job this thread woke up for
+
+    while (true)
+    {
+        Job const *job = nullptr;
+
+        {
+            std::unique_lock lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+
+            if (stop_)
+                return;
+
+            // run() waits for all threads of a job before starting the next,
+            // so a thread never misses a job that it takes part in.
+            seen = generation_;
+            if (thread >= numActive_)
+                continue;
+
+            job = job_;
+        }
+
+        (*job)(thread);
+
+        std::lock_guard lock(mutex_);
+        if (--numBusy_ == 0)
+            done_.notify_one();
+    }
+}
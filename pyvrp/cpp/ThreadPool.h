@@ -0,0 +1,67 @@
+#ifndef PYVRP_THREADPOOL_H
+#define PYVRP_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of threads that run jobs together with the calling thread. The
+ * threads are started once, and wait between jobs, so that short jobs do not
+ * pay for starting and joining threads every time they are run. A pool runs
+ * one job at a time: it must not be used from several threads at once.
+ */
+class ThreadPool
+{
+public:
+    using Job = std::function<void(size_t)>;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable wake_;  // signals a new job, or stopping
+    std::condition_variable done_;  // signals that the threads finished a job
+
+    Job const *job_ = nullptr;  // the current job, while it runs
+    size_t generation_ = 0;     // number of jobs started so far
+    size_t numActive_ = 0;      // threads, including the caller, running it
+    size_t numBusy_ = 0;        // pool threads still running it
+    bool stop_ = false;
+
+    // Declared last, so that the threads are joined before the members they
+    // use are destroyed.
+    std::vector<std::jthread> threads_;
+
+    // Waits for jobs, and runs those it takes part in as the given thread.
+    void work(size_t thread);
+
+public:
+    /**
+     * Starts the given number of threads, in addition to the calling thread.
+     */
+    explicit ThreadPool(size_t numThreads);
+
+    ThreadPool(ThreadPool const &other) = delete;
+
+    ThreadPool &operator=(ThreadPool const &other) = delete;
+
+    ~ThreadPool();
+
+    /**
+     * @return Number of threads that can run a job, including the calling
+     *         thread.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * Calls the given job once on each of the given number of threads, with
+     * that thread's index, and blocks until all calls have returned. The
+     * calling thread is thread 0. The number of threads is capped at size().
+     * The job must not throw.
+     */
+    void run(size_t numThreads, Job const &job);
+};
+
+#endif  // PYVRP_THREADPOOL_H
@@ -8,6 +8,8 @@ class TimeWindowSegment
 {
     using TWS = TimeWindowSegment;
 
+    friend class RouteSnapshot;  // reads the fields into its own arrays
+
     int idxFirst = 0;       // Index of the first client in the segment
     int idxLast = 0;        // Index of the last client in the segment
     Duration duration = 0;  // Total duration, incl. waiting and servicing
@@ -15,16 +17,21 @@ class TimeWindowSegment
     Duration twEarly = 0;   // Earliest visit moment of first client
     Duration twLate = 0;    // Latest visit moment of last client
 
-    [[nodiscard]] inline TWS merge(Matrix<Duration> const &durationMatrix,
+    template <typename DurationMatrix>
+    [[nodiscard]] inline TWS merge(DurationMatrix const &durationMatrix,
                                    TWS const &other) const;
 
 public:
-    template <typename... Args>
-    [[nodiscard]] inline static TWS
-    merge(Matrix<Duration> const &durationMatrix,
-          TWS const &first,
-          TWS const &second,
-          Args... args);
+    /**
+     * Merges the given segments, in order. The duration matrix can be any
+     * matrix-like type whose elements are indexed by (from, to), such as a
+     * Matrix<Duration> or ProblemData::Durations.
+     */
+    template <typename DurationMatrix, typename... Args>
+    [[nodiscard]] inline static TWS merge(DurationMatrix const &durationMatrix,
+                                          TWS const &first,
+                                          TWS const &second,
+                                          Args... args);
 
     /**
      * Total time warp, that is, the time warp along the the segment, and
@@ -42,8 +49,9 @@ public:
                              Duration twLate);
 };
 
+template <typename DurationMatrix>
 TimeWindowSegment TimeWindowSegment::merge(
-    [[maybe_unused]] Matrix<Duration> const &durationMatrix,
+    [[maybe_unused]] DurationMatrix const &durationMatrix,
     [[maybe_unused]] TimeWindowSegment const &other) const
 {
 #ifdef PYVRP_NO_TIME_WINDOWS
@@ -63,9 +71,9 @@ TimeWindowSegment TimeWindowSegment::merge(
 #endif
 }
 
-template <typename... Args>
+template <typename DurationMatrix, typename... Args>
 TimeWindowSegment TimeWindowSegment::merge(
-    [[maybe_unused]] Matrix<Duration> const &durationMatrix,
+    [[maybe_unused]] DurationMatrix const &durationMatrix,
     [[maybe_unused]] TimeWindowSegment const &first,
     [[maybe_unused]] TimeWindowSegment const &second,
     [[maybe_unused]] Args... args)
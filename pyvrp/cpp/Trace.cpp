@@ -0,0 +1,215 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Number of slots in the ring buffer. Must be a power of two.
+constexpr size_t NUM_SLOTS = 1 << 14;
+
+char const *categoryName(trace::Category category)
+{
+    switch (category)
+    {
+    case trace::Category::SEARCH:
+        return "search";
+    case trace::Category::ROUTE:
+        return "route";
+    case trace::Category::OPERATOR:
+        return "operator";
+    case trace::Category::CROSSOVER:
+        return "crossover";
+    }
+
+    return "unknown";
+}
+
+// Bounded multi-producer, single-consumer ring buffer, after Vyukov's bounded
+// MPMC queue. Each slot carries a sequence number that tells producers and
+// the consumer whether the slot is free to be written, or ready to be read.
+// Producers never block: when the buffer is full, the message is dropped.
+class Sink
+{
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        trace::Category category;
+        trace::Level level;
+        uint16_t length;
+        char text[trace::Message::CAPACITY];
+    };
+
+    std::array<Slot, NUM_SLOTS> slots;
+    alignas(64) std::atomic<size_t> enqueuePos = 0;
+    alignas(64) size_t dequeuePos = 0;  // only touched by the drain thread
+    alignas(64) std::atomic<size_t> written = 0;
+    std::atomic<size_t> dropped = 0;
+    std::atomic<bool> stop = false;
+
+    uint32_t mask = ~0u;  // enabled categories
+    std::FILE *out = stderr;
+    std::thread drainer;
+
+    // Writes out all messages that are currently ready. Returns the number of
+    // messages that have been written.
+    size_t drain()
+    {
+        size_t count = 0;
+
+        while (true)
+        {
+            auto &slot = slots[dequeuePos & (NUM_SLOTS - 1)];
+            auto const seq = slot.sequence.load(std::memory_order_acquire);
+
+            if (seq != dequeuePos + 1)  // not yet ready, or buffer is empty
+                break;
+
+            std::fprintf(out,
+                         "[%s:%s] %.*s\n",
+                         categoryName(slot.category),
+                         slot.level == trace::Level::INFO ? "info" : "debug",
+                         static_cast<int>(slot.length),
+                         slot.text);
+
+            slot.sequence.store(dequeuePos + NUM_SLOTS,
+                                std::memory_order_release);
+            dequeuePos++;
+            count++;
+        }
+
+        if (auto const numDropped = dropped.exchange(0))
+            std::fprintf(out, "[trace] dropped %zu messages\n", numDropped);
+
+        if (count > 0)
+        {
+            std::fflush(out);
+            written.fetch_add(count, std::memory_order_release);
+        }
+
+        return count;
+    }
+
+    void flush()
+    {
+        // Every message that claimed a slot is eventually written out, so we
+        // wait until the written count catches up with the number of slots
+        // that were claimed when this function was called.
+        auto const target = enqueuePos.load(std::memory_order_acquire);
+        while (written.load(std::memory_order_acquire) < target)
+            std::this_thread::yield();
+    }
+
+    void run()
+    {
+        while (!stop.load(std::memory_order_acquire))
+            if (drain() == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        drain();
+    }
+
+public:
+    Sink()
+    {
+        for (size_t idx = 0; idx != NUM_SLOTS; ++idx)
+            slots[idx].sequence.store(idx, std::memory_order_relaxed);
+
+        if (char const *categories = std::getenv("PYVRP_TRACE_CATEGORIES"))
+        {
+            mask = 0;
+            std::string const names = categories;
+
+            for (auto cat : {trace::Category::SEARCH,
+                             trace::Category::ROUTE,
+                             trace::Category::OPERATOR,
+                             trace::Category::CROSSOVER})
+                if (names.find(categoryName(cat)) != std::string::npos)
+                    mask |= 1u << static_cast<uint32_t>(cat);
+        }
+
+        // Each extension module has its own sink, so the file is opened for
+        // appending: truncating it would discard what other sinks wrote.
+        if (char const *path = std::getenv("PYVRP_TRACE_FILE"))
+            if (auto *file = std::fopen(path, "a"))
+                out = file;
+
+        drainer = std::thread(&Sink::run, this);
+    }
+
+    // Runs at exit, since the sink is a function-local static. Messages that
+    // are still in the buffer are written out before the drain thread stops.
+    ~Sink()
+    {
+        flush();
+        stop.store(true, std::memory_order_release);
+        drainer.join();
+
+        if (out != stderr)
+            std::fclose(out);
+    }
+
+    [[nodiscard]] bool enabled(trace::Category category) const
+    {
+        return mask & (1u << static_cast<uint32_t>(category));
+    }
+
+    void push(trace::Category category,
+              trace::Level level,
+              std::string_view message)
+    {
+        auto pos = enqueuePos.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto &slot = slots[pos & (NUM_SLOTS - 1)];
+            auto const seq = slot.sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+            if (diff == 0)  // slot is free: try to claim it
+            {
+                if (enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                {
+                    auto const length
+                        = std::min(message.size(), sizeof(slot.text));
+
+                    std::memcpy(slot.text, message.data(), length);
+                    slot.category = category;
+                    slot.level = level;
+                    slot.length = static_cast<uint16_t>(length);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            }
+            else if (diff < 0)  // buffer is full
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else  // another producer claimed this slot; reload and retry
+                pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+Sink &sink()
+{
+    static Sink instance;
+    return instance;
+}
+}  // namespace
+
+bool trace::enabled(Category category) { return sink().enabled(category); }
+
+void trace::write(Category category, Level level, std::string_view message)
+{
+    sink().push(category, level, message);
+}
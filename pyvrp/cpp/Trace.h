@@ -0,0 +1,97 @@
+#ifndef PYVRP_TRACE_H
+#define PYVRP_TRACE_H
+
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+
+// Compile-time trace level. Level 0 (the default) compiles all tracing out of
+// the extensions; level 1 keeps informational messages, and level 2 also keeps
+// the (very verbose) per-evaluation debug messages. Set via the meson 'trace'
+// option.
+#ifndef PYVRP_TRACE_LEVEL
+#define PYVRP_TRACE_LEVEL 0
+#endif
+
+namespace trace
+{
+enum class Category : uint8_t
+{
+    SEARCH,
+    ROUTE,
+    OPERATOR,
+    CROSSOVER,
+};
+
+enum class Level : uint8_t
+{
+    INFO = 1,
+    DEBUG = 2,
+};
+
+/**
+ * Returns whether messages of the given category should be recorded. All
+ * categories are enabled by default; the ``PYVRP_TRACE_CATEGORIES`` environment
+ * variable can be set to a comma-separated list of category names (e.g.
+ * ``search,operator``) to restrict this.
+ */
+bool enabled(Category category);
+
+/**
+ * Pushes the given message onto the trace ring buffer. This does not block: it
+ * either claims a free slot in the buffer, or drops the message when the
+ * buffer is full. Messages are written out by a background thread, either to
+ * stderr, or appended to the file given by the ``PYVRP_TRACE_FILE``
+ * environment variable. Messages still in the buffer at exit are written out
+ * before the program ends.
+ */
+void write(Category category, Level level, std::string_view message);
+
+/**
+ * Formats a single trace message into a fixed-size, stack-allocated buffer.
+ * Messages that do not fit are truncated.
+ */
+class Message : private std::streambuf, public std::ostream
+{
+public:
+    static constexpr size_t CAPACITY = 240;
+
+private:
+    char buffer[CAPACITY];
+
+public:
+    Message() : std::ostream(this) { setp(buffer, buffer + CAPACITY); }
+
+    [[nodiscard]] std::string_view view() const
+    {
+        return {pbase(), static_cast<size_t>(pptr() - pbase())};
+    }
+};
+}  // namespace trace
+
+#if PYVRP_TRACE_LEVEL > 0
+#define PYVRP_TRACE(category, level, ...)                                      \
+    do                                                                         \
+    {                                                                          \
+        if constexpr (static_cast<int>(trace::Level::level)                    \
+                      <= PYVRP_TRACE_LEVEL)                                    \
+        {                                                                      \
+            if (trace::enabled(trace::Category::category))                     \
+            {                                                                  \
+                trace::Message traceMessage;                                   \
+                traceMessage << __VA_ARGS__;                                   \
+                trace::write(trace::Category::category,                        \
+                             trace::Level::level,                              \
+                             traceMessage.view());                             \
+            }                                                                  \
+        }                                                                      \
+    } while (false)
+#else
+#define PYVRP_TRACE(category, level, ...)                                      \
+    do                                                                         \
+    {                                                                          \
+    } while (false)
+#endif
+
+#endif  // PYVRP_TRACE_H
@@ -1,5 +1,6 @@
 #include "crossover.h"
 #include "Measure.h"
+#include "Trace.h"
 
 #include <cmath>
 #include <limits>
@@ -23,16 +24,13 @@ Cost deltaCost(Client client,
 #ifdef PYVRP_NO_TIME_WINDOWS
     return static_cast<Cost>(propDist - currDist);
 #else
-    auto const &clientData = data.client(client);
-    auto const &prevData = data.client(prev);
-
-    auto const clientService = clientData.serviceDuration;
-    auto const clientLate = clientData.twLate;
-    auto const nextLate = data.client(next).twLate;
+    auto const clientService = data.serviceDuration(client);
+    auto const clientLate = data.twLate(client);
+    auto const nextLate = data.twLate(next);
 
     // Determine the earliest time we can depart from prev.
-    auto const prevStart = std::max(data.duration(0, prev), prevData.twEarly);
-    auto const prevFinish = prevStart + prevData.serviceDuration;
+    auto const prevStart = std::max(data.duration(0, prev), data.twEarly(prev));
+    auto const prevFinish = prevStart + data.serviceDuration(prev);
 
     // Time warp when we go directly from prev to next (current situation).
     auto const prevNextArrive = prevFinish + data.duration(prev, next);
@@ -42,7 +40,7 @@ Cost deltaCost(Client client,
     // after client.twLate. We finish at start time + service. We subtract any
     // time warp from the departure time at client.
     auto const clientArrive = prevFinish + data.duration(prev, client);
-    auto const clientStart = std::max(clientArrive, clientData.twEarly);
+    auto const clientStart = std::max(clientArrive, data.twEarly(client));
     auto const clientTimeWarp = std::max<Duration>(clientStart - clientLate, 0);
     auto const clientFinish = clientStart - clientTimeWarp + clientService;
 
@@ -64,7 +62,7 @@ void crossover::greedyRepair(Routes &routes,
                              ProblemData const &data,
                              CostEvaluator const &costEvaluator)
 {
-    std::cout << "                    CROSSOVER GREEDY Enter" << std::endl;
+    PYVRP_TRACE(CROSSOVER, DEBUG, "CROSSOVER GREEDY Enter");
     auto const numRoutes = routes.size();
 
     // Determine centroids of each route.
@@ -1,4 +1,5 @@
 #include "crossover.h"
+#include "Trace.h"
 
 #include <cassert>
 #include <cmath>
@@ -45,7 +46,7 @@ Solution selectiveRouteExchange(
     std::pair<size_t, size_t> const startIndices,
     size_t const numMovedRoutes)
 {
-    std::cout << "          SELECTEXCHANGE Enter" << std::endl;
+    PYVRP_TRACE(CROSSOVER, INFO, "SELECTEXCHANGE Enter");
 
     std::mt19937 rng;
     // We create two candidate offsprings, both based on parent A:
@@ -238,7 +239,7 @@ Solution selectiveRouteExchange(
 
     auto const cost1 = costEvaluator.penalisedCost(sol1);
     auto const cost2 = costEvaluator.penalisedCost(sol2);
-    std::cout << "Cost1: " << cost1 <<  " Cost2: " << cost2 << std::endl;
+    PYVRP_TRACE(CROSSOVER, INFO, "Cost1: " << cost1 << " Cost2: " << cost2);
 
     return cost1 < cost2 ? sol1 : sol2;
 }
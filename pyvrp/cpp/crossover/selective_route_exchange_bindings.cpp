@@ -12,5 +12,6 @@ PYBIND11_MODULE(_selective_route_exchange, m)
           py::arg("data"),
           py::arg("cost_evaluator"),
           py::arg("start_indices"),
-          py::arg("num_moved_routes"));
+          py::arg("num_moved_routes"),
+          py::call_guard<py::gil_scoped_release>());
 }
@@ -2,10 +2,13 @@
 #define PYVRP_EXCHANGE_H
 
 #include "LocalSearchOperator.h"
+#include "SequenceSegment.h"
 #include "TimeWindowSegment.h"
+#include "Trace.h"
 
 #include <cassert>
 
+using SS = SequenceSegment;
 using TWS = TimeWindowSegment;
 
 /**
@@ -37,51 +40,15 @@ template <size_t N, size_t M> class Exchange : public LocalSearchOperator<Node>
     Cost
     evalSwapMove(Node *U, Node *V, CostEvaluator const &costEvaluator) const;
 
-    // Enforce salvage sequence constraint
-//    bool checkSalvageSequenceConstraint(Node *U,
-//                                        Node *V) const;
-
 public:
     Cost
     evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Node *U, Node *V) const override;
-};
 
-//template <size_t N, size_t M>
-//bool Exchange<N, M>::checkSalvageSequenceConstraint(Node *U, Node *V) const
-//{
-//    // These sequences should violate the constraint
-//    // S-B
-//    // S-D
-//    // B-B
-//    // B-D
-//    // The loops start from U and V respectively and go up to N and M nodes
-//    for(size_t uIndex = 0; uIndex < N; ++uIndex, U = n(U)){
-//        for(size_t vIndex = 0; vIndex < M; ++vIndex, V = n(V)){
-//            bool uIsClientDelivery = (data.client(U->client).demandWeight || data.client(U->client).demandVolume);
-//            bool uIsClientSalvage = (data.client(U->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//            bool uIsBoth = uIsClientDelivery && uIsClientSalvage;
-//        
-//            bool vIsClientDelivery = (data.client(V->client).demandWeight || data.client(V->client).demandVolume);
-//            bool vIsClientSalvage = (data.client(V->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//            bool vIsBoth = vIsClientDelivery && vIsClientSalvage;
-//        
-//            bool nextUClientDelivery = (data.client(n(U)->client).demandWeight || data.client(n(U)->client).demandVolume);
-//            bool nextVClientDelivery = (data.client(n(V)->client).demandWeight || data.client(n(V)->client).demandVolume);
-//
-//            // S-B or S-D
-//            if (uIsClientSalvage && !uIsBoth && ((vIsClientDelivery || vIsBoth) || nextVClientDelivery))
-//                return true;
-//        
-//            // B-B or B-D
-//            if (uIsBoth && ((vIsBoth || vIsClientDelivery) || nextUClientDelivery))
-//                return true;
-//        }
-//    }
-//
-//    return false;
-//}
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Node>>
+    clone() const override;
+};
 
 template <size_t N, size_t M>
 bool Exchange<N, M>::containsDepot(Node *node, size_t segLength) const
@@ -119,7 +86,7 @@ Cost Exchange<N, M>::evalRelocateMove(Node *U,
                                       Node *V,
                                       CostEvaluator const &costEvaluator) const
 {
-    std::cout << "Enter evalRelocateMove" << std::endl;
+    PYVRP_TRACE(OPERATOR, DEBUG, "Enter evalRelocateMove");
     auto const posU = U->position;
     auto const posV = V->position;
 
@@ -136,19 +103,17 @@ Cost Exchange<N, M>::evalRelocateMove(Node *U,
 
     Cost deltaCost = static_cast<Cost>(proposed - current);
 
-    Store uNumStores = U->route->storeCount();
-    Store vNumStores = V->route->storeCount();
-
-    bool uFoundStore = U->route->containsStore(data.client(U->client).clientStore);
-    bool vFoundStore = V->route->containsStore(data.client(V->client).clientStore);
-
     if (U->route != V->route)
     {
+        if (orderIndex)  // moving U's segment may change order splits
+            deltaCost += orderIndex->exchangeCost(
+                U->route, posU, posU + N - 1, V->route, 1, 0, costEvaluator);
+
         if (U->route->isFeasible() && deltaCost >= 0)
             return deltaCost;
 
         auto uTWS = TWS::merge(
-            data.durationMatrix(), p(U)->twBefore, n(endU)->twAfter);
+            data.durations(), p(U)->twBefore, n(endU)->twAfter);
 
         deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
         deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
@@ -156,26 +121,28 @@ Cost Exchange<N, M>::evalRelocateMove(Node *U,
         auto const weightDiff = U->route->weightBetween(posU, posU + N - 1);
         auto const volumeDiff = U->route->volumeBetween(posU, posU + N - 1);
         auto const salvageDiff = U->route->salvageBetween(posU, posU + N - 1);
-        auto const uStoresDiff = U->route->storesBetween(posU, posU + N - 1);
-        // auto const vStoresDiff = V->route->storesBetween(posV, posV + M - 1);
-
-        if(uFoundStore){
-            uNumStores = uNumStores - Store(1);
-        }
 
-        if(!vFoundStore){
-            vNumStores = vNumStores + Store(1);
-        }
+        // U's route loses the stores that are only visited in the moved
+        // segment; V's route gains those stores in it that it does not visit.
+        auto const uStores = U->route->storeCount()
+                             - U->route->storesOnlyBetween(posU, posU + N - 1);
 
         deltaCost += costEvaluator.weightPenalty(U->route->weight() - weightDiff, data.weightCapacity());
         deltaCost += costEvaluator.volumePenalty(U->route->volume() - volumeDiff, data.volumeCapacity());
         deltaCost += costEvaluator.salvagePenalty(U->route->salvage() - salvageDiff, data.salvageCapacity());
-        deltaCost += costEvaluator.storesPenalty(Store(uNumStores) - uStoresDiff, data.routeStoreLimit());
+        deltaCost += costEvaluator.storesPenalty(uStores, data.routeStoreLimit());
 
         deltaCost -= costEvaluator.weightPenalty(U->route->weight(), data.weightCapacity());
         deltaCost -= costEvaluator.volumePenalty(U->route->volume(), data.volumeCapacity());
         deltaCost -= costEvaluator.salvagePenalty(U->route->salvage(), data.salvageCapacity());
-        deltaCost -= costEvaluator.storesPenalty(Store(uNumStores), data.routeStoreLimit());
+        deltaCost -= costEvaluator.storesPenalty(U->route->storeCount(), data.routeStoreLimit());
+
+        auto const uSeq = SS::merge(
+            p(U)->seqBefore,
+            U->route->seqBetween(posU + N, U->route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(uSeq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(U->route->sequenceViolations());
 
         if (deltaCost >= 0)    // if delta cost of just U's route is not enough
             return deltaCost;  // even without V, the move will never be good.
@@ -183,14 +150,28 @@ Cost Exchange<N, M>::evalRelocateMove(Node *U,
         deltaCost += costEvaluator.weightPenalty(V->route->weight() + weightDiff, data.weightCapacity());
         deltaCost += costEvaluator.volumePenalty(V->route->volume() + volumeDiff, data.volumeCapacity());
         deltaCost += costEvaluator.salvagePenalty(V->route->salvage() + salvageDiff, data.salvageCapacity());
-        deltaCost += costEvaluator.storesPenalty(Store(vNumStores) + uStoresDiff, data.routeStoreLimit());
+        auto const vStores = V->route->storeCount()
+                             + U->route->storesBetweenIf(
+                                 posU, posU + N - 1, [&](Store store) {
+                                     return !V->route->containsStore(store);
+                                 });
+
+        deltaCost += costEvaluator.storesPenalty(vStores, data.routeStoreLimit());
 
         deltaCost -= costEvaluator.weightPenalty(V->route->weight(), data.weightCapacity());
         deltaCost -= costEvaluator.volumePenalty(V->route->volume(), data.volumeCapacity());
         deltaCost -= costEvaluator.salvagePenalty(V->route->salvage(), data.salvageCapacity());
-        deltaCost -= costEvaluator.storesPenalty(Store(vNumStores), data.routeStoreLimit());
+        deltaCost -= costEvaluator.storesPenalty(V->route->storeCount(), data.routeStoreLimit());
+
+        auto const vSeq = SS::merge(
+            V->seqBefore,
+            U->route->seqBetween(posU, posU + N - 1),
+            V->route->seqBetween(posV + 1, V->route->size()));
 
-        auto vTWS = TWS::merge(data.durationMatrix(),
+        deltaCost += costEvaluator.sequencePenalty(vSeq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(V->route->sequenceViolations());
+
+        auto vTWS = TWS::merge(data.durations(),
                                V->twBefore,
                                U->route->twBetween(posU, posU + N - 1),
                                n(V)->twAfter);
@@ -202,12 +183,29 @@ Cost Exchange<N, M>::evalRelocateMove(Node *U,
     {
         auto const *route = U->route;
 
+        // Moving the segment only changes the order in which the route's
+        // clients are visited, so only the sequence and time warp can change.
+        SS seq;
+        if (posU < posV)
+            seq = SS::merge(p(U)->seqBefore,
+                            route->seqBetween(posU + N, posV),
+                            route->seqBetween(posU, posU + N - 1),
+                            route->seqBetween(posV + 1, route->size()));
+        else
+            seq = SS::merge(V->seqBefore,
+                            route->seqBetween(posU, posU + N - 1),
+                            route->seqBetween(posV + 1, posU - 1),
+                            route->seqBetween(posU + N, route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(seq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(route->sequenceViolations());
+
         if (!route->hasTimeWarp() && deltaCost >= 0)
             return deltaCost;
 
         if (posU < posV)
         {
-            auto const tws = TWS::merge(data.durationMatrix(),
+            auto const tws = TWS::merge(data.durations(),
                                         p(U)->twBefore,
                                         route->twBetween(posU + N, posV),
                                         route->twBetween(posU, posU + N - 1),
@@ -217,7 +215,7 @@ Cost Exchange<N, M>::evalRelocateMove(Node *U,
         }
         else
         {
-            auto const tws = TWS::merge(data.durationMatrix(),
+            auto const tws = TWS::merge(data.durations(),
                                         V->twBefore,
                                         route->twBetween(posU, posU + N - 1),
                                         route->twBetween(posV + 1, posU - 1),
@@ -237,7 +235,7 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
                                   Node *V,
                                   CostEvaluator const &costEvaluator) const
 {
-    std::cout << "Enter evalSwapMove" << std::endl;
+    PYVRP_TRACE(OPERATOR, DEBUG, "Enter evalSwapMove");
     auto const posU = U->position;
     auto const posV = V->position;
 
@@ -264,10 +262,19 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
 
     if (U->route != V->route)
     {
+        if (orderIndex)  // swapping the segments may change order splits
+            deltaCost += orderIndex->exchangeCost(U->route,
+                                                  posU,
+                                                  posU + N - 1,
+                                                  V->route,
+                                                  posV,
+                                                  posV + M - 1,
+                                                  costEvaluator);
+
         if (U->route->isFeasible() && V->route->isFeasible() && deltaCost >= 0)
             return deltaCost;
 
-        auto uTWS = TWS::merge(data.durationMatrix(),
+        auto uTWS = TWS::merge(data.durations(),
                                p(U)->twBefore,
                                V->route->twBetween(posV, posV + M - 1),
                                n(endU)->twAfter);
@@ -284,8 +291,27 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
         auto const weightDiff = weightU - weightV;
         auto const volumeDiff = volumeU - volumeV;
         auto const salvageDiff = salvageU - salvageV;
-        auto const storesDiff = U->route->storesBetween(posU, posU + N - 1);
-        // auto const storesV = V->route->storesBetween(posV, posV + M - 1);
+
+        // Each route loses the stores that are only visited in its segment,
+        // and gains those stores in the other segment it does not otherwise
+        // visit.
+        auto const uStores
+            = U->route->storeCount()
+              - U->route->storesOnlyBetween(posU, posU + N - 1)
+              + V->route->storesBetweenIf(
+                  posV, posV + M - 1, [&](Store store) {
+                      return !U->route->visitsStoreOutside(
+                          store, posU, posU + N - 1);
+                  });
+
+        auto const vStores
+            = V->route->storeCount()
+              - V->route->storesOnlyBetween(posV, posV + M - 1)
+              + U->route->storesBetweenIf(
+                  posU, posU + N - 1, [&](Store store) {
+                      return !V->route->visitsStoreOutside(
+                          store, posV, posV + M - 1);
+                  });
 
         deltaCost += costEvaluator.weightPenalty(U->route->weight() - weightDiff,
                                                data.weightCapacity());
@@ -293,7 +319,7 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
                                                data.volumeCapacity());
         deltaCost += costEvaluator.salvagePenalty(U->route->salvage() - salvageDiff,
                                                data.salvageCapacity());
-        deltaCost += costEvaluator.storesPenalty(U->route->storeCount() - storesDiff,
+        deltaCost += costEvaluator.storesPenalty(uStores,
                                                data.routeStoreLimit());
         deltaCost -= costEvaluator.weightPenalty(U->route->weight(),
                                                data.weightCapacity());
@@ -304,7 +330,23 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
         deltaCost -= costEvaluator.storesPenalty(U->route->storeCount(),
                                                data.routeStoreLimit());
 
-        auto vTWS = TWS::merge(data.durationMatrix(),
+        auto const uSeq = SS::merge(
+            p(U)->seqBefore,
+            V->route->seqBetween(posV, posV + M - 1),
+            U->route->seqBetween(posU + N, U->route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(uSeq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(U->route->sequenceViolations());
+
+        auto const vSeq = SS::merge(
+            p(V)->seqBefore,
+            U->route->seqBetween(posU, posU + N - 1),
+            V->route->seqBetween(posV + M, V->route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(vSeq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(V->route->sequenceViolations());
+
+        auto vTWS = TWS::merge(data.durations(),
                                p(V)->twBefore,
                                U->route->twBetween(posU, posU + N - 1),
                                n(endV)->twAfter);
@@ -318,7 +360,7 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
                                                data.volumeCapacity());
         deltaCost += costEvaluator.salvagePenalty(V->route->salvage() + salvageDiff,
                                                data.salvageCapacity());
-        deltaCost += costEvaluator.storesPenalty(V->route->storeCount() + storesDiff,
+        deltaCost += costEvaluator.storesPenalty(vStores,
                                                data.routeStoreLimit());
         deltaCost -= costEvaluator.weightPenalty(V->route->weight(),
                                                data.weightCapacity());
@@ -333,12 +375,29 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
     {
         auto const *route = U->route;
 
+        SS seq;
+        if (posU < posV)
+            seq = SS::merge(p(U)->seqBefore,
+                            route->seqBetween(posV, posV + M - 1),
+                            route->seqBetween(posU + N, posV - 1),
+                            route->seqBetween(posU, posU + N - 1),
+                            route->seqBetween(posV + M, route->size()));
+        else
+            seq = SS::merge(p(V)->seqBefore,
+                            route->seqBetween(posU, posU + N - 1),
+                            route->seqBetween(posV + M, posU - 1),
+                            route->seqBetween(posV, posV + M - 1),
+                            route->seqBetween(posU + N, route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(seq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(route->sequenceViolations());
+
         if (!route->hasTimeWarp() && deltaCost >= 0)
             return deltaCost;
 
         if (posU < posV)
         {
-            auto const tws = TWS::merge(data.durationMatrix(),
+            auto const tws = TWS::merge(data.durations(),
                                         p(U)->twBefore,
                                         route->twBetween(posV, posV + M - 1),
                                         route->twBetween(posU + N, posV - 1),
@@ -349,7 +408,7 @@ Cost Exchange<N, M>::evalSwapMove(Node *U,
         }
         else
         {
-            auto const tws = TWS::merge(data.durationMatrix(),
+            auto const tws = TWS::merge(data.durations(),
                                         p(V)->twBefore,
                                         route->twBetween(posU, posU + N - 1),
                                         route->twBetween(posV + M, posU - 1),
@@ -370,9 +429,6 @@ Cost Exchange<N, M>::evaluate(Node *U,
                               Node *V,
                               CostEvaluator const &costEvaluator)
 {
-    //if (checkSalvageSequenceConstraint(U, V))
-    //    return std::numeric_limits<Cost>::max() / 1000;
-
     if (containsDepot(U, N) || overlap(U, V))
         return 0;
 
@@ -422,4 +478,10 @@ template <size_t N, size_t M> void Exchange<N, M>::apply(Node *U, Node *V) const
     }
 }
 
+template <size_t N, size_t M>
+std::unique_ptr<LocalSearchOperator<Node>> Exchange<N, M>::clone() const
+{
+    return std::make_unique<Exchange<N, M>>(data);
+}
+
 #endif  // PYVRP_EXCHANGE_H
@@ -0,0 +1,115 @@
+#include "KDTree.h"
+
+#include <algorithm>
+
+void KDTree::build(size_t begin, size_t end)
+{
+    if (end - begin <= 1)
+        return;
+
+    auto const byX = [](auto const &first, auto const &second) {
+        return first.x < second.x;
+    };
+
+    auto const byY = [](auto const &first, auto const &second) {
+        return first.y < second.y;
+    };
+
+    auto const first = points.begin() + begin;
+    auto const last = points.begin() + end;
+    auto const [minX, maxX] = std::minmax_element(first, last, byX);
+    auto const [minY, maxY] = std::minmax_element(first, last, byY);
+
+    auto const mid = begin + (end - begin) / 2;
+    auto const onX = maxX->x - minX->x >= maxY->y - minY->y;
+
+    if (onX)
+        std::nth_element(first, points.begin() + mid, last, byX);
+    else
+        std::nth_element(first, points.begin() + mid, last, byY);
+
+    splitOnX[mid] = onX;
+    build(begin, mid);
+    build(mid + 1, end);
+}
+
+void KDTree::search(size_t begin,
+                    size_t end,
+                    Point const &point,
+                    size_t k,
+                    std::vector<std::pair<double, int>> &heap) const
+{
+    if (begin == end)
+        return;
+
+    auto const mid = begin + (end - begin) / 2;
+    auto const &split = points[mid];
+
+    if (split.client != point.client)
+    {
+        auto const diffX = split.x - point.x;
+        auto const diffY = split.y - point.y;
+        std::pair<double, int> const candidate
+            = {diffX * diffX + diffY * diffY, split.client};
+
+        if (heap.size() < k || candidate < heap.front())
+        {
+            if (heap.size() == k)
+            {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.pop_back();
+            }
+
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    // The near side is the subtree on the same side of the splitting line as
+    // the given point.
+    auto const diff = splitOnX[mid] ? point.x - split.x : point.y - split.y;
+    auto const nearBegin = diff < 0 ? begin : mid + 1;
+    auto const nearEnd = diff < 0 ? mid : end;
+    auto const farBegin = diff < 0 ? mid + 1 : begin;
+    auto const farEnd = diff < 0 ? end : mid;
+
+    search(nearBegin, nearEnd, point, k, heap);
+
+    // The far side can only contain nearer clients when the splitting line is
+    // not further away than the furthest client found so far. Clients at
+    // exactly that distance may still win on their index, so we search those
+    // as well.
+    if (heap.size() < k || diff * diff <= heap.front().first)
+        search(farBegin, farEnd, point, k, heap);
+}
+
+void KDTree::nearest(size_t client, size_t k, std::vector<int> &nearest) const
+{
+    std::vector<std::pair<double, int>> heap;
+    heap.reserve(k + 1);
+
+    if (k > 0)
+        search(0, points.size(), locations[client], k, heap);
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    nearest.clear();
+    for (auto const &[distance, other] : heap)
+        nearest.push_back(other);
+}
+
+KDTree::KDTree(ProblemData const &data)
+    : splitOnX(data.numClients(), false)
+{
+    locations.reserve(data.numClients() + 1);
+    for (size_t client = 0; client <= data.numClients(); ++client)
+    {
+        auto const &clientData = data.client(client);
+        locations.push_back({static_cast<double>(clientData.x.get()),
+                             static_cast<double>(clientData.y.get()),
+                             static_cast<int>(client)});
+    }
+
+    points.assign(locations.begin() + 1, locations.end());  // excl. depot
+    build(0, points.size());
+}
@@ -0,0 +1,54 @@
+#ifndef PYVRP_KDTREE_H
+#define PYVRP_KDTREE_H
+
+#include "ProblemData.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Two-dimensional k-d tree over the client locations, excluding the depot.
+ * The tree is stored implicitly: each subtree is a contiguous range of the
+ * points array, split at its median on the dimension in which the range is
+ * widest. Building the tree takes O(n log n) time and O(n) memory. A nearest
+ * neighbour query for k clients then typically takes O(k log n) time. The
+ * tree is not modified by queries, so it can be queried from multiple threads
+ * at the same time.
+ */
+class KDTree
+{
+    struct Point
+    {
+        double x;
+        double y;
+        int client;
+    };
+
+    std::vector<Point> points;     // tree structure, see the class comment
+    std::vector<bool> splitOnX;    // split dimension of the subtree at each mid
+    std::vector<Point> locations;  // location of each client (+depot)
+
+    void build(size_t begin, size_t end);
+
+    // Adds the clients in the range [begin, end) that are nearer to the given
+    // point than the furthest client in the heap, which holds at most k
+    // clients.
+    void search(size_t begin,
+                size_t end,
+                Point const &point,
+                size_t k,
+                std::vector<std::pair<double, int>> &heap) const;
+
+public:
+    /**
+     * Stores the (at most) k clients nearest to the given client in the
+     * nearest vector, sorted by increasing Euclidean distance, with ties
+     * broken by client index. The client itself is not included.
+     */
+    void nearest(size_t client, size_t k, std::vector<int> &nearest) const;
+
+    explicit KDTree(ProblemData const &data);
+};
+
+#endif  // PYVRP_KDTREE_H
@@ -1,17 +1,24 @@
 #include "LocalSearch.h"
 #include "Measure.h"
+#include "SequenceSegment.h"
 #include "TimeWindowSegment.h"
+#include "Trace.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
+using SS = SequenceSegment;
 using TWS = TimeWindowSegment;
 
-Solution LocalSearch::search(Solution &solution,
+Solution LocalSearch::search(Solution const &solution,
                              CostEvaluator const &costEvaluator)
 {
     loadSolution(solution);
@@ -30,13 +37,13 @@ Solution LocalSearch::search(Solution &solution,
 
     for (int step = 0; !searchCompleted; ++step)
     {
-        std::cout << "Outer: " << step << std::endl;
+        PYVRP_TRACE(SEARCH, INFO, "Outer: " << step);
         searchCompleted = true;
 
         // Node operators are evaluated at neighbouring (U, V) pairs.
         for (auto const uClient : orderNodes)
         {
-            std::cout << "Inner UClient: " << uClient << std::endl;
+            PYVRP_TRACE(SEARCH, DEBUG, "Inner UClient: " << uClient);
             auto *U = &clients[uClient];
 
             auto const lastTestedNode = lastTestedNodes[uClient];
@@ -47,9 +54,9 @@ Solution LocalSearch::search(Solution &solution,
 
             // Shuffling the neighbours in this loop should not matter much as
             // we are already randomizing the nodes U.
-            for (auto const vClient : neighbours[uClient])
+            for (auto const vClient : (*neighbours)[uClient])
             {
-                std::cout << "Inner VClient: " << vClient << std::endl;
+                PYVRP_TRACE(SEARCH, DEBUG, "Inner VClient: " << vClient);
                 auto *V = &clients[vClient];
 
                 if (!U->route && V->route)             // U might be inserted
@@ -68,8 +75,8 @@ Solution LocalSearch::search(Solution &solution,
                         continue;
                 }
             }
-       
-            std::cout << "After Inner VClient" << std::endl;
+
+            PYVRP_TRACE(SEARCH, DEBUG, "After Inner VClient");
             if (step > 0)  // empty moves are not tested initially to avoid
             {              // using too many routes.
                 auto pred = [](auto const &route) { return route.empty(); };
@@ -78,7 +85,7 @@ Solution LocalSearch::search(Solution &solution,
                 if (empty == routes.end())
                     continue;
 
-                std::cout << "Route not empty" << std::endl;
+                PYVRP_TRACE(SEARCH, DEBUG, "Route not empty");
                 if (U->route)  // try inserting U into the empty route.
                     applyNodeOps(U, empty->depot, costEvaluator);
                 else  // U is not in the solution, so again try inserting.
@@ -90,13 +97,17 @@ Solution LocalSearch::search(Solution &solution,
     return exportSolution();
 }
 
-Solution LocalSearch::intensify(Solution &solution,
+Solution LocalSearch::intensify(Solution const &solution,
                                 CostEvaluator const &costEvaluator,
                                 int overlapToleranceDegrees)
 {
     loadSolution(solution);
 
-    auto const overlapTolerance = overlapToleranceDegrees * 65536;
+    // Circle sectors measure angles in units of 1/65536th of a full circle.
+    // Tolerances of a full circle or more all mean every pair of routes is
+    // tested, so we clamp to avoid overflow.
+    auto const overlapTolerance = static_cast<int>(std::clamp<long long>(
+        overlapToleranceDegrees * 65536LL / 360, -65536, 65536));
 
     if (routeOps.empty())
         throw std::runtime_error("No known route operators.");
@@ -107,6 +118,9 @@ Solution LocalSearch::intensify(Solution &solution,
     searchCompleted = false;
     numMoves = 0;
 
+    std::vector<int> candidates;
+    std::vector<std::pair<double, int>> ranked;
+
     while (!searchCompleted)
     {
         searchCompleted = true;
@@ -121,12 +135,31 @@ Solution LocalSearch::intensify(Solution &solution,
             auto const lastTested = lastTestedRoutes[U.idx];
             lastTestedRoutes[U.idx] = numMoves;
 
-            // Shuffling in this loop should not matter much as we are
-            // already randomizing the routes U.
-            for (int rV = 0; rV != U.idx; ++rV)
+            // We test each pair of routes only once per loop, from the route
+            // with the larger index. Routes whose centroids are closer to that
+            // of U are tested first, since those are the most likely to have
+            // improving moves.
+            sectorIndex.overlapping(U, overlapTolerance, candidates);
+            ranked.clear();
+
+            auto const [uX, uY] = U.centroid();
+            for (auto const rV : candidates)
+                if (rV < U.idx)
+                {
+                    auto const [vX, vY] = routes[rV].centroid();
+                    auto const dist = (uX - vX) * (uX - vX)
+                                      + (uY - vY) * (uY - vY);
+                    ranked.emplace_back(dist, rV);
+                }
+
+            std::sort(ranked.begin(), ranked.end());
+
+            for (auto const &candidate : ranked)
             {
-                auto &V = routes[rV];
+                auto &V = routes[candidate.second];
 
+                // Earlier moves may have changed the routes since the index
+                // was queried, so we test again that the routes overlap.
                 if (V.empty() || !U.overlapsWith(V, overlapTolerance))
                     continue;
 
@@ -143,30 +176,211 @@ Solution LocalSearch::intensify(Solution &solution,
     return exportSolution();
 }
 
+std::vector<Solution>
+LocalSearch::searchBatch(std::vector<Solution> const &solutions,
+                         CostEvaluator const &costEvaluator,
+                         size_t numThreads)
+{
+    auto task = [&](LocalSearch &ls, Solution const &solution) {
+        return ls.search(solution, costEvaluator);
+    };
+
+    return runBatch(solutions, task, numThreads);
+}
+
+std::vector<Solution>
+LocalSearch::intensifyBatch(std::vector<Solution> const &solutions,
+                            CostEvaluator const &costEvaluator,
+                            int overlapToleranceDegrees,
+                            size_t numThreads)
+{
+    auto task = [&](LocalSearch &ls, Solution const &solution) {
+        return ls.intensify(solution, costEvaluator, overlapToleranceDegrees);
+    };
+
+    return runBatch(solutions, task, numThreads);
+}
+
+void LocalSearch::prepareWorkers(size_t numWorkers)
+{
+    while (workers.size() < numWorkers)
+        workers.emplace_back(clone());
+
+    for (size_t idx = 0; idx != numWorkers; ++idx)
+    {
+        auto &ls = *workers[idx];
+        ls.orderNodes = orderNodes;
+        ls.orderRoutes = orderRoutes;
+        ls.nodeOpOrder = nodeOpOrder;
+        ls.routeOpOrder = routeOpOrder;
+    }
+}
+
+std::vector<Solution>
+LocalSearch::runBatch(std::vector<Solution> const &solutions,
+                      Task const &task,
+                      size_t numThreads)
+{
+    if (solutions.empty())
+        return {};
+
+    if (numThreads == 0)
+        numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    numThreads = std::min(numThreads, solutions.size());
+    prepareWorkers(numThreads);
+
+    if (!pool || pool->size() < numThreads)
+        pool = std::make_unique<ThreadPool>(numThreads - 1);
+
+    // Threads repeatedly claim the next unprocessed solution, so that threads
+    // that happen to get easy solutions do not sit idle while others finish.
+    std::atomic<size_t> next = 0;
+    std::vector<std::optional<Solution>> results(solutions.size());
+    std::vector<std::exception_ptr> errors(numThreads);
+
+    auto work = [&](size_t thread) {
+        try
+        {
+            auto &ls = *workers[thread];
+            for (auto idx = next++; idx < solutions.size(); idx = next++)
+                results[idx].emplace(task(ls, solutions[idx]));
+        }
+        catch (...)
+        {
+            errors[thread] = std::current_exception();
+            next = solutions.size();  // stops the other threads early
+        }
+    };
+
+    pool->run(numThreads, work);  // the calling thread is the first worker
+
+    for (size_t idx = 0; idx != numThreads; ++idx)
+    {
+        addStatistics(*workers[idx]);
+        workers[idx]->resetStatistics();
+    }
+
+    for (auto const &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    std::vector<Solution> improved;
+    improved.reserve(solutions.size());
+
+    for (auto &result : results)
+        improved.emplace_back(std::move(*result));
+
+    return improved;
+}
+
 void LocalSearch::shuffle(XorShift128 &rng)
 {
     std::shuffle(orderNodes.begin(), orderNodes.end(), rng);
-    std::shuffle(nodeOps.begin(), nodeOps.end(), rng);
+    std::shuffle(nodeOpOrder.begin(), nodeOpOrder.end(), rng);
 
     std::shuffle(orderRoutes.begin(), orderRoutes.end(), rng);
-    std::shuffle(routeOps.begin(), routeOps.end(), rng);
+    std::shuffle(routeOpOrder.begin(), routeOpOrder.end(), rng);
+}
+
+std::vector<OperatorStatistics> const &
+LocalSearch::nodeOperatorStatistics() const
+{
+    return nodeOpStats;
+}
+
+std::vector<OperatorStatistics> const &
+LocalSearch::routeOperatorStatistics() const
+{
+    return routeOpStats;
+}
+
+OperatorStatistics const &LocalSearch::insertStatistics() const
+{
+    return insertStats;
+}
+
+OperatorStatistics const &LocalSearch::removeStatistics() const
+{
+    return removeStats;
+}
+
+void LocalSearch::resetStatistics()
+{
+    std::fill(nodeOpStats.begin(), nodeOpStats.end(), OperatorStatistics{});
+    std::fill(routeOpStats.begin(), routeOpStats.end(), OperatorStatistics{});
+    insertStats = {};
+    removeStats = {};
+}
+
+void LocalSearch::addStatistics(LocalSearch const &other)
+{
+    if (other.nodeOpStats.size() != nodeOpStats.size()
+        || other.routeOpStats.size() != routeOpStats.size())
+        throw std::invalid_argument("Local search operators do not match.");
+
+    for (size_t op = 0; op != nodeOpStats.size(); ++op)
+        nodeOpStats[op] += other.nodeOpStats[op];
+
+    for (size_t op = 0; op != routeOpStats.size(); ++op)
+        routeOpStats[op] += other.routeOpStats[op];
+
+    insertStats += other.insertStats;
+    removeStats += other.removeStats;
+}
+
+std::unique_ptr<LocalSearch> LocalSearch::clone() const
+{
+    // The constructor is private, so we cannot use std::make_unique here.
+    std::unique_ptr<LocalSearch> ls(new LocalSearch(data, neighbours));
+
+    for (auto const *op : nodeOps)
+    {
+        ls->ownedNodeOps.emplace_back(op->clone());
+        ls->addNodeOperator(*ls->ownedNodeOps.back());
+    }
+
+    for (auto const *op : routeOps)
+    {
+        ls->ownedRouteOps.emplace_back(op->clone());
+        ls->addRouteOperator(*ls->ownedRouteOps.back());
+    }
+
+    ls->orderNodes = orderNodes;
+    ls->orderRoutes = orderRoutes;
+    ls->nodeOpOrder = nodeOpOrder;
+    ls->routeOpOrder = routeOpOrder;
+
+    return ls;
 }
 
 bool LocalSearch::applyNodeOps(Node *U,
                                Node *V,
                                CostEvaluator const &costEvaluator)
 {
-    for (auto *nodeOp : nodeOps)
-        if (nodeOp->evaluate(U, V, costEvaluator) < 0)
+    for (auto const opIdx : nodeOpOrder)
+    {
+        auto *nodeOp = nodeOps[opIdx];
+        auto &stats = nodeOpStats[opIdx];
+
+        EvaluationTimer timer(stats.evaluationTicks);
+        auto const deltaCost = nodeOp->evaluate(U, V, costEvaluator);
+        timer.stop();
+
+        stats.recordEvaluation(deltaCost);
+
+        if (deltaCost < 0)
         {
             auto *routeU = U->route;  // copy pointers because the operator can
             auto *routeV = V->route;  // modify the node's route membership
 
             nodeOp->apply(U, V);
             update(routeU, routeV);
+            stats.recordApplication(deltaCost);
 
             return true;
         }
+    }
 
     return false;
 }
@@ -175,11 +389,22 @@ bool LocalSearch::applyRouteOps(Route *U,
                                 Route *V,
                                 CostEvaluator const &costEvaluator)
 {
-    for (auto *routeOp : routeOps)
-        if (routeOp->evaluate(U, V, costEvaluator) < 0)
+    for (auto const opIdx : routeOpOrder)
+    {
+        auto *routeOp = routeOps[opIdx];
+        auto &stats = routeOpStats[opIdx];
+
+        EvaluationTimer timer(stats.evaluationTicks);
+        auto const deltaCost = routeOp->evaluate(U, V, costEvaluator);
+        timer.stop();
+
+        stats.recordEvaluation(deltaCost);
+
+        if (deltaCost < 0)
         {
             routeOp->apply(U, V);
             update(U, V);
+            stats.recordApplication(deltaCost);
 
             for (auto *op : routeOps)  // this is used by some route operators
             {                          // (particularly SWAP*) to keep caches
@@ -189,6 +414,7 @@ bool LocalSearch::applyRouteOps(Route *U,
 
             return true;
         }
+    }
 
     return false;
 }
@@ -199,6 +425,8 @@ void LocalSearch::maybeInsert(Node *U,
 {
     assert(!U->route && V->route);
 
+    EvaluationTimer timer(insertStats.evaluationTicks);
+
     Distance const deltaDist = data.dist(V->client, U->client)
                                + data.dist(U->client, n(V)->client)
                                - data.dist(V->client, n(V)->client);
@@ -206,14 +434,14 @@ void LocalSearch::maybeInsert(Node *U,
     auto const &uClient = data.client(U->client);
     Cost deltaCost = static_cast<Cost>(deltaDist) - uClient.prize;
 
-    deltaCost += costEvaluator.weightPenalty(V->route->weight() + uClient.demandWeight,
+    deltaCost += costEvaluator.weightPenalty(V->route->weight() + data.demandWeight(U->client),
                                            data.weightCapacity());
-    deltaCost += costEvaluator.volumePenalty(V->route->volume() + uClient.demandVolume,
+    deltaCost += costEvaluator.volumePenalty(V->route->volume() + data.demandVolume(U->client),
                                            data.volumeCapacity());
-    deltaCost += costEvaluator.salvagePenalty(V->route->salvage() + uClient.demandSalvage,
+    deltaCost += costEvaluator.salvagePenalty(V->route->salvage() + data.demandSalvage(U->client),
                                            data.salvageCapacity());
 
-    if (!V->route->containsStore(uClient.clientStore))
+    if (!V->route->containsStore(data.clientStore(U->client)))
     {
         deltaCost += costEvaluator.storesPenalty(V->route->stores() + Store(1), data.routeStoreLimit());
     }
@@ -225,75 +453,102 @@ void LocalSearch::maybeInsert(Node *U,
     deltaCost
         -= costEvaluator.salvagePenalty(V->route->salvage(), data.salvageCapacity());
 
-    if (!V->route->containsStore(uClient.clientStore))
+    if (!V->route->containsStore(data.clientStore(U->client)))
     {
         deltaCost -= costEvaluator.storesPenalty(V->route->stores(), data.routeStoreLimit());
     }
 
+    deltaCost += orderIndex.relocateCost(U, V->route, costEvaluator);
+
+    auto const *route = V->route;
+    auto const vSeq
+        = SS::merge(V->seqBefore,
+                    U->seq,
+                    route->seqBetween(V->position + 1, route->size()));
+
+    deltaCost += costEvaluator.sequencePenalty(vSeq.violations());
+    deltaCost -= costEvaluator.sequencePenalty(route->sequenceViolations());
+
     // If this is true, adding U cannot decrease time warp in V's route enough
     // to offset the deltaCost.
     if (deltaCost >= costEvaluator.twPenalty(V->route->timeWarp()))
+    {
+        insertStats.recordEvaluation(deltaCost);
         return;
+    }
 
     auto const vTWS
-        = TWS::merge(data.durationMatrix(), V->twBefore, U->tw, n(V)->twAfter);
+        = TWS::merge(data.durations(), V->twBefore, U->tw, n(V)->twAfter);
 
     deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
     deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
 
+    timer.stop();
+    insertStats.recordEvaluation(deltaCost);
+
     if (deltaCost < 0)
     {
         U->insertAfter(V);           // U has no route, so there's nothing to
         update(V->route, V->route);  // update there.
+        insertStats.recordApplication(deltaCost);
     }
 }
 
 void LocalSearch::maybeRemove(Node *U, CostEvaluator const &costEvaluator)
-{                   
+{
     assert(U->route);
 
+    EvaluationTimer timer(removeStats.evaluationTicks);
+
     Distance const deltaDist = data.dist(p(U)->client, n(U)->client)
                                - data.dist(p(U)->client, U->client)
                                - data.dist(U->client, n(U)->client);
                     
     auto const &uClient = data.client(U->client);
 
-    Store numStores = U->route->storeCount();
-    bool foundStore = U->route->containsStore(uClient.clientStore);
-
     Cost deltaCost = static_cast<Cost>(deltaDist) + uClient.prize;
 
-    deltaCost += costEvaluator.weightPenalty(U->route->weight() - uClient.demandWeight,
+    deltaCost += costEvaluator.weightPenalty(U->route->weight() - data.demandWeight(U->client),
                                            data.weightCapacity());
-    deltaCost += costEvaluator.volumePenalty(U->route->volume() - uClient.demandVolume,
+    deltaCost += costEvaluator.volumePenalty(U->route->volume() - data.demandVolume(U->client),
                                            data.volumeCapacity());
-    deltaCost += costEvaluator.salvagePenalty(U->route->salvage() - uClient.demandSalvage,
+    deltaCost += costEvaluator.salvagePenalty(U->route->salvage() - data.demandSalvage(U->client),
                                            data.salvageCapacity());
-    
-    if (foundStore)
-    {
-        deltaCost += costEvaluator.storesPenalty(numStores - Store(1), data.routeStoreLimit());
-    }
+
+    // U's route only loses U's store if U is that store's only visit.
+    auto const uStores = U->route->storeCount()
+                         - U->route->storesOnlyBetween(U->position, U->position);
+
+    deltaCost += costEvaluator.storesPenalty(uStores, data.routeStoreLimit());
 
     deltaCost -= costEvaluator.weightPenalty(U->route->weight(), data.weightCapacity());
     deltaCost -= costEvaluator.volumePenalty(U->route->volume(), data.volumeCapacity());
     deltaCost -= costEvaluator.salvagePenalty(U->route->salvage(), data.salvageCapacity());
+    deltaCost -= costEvaluator.storesPenalty(U->route->storeCount(), data.routeStoreLimit());
 
-    if (foundStore)
-    {
-        deltaCost += costEvaluator.storesPenalty(numStores, data.routeStoreLimit());
-    }
-    
-    auto uTWS = TWS::merge(data.durationMatrix(), p(U)->twBefore, n(U)->twAfter);
+    deltaCost += orderIndex.relocateCost(U, nullptr, costEvaluator);
+
+    auto const uSeq
+        = SS::merge(p(U)->seqBefore,
+                    U->route->seqBetween(U->position + 1, U->route->size()));
+
+    deltaCost += costEvaluator.sequencePenalty(uSeq.violations());
+    deltaCost -= costEvaluator.sequencePenalty(U->route->sequenceViolations());
+
+    auto uTWS = TWS::merge(data.durations(), p(U)->twBefore, n(U)->twAfter);
 
     deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
     deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
+    timer.stop();
+    removeStats.recordEvaluation(deltaCost);
+
     if (deltaCost < 0)
     {
         auto *route = U->route;  // after U->remove(), U->route is a nullptr
         U->remove();
         update(route, route);
+        removeStats.recordApplication(deltaCost);
     }
 }
 
@@ -333,7 +588,7 @@ void LocalSearch::maybeRemove(Node *U, CostEvaluator const &costEvaluator)
 //    }  
 //
 //    auto uTWS
-//        = TWS::merge(data.durationMatrix(), p(U)->twBefore, n(U)->twAfter);
+//        = TWS::merge(data.durations(), p(U)->twBefore, n(U)->twAfter);
 //
 //    deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
 //    deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
@@ -352,11 +607,15 @@ void LocalSearch::update(Route *U, Route *V)
     searchCompleted = false;
 
     U->update();
+    orderIndex.update(*U);
+    sectorIndex.update(*U);
     lastModified[U->idx] = numMoves;
 
     if (U != V)
     {
         V->update();
+        orderIndex.update(*V);
+        sectorIndex.update(*V);
         lastModified[V->idx] = numMoves;
     }
 }
@@ -367,11 +626,12 @@ void LocalSearch::loadSolution(Solution const &solution)
     {
         clients[client].tw = {static_cast<int>(client),  // TODO cast
                               static_cast<int>(client),  // TODO cast
-                              data.client(client).serviceDuration,
+                              data.serviceDuration(client),
                               0,
-                              data.client(client).twEarly,
-                              data.client(client).twLate};
+                              data.twEarly(client),
+                              data.twLate(client)};
 
+        clients[client].seq = SS(data.clientClass(client));
         clients[client].route = nullptr;  // nullptr implies "not in solution"
     }
 
@@ -390,9 +650,12 @@ void LocalSearch::loadSolution(Solution const &solution)
 
         startDepot->tw = clients[0].tw;
         startDepot->twBefore = clients[0].tw;
+        startDepot->seq = {};
+        startDepot->seqBefore = {};
 
         endDepot->tw = clients[0].tw;
         endDepot->twAfter = clients[0].tw;
+        endDepot->seq = {};
 
         Route *route = &routes[r];
 
@@ -420,15 +683,17 @@ void LocalSearch::loadSolution(Solution const &solution)
         }
 
         route->update();
+        orderIndex.update(*route);
+        sectorIndex.update(*route);
     }
 
     for (auto *routeOp : routeOps)
         routeOp->init(solution);
 }
 
-Solution LocalSearch::exportSolution() // const
+Solution LocalSearch::exportSolution() const
 {
-    std::cout << "          LOCALSEARCH EXPORTSOLUTION Enter" << std::endl;
+    PYVRP_TRACE(SEARCH, INFO, "LOCALSEARCH EXPORTSOLUTION Enter");
     std::vector<std::vector<int>> solRoutes(data.numVehicles());
 
     for (size_t r = 0; r < data.numVehicles(); r++)
@@ -442,40 +707,50 @@ Solution LocalSearch::exportSolution() // const
         }
     }
 
-    reorderRoutes(solRoutes, data);
-
-    bool repairedConstraintsPassed = false;
-    Solution sol{data, solRoutes};
-    repairedConstraintsPassed = std::all_of(sol.getRoutes().begin(), sol.getRoutes().end(),
-        [this](const Solution::Route &route) { return this->checkSequence(this->data, route); });
-    if (repairedConstraintsPassed) {
-        std::cout << "                    LOCALSEARCH EXPORTSOLUTION repairedConstraintsPassed" << std::endl;
-    }
-    std::cout << "          LOCALSEARCH EXPORTSOLUTION Exit" << std::endl;
-    return sol;
+    PYVRP_TRACE(SEARCH, INFO, "LOCALSEARCH EXPORTSOLUTION Exit");
+    return {data, solRoutes};
 }
 
 bool LocalSearch::solHasValidSequences(const Solution &sol)
 {
-    bool isValidSequence = false;
-    isValidSequence = std::all_of(sol.getRoutes().begin(), sol.getRoutes().end(),
-        [this](const Solution::Route &route) { return this->checkSequence(this->data, route); });
-    return isValidSequence;
+    return !sol.hasSequenceViolations();
 }
 
-void LocalSearch::addNodeOperator(NodeOp &op) { nodeOps.emplace_back(&op); }
+void LocalSearch::addNodeOperator(NodeOp &op)
+{
+    workers.clear();  // workers have clones of the old set of operators
+
+    op.setOrderIndex(&orderIndex);
+    nodeOpOrder.push_back(nodeOps.size());
+    nodeOps.emplace_back(&op);
+    nodeOpStats.emplace_back();
+}
 
-void LocalSearch::addRouteOperator(RouteOp &op) { routeOps.emplace_back(&op); }
+void LocalSearch::addRouteOperator(RouteOp &op)
+{
+    workers.clear();  // workers have clones of the old set of operators
+
+    op.setOrderIndex(&orderIndex);
+    routeOpOrder.push_back(routeOps.size());
+    routeOps.emplace_back(&op);
+    routeOpStats.emplace_back();
+}
+
+void LocalSearch::setNeighbours(Neighbours const &neighbours)
+{
+    setNeighbourhood(Neighbourhood(neighbours));
+}
 
-void LocalSearch::setNeighbours(Neighbours neighbours)
+void LocalSearch::setNeighbourhood(Neighbourhood neighbourhood)
 {
-    if (neighbours.size() != data.numClients() + 1)
+    if (neighbourhood.size() != data.numClients() + 1)
         throw std::runtime_error("Neighbourhood dimensions do not match.");
 
     for (size_t client = 0; client <= data.numClients(); ++client)
     {
-        auto const beginPos = neighbours[client].begin();
-        auto const endPos = neighbours[client].end();
+        auto const clientNeighbours = neighbourhood[client];
+        auto const beginPos = clientNeighbours.begin();
+        auto const endPos = clientNeighbours.end();
 
         auto const clientPos = std::find(beginPos, endPos, client);
         auto const depotPos = std::find(beginPos, endPos, 0);
@@ -488,31 +763,52 @@ void LocalSearch::setNeighbours(Neighbours neighbours)
         }
     }
 
-    auto isEmpty = [](auto const &neighbours) { return neighbours.empty(); };
-    if (std::all_of(neighbours.begin(), neighbours.end(), isEmpty))
+    if (neighbourhood.numNeighbours() == 0)
         throw std::runtime_error("Neighbourhood is empty.");
 
-    this->neighbours = neighbours;
+    this->neighbours
+        = std::make_shared<Neighbourhood const>(std::move(neighbourhood));
+    workers.clear();  // workers share the old neighbourhood structure
 }
 
-LocalSearch::Neighbours const &LocalSearch::getNeighbours() const
+LocalSearch::Neighbours LocalSearch::getNeighbours() const
 {
-    return neighbours;
+    return neighbours->toLists();
 }
 
-LocalSearch::LocalSearch(ProblemData const &data, Neighbours neighbours)
+Neighbourhood const &LocalSearch::getNeighbourhood() const
+{
+    return *neighbours;
+}
+
+LocalSearch::LocalSearch(ProblemData const &data, Neighbours const &neighbours)
+    : LocalSearch(data, std::shared_ptr<Neighbourhood const>())
+{
+    setNeighbours(neighbours);
+}
+
+LocalSearch::LocalSearch(ProblemData const &data, Neighbourhood neighbourhood)
+    : LocalSearch(data, std::shared_ptr<Neighbourhood const>())
+{
+    setNeighbourhood(std::move(neighbourhood));
+}
+
+LocalSearch::~LocalSearch() = default;
+
+LocalSearch::LocalSearch(ProblemData const &data,
+                         std::shared_ptr<Neighbourhood const> neighbours)
     : data(data),
-      neighbours(data.numClients() + 1),
+      neighbours(std::move(neighbours)),
       orderNodes(data.numClients()),
       orderRoutes(data.numVehicles()),
       lastModified(data.numVehicles(), -1),
       clients(data.numClients() + 1),
       routes(data.numVehicles(), data),
       startDepots(data.numVehicles()),
-      endDepots(data.numVehicles())
+      endDepots(data.numVehicles()),
+      orderIndex(data),
+      sectorIndex(data.numVehicles())
 {
-    setNeighbours(neighbours);
-
     std::iota(orderNodes.begin(), orderNodes.end(), 1);
     std::iota(orderRoutes.begin(), orderRoutes.end(), 0);
 
@@ -531,146 +827,3 @@ LocalSearch::LocalSearch(ProblemData const &data, Neighbours neighbours)
         endDepots[i].route = &routes[i];
     }
 }
-
-bool LocalSearch::checkSequence(ProblemData const &data, const Solution::Route &route)
-{
-    std::cout << "                    LOCALSEARCH CHECKSEQUENCE Enter" << std::endl;
-    bool foundDelivery = false;
-    bool foundBoth = false;
-    bool foundSalvage = false;
-
-    for (Client c : route) {
-        bool isDelivery = (data.client(c).demandWeight || data.client(c).demandVolume);
-        bool isSalvage = (data.client(c).demandSalvage == 1);
-        bool isBoth = (isDelivery && isSalvage);
-
-        std::cout << "                              LOCALSEARCH CHECKSEQUENCE Client: " << c
-           << " Dem Salv: " << data.client(c).demandSalvage
-           << " Dem Weig: " << data.client(c).demandWeight
-           << " Dem Volu: " << data.client(c).demandVolume
-           << " Salv is: " << isSalvage
-           << " Salv fo: " << foundSalvage << " Both is: "
-           << isBoth << " Both fo: " << foundBoth << " Del is: "
-          << isDelivery << " Del fo: " << isDelivery << std::endl;
-
-        if (isBoth && (foundBoth || foundSalvage))
-        {
-            std::cout << "                              LOCALSEARCH CHECKSEQUENCE Failed (isBoth && (foundBoth || foundSalvage))" << std::endl;
-            std::cout << "                    LOCALSEARCH CHECKSEQUENCE Exit Selective checkSequence" << std::endl;
-            return false;
-        }
-        if (isDelivery && (foundBoth || foundSalvage))
-        {
-            std::cout << "                              LOCALSEARCH CHECKSEQUENCE Failed (isDelivery && (foundBoth || foundSalvage))" << std::endl;
-            std::cout << "                    LOCALSEARCH CHECKSEQUENCE Exit Selective checkSequence" << std::endl;
-            return false;
-        }
-        if (isSalvage && foundBoth)
-        {
-            std::cout << "                              LOCALSEARCH CHECKSEQUENCE Failed (isSalvage && foundBoth)" << std::endl;
-            std::cout << "                    LOCALSEARCH CHECKSEQUENCE Exit Selective checkSequence" << std::endl;
-            return false;
-        }
-
-        if (isSalvage)
-        {
-            if (!foundSalvage)
-                foundSalvage = true;
-        }
-
-        if (isDelivery)
-        {
-            if (!foundDelivery)
-                foundDelivery = true;
-        }
-
-        if(isBoth)
-        {
-            if (!foundBoth)
-                foundBoth = true;
-        }
-
-        continue;
-    }
-    std::cout << "                    LOCALSEARCH CHECKSEQUENCE Exit" << std::endl;
-    return true;
-}
-
-void LocalSearch::reorderRoutes(std::vector<std::vector<Client>> &routes, ProblemData const &data)
-{
-    std::cout << "                    LOCALSEARCH REORDER Enter" << std::endl;
-    std::vector<std::vector<Client>> newRoutes;
-
-    int routeCnt=0;
-    for (auto &route : routes)
-    {
-        std::cout << "                              LOCALSEARCH REORDER Route: " << routeCnt << std::endl;
-        std::vector<Client> deliveryRoute, bothRoute, salvageRoute;
-
-        for (const auto &client : route)
-        {
-            std::cout << "                                        LOCALSEARCH REORDER  Client: " << client << std::endl;
-            bool isDelivery = (data.client(client).demandWeight || data.client(client).demandVolume);
-            bool isSalvage = (data.client(client).demandSalvage == 1);
-            bool isBoth = (isDelivery && isSalvage);
-
-            if (isDelivery && !isBoth)
-            {
-                deliveryRoute.push_back(client);
-            }
-            else if (isBoth)
-            {
-                bothRoute.push_back(client);
-            }
-            else
-            {
-                salvageRoute.push_back(client);
-            }
-        }
-
-        auto deliveryIter = deliveryRoute.begin();
-        auto bothIter = bothRoute.begin();
-        auto salvageIter = salvageRoute.begin();
-
-        while (deliveryIter != deliveryRoute.end() || bothIter != bothRoute.end() || salvageIter != salvageRoute.end())
-        {
-            std::vector<Client> newRoute;
-
-            // Add Ds
-            while (deliveryIter != deliveryRoute.end())
-            {
-                newRoute.push_back(*deliveryIter);
-                ++deliveryIter;
-            }
-
-            // Add single B if exists
-            if (bothIter != bothRoute.end())
-            {
-                newRoute.push_back(*bothIter);
-                ++bothIter;
-            }
-
-            newRoutes.push_back(newRoute);
-
-            // If no more Bs exist, add remaining Ss to new route
-            if (bothIter == bothRoute.end())
-            {
-                newRoute.clear();
-
-                while (salvageIter != salvageRoute.end())
-                {
-                    newRoute.push_back(*salvageIter);
-                    ++salvageIter;
-                }
-
-                if (!newRoute.empty())
-                {
-                    newRoutes.push_back(newRoute);
-                }
-            }
-        }
-        routeCnt++;
-    }
-    std::cout << "                    LOCALSEARCH REORDER Exit" << std::endl;
-    routes = newRoutes;
-}
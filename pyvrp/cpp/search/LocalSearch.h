@@ -3,13 +3,19 @@
 
 #include "CostEvaluator.h"
 #include "LocalSearchOperator.h"
+#include "Neighbourhood.h"
 #include "Node.h"
+#include "OperatorStatistics.h"
+#include "OrderIndex.h"
 #include "ProblemData.h"
 #include "Route.h"
+#include "SectorIndex.h"
 #include "Solution.h"
+#include "ThreadPool.h"
 #include "XorShift128.h"
 
 #include <functional>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -22,9 +28,10 @@ class LocalSearch
 
     ProblemData const &data;
 
-    // Neighborhood restrictions: list of nearby clients for each client (size
-    // numClients + 1, but nothing stored for the depot!)
-    Neighbours neighbours;
+    // Neighborhood restrictions: nearby clients for each client (size
+    // numClients + 1, but nothing stored for the depot!). Shared with the
+    // workers of batch searches, which do not modify it.
+    std::shared_ptr<Neighbourhood const> neighbours;
 
     std::vector<int> orderNodes;   // node order used by LocalSearch::search
     std::vector<int> orderRoutes;  // route order used by LocalSearch::intensify
@@ -36,17 +43,51 @@ class LocalSearch
     std::vector<Node> startDepots;  // These mark the start of routes
     std::vector<Node> endDepots;    // These mark the end of routes
 
-    std::vector<NodeOp *> nodeOps;
-    std::vector<RouteOp *> routeOps;
+    OrderIndex orderIndex;    // Tracks the routes each order is split over
+    SectorIndex sectorIndex;  // Tracks the circle sector of each route
+
+    std::vector<NodeOp *> nodeOps;    // in the order they were added
+    std::vector<RouteOp *> routeOps;  // in the order they were added
+
+    std::vector<size_t> nodeOpOrder;   // order in which operators are tested,
+    std::vector<size_t> routeOpOrder;  // as indices into the vectors above
+
+    std::vector<OperatorStatistics> nodeOpStats;   // per node operator
+    std::vector<OperatorStatistics> routeOpStats;  // per route operator
+    OperatorStatistics insertStats;                // of maybeInsert()
+    OperatorStatistics removeStats;                // of maybeRemove()
 
     int numMoves = 0;              // Operator counter
     bool searchCompleted = false;  // No further improving move found?
 
+    // Operators owned by this local search. These are only used by clones,
+    // which own clones of the operators of the original local search.
+    std::vector<std::unique_ptr<NodeOp>> ownedNodeOps;
+    std::vector<std::unique_ptr<RouteOp>> ownedRouteOps;
+
+    // Each worker of a batch search is a clone of this local search. Workers
+    // are created on first use, and kept between batches, as are the threads
+    // that run them.
+    std::vector<std::unique_ptr<LocalSearch>> workers;
+    std::unique_ptr<ThreadPool> pool;
+
+    using Task = std::function<Solution(LocalSearch &, Solution const &)>;
+
+    // Ensures there are at least the given number of workers, with operators
+    // and evaluation order in sync with this local search.
+    void prepareWorkers(size_t numWorkers);
+
+    // Runs the given task for each solution, using the given number of threads
+    // (or one per hardware thread when zero).
+    std::vector<Solution> runBatch(std::vector<Solution> const &solutions,
+                                   Task const &task,
+                                   size_t numThreads);
+
     // Load an initial solution that we will attempt to improve.
     void loadSolution(Solution const &solution);
 
     // Export the LS solution back into a solution.
-    Solution exportSolution(); // const;
+    Solution exportSolution() const;
 
     // Tests the node pair (U, V).
     bool applyNodeOps(Node *U, Node *V, CostEvaluator const &costEvaluator);
@@ -63,10 +104,9 @@ class LocalSearch
     // Test removing U from the solution. Called when U can be removed.
     void maybeRemove(Node *U, CostEvaluator const &costEvaluator);
 
-    // Enforce salvage sequence constraint
-
-    void reorderRoutes(std::vector<std::vector<Client>> &routes, ProblemData const &data);
-    bool checkSequence(ProblemData const &data, const Solution::Route &route);
+    // Used for clones, which share the neighbourhood structure.
+    LocalSearch(ProblemData const &data,
+                std::shared_ptr<Neighbourhood const> neighbours);
 
 public:
     /**
@@ -85,35 +125,128 @@ public:
      * the neighbourhood structure is a vector of nearby clients. The depot has
      * no nearby client.
      */
-    void setNeighbours(Neighbours neighbours);
+    void setNeighbours(Neighbours const &neighbours);
+
+    /**
+     * Set neighbourhood structure to use by the local search, as computed by
+     * computeNeighbourhood(), for example.
+     */
+    void setNeighbourhood(Neighbourhood neighbourhood);
+
+    /**
+     * @return The neighbourhood structure currently in use, as a vector of
+     *         nearby clients for each client.
+     */
+    Neighbours getNeighbours() const;
 
     /**
      * @return The neighbourhood structure currently in use.
      */
-    Neighbours const &getNeighbours() const;
+    Neighbourhood const &getNeighbourhood() const;
 
     /**
      * Performs regular (node-based) local search around the given solution,
      * and returns a new, hopefully improved solution.
      */
-    Solution search(Solution &solution, CostEvaluator const &costEvaluator);
+    Solution search(Solution const &solution,
+                    CostEvaluator const &costEvaluator);
 
     /**
      * Performs a more intensive route-based local search around the given
      * solution, and returns a new, hopefully improved solution.
      */
-    Solution intensify(Solution &solution,
+    Solution intensify(Solution const &solution,
                        CostEvaluator const &costEvaluator,
                        int overlapToleranceDegrees = 0);
 
+    /**
+     * Performs regular local search around each of the given solutions, in
+     * parallel. The solutions are divided dynamically over the threads, each
+     * of which has its own copy of the search state and operators. The
+     * results are the same as those of calling search() on each solution in
+     * turn, without shuffling in between. Statistics of the threads are added
+     * to those of this local search.
+     *
+     * @param solutions     Solutions to improve.
+     * @param costEvaluator Cost evaluator to use.
+     * @param numThreads    Number of threads to use. Defaults to the number of
+     *                      hardware threads when zero. At most one thread is
+     *                      used per solution.
+     * @return The improved solutions, in the same order as the given ones.
+     */
+    std::vector<Solution> searchBatch(std::vector<Solution> const &solutions,
+                                      CostEvaluator const &costEvaluator,
+                                      size_t numThreads = 0);
+
+    /**
+     * Performs the more intensive route-based local search around each of the
+     * given solutions, in parallel. See searchBatch() for details.
+     */
+    std::vector<Solution>
+    intensifyBatch(std::vector<Solution> const &solutions,
+                   CostEvaluator const &costEvaluator,
+                   int overlapToleranceDegrees = 0,
+                   size_t numThreads = 0);
+
     /**
      * Shuffles the order in which the node and route pairs are evaluated, and
      * the order in which node and route operators are applied.
      */
     void shuffle(XorShift128 &rng);
 
-    LocalSearch(ProblemData const &data, Neighbours neighbours);
+    /**
+     * @return Statistics of each node operator, in the order in which the
+     *         operators were added.
+     */
+    std::vector<OperatorStatistics> const &nodeOperatorStatistics() const;
+
+    /**
+     * @return Statistics of each route operator, in the order in which the
+     *         operators were added.
+     */
+    std::vector<OperatorStatistics> const &routeOperatorStatistics() const;
+
+    /**
+     * @return Statistics of inserting clients that are not in the solution.
+     */
+    OperatorStatistics const &insertStatistics() const;
+
+    /**
+     * @return Statistics of removing optional clients from the solution.
+     */
+    OperatorStatistics const &removeStatistics() const;
+
+    /**
+     * Resets all operator statistics to zero. Statistics accumulate over calls
+     * to search() and intensify() until they are reset.
+     */
+    void resetStatistics();
 
+    /**
+     * Adds the statistics of the given local search to those of this local
+     * search. Both must have the same operators, added in the same order.
+     */
+    void addStatistics(LocalSearch const &other);
+
+    /**
+     * Returns a new local search for the same problem data, that shares this
+     * local search's neighbourhood structure, and owns clones of its
+     * operators. The clone uses the same evaluation order, but its statistics
+     * start at zero. Clones can be used independently of this local search,
+     * for example on another thread, but must not outlive it.
+     */
+    [[nodiscard]] std::unique_ptr<LocalSearch> clone() const;
+
+    LocalSearch(ProblemData const &data, Neighbours const &neighbours);
+
+    LocalSearch(ProblemData const &data, Neighbourhood neighbourhood);
+
+    ~LocalSearch();
+
+    /**
+     * Tests if all routes of the given solution visit their clients in a
+     * feasible delivery/salvage sequence.
+     */
     bool solHasValidSequences(const Solution &sol);
 };
 
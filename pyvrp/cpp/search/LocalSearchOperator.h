@@ -4,10 +4,15 @@
 #include "CostEvaluator.h"
 #include "Measure.h"
 #include "Node.h"
+#include "OrderIndex.h"
 #include "ProblemData.h"
 #include "Route.h"
 #include "Solution.h"
 
+#include <memory>
+
+template <typename Arg> class LocalSearchOperator;
+
 template <typename Arg> class LocalSearchOperatorBase
 {
     // Can only be specialised into either a Node or Route operator; there
@@ -18,6 +23,11 @@ template <typename Arg> class LocalSearchOperatorBase
 protected:
     ProblemData const &data;
 
+    // Solution-wide order index maintained by the local search. This is a
+    // nullptr when the operator is used outside of the local search, in which
+    // case order splits are not evaluated.
+    OrderIndex const *orderIndex = nullptr;
+
 public:
     /**
      * Determines the cost delta of applying this operator to the arguments.
@@ -40,6 +50,22 @@ public:
     // TODO remove arguments - always applies to most recently evaluated pair.
     virtual void apply(Arg *U, Arg *V) const = 0;
 
+    /**
+     * Sets the order index to use when evaluating how moves change the number
+     * of routes that orders span. Called by the local search when the operator
+     * is added to it.
+     */
+    virtual void setOrderIndex(OrderIndex const *index) { orderIndex = index; }
+
+    /**
+     * Returns a new operator of the same type, for the same problem data, but
+     * with its own (fresh) internal state. This is used to give each thread of
+     * a batch local search its own operator instances, since operators may
+     * cache state between calls to <code>evaluate()</code>.
+     */
+    [[nodiscard]] virtual std::unique_ptr<LocalSearchOperator<Arg>>
+    clone() const = 0;
+
     LocalSearchOperatorBase(ProblemData const &data) : data(data){};
     virtual ~LocalSearchOperatorBase() = default;
 };
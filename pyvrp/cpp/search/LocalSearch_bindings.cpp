@@ -6,9 +6,37 @@
 
 namespace py = pybind11;
 
+namespace
+{
+py::dict toDict(OperatorStatistics const &stats)
+{
+    py::dict result;
+    result["num_evaluations"] = stats.numEvaluations;
+    result["num_improving"] = stats.numImproving;
+    result["num_applied"] = stats.numApplied;
+    result["evaluation_ticks"] = stats.evaluationTicks;
+    result["total_delta"] = stats.totalDelta.get();
+    return result;
+}
+
+py::list toList(std::vector<OperatorStatistics> const &stats)
+{
+    py::list result;
+    for (auto const &opStats : stats)
+        result.append(toDict(opStats));
+    return result;
+}
+}  // namespace
+
 PYBIND11_MODULE(_LocalSearch, m)
 {
     py::class_<LocalSearch>(m, "LocalSearch")
+        // The Neighbourhood overloads are registered first: a Neighbourhood
+        // object would otherwise be converted (slowly) to a list of lists.
+        .def(py::init<ProblemData const &, Neighbourhood>(),
+             py::arg("data"),
+             py::arg("neighbours"),
+             py::keep_alive<1, 2>())  // keep data alive until LS is freed
         .def(py::init<ProblemData const &, std::vector<std::vector<int>>>(),
              py::arg("data"),
              py::arg("neighbours"),
@@ -21,21 +49,52 @@ PYBIND11_MODULE(_LocalSearch, m)
              &LocalSearch::addRouteOperator,
              py::arg("op"),
              py::keep_alive<1, 2>())
+        .def("set_neighbours",
+             &LocalSearch::setNeighbourhood,
+             py::arg("neighbours"))
         .def("set_neighbours",
              &LocalSearch::setNeighbours,
              py::arg("neighbours"))
-        .def("get_neighbours",
-             &LocalSearch::getNeighbours,
+        .def("get_neighbours", &LocalSearch::getNeighbours)
+        .def("get_neighbourhood",
+             &LocalSearch::getNeighbourhood,
              py::return_value_policy::reference_internal)
         .def("search",
              &LocalSearch::search,
              py::arg("solution"),
-             py::arg("cost_evaluator"))
+             py::arg("cost_evaluator"),
+             py::call_guard<py::gil_scoped_release>())
         .def("intensify",
              &LocalSearch::intensify,
              py::arg("solution"),
              py::arg("cost_evaluator"),
-             py::arg("overlap_tolerance_degrees") = 0)
+             py::arg("overlap_tolerance_degrees") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("search_batch",
+             &LocalSearch::searchBatch,
+             py::arg("solutions"),
+             py::arg("cost_evaluator"),
+             py::arg("num_threads") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("intensify_batch",
+             &LocalSearch::intensifyBatch,
+             py::arg("solutions"),
+             py::arg("cost_evaluator"),
+             py::arg("overlap_tolerance_degrees") = 0,
+             py::arg("num_threads") = 0,
+             py::call_guard<py::gil_scoped_release>())
         .def("shuffle", &LocalSearch::shuffle, py::arg("rng"))
+        .def("statistics",
+             [](LocalSearch const &ls) {
+                 py::dict result;
+                 result["node_operators"]
+                     = toList(ls.nodeOperatorStatistics());
+                 result["route_operators"]
+                     = toList(ls.routeOperatorStatistics());
+                 result["insert"] = toDict(ls.insertStatistics());
+                 result["remove"] = toDict(ls.removeStatistics());
+                 return result;
+             })
+        .def("reset_statistics", &LocalSearch::resetStatistics)
         .def("solHasValidSequences", &LocalSearch::solHasValidSequences, py::arg("sol"));
 }
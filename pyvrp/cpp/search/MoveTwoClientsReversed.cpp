@@ -1,23 +1,22 @@
 #include "MoveTwoClientsReversed.h"
 #include "Route.h"
+#include "SequenceSegment.h"
 #include "TimeWindowSegment.h"
+#include "Trace.h"
 
 #include <cassert>
 
+using SS = SequenceSegment;
 using TWS = TimeWindowSegment;
 
 Cost MoveTwoClientsReversed::evaluate(Node *U,
                                       Node *V,
                                       CostEvaluator const &costEvaluator)
 {
-    std::cout << "Enter MoveTwoClientsReversed:evaluate" << std::endl;
+    PYVRP_TRACE(OPERATOR, DEBUG, "Enter MoveTwoClientsReversed:evaluate");
     if (U == n(V) || n(U) == V || n(U)->isDepot())
         return 0;
 
-    // if(checkSalvageSequenceConstraint(U, V)) {
-    //     return std::numeric_limits<Cost>::max() / 1000;
-    // }
-
     auto const posU = U->position;
     auto const posV = V->position;
 
@@ -34,11 +33,15 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
 
     if (U->route != V->route)
     {
+        if (orderIndex)  // moving U and n(U) may change order splits
+            deltaCost += orderIndex->exchangeCost(
+                U->route, posU, posU + 1, V->route, 1, 0, costEvaluator);
+
         if (U->route->isFeasible() && deltaCost >= 0)
             return deltaCost;
 
         auto uTWS = TWS::merge(
-            data.durationMatrix(), p(U)->twBefore, n(n(U))->twAfter);
+            data.durations(), p(U)->twBefore, n(n(U))->twAfter);
 
         deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
         deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
@@ -46,9 +49,8 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
         auto const weightDiff = U->route->weightBetween(posU, posU + 1);
         auto const volumeDiff = U->route->volumeBetween(posU, posU + 1);
         auto const salvageDiff = U->route->salvageBetween(posU, posU + 1);
-        auto const storeCountU = U->route->storesBetween(posU, posU + 1);
-        auto const storeCountV = V->route->storesBetween(posV, posV + 1);
-        auto const storeDiff = storeCountU - storeCountV;
+        auto const uStores = U->route->storeCount()
+                             - U->route->storesOnlyBetween(posU, posU + 1);
 
         deltaCost += costEvaluator.weightPenalty(U->route->weight() - weightDiff,
                                                data.weightCapacity());
@@ -56,7 +58,7 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
                                                data.volumeCapacity());
         deltaCost += costEvaluator.salvagePenalty(U->route->salvage() - salvageDiff,
                                                data.salvageCapacity());
-        deltaCost += costEvaluator.storesPenalty(U->route->storeCount() - storeDiff,
+        deltaCost += costEvaluator.storesPenalty(uStores,
                                                data.routeStoreLimit());
         deltaCost -= costEvaluator.weightPenalty(U->route->weight(),
                                                data.weightCapacity());
@@ -67,6 +69,12 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
         deltaCost -= costEvaluator.storesPenalty(U->route->storeCount(),
                                                data.routeStoreLimit());
 
+        auto const uSeq = SS::merge(
+            p(U)->seqBefore, U->route->seqBetween(posU + 2, U->route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(uSeq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(U->route->sequenceViolations());
+
         if (deltaCost >= 0)    // if delta cost of just U's route is not enough
             return deltaCost;  // even without V, the move will never be good
 
@@ -76,7 +84,13 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
                                                data.volumeCapacity());
         deltaCost += costEvaluator.salvagePenalty(V->route->salvage() + salvageDiff,
                                                data.salvageCapacity());
-        deltaCost += costEvaluator.storesPenalty(V->route->storeCount() + storeDiff, 
+        auto const vStores = V->route->storeCount()
+                             + U->route->storesBetweenIf(
+                                 posU, posU + 1, [&](Store store) {
+                                     return !V->route->containsStore(store);
+                                 });
+
+        deltaCost += costEvaluator.storesPenalty(vStores,
                                                data.routeStoreLimit());
         deltaCost -= costEvaluator.weightPenalty(V->route->weight(),
                                                data.weightCapacity());
@@ -87,8 +101,17 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
         deltaCost -= costEvaluator.storesPenalty(V->route->storeCount(), 
                                                data.routeStoreLimit());
 
+        auto const vSeq
+            = SS::merge(V->seqBefore,
+                        n(U)->seq,
+                        U->seq,
+                        V->route->seqBetween(posV + 1, V->route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(vSeq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(V->route->sequenceViolations());
+
         auto vTWS = TWS::merge(
-            data.durationMatrix(), V->twBefore, n(U)->tw, U->tw, n(V)->twAfter);
+            data.durations(), V->twBefore, n(U)->tw, U->tw, n(V)->twAfter);
 
         deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
         deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
@@ -97,12 +120,29 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
     {
         auto const *route = U->route;
 
+        SS seq;
+        if (posU < posV)
+            seq = SS::merge(p(U)->seqBefore,
+                            route->seqBetween(posU + 2, posV),
+                            n(U)->seq,
+                            U->seq,
+                            route->seqBetween(posV + 1, route->size()));
+        else
+            seq = SS::merge(V->seqBefore,
+                            n(U)->seq,
+                            U->seq,
+                            route->seqBetween(posV + 1, posU - 1),
+                            route->seqBetween(posU + 2, route->size()));
+
+        deltaCost += costEvaluator.sequencePenalty(seq.violations());
+        deltaCost -= costEvaluator.sequencePenalty(route->sequenceViolations());
+
         if (!route->hasTimeWarp() && deltaCost >= 0)
             return deltaCost;
 
         if (posU < posV)
         {
-            auto const uTWS = TWS::merge(data.durationMatrix(),
+            auto const uTWS = TWS::merge(data.durations(),
                                          p(U)->twBefore,
                                          route->twBetween(posU + 2, posV),
                                          n(U)->tw,
@@ -113,7 +153,7 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
         }
         else
         {
-            auto const uTWS = TWS::merge(data.durationMatrix(),
+            auto const uTWS = TWS::merge(data.durations(),
                                          V->twBefore,
                                          n(U)->tw,
                                          U->tw,
@@ -129,35 +169,6 @@ Cost MoveTwoClientsReversed::evaluate(Node *U,
     return deltaCost;
 }
 
-//bool MoveTwoClientsReversed::checkSalvageSequenceConstraint(Node *U, Node *V) const
-//{
-//    // These sequences should violate the constraint
-//    // S-B
-//    // S-D
-//    // B-B
-//    // B-D
-//    bool uIsClientDelivery = (data.client(U->client).demandWeight || data.client(U->client).demandVolume);
-//    bool uIsClientSalvage = (data.client(U->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool uIsBoth = uIsClientDelivery && uIsClientSalvage;
-//
-//    bool vIsClientDelivery = (data.client(V->client).demandWeight || data.client(V->client).demandVolume);
-//    bool vIsClientSalvage = (data.client(V->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool vIsBoth = vIsClientDelivery && vIsClientSalvage;
-//
-//    bool nextUClientDelivery = (data.client(n(U)->client).demandWeight || data.client(n(U)->client).demandVolume);
-//    bool nextVClientDelivery = (data.client(n(V)->client).demandWeight || data.client(n(V)->client).demandVolume);
-//
-//    // S-B or S-D
-//    if (uIsClientSalvage && !uIsBoth && ((vIsClientDelivery || vIsBoth) || nextVClientDelivery))
-//        return true;
-//
-//    // B-B or B-D
-//    if (uIsBoth && ((vIsBoth || vIsClientDelivery) || nextUClientDelivery))
-//        return true;
-//
-//    return false;
-//}
-
 void MoveTwoClientsReversed::apply(Node *U, Node *V) const
 {
     auto *X = n(U);  // copy since the insert below changes n(U)
@@ -165,3 +176,8 @@ void MoveTwoClientsReversed::apply(Node *U, Node *V) const
     U->insertAfter(V);
     X->insertAfter(V);
 }
+
+std::unique_ptr<LocalSearchOperator<Node>> MoveTwoClientsReversed::clone() const
+{
+    return std::make_unique<MoveTwoClientsReversed>(data);
+}
@@ -10,14 +10,14 @@ class MoveTwoClientsReversed : public LocalSearchOperator<Node>
 {
     using LocalSearchOperator::LocalSearchOperator;
 
-//    bool checkSalvageSequenceConstraint(Node *U,
-//                                        Node *V) const;
-
 public:
     Cost
     evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Node *U, Node *V) const override;
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Node>>
+    clone() const override;
 };
 
 #endif  // PYVRP_MOVETWOCLIENTSREVERSED_H
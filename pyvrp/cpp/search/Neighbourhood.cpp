@@ -0,0 +1,337 @@
+#include "Neighbourhood.h"
+#include "KDTree.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <utility>
+
+namespace
+{
+using Candidate = std::pair<double, int>;  // [proximity, client]
+
+// Proximity of the given client to the given other client, based on Vidal et
+// al. (2013). The terms are summed in the same order as in the original numpy
+// implementation, so that ties are broken in the same way.
+double proximity(ProblemData const &data,
+                 NeighbourhoodParams const &params,
+                 size_t client,
+                 size_t other)
+{
+    auto const distance = static_cast<double>(data.dist(client, other).get());
+    auto const duration
+        = static_cast<double>(data.duration(client, other).get());
+
+    auto const early = static_cast<double>(data.twEarly(client).get());
+    auto const late = static_cast<double>(data.twLate(client).get());
+    auto const service
+        = static_cast<double>(data.serviceDuration(client).get());
+
+    auto const otherEarly = static_cast<double>(data.twEarly(other).get());
+    auto const otherLate = static_cast<double>(data.twLate(other).get());
+    auto const prize = static_cast<double>(data.client(other).prize.get());
+
+    auto const minWaitTime
+        = std::max(otherEarly - duration - service - late, 0.0);
+    auto const minTimeWarp
+        = std::max(early + service + duration - otherLate, 0.0);
+
+    return distance + params.weightWaitTime * minWaitTime
+           + params.weightTimeWarp * minTimeWarp - prize;
+}
+
+// Groups of clients, stored in CSR format like the neighbourhood itself.
+struct Groups
+{
+    std::vector<size_t> offsets;
+    std::vector<int> members;
+    std::vector<int> groupOf;  // group index of each client, or -1 if none
+
+    [[nodiscard]] std::span<int const> of(size_t client) const
+    {
+        auto const group = groupOf[client];
+        if (group < 0)
+            return {};
+
+        return {members.data() + offsets[group],
+                members.data() + offsets[group + 1]};
+    }
+};
+
+// Groups clients by the given key, which is -1 for clients without a group.
+template <typename KeyFn>
+Groups makeGroups(ProblemData const &data, size_t numGroups, KeyFn key)
+{
+    Groups groups;
+    groups.offsets.resize(numGroups + 1, 0);
+    groups.groupOf.resize(data.numClients() + 1, -1);
+
+    for (size_t client = 1; client <= data.numClients(); ++client)
+        if (auto const group = key(client); group >= 0)
+        {
+            groups.groupOf[client] = group;
+            groups.offsets[group + 1]++;
+        }
+
+    std::partial_sum(
+        groups.offsets.begin(), groups.offsets.end(), groups.offsets.begin());
+
+    groups.members.resize(groups.offsets.back());
+    auto next = groups.offsets;
+
+    for (size_t client = 1; client <= data.numClients(); ++client)
+        if (auto const group = groups.groupOf[client]; group >= 0)
+            groups.members[next[group]++] = static_cast<int>(client);
+
+    return groups;
+}
+
+// Returns the symmetrised version of the given neighbourhood, where each row
+// is sorted by client index.
+Neighbourhood symmetrise(Neighbourhood const &neighbourhood)
+{
+    auto const dim = neighbourhood.size();
+
+    std::vector<size_t> offsets(dim + 1, 0);
+    for (size_t client = 0; client != dim; ++client)
+        for (auto const other : neighbourhood[client])
+        {
+            offsets[client + 1]++;
+            offsets[other + 1]++;
+        }
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<int> indices(offsets.back());
+    auto next = offsets;
+
+    for (size_t client = 0; client != dim; ++client)
+        for (auto const other : neighbourhood[client])
+        {
+            indices[next[client]++] = other;
+            indices[next[other]++] = static_cast<int>(client);
+        }
+
+    // Each row may now contain duplicates, which we remove while compacting
+    // the rows towards the front of the indices array.
+    size_t size = 0;
+    for (size_t client = 0; client != dim; ++client)
+    {
+        auto const begin = indices.begin() + offsets[client];
+        auto const end = indices.begin() + offsets[client + 1];
+
+        std::sort(begin, end);
+        auto const last = std::unique(begin, end);
+
+        offsets[client] = size;
+        for (auto it = begin; it != last; ++it)
+            indices[size++] = *it;
+    }
+
+    offsets[dim] = size;
+    indices.resize(size);
+
+    return {std::move(offsets), std::move(indices)};
+}
+}  // namespace
+
+size_t Neighbourhood::size() const { return offsets_.size() - 1; }
+
+size_t Neighbourhood::numNeighbours() const { return indices_.size(); }
+
+std::vector<size_t> const &Neighbourhood::offsets() const { return offsets_; }
+
+std::vector<int> const &Neighbourhood::indices() const { return indices_; }
+
+std::vector<std::vector<int>> Neighbourhood::toLists() const
+{
+    std::vector<std::vector<int>> lists;
+    lists.reserve(size());
+
+    for (size_t client = 0; client != size(); ++client)
+    {
+        auto const neighbours = (*this)[client];
+        lists.emplace_back(neighbours.begin(), neighbours.end());
+    }
+
+    return lists;
+}
+
+Neighbourhood::Neighbourhood(std::vector<size_t> offsets,
+                             std::vector<int> indices)
+    : offsets_(std::move(offsets)), indices_(std::move(indices))
+{
+    if (offsets_.empty() || offsets_.front() != 0)
+        throw std::invalid_argument("Offsets must start at zero.");
+
+    if (!std::is_sorted(offsets_.begin(), offsets_.end()))
+        throw std::invalid_argument("Offsets must be non-decreasing.");
+
+    if (offsets_.back() != indices_.size())
+        throw std::invalid_argument("Offsets do not match indices.");
+}
+
+Neighbourhood::Neighbourhood(std::vector<std::vector<int>> const &neighbours)
+    : offsets_(neighbours.size() + 1, 0)
+{
+    for (size_t client = 0; client != neighbours.size(); ++client)
+        offsets_[client + 1] = offsets_[client] + neighbours[client].size();
+
+    indices_.reserve(offsets_.back());
+    for (auto const &clientNeighbours : neighbours)
+        indices_.insert(
+            indices_.end(), clientNeighbours.begin(), clientNeighbours.end());
+}
+
+Neighbourhood computeNeighbourhood(ProblemData const &data,
+                                   NeighbourhoodParams const &params,
+                                   size_t numThreads)
+{
+    auto const dim = data.numClients() + 1;
+    auto const numOthers = dim > 1 ? dim - 2 : 0;  // excl. depot and self
+    auto const numNearest = std::min(params.nbGranular, numOthers);
+
+    // Proximities are computed for all other clients, unless candidates are
+    // selected by location first. That is only worthwhile when there are
+    // fewer candidates than other clients.
+    auto const useTree
+        = params.numCandidates != 0 && params.numCandidates < numOthers;
+
+    std::unique_ptr<KDTree> tree;
+    if (useTree)
+        tree = std::make_unique<KDTree>(data);
+
+    Groups stores;
+    if (params.includeSameStore)
+        stores = makeGroups(data, data.numStores(), [&](size_t client) {
+            return static_cast<int>(data.clientStore(client).get());
+        });
+
+    Groups orders;
+    if (params.includeSameOrder)
+        orders = makeGroups(data, data.numOrders(), [&](size_t client) {
+            return static_cast<int>(data.clientOrder(client).get());
+        });
+
+    auto const prox = [&](size_t client, size_t other) {
+        auto const value = proximity(data, params, client, other);
+        if (!params.symmetricProximity)
+            return value;
+
+        return std::min(value, proximity(data, params, other, client));
+    };
+
+    if (numThreads == 0)
+        numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    numThreads = std::min(numThreads, std::max<size_t>(data.numClients(), 1));
+
+    // Each thread computes the neighbours of a contiguous range of clients,
+    // and stores those consecutively in its own chunk. The chunks are joined
+    // together afterwards. The depot has no neighbours.
+    std::vector<size_t> sizes(dim, 0);
+    std::vector<std::vector<int>> chunks(numThreads);
+    std::vector<std::exception_ptr> errors(numThreads);
+
+    auto work = [&](size_t thread) {
+        try
+        {
+            auto const begin = 1 + thread * (dim - 1) / numThreads;
+            auto const end = 1 + (thread + 1) * (dim - 1) / numThreads;
+
+            auto &chunk = chunks[thread];
+            chunk.reserve((end - begin) * numNearest);
+
+            std::vector<Candidate> candidates;
+            std::vector<Candidate> selected;
+            std::vector<int> nearest;
+            candidates.reserve(useTree ? params.numCandidates : numOthers);
+
+            for (auto client = begin; client != end; ++client)
+            {
+                candidates.clear();
+
+                if (useTree)
+                {
+                    tree->nearest(client, params.numCandidates, nearest);
+                    for (auto const other : nearest)
+                        candidates.emplace_back(prox(client, other), other);
+                }
+                else
+                {
+                    for (size_t other = 1; other != dim; ++other)
+                        if (other != client)
+                            candidates.emplace_back(prox(client, other),
+                                                    other);
+                }
+
+                auto const nth = candidates.begin() + numNearest;
+                std::nth_element(candidates.begin(), nth, candidates.end());
+                selected.assign(candidates.begin(), nth);
+
+                // Clients of the same store or order. Some of these may already
+                // be among the nearest clients; such duplicates are removed
+                // below, after sorting.
+                auto const addGroup = [&](std::span<int const> members) {
+                    for (auto const other : members)
+                        if (static_cast<size_t>(other) != client)
+                            selected.emplace_back(prox(client, other), other);
+                };
+
+                if (params.includeSameStore)
+                    addGroup(stores.of(client));
+
+                if (params.includeSameOrder)
+                    addGroup(orders.of(client));
+
+                std::sort(selected.begin(), selected.end());
+                selected.erase(std::unique(selected.begin(), selected.end()),
+                               selected.end());
+
+                sizes[client] = selected.size();
+                for (auto const &candidate : selected)
+                    chunk.push_back(candidate.second);
+            }
+        }
+        catch (...)
+        {
+            errors[thread] = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(numThreads - 1);
+
+        for (size_t thread = 1; thread != numThreads; ++thread)
+            threads.emplace_back(work, thread);
+
+        work(0);  // the calling thread computes the first range of clients
+    }             // all threads are joined here
+
+    for (auto const &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    std::vector<size_t> offsets(dim + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+
+    std::vector<int> indices;
+    indices.reserve(offsets.back());
+
+    for (auto &chunk : chunks)
+    {
+        indices.insert(indices.end(), chunk.begin(), chunk.end());
+        std::vector<int>().swap(chunk);  // frees the chunk's memory
+    }
+
+    Neighbourhood neighbourhood(std::move(offsets), std::move(indices));
+
+    if (params.symmetricNeighbours)
+        return symmetrise(neighbourhood);
+
+    return neighbourhood;
+}
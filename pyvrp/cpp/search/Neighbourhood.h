@@ -0,0 +1,153 @@
+#ifndef PYVRP_NEIGHBOURHOOD_H
+#define PYVRP_NEIGHBOURHOOD_H
+
+#include "ProblemData.h"
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Granular neighbourhood structure, stored in compressed sparse row (CSR)
+ * format: the neighbours of all clients are stored consecutively in a single
+ * array, and a second array stores where the neighbours of each client start.
+ * The structure has an entry for the depot, which has no neighbours.
+ */
+class Neighbourhood
+{
+    std::vector<size_t> offsets_;  // neighbours of client i are in indices_
+    std::vector<int> indices_;     // [offsets_[i], offsets_[i + 1])
+
+public:
+    /**
+     * @return The neighbours of the given client.
+     */
+    [[nodiscard]] inline std::span<int const> operator[](size_t client) const;
+
+    /**
+     * @return Number of clients in this structure, including the depot.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @return Total number of neighbours, summed over all clients.
+     */
+    [[nodiscard]] size_t numNeighbours() const;
+
+    /**
+     * @return Offsets into indices() at which the neighbours of each client
+     *         start. This has size() + 1 elements; the last is the total
+     *         number of neighbours.
+     */
+    [[nodiscard]] std::vector<size_t> const &offsets() const;
+
+    /**
+     * @return Neighbours of all clients, stored consecutively.
+     */
+    [[nodiscard]] std::vector<int> const &indices() const;
+
+    /**
+     * @return The neighbourhood as a list of neighbours for each client.
+     */
+    [[nodiscard]] std::vector<std::vector<int>> toLists() const;
+
+    /**
+     * Constructs the neighbourhood structure from the given CSR arrays.
+     *
+     * @throws std::invalid_argument When the offsets are empty, do not start
+     *                               at zero, are decreasing, or do not end at
+     *                               the number of indices.
+     */
+    Neighbourhood(std::vector<size_t> offsets, std::vector<int> indices);
+
+    /**
+     * Constructs the neighbourhood structure from a list of neighbours for
+     * each client.
+     */
+    explicit Neighbourhood(std::vector<std::vector<int>> const &neighbours);
+};
+
+/**
+ * Granular neighbourhood parameters. See the Python
+ * <code>NeighbourhoodParams</code> class for a description of each parameter.
+ */
+struct NeighbourhoodParams
+{
+    double weightWaitTime;
+    double weightTimeWarp;
+    size_t nbGranular;
+    bool symmetricProximity;
+    bool symmetricNeighbours;
+    bool includeSameStore;
+    bool includeSameOrder;
+    size_t numCandidates;
+
+    NeighbourhoodParams(double weightWaitTime = 0.2,
+                        double weightTimeWarp = 1.0,
+                        size_t nbGranular = 40,
+                        bool symmetricProximity = true,
+                        bool symmetricNeighbours = false,
+                        bool includeSameStore = false,
+                        bool includeSameOrder = false,
+                        size_t numCandidates = 0)
+        : weightWaitTime(weightWaitTime),
+          weightTimeWarp(weightTimeWarp),
+          nbGranular(nbGranular),
+          symmetricProximity(symmetricProximity),
+          symmetricNeighbours(symmetricNeighbours),
+          includeSameStore(includeSameStore),
+          includeSameOrder(includeSameOrder),
+          numCandidates(numCandidates)
+    {
+        if (nbGranular == 0)
+            throw std::invalid_argument("nb_granular <= 0 not understood.");
+
+        if (numCandidates != 0 && numCandidates < nbGranular)
+            throw std::invalid_argument(
+                "num_candidates < nb_granular not understood.");
+    }
+};
+
+/**
+ * Computes a granular neighbourhood for the given problem data. Each client's
+ * neighbourhood consists of the nbGranular other clients with the smallest
+ * proximity, based on Vidal et al. (2013). Proximity combines distance, the
+ * minimum wait time and time warp of visiting the clients consecutively, and
+ * the prize of the neighbouring client. Ties are broken by client index.
+ * <br />
+ * When requested, all other clients of the same store, or of the same order,
+ * are also in a client's neighbourhood. Clients with the default store index
+ * (-1) do not share a store. The neighbours of each client are sorted by
+ * proximity, or by client index if the neighbourhood is symmetrised.
+ * <br />
+ * Proximities are computed one row at a time, so the memory used is linear in
+ * the size of the neighbourhood, rather than quadratic in the number of
+ * clients. Rows are divided over the given number of threads.
+ * <br />
+ * By default, the proximity to every other client is computed, which takes
+ * time quadratic in the number of clients. When numCandidates is set, a k-d
+ * tree over the client locations is used instead, and proximities are only
+ * computed for the numCandidates clients nearest to each client in Euclidean
+ * distance. This takes O(n log n) time, for fixed numCandidates. The result is
+ * identical to the exact computation when each client's nearest clients by
+ * proximity are among its candidates, which is always the case when there
+ * are at least as many candidates as other clients.
+ *
+ * @param data       Problem data.
+ * @param params     Neighbourhood parameters.
+ * @param numThreads Number of threads to use. Defaults to the number of
+ *                   hardware threads when zero.
+ * @return The granular neighbourhood.
+ */
+Neighbourhood computeNeighbourhood(ProblemData const &data,
+                                   NeighbourhoodParams const &params,
+                                   size_t numThreads = 0);
+
+std::span<int const> Neighbourhood::operator[](size_t client) const
+{
+    return {indices_.data() + offsets_[client],
+            indices_.data() + offsets_[client + 1]};
+}
+
+#endif  // PYVRP_NEIGHBOURHOOD_H
@@ -0,0 +1,53 @@
+#include "Neighbourhood.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(_Neighbourhood, m)
+{
+    py::class_<Neighbourhood>(m, "Neighbourhood")
+        .def(py::init<std::vector<std::vector<int>> const &>(),
+             py::arg("neighbours"))
+        .def(py::init<std::vector<size_t>, std::vector<int>>(),
+             py::arg("offsets"),
+             py::arg("indices"))
+        .def("__len__", &Neighbourhood::size)
+        .def(
+            "__getitem__",
+            [](Neighbourhood const &neighbourhood, size_t client) {
+                if (client >= neighbourhood.size())
+                    throw py::index_error();
+
+                auto const neighbours = neighbourhood[client];
+                return std::vector<int>(neighbours.begin(), neighbours.end());
+            },
+            py::arg("client"))
+        .def("num_neighbours", &Neighbourhood::numNeighbours)
+        .def("offsets",
+             &Neighbourhood::offsets,
+             py::return_value_policy::reference_internal)
+        .def("indices",
+             &Neighbourhood::indices,
+             py::return_value_policy::reference_internal)
+        .def("to_lists", &Neighbourhood::toLists);
+
+    py::class_<NeighbourhoodParams>(m, "NeighbourhoodParams")
+        .def(py::init<double, double, size_t, bool, bool, bool, bool, size_t>(),
+             py::arg("weight_wait_time") = 0.2,
+             py::arg("weight_time_warp") = 1.0,
+             py::arg("nb_granular") = 40,
+             py::arg("symmetric_proximity") = true,
+             py::arg("symmetric_neighbours") = false,
+             py::arg("include_same_store") = false,
+             py::arg("include_same_order") = false,
+             py::arg("num_candidates") = 0);
+
+    m.def("compute_neighbourhood",
+          &computeNeighbourhood,
+          py::arg("data"),
+          py::arg("params"),
+          py::arg("num_threads") = 0,
+          py::call_guard<py::gil_scoped_release>());
+}
@@ -2,6 +2,7 @@
 #define PYVRP_NODE_H
 
 #include "Measure.h"
+#include "SequenceSegment.h"
 #include "TimeWindowSegment.h"
 
 class Route;
@@ -18,7 +19,9 @@ struct Node
     Load cumulatedWeight;                  // Weight depot -> client (incl)
     Load cumulatedVolume;                  // Volume depot -> client (incl)
     Salvage cumulatedSalvage;              // Salvage depot -> client (incl)
-    Store cumulatedStores;              // Stores depot -> client (incl)
+    Store cumulatedStores;                 // Distinct stores depot -> client
+    Store storesAfter;                     // Distinct stores client -> depot
+    size_t prevStoreVisit;                 // Position of previous store visit
     Distance cumulatedDistance;          // Dist depot -> client (incl)
     Distance cumulatedReversalDistance;  // Dist if (0..client) is reversed
 
@@ -26,6 +29,9 @@ struct Node
     TimeWindowSegment twBefore;  // TWS for (0...client) including self
     TimeWindowSegment twAfter;   // TWS for (client...0) including self
 
+    SequenceSegment seq;        // Sequence data for individual node (client)
+    SequenceSegment seqBefore;  // Sequence data for (0...client) incl. self
+
     [[nodiscard]] inline bool isDepot() const;
 
     /**
@@ -0,0 +1,107 @@
+#ifndef PYVRP_OPERATORSTATISTICS_H
+#define PYVRP_OPERATORSTATISTICS_H
+
+#include "Measure.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef PYVRP_OPERATOR_TIMING
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+/**
+ * Counters that track how often the local search evaluates and applies moves
+ * of a single operator, and what those moves are worth. Evaluation time is
+ * only measured when compiled with the meson 'operator_timing' option: in
+ * that case it is counted in timestamp counter ticks (or nanoseconds, on
+ * platforms without such a counter). Otherwise it is always zero.
+ */
+struct OperatorStatistics
+{
+    size_t numEvaluations = 0;     // calls to evaluate()
+    size_t numImproving = 0;       // evaluations with a negative delta cost
+    size_t numApplied = 0;         // moves that were applied
+    uint64_t evaluationTicks = 0;  // cumulative time spent in evaluate()
+    Cost totalDelta = 0;           // sum of delta costs of applied moves
+
+    /**
+     * Records an evaluation that resulted in the given delta cost.
+     */
+    void recordEvaluation(Cost deltaCost)
+    {
+        numEvaluations++;
+        numImproving += deltaCost < 0;
+    }
+
+    /**
+     * Records that a move with the given delta cost was applied.
+     */
+    void recordApplication(Cost deltaCost)
+    {
+        numApplied++;
+        totalDelta += deltaCost;
+    }
+
+    OperatorStatistics &operator+=(OperatorStatistics const &other)
+    {
+        numEvaluations += other.numEvaluations;
+        numImproving += other.numImproving;
+        numApplied += other.numApplied;
+        evaluationTicks += other.evaluationTicks;
+        totalDelta += other.totalDelta;
+        return *this;
+    }
+};
+
+/**
+ * Adds the time between its construction and destruction (or the first call
+ * to stop()) to the given tick counter. Compiles to nothing unless the
+ * 'operator_timing' option is set, so it can be left in the hot loops.
+ */
+class EvaluationTimer
+{
+#ifdef PYVRP_OPERATOR_TIMING
+    uint64_t &ticks;
+    uint64_t start;
+    bool running = true;
+
+    static uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        auto const time = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time)
+            .count();
+#endif
+    }
+
+public:
+    explicit EvaluationTimer(uint64_t &ticks) : ticks(ticks), start(now()) {}
+
+    void stop()
+    {
+        if (running)
+            ticks += now() - start;
+
+        running = false;
+    }
+
+    ~EvaluationTimer() { stop(); }
+#else
+public:
+    explicit EvaluationTimer([[maybe_unused]] uint64_t &ticks) {}
+
+    void stop() {}
+#endif
+
+    EvaluationTimer(EvaluationTimer const &) = delete;
+    EvaluationTimer &operator=(EvaluationTimer const &) = delete;
+};
+
+#endif  // PYVRP_OPERATORSTATISTICS_H
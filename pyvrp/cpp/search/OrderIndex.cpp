@@ -0,0 +1,171 @@
+#include "OrderIndex.h"
+
+#include <cassert>
+
+void OrderIndex::adjustSpanned(size_t order, int diff)
+{
+    Order const limit = data.orderRouteLimit();
+    Order const before = spanned[order];
+
+    spanned[order] += diff;
+
+    Order const after = spanned[order];
+    excess_ += (after > limit ? after - limit : Order(0))
+               - (before > limit ? before - limit : Order(0));
+}
+
+Cost OrderIndex::countsCost(size_t order,
+                            Route const *from,
+                            Route const *to,
+                            int numMoved,
+                            CostEvaluator const &costEvaluator) const
+{
+    assert(from != to);
+
+    auto numRoutes = spanned[order];
+
+    if (from && counts(order, from->idx) == numMoved)  // last ones leave from
+        numRoutes--;
+
+    if (to && counts(order, to->idx) == 0)  // first ones arrive at to
+        numRoutes++;
+
+    if (numRoutes == spanned[order])
+        return 0;
+
+    auto const limit = data.orderRouteLimit();
+    return costEvaluator.ordersPenalty(numRoutes, limit)
+           - costEvaluator.ordersPenalty(spanned[order], limit);
+}
+
+void OrderIndex::update(Route const &route)
+{
+    auto const idx = static_cast<size_t>(route.idx);
+    auto &orders = routeOrders[idx];
+
+    for (auto const order : orders)  // first remove the old contributions of
+    {                                // this route from the index
+        counts(order, idx) = 0;
+        adjustSpanned(order, -1);
+    }
+
+    orders.clear();
+
+    for (size_t pos = 1; pos <= route.size(); ++pos)
+    {
+        auto const order = orderOf(route[pos]->client);
+        if (order < 0)
+            continue;
+
+        if (counts(order, idx)++ == 0)  // first client of order on this route
+        {
+            adjustSpanned(order, 1);
+            orders.push_back(order);
+        }
+    }
+}
+
+int OrderIndex::numRoutes(Order order) const
+{
+    return spanned[static_cast<size_t>(order.get())];
+}
+
+Order OrderIndex::excess() const { return excess_; }
+
+Cost OrderIndex::relocateCost(Node const *U,
+                              Route const *to,
+                              CostEvaluator const &costEvaluator) const
+{
+    auto const order = orderOf(U->client);
+
+    if (order < 0 || U->route == to)
+        return 0;
+
+    return countsCost(order, U->route, to, 1, costEvaluator);
+}
+
+Cost OrderIndex::swapCost(Node const *U,
+                          Node const *V,
+                          CostEvaluator const &costEvaluator) const
+{
+    auto const uOrder = orderOf(U->client);
+    auto const vOrder = orderOf(V->client);
+
+    // When U and V belong to the same order, or are in the same route, the
+    // swap does not change the number of clients of any order on any route.
+    if (uOrder == vOrder || U->route == V->route)
+        return 0;
+
+    Cost deltaCost = 0;
+
+    if (uOrder >= 0)
+        deltaCost += countsCost(uOrder, U->route, V->route, 1, costEvaluator);
+
+    if (vOrder >= 0)
+        deltaCost += countsCost(vOrder, V->route, U->route, 1, costEvaluator);
+
+    return deltaCost;
+}
+
+Cost OrderIndex::exchangeCost(Route const *U,
+                              size_t uStart,
+                              size_t uEnd,
+                              Route const *V,
+                              size_t vStart,
+                              size_t vEnd,
+                              CostEvaluator const &costEvaluator) const
+{
+    if (U == V)
+        return 0;
+
+    auto const addMoved = [&](Route const *route, size_t pos, int diff) {
+        auto const order = orderOf((*route)[pos]->client);
+        if (order < 0)
+            return;
+
+        if (netMoved[order] == 0)  // may list an order twice when the net
+            touched.push_back(order);  // count returns to zero; that is OK
+
+        netMoved[order] += diff;
+    };
+
+    for (size_t pos = uStart; pos <= uEnd; ++pos)
+        addMoved(U, pos, 1);
+
+    for (size_t pos = vStart; pos <= vEnd; ++pos)
+        addMoved(V, pos, -1);
+
+    Cost deltaCost = 0;
+    auto const limit = data.orderRouteLimit();
+
+    for (auto const order : touched)
+    {
+        auto const moved = netMoved[order];
+        if (moved == 0)  // nothing changes for this order, or it has already
+            continue;    // been evaluated
+
+        netMoved[order] = 0;
+
+        auto const uCount = counts(order, U->idx);
+        auto const vCount = counts(order, V->idx);
+
+        auto const numRoutes = spanned[order] - (uCount > 0) - (vCount > 0)
+                               + (uCount - moved > 0) + (vCount + moved > 0);
+
+        deltaCost += costEvaluator.ordersPenalty(numRoutes, limit);
+        deltaCost -= costEvaluator.ordersPenalty(spanned[order], limit);
+    }
+
+    touched.clear();
+    return deltaCost;
+}
+
+OrderIndex::OrderIndex(ProblemData const &data)
+    : data(data),
+      counts(data.numOrders(), data.numVehicles()),
+      spanned(data.numOrders(), 0),
+      routeOrders(data.numVehicles()),
+      netMoved(data.numOrders(), 0)
+{
+    touched.reserve(data.numOrders());
+}
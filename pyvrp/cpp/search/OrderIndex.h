@@ -0,0 +1,108 @@
+#ifndef PYVRP_ORDERINDEX_H
+#define PYVRP_ORDERINDEX_H
+
+#include "CostEvaluator.h"
+#include "Matrix.h"
+#include "Measure.h"
+#include "Node.h"
+#include "ProblemData.h"
+#include "Route.h"
+
+#include <vector>
+
+/**
+ * Solution-wide index that tracks, for each order, how many of its clients are
+ * visited on each route, and how many routes the order spans. The index is
+ * owned by the local search, which keeps it in sync with the routes. Operators
+ * use it to determine in O(1) time (per moved client) how a move changes the
+ * order split penalty.
+ */
+class OrderIndex
+{
+    ProblemData const &data;
+
+    Matrix<int> counts;             // number of clients of order on route
+    std::vector<int> spanned;       // number of routes each order spans
+    std::vector<std::vector<size_t>> routeOrders;  // orders on each route
+    Order excess_ = 0;  // total spanned routes over the order route limit
+
+    // Scratch space used to evaluate moves of larger segments: the net number
+    // of clients of each order that move from the first to the second route.
+    mutable std::vector<int> netMoved;
+    mutable std::vector<size_t> touched;
+
+    // Returns the order index of the given client, or -1 if the client is not
+    // part of any order.
+    [[nodiscard]] inline int orderOf(int client) const;
+
+    // Adjusts the number of routes the given order spans by the given amount.
+    void adjustSpanned(size_t order, int diff);
+
+    // Returns the penalty delta when the given number of clients of the given
+    // order move from one route to another. Either route may be a nullptr.
+    [[nodiscard]] Cost countsCost(size_t order,
+                                  Route const *from,
+                                  Route const *to,
+                                  int numMoved,
+                                  CostEvaluator const &costEvaluator) const;
+
+public:
+    /**
+     * Updates the index with the current contents of the given route. Should
+     * be called after the route itself has been updated. Runs in time linear
+     * in the size of the route.
+     */
+    void update(Route const &route);
+
+    /**
+     * @return Number of routes the given order currently spans.
+     */
+    [[nodiscard]] int numRoutes(Order order) const;
+
+    /**
+     * @return Total number of routes orders span in excess of the order route
+     *         limit, summed over all orders.
+     */
+    [[nodiscard]] Order excess() const;
+
+    /**
+     * Returns the change in the order split penalty when client U is moved
+     * from its current route to the given route. Either route may be a
+     * nullptr, which indicates that U is not (or no longer) in the solution.
+     * Runs in O(1) time.
+     */
+    [[nodiscard]] Cost relocateCost(Node const *U,
+                                    Route const *to,
+                                    CostEvaluator const &costEvaluator) const;
+
+    /**
+     * Returns the change in the order split penalty when clients U and V are
+     * swapped between their routes. Runs in O(1) time.
+     */
+    [[nodiscard]] Cost swapCost(Node const *U,
+                                Node const *V,
+                                CostEvaluator const &costEvaluator) const;
+
+    /**
+     * Returns the change in the order split penalty when the clients in
+     * segment [uStart, uEnd] of route U are moved to route V, and those in
+     * segment [vStart, vEnd] of route V are moved to route U. Segments with
+     * start > end are empty. Runs in time linear in the segment lengths.
+     */
+    [[nodiscard]] Cost exchangeCost(Route const *U,
+                                    size_t uStart,
+                                    size_t uEnd,
+                                    Route const *V,
+                                    size_t vStart,
+                                    size_t vEnd,
+                                    CostEvaluator const &costEvaluator) const;
+
+    OrderIndex(ProblemData const &data);
+};
+
+int OrderIndex::orderOf(int client) const
+{
+    return static_cast<int>(data.clientOrder(client).get());
+}
+
+#endif  // PYVRP_ORDERINDEX_H
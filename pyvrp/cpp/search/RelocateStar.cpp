@@ -1,36 +1,179 @@
 #include "RelocateStar.h"
 
-Cost RelocateStar::evaluate(Route *U, Route *V, CostEvaluator const &costEvaluator)
+#include "SequenceSegment.h"
+#include "TimeWindowSegment.h"
+
+using SS = SequenceSegment;
+using TWS = TimeWindowSegment;
+
+void RelocateStar::prepare(Route const *from,
+                           Route const *to,
+                           RouteSnapshot const &toSnapshot,
+                           std::vector<Relocation> &relocations,
+                           CostEvaluator const &costEvaluator)
+{
+    // We never shrink, so the insertion data's buffers can be reused.
+    if (relocations.size() < from->size())
+        relocations.resize(from->size());
+
+    for (size_t pos = 1; pos <= from->size(); ++pos)
+    {
+        auto &relocation = relocations[pos - 1];
+        auto *U = (*from)[pos];
+
+        relocation.node = U;
+        relocation.current = from->distBetween(pos - 1, pos + 1);
+        relocation.shortcut = data.dist(p(U)->client, n(U)->client);
+        relocation.segment = from->distBetween(pos, pos);
+
+        if (orderIndex)  // moving U may change order splits
+            relocation.orderCost = orderIndex->exchangeCost(
+                from, pos, pos, to, 1, 0, costEvaluator);
+
+        relocation.timeWarp
+            = TWS::merge(data.durations(), p(U)->twBefore, n(U)->twAfter)
+                  .totalTimeWarp();
+
+        relocation.weight = from->weightBetween(pos, pos);
+        relocation.volume = from->volumeBetween(pos, pos);
+        relocation.salvage = from->salvageBetween(pos, pos);
+
+        relocation.fromStores
+            = from->storeCount() - from->storesOnlyBetween(pos, pos);
+        relocation.toStores
+            = to->storeCount()
+              + from->storesBetweenIf(pos, pos, [&](Store store) {
+                    return !to->containsStore(store);
+                });
+
+        auto const seqAfter = from->seqBetween(pos + 1, from->size());
+        relocation.violations
+            = SS::merge(p(U)->seqBefore, seqAfter).violations();
+
+        toSnapshot.insertions(U, relocation.insertions);
+    }
+}
+
+Cost RelocateStar::relocateCost(Relocation const &relocation,
+                                Route const *to,
+                                RouteSnapshot const &toSnapshot,
+                                size_t position,
+                                CostEvaluator const &costEvaluator) const
+{
+    // This follows Exchange<1, 0>::evalRelocateMove() for different routes
+    // step by step, including its early returns, so the delta costs are the
+    // same, also in floating point.
+    auto const *from = relocation.node->route;
+    auto const &insertions = relocation.insertions;
+
+    Distance const current = relocation.current + toSnapshot.distAt(position);
+    Distance const proposed = insertions.distTo[position] + relocation.segment
+                              + insertions.distFrom[position]
+                              + relocation.shortcut;
+
+    Cost deltaCost = static_cast<Cost>(proposed - current);
+
+    if (orderIndex)
+        deltaCost += relocation.orderCost;
+
+    if (from->isFeasible() && deltaCost >= 0)
+        return deltaCost;
+
+    deltaCost += costEvaluator.twPenalty(relocation.timeWarp);
+    deltaCost -= costEvaluator.twPenalty(from->timeWarp());
+
+    deltaCost += costEvaluator.weightPenalty(from->weight() - relocation.weight,
+                                             data.weightCapacity());
+    deltaCost += costEvaluator.volumePenalty(from->volume() - relocation.volume,
+                                             data.volumeCapacity());
+    deltaCost += costEvaluator.salvagePenalty(
+        from->salvage() - relocation.salvage, data.salvageCapacity());
+    deltaCost += costEvaluator.storesPenalty(relocation.fromStores,
+                                             data.routeStoreLimit());
+
+    deltaCost -= costEvaluator.weightPenalty(from->weight(),
+                                             data.weightCapacity());
+    deltaCost -= costEvaluator.volumePenalty(from->volume(),
+                                             data.volumeCapacity());
+    deltaCost -= costEvaluator.salvagePenalty(from->salvage(),
+                                              data.salvageCapacity());
+    deltaCost -= costEvaluator.storesPenalty(from->storeCount(),
+                                             data.routeStoreLimit());
+
+    deltaCost += costEvaluator.sequencePenalty(relocation.violations);
+    deltaCost -= costEvaluator.sequencePenalty(from->sequenceViolations());
+
+    if (deltaCost >= 0)    // if delta cost of just U's route is not enough
+        return deltaCost;  // even without V, the move will never be good.
+
+    deltaCost += costEvaluator.weightPenalty(to->weight() + relocation.weight,
+                                             data.weightCapacity());
+    deltaCost += costEvaluator.volumePenalty(to->volume() + relocation.volume,
+                                             data.volumeCapacity());
+    deltaCost += costEvaluator.salvagePenalty(
+        to->salvage() + relocation.salvage, data.salvageCapacity());
+    deltaCost += costEvaluator.storesPenalty(relocation.toStores,
+                                             data.routeStoreLimit());
+
+    deltaCost -= costEvaluator.weightPenalty(to->weight(),
+                                             data.weightCapacity());
+    deltaCost -= costEvaluator.volumePenalty(to->volume(),
+                                             data.volumeCapacity());
+    deltaCost -= costEvaluator.salvagePenalty(to->salvage(),
+                                              data.salvageCapacity());
+    deltaCost -= costEvaluator.storesPenalty(to->storeCount(),
+                                             data.routeStoreLimit());
+
+    deltaCost += costEvaluator.sequencePenalty(insertions.violations[position]);
+    deltaCost -= costEvaluator.sequencePenalty(to->sequenceViolations());
+
+    deltaCost += costEvaluator.twPenalty(insertions.timeWarp[position]);
+    deltaCost -= costEvaluator.twPenalty(to->timeWarp());
+
+    return deltaCost;
+}
+
+Cost RelocateStar::evaluate(Route *U,
+                            Route *V,
+                            CostEvaluator const &costEvaluator)
 {
     move = {};
 
-    for (auto *nodeU = n(U->depot); !nodeU->isDepot(); nodeU = n(nodeU))
-    {   
-        //if (checkSalvageSequenceConstraint(nodeU, V->depot))
-        //    continue;
+    snapshotU.load(*U);
+    snapshotV.load(*V);
+
+    prepare(U, V, snapshotV, fromU, costEvaluator);
+    prepare(V, U, snapshotU, fromV, costEvaluator);
+
+    // Moves are tested in the same order as evaluating each of them with
+    // Exchange<1, 0> would, so ties are broken the same way.
+    for (size_t idxU = 0; idxU != U->size(); ++idxU)
+    {
+        auto const &relocationU = fromU[idxU];
+        auto *nodeU = relocationU.node;
 
         // Test inserting U after V's depot
-        Cost deltaCost = relocate.evaluate(nodeU, V->depot, costEvaluator);
-        
+        Cost deltaCost
+            = relocateCost(relocationU, V, snapshotV, 0, costEvaluator);
+
         if (deltaCost < move.deltaCost)
             move = {deltaCost, nodeU, V->depot};
-        
-        for (auto *nodeV = n(V->depot); !nodeV->isDepot(); nodeV = n(nodeV))
-        {   
-            //if (checkSalvageSequenceConstraint(nodeU, nodeV))
-            //    continue;
+
+        for (size_t idxV = 0; idxV != V->size(); ++idxV)
+        {
+            auto const &relocationV = fromV[idxV];
+            auto *nodeV = relocationV.node;
 
             // Test inserting U after V
-            deltaCost = relocate.evaluate(nodeU, nodeV, costEvaluator);
+            deltaCost = relocateCost(
+                relocationU, V, snapshotV, nodeV->position, costEvaluator);
 
             if (deltaCost < move.deltaCost)
                 move = {deltaCost, nodeU, nodeV};
-            
-            //if (checkSalvageSequenceConstraint(nodeV, nodeU))
-            //    continue;
 
             // Test inserting V after U
-            deltaCost = relocate.evaluate(nodeV, nodeU, costEvaluator);
+            deltaCost = relocateCost(
+                relocationV, U, snapshotU, nodeU->position, costEvaluator);
 
             if (deltaCost < move.deltaCost)
                 move = {deltaCost, nodeV, nodeU};
@@ -40,37 +183,13 @@ Cost RelocateStar::evaluate(Route *U, Route *V, CostEvaluator const &costEvaluat
     return move.deltaCost;
 }
 
-//bool RelocateStar::checkSalvageSequenceConstraint(Node *U, Node *V) const
-//{
-//    // These sequences should violate the constraint
-//    // S-B
-//    // S-D
-//    // B-B
-//    // B-D
-//    bool uIsClientDelivery = (data.client(U->client).demandWeight || data.client(U->client).demandVolume);
-//    bool uIsClientSalvage = (data.client(U->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool uIsBoth = uIsClientDelivery && uIsClientSalvage;
-//    
-//    bool vIsClientDelivery = (data.client(V->client).demandWeight || data.client(V->client).demandVolume);
-//    bool vIsClientSalvage = (data.client(V->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool vIsBoth = vIsClientDelivery && vIsClientSalvage;
-//    
-//    bool nextUClientDelivery = (data.client(n(U)->client).demandWeight || data.client(n(U)->client).demandVolume);
-//    bool nextVClientDelivery = (data.client(n(V)->client).demandWeight || data.client(n(V)->client).demandVolume);
-//    
-//    // S-B or S-D
-//    if (uIsClientSalvage && !uIsBoth && ((vIsClientDelivery || vIsBoth) || nextVClientDelivery))
-//        return true;
-//
-//    // B-B or B-D
-//    if (uIsBoth && ((vIsBoth || vIsClientDelivery) || nextUClientDelivery))
-//        return true;
-//
-//    return false;
-//}
-
 void RelocateStar::apply([[maybe_unused]] Route *U,
                          [[maybe_unused]] Route *V) const
 {
     move.from->insertAfter(move.to);
 }
+
+std::unique_ptr<LocalSearchOperator<Route>> RelocateStar::clone() const
+{
+    return std::make_unique<RelocateStar>(data);
+}
@@ -1,13 +1,17 @@
 #ifndef PYVRP_RELOCATESTAR_H
 #define PYVRP_RELOCATESTAR_H
 
-#include "Exchange.h"
 #include "LocalSearchOperator.h"
 #include "Measure.h"
+#include "RouteSnapshot.h"
+
+#include <vector>
 
 /**
  * Performs the best (1, 0)-exchange move between routes U and V. Tests both
- * ways: from U to V, and from V to U.
+ * ways: from U to V, and from V to U. Moves are evaluated exactly like
+ * Exchange<1, 0> does, but the insertion data of each client is computed for
+ * all positions in the other route at once, from a RouteSnapshot.
  */
 class RelocateStar : public LocalSearchOperator<Route>
 {
@@ -18,10 +22,47 @@ class RelocateStar : public LocalSearchOperator<Route>
         Node *to = nullptr;
     };
 
-    Exchange<1, 0> relocate;
+    // Data of moving a client into the other route that does not depend on
+    // where in the other route the client is inserted.
+    struct Relocation
+    {
+        Node *node = nullptr;
+        Distance current = 0;   // route distance from p(node) to n(node)
+        Distance shortcut = 0;  // distance from p(node) directly to n(node)
+        Distance segment = 0;   // route distance from node to node
+        Cost orderCost = 0;
+        Duration timeWarp = 0;  // time warp of node's route after removal
+        Load weight = 0;
+        Load volume = 0;
+        Salvage salvage = 0;
+        Store fromStores = 0;     // stores on node's route after removal
+        Store toStores = 0;       // stores on other route after insertion
+        Sequence violations = 0;  // of node's route after removal
+        RouteSnapshot::Insertions insertions;
+    };
+
+    RouteSnapshot snapshotU;
+    RouteSnapshot snapshotV;
+    std::vector<Relocation> fromU;
+    std::vector<Relocation> fromV;
     Move move;
-//    bool checkSalvageSequenceConstraint(Node *U,
-//                                        Node *V) const;
+
+    // Computes the relocation data of each client in route from, for
+    // insertion into route to. The relocations vector may afterwards be longer
+    // than route from.
+    void prepare(Route const *from,
+                 Route const *to,
+                 RouteSnapshot const &toSnapshot,
+                 std::vector<Relocation> &relocations,
+                 CostEvaluator const &costEvaluator);
+
+    // Delta cost of inserting the relocated client after the given position
+    // of route to.
+    [[nodiscard]] Cost relocateCost(Relocation const &relocation,
+                                    Route const *to,
+                                    RouteSnapshot const &toSnapshot,
+                                    size_t position,
+                                    CostEvaluator const &costEvaluator) const;
 
 public:
     Cost
@@ -29,8 +70,11 @@ public:
 
     void apply(Route *U, Route *V) const override;
 
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Route>>
+    clone() const override;
+
     RelocateStar(ProblemData const &data)
-        : LocalSearchOperator<Route>(data), relocate(data)
+        : LocalSearchOperator<Route>(data), snapshotU(data), snapshotV(data)
     {
     }
 };
@@ -2,47 +2,39 @@
 // TODO use std::numbers::pi instead of M_PI when C++20 is supported by CIBW
 
 #include "Route.h"
+#include "Trace.h"
 
 #include <cmath>
 #include <ostream>
-#include <set>
 
 using TWS = TimeWindowSegment;
 
-Route::Route(ProblemData const &data) : data(data) {}
-
-bool Route::containsStore(Store store_index) const 
+Route::Route(ProblemData const &data)
+    : data(data),
+      storeVisits(data.numStores() + 1, 0),
+      firstStoreVisits(data.numStores() + 1, 0),
+      lastStoreVisits(data.numStores() + 1, 0),
+      stores_(0)
 {
-    for (const auto& node : nodes) {
-        if (data.client(node->client).clientStore == store_index) {
-            return true;
-        }
-    }
-    return false;
 }
 
-Store Route::storeCount() const
+void Route::setupNodes(size_t position, Node *node)
 {
-    std::set<int> uniqueStores;
-    for (size_t pos = 0; pos != nodes.size(); ++pos)
+    // Save the old suffix of this route before it is overwritten. Both vectors
+    // persist between updates, so they only allocate when the route grows
+    // longer than it has been before.
+    oldSuffix.assign(nodes.begin() + position - 1, nodes.end());
+    nodes.resize(position - 1);
+
+    while (true)
     {
-        auto *node = nodes[pos];
-        uniqueStores.insert(static_cast<int>(data.client(node->client).clientStore));
-    }
-    return Store(uniqueStores.size());
-}
-    
+        nodes.push_back(node);
 
-void Route::setupNodes()
-{
-    nodes.clear();
-    auto *node = depot;
+        if (node->isDepot())
+            break;
 
-    do
-    {
         node = n(node);
-        nodes.push_back(node);
-    } while (!node->isDepot());
+    }
 }
 
 void Route::setupSector()
@@ -60,12 +52,17 @@ void Route::setupSector()
 
     sector.initialize(angle);
 
+    double sumX = 0;
+    double sumY = 0;
+
     for (auto it = nodes.begin(); it != nodes.end() - 1; ++it)
     {
         auto const *node = *it;
         assert(!node->isDepot());
 
         auto const &clientData = data.client(node->client);
+        sumX += static_cast<double>(clientData.x);
+        sumY += static_cast<double>(clientData.y);
 
         auto const diffX = static_cast<double>(clientData.x - depotData.x);
         auto const diffY = static_cast<double>(clientData.y - depotData.y);
@@ -74,6 +71,99 @@ void Route::setupSector()
 
         sector.extend(angle);
     }
+
+    auto const numClients = static_cast<double>(size());
+    centroid_ = {sumX / numClients, sumY / numClients};
+}
+
+void Route::setupStoreVisits(size_t position)
+{
+    // The store visits in the unchanged prefix [1, position) remain valid, so
+    // we first remove the visits of the old suffix of this route. Note that
+    // the depot does not visit any stores.
+    for (auto const *node : oldSuffix)
+    {
+        if (node->isDepot())
+            continue;
+
+        auto const store = storeIdx(data.clientStore(node->client));
+        if (--storeVisits[store] == 0)
+        {
+            firstStoreVisits[store] = 0;
+            lastStoreVisits[store] = 0;
+            stores_ -= 1;
+        }
+    }
+
+    // Stores that are still visited in the prefix may have had their last
+    // visit in the old suffix. We reset those, and then scan the prefix
+    // backwards to find their actual last visit.
+    size_t numMissing = 0;
+    for (auto const *node : oldSuffix)
+    {
+        if (node->isDepot())
+            continue;
+
+        auto const store = storeIdx(data.clientStore(node->client));
+        if (storeVisits[store] > 0 && lastStoreVisits[store] >= position)
+        {
+            lastStoreVisits[store] = 0;
+            numMissing++;
+        }
+    }
+
+    for (size_t pos = position - 1; pos > 0 && numMissing > 0; --pos)
+    {
+        auto const store = storeIdx(data.clientStore(nodes[pos - 1]->client));
+        if (lastStoreVisits[store] == 0)
+        {
+            lastStoreVisits[store] = pos;
+            numMissing--;
+        }
+    }
+
+    // Add the visits of the new suffix of this route.
+    depot->cumulatedStores = 0;
+    for (size_t pos = position; pos <= nodes.size(); ++pos)
+    {
+        auto *node = nodes[pos - 1];
+
+        if (node->isDepot())
+        {
+            node->cumulatedStores = stores_;
+            node->prevStoreVisit = 0;
+            continue;
+        }
+
+        auto const store = storeIdx(data.clientStore(node->client));
+
+        node->prevStoreVisit = lastStoreVisits[store];
+        node->cumulatedStores = p(node)->cumulatedStores;
+
+        if (storeVisits[store]++ == 0)
+        {
+            firstStoreVisits[store] = pos;
+            node->cumulatedStores += 1;
+            stores_ += 1;
+        }
+
+        lastStoreVisits[store] = pos;
+    }
+
+    // The last visits may have changed anywhere, so the number of distinct
+    // stores after each node must be recomputed for the whole route.
+    nodes.back()->storesAfter = 0;
+    for (auto pos = nodes.size() - 1; pos > 0; --pos)
+    {
+        auto *node = nodes[pos - 1];
+        auto const store = storeIdx(data.clientStore(node->client));
+
+        node->storesAfter = n(node)->storesAfter;
+        if (lastStoreVisits[store] == pos)
+            node->storesAfter += 1;
+    }
+
+    depot->storesAfter = stores_;
 }
 
 void Route::setupRouteTimeWindows()
@@ -84,7 +174,7 @@ void Route::setupRouteTimeWindows()
     {
         auto *prev = p(node);
         prev->twAfter
-            = TWS::merge(data.durationMatrix(), prev->tw, node->twAfter);
+            = TWS::merge(data.durations(), prev->tw, node->twAfter);
         node = prev;
     } while (!node->isDepot());
 }
@@ -96,65 +186,70 @@ bool Route::overlapsWith(Route const &other, int const tolerance) const
 
 void Route::update()
 {
-    std::cout << "Enter Route update." << std::endl;
-    auto const oldNodes = nodes;
-    setupNodes();
+    PYVRP_TRACE(ROUTE, DEBUG, "Enter Route update.");
 
-    Load weight = 0;
-    Load volume = 0;
-    Salvage salvage = 0;
-    Distance distance = 0;
-    Distance reverseDistance = 0;
-    bool foundChange = false;
+    // The nodes vector still describes the route as it was before the change,
+    // so the first position where it disagrees with the linked list is the
+    // first changed position. Everything before it is still valid.
+    size_t changePos = 1;
+    auto *node = n(depot);
 
-    std::set<int> uniqueStores;  
+    while (changePos <= nodes.size() && nodes[changePos - 1] == node
+           && !node->isDepot())
+    {
+        node = n(node);
+        changePos++;
+    }
 
-    for (size_t pos = 0; pos != nodes.size(); ++pos)
+    if (changePos > nodes.size() || nodes[changePos - 1] != node)
     {
-        auto *node = nodes[pos];
+        setupNodes(changePos, node);
+
+        Load weight = 0;
+        Load volume = 0;
+        Salvage salvage = 0;
+        Distance distance = 0;
+        Distance reverseDistance = 0;
 
-        if (!foundChange && (pos >= oldNodes.size() || node != oldNodes[pos]))
+        if (changePos > 1)
         {
-            foundChange = true;
-
-            if (pos > 0)
-            {
-                weight = nodes[pos - 1]->cumulatedWeight;
-                volume = nodes[pos - 1]->cumulatedVolume;
-                salvage = nodes[pos - 1]->cumulatedSalvage;
-                distance = nodes[pos - 1]->cumulatedDistance;
-                reverseDistance = nodes[pos - 1]->cumulatedReversalDistance;
-            }
+            auto const *prev = nodes[changePos - 2];
+            weight = prev->cumulatedWeight;
+            volume = prev->cumulatedVolume;
+            salvage = prev->cumulatedSalvage;
+            distance = prev->cumulatedDistance;
+            reverseDistance = prev->cumulatedReversalDistance;
         }
 
-        if (!foundChange)
-            continue;
+        for (size_t pos = changePos - 1; pos != nodes.size(); ++pos)
+        {
+            node = nodes[pos];
 
-        weight += data.client(node->client).demandWeight;
-        volume += data.client(node->client).demandVolume;
-        salvage += data.client(node->client).demandSalvage;
-        uniqueStores.insert(static_cast<int>(data.client(node->client).clientStore));
+            weight += data.demandWeight(node->client);
+            volume += data.demandVolume(node->client);
+            salvage += data.demandSalvage(node->client);
 
-        distance += data.dist(p(node)->client, node->client);
+            distance += data.dist(p(node)->client, node->client);
 
-        reverseDistance += data.dist(node->client, p(node)->client);
-        reverseDistance -= data.dist(p(node)->client, node->client);
+            reverseDistance += data.dist(node->client, p(node)->client);
+            reverseDistance -= data.dist(p(node)->client, node->client);
 
-        node->position = pos + 1;
-        node->cumulatedWeight = weight;
-        node->cumulatedVolume = volume;
-        node->cumulatedSalvage = salvage;
-        node->cumulatedStores = uniqueStores.size();  
-        node->cumulatedDistance = distance;
-        node->cumulatedReversalDistance = reverseDistance;
+            node->position = pos + 1;
+            node->cumulatedWeight = weight;
+            node->cumulatedVolume = volume;
+            node->cumulatedSalvage = salvage;
+            node->cumulatedDistance = distance;
+            node->cumulatedReversalDistance = reverseDistance;
 
-        node->twBefore 
-            = TWS::merge(data.durationMatrix(), p(node)->twBefore, node->tw);
+            node->twBefore
+                = TWS::merge(data.durations(), p(node)->twBefore, node->tw);
+            node->seqBefore
+                = SequenceSegment::merge(p(node)->seqBefore, node->seq);
+        }
 
+        setupStoreVisits(changePos);
     }
 
-    stores_ = nodes.back()->cumulatedStores;  
-
     setupSector();
     setupRouteTimeWindows();
 
@@ -170,9 +265,14 @@ void Route::update()
 
     isSalvageCapacityFeasible_ = static_cast<size_t>(salvage_) <= data.salvageCapacity();
     isStoresLimitFeasible_ = static_cast<size_t>(stores_) <= data.routeStoreLimit();  
-
-    std::cout << "############## STORESFEASIBILITY: " << isStoresLimitFeasible_ << " " << isSalvageCapacityFeasible_ << " " << isWeightFeasible_ << " " << isVolumeFeasible_ << std::endl;
-//    std::cout << "Exit Route update." << std::endl;
+    isSequenceFeasible_ = sequenceViolations() == 0;
+
+    PYVRP_TRACE(ROUTE,
+                DEBUG,
+                "STORESFEASIBILITY: " << isStoresLimitFeasible_ << " "
+                                      << isSalvageCapacityFeasible_ << " "
+                                      << isWeightFeasible_ << " "
+                                      << isVolumeFeasible_);
 }
 
 
@@ -227,7 +327,7 @@ void Route::update()
 //        node->cumulatedReversalDistance = reverseDistance;
 //
 //        node->twBefore
-//            = TWS::merge(data.durationMatrix(), p(node)->twBefore, node->tw);
+//            = TWS::merge(data.durations(), p(node)->twBefore, node->tw);
 //
 //    }
 //    setupSector();
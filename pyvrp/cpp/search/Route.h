@@ -4,42 +4,64 @@
 #include "CircleSector.h"
 #include "Node.h"
 #include "ProblemData.h"
+#include "SequenceSegment.h"
 #include "TimeWindowSegment.h"
+#include "Trace.h"
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cassert>
 #include <iosfwd>
+#include <utility>
 
 class Route
 {
     ProblemData const &data;
 
     std::vector<Node *> nodes;  // List of nodes (in order) in this solution.
+    std::vector<Node *> oldSuffix;  // Scratch: changed nodes before update()
     CircleSector sector;        // Circle sector of the route's clients
+    std::pair<double, double> centroid_;  // Mean location of the clients
+
+    // Number of visits to each store on this route, and the positions of the
+    // first and last of those visits (zero if the store is not visited). These
+    // are indexed by store + 1, so the default store index of -1 maps to zero.
+    std::vector<int> storeVisits;
+    std::vector<size_t> firstStoreVisits;
+    std::vector<size_t> lastStoreVisits;
 
     Load weight_;            // Current route weight load.
     Load volume_;            // Current route volume load.
     Salvage salvage_;        // Current route salvage demand.
-    Store stores_;        // Current route stores demand.
+    Store stores_;           // Current number of distinct stores on route.
     bool isWeightFeasible_;  // Whether current weight load is feasible.
     bool isVolumeFeasible_;  // Whether current volume load is feasible.
     bool isSalvageCapacityFeasible_;  // Whether current salvage demand is salvage capacity feasible.
     bool isStoresLimitFeasible_;  // Whether current number of stores on route is feasible.
-    // bool isSalvageSequenceFeasible_;  // Whether current route sequence salvage sequence feasible.
+    bool isSequenceFeasible_;  // Whether the delivery/salvage sequence is feasible.
 
     Duration timeWarp_;        // Current route time warp.
     bool isTimeWarpFeasible_;  // Whether current time warp is feasible.
 
-    // Populates the nodes vector.
-    void setupNodes();
+    // Populates the nodes vector from the given position onwards, starting
+    // with the given node. The replaced nodes are stored in oldSuffix.
+    void setupNodes(size_t position, Node *node);
 
-    // Sets the sector data.
+    // Sets the sector and centroid data.
     void setupSector();
 
     // Sets forward node time windows.
     void setupRouteTimeWindows();
 
+    // Updates the store visit data of the nodes from the given (changed)
+    // position onwards. The nodes in oldSuffix are the nodes that were at
+    // those positions before the change.
+    void setupStoreVisits(size_t position);
+
+    // Returns the index into the store visit data for the given store.
+    [[nodiscard]] inline size_t storeIdx(Store store) const;
+
     // Clone routine
     Route* clone() const;
 
@@ -48,17 +70,36 @@ public:           // TODO make fields private
     Node *depot;  // Pointer to the associated depot
 
     /**
-     * Checks if a given store exists in the route.
+     * Checks if a given store is visited by this route. Runs in O(1) time.
      *
-     * @param index of the store to check.
+     * @param store Index of the store to check.
      * @return true if the store exists in the route, false otherwise.
      */
-    [[nodiscard]] bool containsStore(Store store_index) const;
+    [[nodiscard]] inline bool containsStore(Store store) const;
+
+    /**
+     * Returns number of unique stores in route. Runs in O(1) time.
+     */
+    [[nodiscard]] inline Store storeCount() const;
 
     /**
-     * Returns number of unique stores in route.
+     * @return Position of the first visit to the given store on this route,
+     *         or zero if the store is not visited.
      */
-    [[nodiscard]] Store storeCount() const;
+    [[nodiscard]] inline size_t firstStoreVisit(Store store) const;
+
+    /**
+     * @return Position of the last visit to the given store on this route, or
+     *         zero if the store is not visited.
+     */
+    [[nodiscard]] inline size_t lastStoreVisit(Store store) const;
+
+    /**
+     * Checks if the given store is visited by this route outside the segment
+     * [start, end]. Runs in O(1) time.
+     */
+    [[nodiscard]] inline bool
+    visitsStoreOutside(Store store, size_t start, size_t end) const;
 
     /**
      * @return The client or depot node at the given position.
@@ -100,6 +141,14 @@ public:           // TODO make fields private
      */
     [[nodiscard]] inline bool hasExcessStores() const;
 
+    /**
+     * Determines whether this route visits its clients in a feasible delivery
+     * and salvage sequence.
+     *
+     * @return true if the route has sequence violations, false otherwise.
+     */
+    [[nodiscard]] inline bool hasSequenceViolations() const;
+
     /**
      * Determines whether this route is time-feasible.
      *
@@ -127,6 +176,12 @@ public:           // TODO make fields private
      */
     [[nodiscard]] inline Store stores() const;
 
+    /**
+     * @return Number of client pairs on this route that are visited out of
+     *         delivery/salvage sequence.
+     */
+    [[nodiscard]] inline Sequence sequenceViolations() const;
+
     /**
      * @return Total time warp on this route.
      */
@@ -148,6 +203,13 @@ public:           // TODO make fields private
     [[nodiscard]] inline TimeWindowSegment twBetween(size_t start,
                                                      size_t end) const;
 
+    /**
+     * Calculates sequence data for segment [start, end]. Returns an empty
+     * segment when start > end. Runs in O(1) time.
+     */
+    [[nodiscard]] inline SequenceSegment seqBetween(size_t start,
+                                                    size_t end) const;
+
     /**
      * Calculates the distance for segment [start, end].
      */
@@ -169,10 +231,42 @@ public:           // TODO make fields private
     [[nodiscard]] inline Salvage salvageBetween(size_t start, size_t end) const;
 
     /**
-     * Calculates the demand for segment [start, end].
+     * Calculates the number of distinct stores visited in segment [start, end].
+     * Runs in O(1) time when the segment starts at the start of the route, or
+     * ends at the end of the route, and in O(end - start) time otherwise.
      */
     [[nodiscard]] inline Store storesBetween(size_t start, size_t end) const;
 
+    /**
+     * Calculates the number of distinct stores visited in segment [start, end]
+     * that are not visited anywhere else on this route. These are exactly the
+     * stores that leave the route when the segment is removed. Same time
+     * complexity as storesBetween().
+     */
+    [[nodiscard]] inline Store storesOnlyBetween(size_t start,
+                                                 size_t end) const;
+
+    /**
+     * Calculates the number of distinct stores visited in segment [start, end]
+     * that satisfy the given predicate. The predicate is evaluated once for
+     * each distinct store. Runs in O(end - start) time.
+     */
+    template <typename Pred>
+    [[nodiscard]] Store
+    storesBetweenIf(size_t start, size_t end, Pred &&pred) const;
+
+    /**
+     * @return Circle sector of this route's clients, around the depot. Has no
+     *         meaning when the route is empty.
+     */
+    [[nodiscard]] inline CircleSector const &circleSector() const;
+
+    /**
+     * @return Centroid (mean x and y coordinates) of this route's clients.
+     *         Has no meaning when the route is empty.
+     */
+    [[nodiscard]] inline std::pair<double, double> const &centroid() const;
+
     /**
      * Tests if this route overlaps with the other route, that is, whether
      * their circle sectors overlap with a given tolerance.
@@ -189,7 +283,42 @@ public:           // TODO make fields private
     Route(ProblemData const &data);
 };
 
-bool Route::isFeasible() const { return !hasExcessWeight() && !hasExcessVolume() && !hasExcessSalvage() && !hasExcessStores() && !hasTimeWarp(); }
+CircleSector const &Route::circleSector() const { return sector; }
+
+std::pair<double, double> const &Route::centroid() const { return centroid_; }
+
+size_t Route::storeIdx(Store store) const
+{
+    auto const idx = static_cast<size_t>(store.get() + 1);
+    assert(idx < storeVisits.size());
+    return idx;
+}
+
+bool Route::containsStore(Store store) const
+{
+    return storeVisits[storeIdx(store)] > 0;
+}
+
+Store Route::storeCount() const { return stores_; }
+
+size_t Route::firstStoreVisit(Store store) const
+{
+    return firstStoreVisits[storeIdx(store)];
+}
+
+size_t Route::lastStoreVisit(Store store) const
+{
+    return lastStoreVisits[storeIdx(store)];
+}
+
+bool Route::visitsStoreOutside(Store store, size_t start, size_t end) const
+{
+    auto const idx = storeIdx(store);
+    return storeVisits[idx] > 0
+           && (firstStoreVisits[idx] < start || lastStoreVisits[idx] > end);
+}
+
+bool Route::isFeasible() const { return !hasExcessWeight() && !hasExcessVolume() && !hasExcessSalvage() && !hasExcessStores() && !hasSequenceViolations() && !hasTimeWarp(); }
 
 bool Route::hasExcessWeight() const { return !isWeightFeasible_; }
 
@@ -199,6 +328,8 @@ bool Route::hasExcessSalvage() const { return !isSalvageCapacityFeasible_; }
 
 bool Route::hasExcessStores() const { return !isStoresLimitFeasible_; }
 
+bool Route::hasSequenceViolations() const { return !isSequenceFeasible_; }
+
 bool Route::hasTimeWarp() const
 {
 #ifdef PYVRP_NO_TIME_WINDOWS
@@ -222,6 +353,11 @@ Salvage Route::salvage() const { return salvage_; }
 
 Store Route::stores() const { return stores_; }
 
+Sequence Route::sequenceViolations() const
+{
+    return nodes.back()->seqBefore.violations();
+}
+
 Duration Route::timeWarp() const { return timeWarp_; }
 
 bool Route::empty() const { return size() == 0; }
@@ -239,11 +375,23 @@ TimeWindowSegment Route::twBetween(size_t start, size_t end) const
 
     for (size_t step = start; step != end; ++step)
         tws = TimeWindowSegment::merge(
-            data.durationMatrix(), tws, nodes[step]->tw);
+            data.durations(), tws, nodes[step]->tw);
 
     return tws;
 }
 
+SequenceSegment Route::seqBetween(size_t start, size_t end) const
+{
+    assert(start > 0 && end <= nodes.size());
+
+    if (start > end)
+        return {};
+
+    auto const &prefix
+        = start == 1 ? depot->seqBefore : nodes[start - 2]->seqBefore;
+    return nodes[end - 1]->seqBefore.withoutPrefix(prefix);
+}
+
 Distance Route::distBetween(size_t start, size_t end) const
 {
     assert(start <= end && end <= nodes.size());
@@ -261,7 +409,7 @@ Load Route::weightBetween(size_t start, size_t end) const
     assert(start <= end && end <= nodes.size());
 
     auto const *startNode = start == 0 ? depot : nodes[start - 1];
-    auto const atStart = data.client(startNode->client).demandWeight;
+    auto const atStart = data.demandWeight(startNode->client);
     auto const startWeight = startNode->cumulatedWeight;
     auto const endWeight = nodes[end - 1]->cumulatedWeight;
 
@@ -275,7 +423,7 @@ Load Route::volumeBetween(size_t start, size_t end) const
     assert(start <= end && end <= nodes.size());
     
     auto const *startNode = start == 0 ? depot : nodes[start - 1];
-    auto const atStart = data.client(startNode->client).demandVolume;
+    auto const atStart = data.demandVolume(startNode->client);
     auto const startVolume = startNode->cumulatedVolume;
     auto const endVolume = nodes[end - 1]->cumulatedVolume;
     
@@ -289,7 +437,7 @@ Salvage Route::salvageBetween(size_t start, size_t end) const
     assert(start <= end && end <= nodes.size());
      
     auto const *startNode = start == 0 ? depot : nodes[start - 1];
-    auto const atStart = data.client(startNode->client).demandSalvage;
+    auto const atStart = data.demandSalvage(startNode->client);
     auto const startSalvage = startNode->cumulatedSalvage;
     auto const endSalvage = nodes[end - 1]->cumulatedSalvage;
      
@@ -299,26 +447,66 @@ Salvage Route::salvageBetween(size_t start, size_t end) const
 }
 
 Store Route::storesBetween(size_t start, size_t end) const
-{   
-    assert(start <= end && end <= nodes.size());
+{
+    start = std::max<size_t>(start, 1);  // depots do not visit any stores
+    end = std::min(end, size());
 
-    if (start == end) return 0;
-    
-    auto const *startNode = start == 0 ? depot : nodes[start - 1];
-    auto const *endNode = nodes[end - 1];
-    
-    auto const startStores = startNode->cumulatedStores; 
-    auto const endStores = endNode->cumulatedStores;
-    
-    std::cout << "In storesBetween: Start:" << start << " Stores: " << startStores << " End:" << end << " Stores: " << endStores << std::endl;
-    assert(startStores <= endStores);
+    if (start > end)
+        return 0;
+
+    if (start == 1)
+        return nodes[end - 1]->cumulatedStores;
+
+    if (end == size())
+        return nodes[start - 1]->storesAfter;
+
+    // A store is counted at its first visit within the segment, that is, at
+    // the visit whose previous visit to the same store lies before the start.
+    Store stores = 0;
+    for (size_t pos = start; pos <= end; ++pos)
+        if (nodes[pos - 1]->prevStoreVisit < start)
+            stores += 1;
 
-    Store storeCount = endStores - startStores;
-    if (data.client(startNode->client).clientStore != data.client(endNode->client).clientStore) {
-        storeCount = storeCount + Store(1);
+    return stores;
+}
+
+Store Route::storesOnlyBetween(size_t start, size_t end) const
+{
+    start = std::max<size_t>(start, 1);
+    end = std::min(end, size());
+
+    if (start > end)
+        return 0;
+
+    // Stores visited only in a prefix (suffix) are exactly those that are not
+    // visited in the complementary suffix (prefix).
+    if (start == 1)
+        return end == size() ? stores_ : stores_ - nodes[end]->storesAfter;
+
+    if (end == size())
+        return stores_ - nodes[start - 2]->cumulatedStores;
+
+    return storesBetweenIf(start, end, [&](Store store) {
+        return !visitsStoreOutside(store, start, end);
+    });
+}
+
+template <typename Pred>
+Store Route::storesBetweenIf(size_t start, size_t end, Pred &&pred) const
+{
+    start = std::max<size_t>(start, 1);
+    end = std::min(end, size());
+
+    Store stores = 0;
+    for (size_t pos = start; pos <= end; ++pos)
+    {
+        auto const *node = nodes[pos - 1];
+        if (node->prevStoreVisit < start  // first visit within the segment
+            && pred(data.clientStore(node->client)))
+            stores += 1;
     }
 
-    return storeCount;
+    return stores;
 }
 
 // Outputs a route into a given ostream in CVRPLib format
@@ -0,0 +1,333 @@
+#include "RouteSnapshot.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#ifdef PYVRP_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+using SS = SequenceSegment;
+
+// The kernels read and write measures as their underlying values.
+static_assert(sizeof(Distance) == sizeof(Value)
+              && std::is_trivially_copyable_v<Distance>);
+static_assert(sizeof(Duration) == sizeof(Value)
+              && std::is_trivially_copyable_v<Duration>);
+
+namespace
+{
+// Arrays are padded to a multiple of this, which is the largest number of
+// lanes used by any kernel.
+constexpr size_t PADDING = 8;
+
+#ifdef PYVRP_AVX2_KERNEL
+#define PYVRP_AVX2 __attribute__((target("avx2")))
+
+bool hasAvx2()
+{
+    static bool const hasAvx2 = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+
+    return hasAvx2;
+}
+
+// Thin wrappers around the AVX2 intrinsics, so the kernel below can be written
+// once for both precisions. Note that max(first, second) returns first only
+// when first > second, so std::max(a, b) corresponds to max(b, a).
+#ifdef PYVRP_DOUBLE_PRECISION
+using Vec = __m256d;
+using Index = __m128i;
+constexpr size_t LANES = 4;
+
+PYVRP_AVX2 inline Vec loadValues(Value const *ptr)
+{
+    return _mm256_loadu_pd(ptr);
+}
+
+PYVRP_AVX2 inline void storeValues(Value *ptr, Vec vec)
+{
+    _mm256_storeu_pd(ptr, vec);
+}
+
+PYVRP_AVX2 inline Vec broadcast(Value value) { return _mm256_set1_pd(value); }
+PYVRP_AVX2 inline Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+PYVRP_AVX2 inline Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+PYVRP_AVX2 inline Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+
+PYVRP_AVX2 inline Index loadIndex(int const *ptr)
+{
+    return _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr));
+}
+
+PYVRP_AVX2 inline Index rowMajor(Index rows, int dim, int col)
+{
+    return _mm_add_epi32(_mm_mullo_epi32(rows, _mm_set1_epi32(dim)),
+                         _mm_set1_epi32(col));
+}
+
+PYVRP_AVX2 inline Index rowMajor(int row, int dim, Index cols)
+{
+    return _mm_add_epi32(_mm_set1_epi32(row * dim), cols);
+}
+
+PYVRP_AVX2 inline Vec gather(Value const *base, Index idx)
+{
+    // The masked gather with all lanes enabled is the same as the unmasked
+    // one, but avoids a spurious uninitialised variable warning in GCC.
+    auto const all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(
+        _mm256_setzero_pd(), base, idx, all, sizeof(Value));
+}
+#else
+using Vec = __m256i;
+using Index = __m256i;
+constexpr size_t LANES = 8;
+
+PYVRP_AVX2 inline Vec loadValues(Value const *ptr)
+{
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr));
+}
+
+PYVRP_AVX2 inline void storeValues(Value *ptr, Vec vec)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), vec);
+}
+
+PYVRP_AVX2 inline Vec broadcast(Value value)
+{
+    return _mm256_set1_epi32(value);
+}
+
+PYVRP_AVX2 inline Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+PYVRP_AVX2 inline Vec sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+PYVRP_AVX2 inline Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+
+PYVRP_AVX2 inline Index loadIndex(int const *ptr) { return loadValues(ptr); }
+
+PYVRP_AVX2 inline Index rowMajor(Index rows, int dim, int col)
+{
+    return _mm256_add_epi32(_mm256_mullo_epi32(rows, _mm256_set1_epi32(dim)),
+                            _mm256_set1_epi32(col));
+}
+
+PYVRP_AVX2 inline Index rowMajor(int row, int dim, Index cols)
+{
+    return _mm256_add_epi32(_mm256_set1_epi32(row * dim), cols);
+}
+
+PYVRP_AVX2 inline Vec gather(Value const *base, Index idx)
+{
+    return _mm256_i32gather_epi32(base, idx, sizeof(Value));
+}
+#endif
+
+static_assert(PADDING % LANES == 0);
+
+template <typename T> Value const *valuesOf(Matrix<T> const &matrix)
+{
+    return reinterpret_cast<Value const *>(&matrix(0, 0));
+}
+
+template <typename T> Value *valuesOf(std::vector<T> &vec)
+{
+    return reinterpret_cast<Value *>(vec.data());
+}
+#endif
+}  // namespace
+
+RouteSnapshot::RouteSnapshot(ProblemData const &data) : data(data) {}
+
+void RouteSnapshot::load(Route const &route)
+{
+    numPositions = route.size() + 1;
+    auto const padded = (numPositions + PADDING - 1) / PADDING * PADDING;
+
+    // Padding lanes are computed by the vectorised kernels, but never read.
+    // Those lanes thus only need valid client indices, which depots are.
+    from.assign(padded, 0);
+    to.assign(padded, 0);
+    distBetween.resize(numPositions);
+
+#ifndef PYVRP_NO_TIME_WINDOWS
+    beforeDuration.assign(padded, 0);
+    beforeTimeWarp.assign(padded, 0);
+    beforeTwEarly.assign(padded, 0);
+    beforeTwLate.assign(padded, 0);
+    afterTimeWarp.assign(padded, 0);
+    afterTwLate.assign(padded, 0);
+#endif
+
+    seqBefore.resize(numPositions);
+    seqAfter.resize(numPositions);
+
+    Node const *node = route.depot;
+    for (size_t idx = 0; idx != numPositions; ++idx, node = node->next)
+    {
+        auto const *next = node->next;
+
+        from[idx] = node->client;
+        to[idx] = next->client;
+        distBetween[idx] = data.dist(node->client, next->client);
+
+#ifndef PYVRP_NO_TIME_WINDOWS
+        beforeDuration[idx] = node->twBefore.duration.get();
+        beforeTimeWarp[idx] = node->twBefore.timeWarp.get();
+        beforeTwEarly[idx] = node->twBefore.twEarly.get();
+        beforeTwLate[idx] = node->twBefore.twLate.get();
+        afterTimeWarp[idx] = next->twAfter.timeWarp.get();
+        afterTwLate[idx] = next->twAfter.twLate.get();
+#endif
+
+        seqBefore[idx] = node->seqBefore;
+        seqAfter[idx] = route.seqBetween(idx + 1, route.size());
+    }
+}
+
+void RouteSnapshot::insertions(Node const *U, Insertions &insertions) const
+{
+    insertions.distTo.resize(from.size());
+    insertions.distFrom.resize(from.size());
+    insertions.timeWarp.resize(from.size());
+    insertions.violations.resize(numPositions);
+
+#ifdef PYVRP_AVX2_KERNEL
+    // The kernel gathers from the full matrices, so it can only be used when
+    // those are stored densely. It computes matrix offsets in 32-bit integers,
+    // so all offsets must also fit.
+    auto const dim = data.numClients() + 1;
+    auto const maxOffset = static_cast<size_t>(std::numeric_limits<int>::max());
+    auto const isDense
+        = data.matrixStorage() == ProblemData::MatrixStorage::DENSE;
+
+    if (hasAvx2() && isDense && dim * dim <= maxOffset)
+        computeAvx2(U, insertions);
+    else
+        computeScalar(U, insertions);
+#else
+    computeScalar(U, insertions);
+#endif
+
+    for (size_t idx = 0; idx != numPositions; ++idx)
+        insertions.violations[idx]
+            = SS::merge(seqBefore[idx], U->seq, seqAfter[idx]).violations();
+}
+
+size_t RouteSnapshot::size() const { return numPositions; }
+
+Distance RouteSnapshot::distAt(size_t position) const
+{
+    return distBetween[position];
+}
+
+void RouteSnapshot::computeScalar(Node const *U, Insertions &insertions) const
+{
+    auto const client = U->client;
+
+    for (size_t idx = 0; idx != numPositions; ++idx)
+    {
+        insertions.distTo[idx] = data.dist(from[idx], client);
+        insertions.distFrom[idx] = data.dist(client, to[idx]);
+    }
+
+#ifdef PYVRP_NO_TIME_WINDOWS
+    std::fill(insertions.timeWarp.begin(), insertions.timeWarp.end(), 0);
+#else
+    // This is TimeWindowSegment::merge() of the route before the insert
+    // position, U, and the route after the insert position. Only the fields
+    // needed to compute the final time warp are evaluated.
+    auto const durMat = data.durations();
+    auto const &tw = U->tw;
+
+    for (size_t idx = 0; idx != numPositions; ++idx)
+    {
+        Value const arcTo = durMat(from[idx], client).get();
+        Value const diffTo = beforeDuration[idx] - beforeTimeWarp[idx] + arcTo;
+        Value const waitTo = std::max<Value>(
+            tw.twEarly.get() - diffTo - beforeTwLate[idx], 0);
+        Value const twTo = std::max<Value>(
+            beforeTwEarly[idx] + diffTo - tw.twLate.get(), 0);
+
+        Value const duration
+            = beforeDuration[idx] + tw.duration.get() + arcTo + waitTo;
+        Value const timeWarp = beforeTimeWarp[idx] + tw.timeWarp.get() + twTo;
+        Value const twEarly
+            = std::max(tw.twEarly.get() - diffTo, beforeTwEarly[idx]) - waitTo;
+
+        Value const arcFrom = durMat(client, to[idx]).get();
+        Value const diffFrom = duration - timeWarp + arcFrom;
+        Value const twFrom
+            = std::max<Value>(twEarly + diffFrom - afterTwLate[idx], 0);
+
+        insertions.timeWarp[idx] = timeWarp + afterTimeWarp[idx] + twFrom;
+    }
+#endif
+}
+
+#ifdef PYVRP_AVX2_KERNEL
+PYVRP_AVX2 void RouteSnapshot::computeAvx2(Node const *U,
+                                           Insertions &insertions) const
+{
+    auto const *distMat = valuesOf(data.distanceMatrix());
+    auto const dim = static_cast<int>(data.distanceMatrix().numCols());
+    auto const client = U->client;
+
+#ifndef PYVRP_NO_TIME_WINDOWS
+    auto const *durMat = valuesOf(data.durationMatrix());
+    auto const &tw = U->tw;
+
+    auto const zero = broadcast(0);
+    auto const duration = broadcast(tw.duration.get());
+    auto const timeWarp = broadcast(tw.timeWarp.get());
+    auto const twEarly = broadcast(tw.twEarly.get());
+    auto const twLate = broadcast(tw.twLate.get());
+#endif
+
+    for (size_t idx = 0; idx < numPositions; idx += LANES)
+    {
+        auto const toClient = rowMajor(loadIndex(&from[idx]), dim, client);
+        auto const fromClient = rowMajor(client, dim, loadIndex(&to[idx]));
+
+        auto const distTo = gather(distMat, toClient);
+        auto const distFrom = gather(distMat, fromClient);
+        storeValues(valuesOf(insertions.distTo) + idx, distTo);
+        storeValues(valuesOf(insertions.distFrom) + idx, distFrom);
+
+#ifdef PYVRP_NO_TIME_WINDOWS
+        storeValues(valuesOf(insertions.timeWarp) + idx, broadcast(0));
+#else
+        // Same operations, in the same order, as computeScalar().
+        auto const bDuration = loadValues(&beforeDuration[idx]);
+        auto const bTimeWarp = loadValues(&beforeTimeWarp[idx]);
+        auto const bTwEarly = loadValues(&beforeTwEarly[idx]);
+        auto const bTwLate = loadValues(&beforeTwLate[idx]);
+
+        auto const arcTo = gather(durMat, toClient);
+        auto const diffTo = add(sub(bDuration, bTimeWarp), arcTo);
+        auto const waitTo = max(zero, sub(sub(twEarly, diffTo), bTwLate));
+        auto const twTo = max(zero, sub(add(bTwEarly, diffTo), twLate));
+
+        auto const mergedDuration
+            = add(add(add(bDuration, duration), arcTo), waitTo);
+        auto const mergedTimeWarp = add(add(bTimeWarp, timeWarp), twTo);
+        auto const mergedTwEarly
+            = sub(max(bTwEarly, sub(twEarly, diffTo)), waitTo);
+
+        auto const aTimeWarp = loadValues(&afterTimeWarp[idx]);
+        auto const aTwLate = loadValues(&afterTwLate[idx]);
+
+        auto const arcFrom = gather(durMat, fromClient);
+        auto const diffFrom
+            = add(sub(mergedDuration, mergedTimeWarp), arcFrom);
+        auto const twFrom
+            = max(zero, sub(add(mergedTwEarly, diffFrom), aTwLate));
+
+        storeValues(valuesOf(insertions.timeWarp) + idx,
+                    add(add(mergedTimeWarp, aTimeWarp), twFrom));
+#endif
+    }
+}
+#endif
@@ -0,0 +1,99 @@
+#ifndef PYVRP_ROUTESNAPSHOT_H
+#define PYVRP_ROUTESNAPSHOT_H
+
+#include "Measure.h"
+#include "Node.h"
+#include "ProblemData.h"
+#include "Route.h"
+#include "SequenceSegment.h"
+
+#include <vector>
+
+// The AVX2 kernel is compiled on x86-64 with GCC and clang. Whether it is also
+// used is decided at runtime, based on the CPU's features.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PYVRP_AVX2_KERNEL
+#endif
+
+/**
+ * Structure-of-arrays copy of a route, used to evaluate inserting a client at
+ * every position of the route in a single pass. Insert position i is directly
+ * after the node at position i of the route, where position 0 is the depot.
+ * <br />
+ * The distance lookups and time window arithmetic of that pass are vectorised
+ * when the CPU supports AVX2. Otherwise, a scalar loop is used. Both compute
+ * exactly the same values as evaluating each insertion with
+ * TimeWindowSegment::merge() and SequenceSegment::merge() would.
+ */
+class RouteSnapshot
+{
+public:
+    /**
+     * Insertion data of a single client, for each insert position of a route
+     * snapshot. The vectors may be longer than the number of insert positions.
+     */
+    struct Insertions
+    {
+        std::vector<Distance> distTo;      // dist(route[i], client)
+        std::vector<Distance> distFrom;    // dist(client, route[i + 1])
+        std::vector<Duration> timeWarp;    // route time warp after insertion
+        std::vector<Sequence> violations;  // route sequence violations, idem
+    };
+
+private:
+    ProblemData const &data;
+    size_t numPositions = 0;
+
+    // Clients before and after each insert position, and the distance between
+    // them. These are padded to a multiple of the vector width with depots.
+    std::vector<int> from;
+    std::vector<int> to;
+    std::vector<Distance> distBetween;
+
+    // Time window data of the route up to and including the client before
+    // each insert position, and of the route from the client after it.
+    std::vector<Value> beforeDuration;
+    std::vector<Value> beforeTimeWarp;
+    std::vector<Value> beforeTwEarly;
+    std::vector<Value> beforeTwLate;
+    std::vector<Value> afterTimeWarp;
+    std::vector<Value> afterTwLate;
+
+    // Sequence data of the route before and after each insert position.
+    std::vector<SequenceSegment> seqBefore;
+    std::vector<SequenceSegment> seqAfter;
+
+    void computeScalar(Node const *U, Insertions &insertions) const;
+
+#ifdef PYVRP_AVX2_KERNEL
+    void computeAvx2(Node const *U, Insertions &insertions) const;
+#endif
+
+public:
+    /**
+     * Copies the given route's data into this snapshot. The snapshot must be
+     * reloaded whenever the route changes.
+     */
+    void load(Route const &route);
+
+    /**
+     * Computes the insertion data of the given client, which should not be in
+     * the snapshot's route, for every insert position.
+     */
+    void insertions(Node const *U, Insertions &insertions) const;
+
+    /**
+     * @return Number of insert positions, that is, route size + 1.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @return Distance between the clients before and after the given insert
+     *         position.
+     */
+    [[nodiscard]] Distance distAt(size_t position) const;
+
+    explicit RouteSnapshot(ProblemData const &data);
+};
+
+#endif  // PYVRP_ROUTESNAPSHOT_H
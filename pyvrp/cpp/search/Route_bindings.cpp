@@ -0,0 +1,167 @@
+#include "Node.h"
+#include "Route.h"
+
+#include <pybind11/pybind11.h>
+
+#include <memory>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+namespace
+{
+// Returns a node for the given client, with the client's own time window and
+// sequence data, like LocalSearch::loadSolution() sets these up.
+Node makeNode(ProblemData const &data, size_t client)
+{
+    if (client > data.numClients())
+        throw std::out_of_range("Client index out of range.");
+
+    Node node{};
+    node.client = static_cast<int>(client);
+    node.tw = {static_cast<int>(client),
+               static_cast<int>(client),
+               data.serviceDuration(client),
+               0,
+               data.twEarly(client),
+               data.twLate(client)};
+    node.seq = SequenceSegment(data.clientClass(client));
+
+    return node;
+}
+
+// Route that owns its start and end depots, so that it can be used outside of
+// a local search. The client nodes are owned by the caller.
+class StandaloneRoute : public Route
+{
+    Node startDepot;
+    Node endDepot;
+
+public:
+    StandaloneRoute(ProblemData const &data, int idx)
+        : Route(data), startDepot(makeNode(data, 0)), endDepot(startDepot)
+    {
+        this->idx = idx;
+        depot = &startDepot;
+
+        startDepot.twBefore = startDepot.tw;
+        endDepot.twAfter = endDepot.tw;
+
+        for (auto *node : {&startDepot, &endDepot})
+            node->route = this;
+
+        startDepot.next = startDepot.prev = &endDepot;
+        endDepot.next = endDepot.prev = &startDepot;
+
+        update();
+    }
+
+    // Returns the node at the given position, where position 0 is the start
+    // depot, and size() + 1 the end depot. Like all positions, these are as
+    // of the last call to update().
+    Node *at(size_t position) const
+    {
+        if (position > size() + 1)
+            throw std::out_of_range("Position out of range.");
+
+        return position == 0 ? depot : (*this)[position];
+    }
+
+    // Inserts the given node, which must not be in a route, at the given
+    // position: after the node currently at position - 1.
+    void insert(size_t position, Node &node)
+    {
+        if (node.route)
+            throw std::invalid_argument("Node is already in a route.");
+
+        if (position == 0 || position > size() + 1)
+            throw std::out_of_range("Position out of range.");
+
+        node.insertAfter(at(position - 1));
+    }
+
+    // Inserts the given node, which must not be in a route, at the end of
+    // this route. Unlike insert(), this does not depend on positions, so
+    // several nodes can be appended before calling update().
+    void append(Node &node)
+    {
+        if (node.route)
+            throw std::invalid_argument("Node is already in a route.");
+
+        node.insertAfter(p(&endDepot));
+    }
+
+    // Removes the client at the given position from this route.
+    void remove(size_t position)
+    {
+        if (position == 0 || position > size())
+            throw std::out_of_range("Position out of range.");
+
+        at(position)->remove();
+    }
+};
+}  // namespace
+
+PYBIND11_MODULE(_Route, m)
+{
+    py::class_<Node>(m, "Node")
+        .def(py::init(&makeNode),
+             py::arg("data"),
+             py::arg("client"),
+             py::keep_alive<1, 2>())  // keep data alive
+        .def_readonly("client", &Node::client)
+        .def_readonly("position", &Node::position)
+        .def("is_depot", &Node::isDepot);
+
+    py::class_<StandaloneRoute>(m, "Route")
+        .def(py::init<ProblemData const &, int>(),
+             py::arg("data"),
+             py::arg("idx") = 0,
+             py::keep_alive<1, 2>())  // keep data alive
+        .def_readonly("idx", &StandaloneRoute::idx)
+        .def("__len__", &StandaloneRoute::size)
+        .def("__getitem__",
+             &StandaloneRoute::at,
+             py::arg("position"),
+             py::return_value_policy::reference_internal)
+        .def("append",
+             &StandaloneRoute::append,
+             py::arg("node"),
+             py::keep_alive<1, 2>())  // keep node alive
+        .def("insert",
+             &StandaloneRoute::insert,
+             py::arg("position"),
+             py::arg("node"),
+             py::keep_alive<1, 3>())  // keep node alive
+        .def("remove", &StandaloneRoute::remove, py::arg("position"))
+        .def("update", &StandaloneRoute::update)
+        .def("store_count",
+             [](StandaloneRoute const &route) {
+                 return route.storeCount().get();
+             })
+        .def(
+            "stores_between",
+            [](StandaloneRoute const &route, size_t start, size_t end) {
+                return route.storesBetween(start, end).get();
+            },
+            py::arg("start"),
+            py::arg("end"))
+        .def(
+            "stores_only_between",
+            [](StandaloneRoute const &route, size_t start, size_t end) {
+                return route.storesOnlyBetween(start, end).get();
+            },
+            py::arg("start"),
+            py::arg("end"))
+        .def(
+            "visits_store_outside",
+            [](StandaloneRoute const &route,
+               Value store,
+               size_t start,
+               size_t end) {
+                return route.visitsStoreOutside(store, start, end);
+            },
+            py::arg("store"),
+            py::arg("start"),
+            py::arg("end"));
+}
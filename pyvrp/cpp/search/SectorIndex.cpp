@@ -0,0 +1,104 @@
+#include "SectorIndex.h"
+
+#include <algorithm>
+
+namespace
+{
+// Number of angle units in a full circle; see CircleSector.
+constexpr int FULL_CIRCLE = 65536;
+}  // namespace
+
+SectorIndex::SectorIndex(size_t numRoutes)
+    : sectors(numRoutes), indexed(numRoutes, false)
+{
+    order.reserve(numRoutes);
+}
+
+size_t SectorIndex::lowerBound(int angle) const
+{
+    auto const it = std::lower_bound(
+        order.begin(), order.end(), angle, [&](int route, int value) {
+            return sectors[route].start < value;
+        });
+
+    return std::distance(order.begin(), it);
+}
+
+void SectorIndex::update(Route const &route)
+{
+    auto const idx = route.idx;
+
+    if (indexed[idx])
+    {
+        // There may be several routes whose sectors start at the same angle,
+        // so we search from the first of those for this route.
+        auto pos = lowerBound(sectors[idx].start);
+        while (order[pos] != idx)
+            pos++;
+
+        order.erase(order.begin() + pos);
+        indexed[idx] = false;
+    }
+
+    if (!route.empty())
+    {
+        sectors[idx] = route.circleSector();
+        indexed[idx] = true;
+
+        auto const pos = lowerBound(sectors[idx].start);
+        order.insert(order.begin() + pos, idx);
+    }
+
+    maxExtent = 0;
+    for (auto const other : order)
+    {
+        auto const extent = CircleSector::positive_mod(sectors[other]);
+        maxExtent = std::max(maxExtent, extent);
+    }
+}
+
+void SectorIndex::overlapping(Route const &route,
+                              int tolerance,
+                              std::vector<int> &candidates) const
+{
+    candidates.clear();
+
+    if (!indexed[route.idx])
+        return;
+
+    // A sector overlaps with this route's sector when it starts at most its
+    // own extent (plus tolerance) before this sector starts, or at most this
+    // sector's extent (plus tolerance) after. All candidates thus start in
+    // the arc [start - before, start + after].
+    auto const &sector = sectors[route.idx];
+    auto const extent = CircleSector::positive_mod(sector);
+    auto const before = std::max(maxExtent + tolerance, 0);
+    auto const after = std::max(extent + tolerance, 0);
+
+    auto const test = [&](int other) {
+        if (other != route.idx
+            && CircleSector::overlap(sector, sectors[other], tolerance))
+            candidates.push_back(other);
+    };
+
+    if (before + after >= FULL_CIRCLE - 1)  // the arc spans the whole circle,
+    {                                       // so every route is a candidate.
+        for (auto const other : order)
+            test(other);
+
+        return;
+    }
+
+    auto const from = CircleSector::positive_mod(sector.start - before);
+    auto const to = from + before + after;  // may be past the full circle
+
+    auto pos = lowerBound(from);
+    for (; pos != order.size() && sectors[order[pos]].start <= to; ++pos)
+        test(order[pos]);
+
+    // Continue from the start of the circle when the arc wraps around.
+    for (pos = 0; pos != order.size()
+                  && sectors[order[pos]].start <= to - FULL_CIRCLE;
+         ++pos)
+        test(order[pos]);
+}
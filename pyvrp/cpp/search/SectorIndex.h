@@ -0,0 +1,47 @@
+#ifndef PYVRP_SECTORINDEX_H
+#define PYVRP_SECTORINDEX_H
+
+#include "CircleSector.h"
+#include "Route.h"
+
+#include <vector>
+
+/**
+ * Index over the circle sectors of the non-empty routes, sorted on the angle
+ * at which each sector starts. The index is owned by the local search, which
+ * keeps it in sync with the routes. It finds the routes whose sectors overlap
+ * a given route's sector in time logarithmic in the number of routes, plus
+ * linear in the number of routes whose sectors start close to it.
+ */
+class SectorIndex
+{
+    std::vector<CircleSector> sectors;  // indexed sector of each route
+    std::vector<bool> indexed;          // whether each route is indexed
+    std::vector<int> order;  // indexed routes, sorted on their sector start
+    int maxExtent = 0;       // largest extent of any indexed sector
+
+    // Returns the position in order of the first route whose sector starts
+    // at or after the given angle.
+    [[nodiscard]] size_t lowerBound(int angle) const;
+
+public:
+    /**
+     * Updates the index with the current sector of the given route. Should be
+     * called after the route itself has been updated. Runs in time linear in
+     * the number of routes.
+     */
+    void update(Route const &route);
+
+    /**
+     * Stores the indices of the routes whose sectors overlap with that of the
+     * given route, with the given tolerance, in the candidates vector. The
+     * given route itself is not included, and neither are empty routes.
+     */
+    void overlapping(Route const &route,
+                     int tolerance,
+                     std::vector<int> &candidates) const;
+
+    SectorIndex(size_t numRoutes);
+};
+
+#endif  // PYVRP_SECTORINDEX_H
@@ -1,61 +1,135 @@
 #include "SwapStar.h"
 
+#include <algorithm>
+#include <utility>
+
+using SS = SequenceSegment;
 using TWS = TimeWindowSegment;
 
+void SwapStar::InsertionCache::rehash(size_t epoch)
+{
+    size_t numCurrent = 0;
+    for (auto const &entry : entries)
+        if (entry.client != 0 && entry.insertPositions.epoch == epoch)
+            numCurrent++;
+
+    // The new table has a load factor of at most 1/4, so there is room for at
+    // least as many new entries before we need to rehash again.
+    auto capacity = MIN_CAPACITY;
+    while (capacity < 4 * (numCurrent + 1))
+        capacity *= 2;
+
+    auto const old = std::exchange(
+        entries, std::vector<Entry>(std::min(capacity, MAX_CAPACITY)));
+    auto const mask = entries.size() - 1;
+    numEntries = 0;
+
+    if (capacity > MAX_CAPACITY)  // then the table is full of current entries,
+        return;                   // and we start over with an empty table.
+
+    for (auto const &entry : old)
+        if (entry.client != 0 && entry.insertPositions.epoch == epoch)
+        {
+            // Client indices are unique, so these are good enough as a hash.
+            auto idx = entry.client & mask;
+            while (entries[idx].client != 0)
+                idx = (idx + 1) & mask;
+
+            entries[idx] = entry;
+            numEntries++;
+        }
+}
+
+SwapStar::ThreeBest &SwapStar::InsertionCache::get(size_t client,
+                                                   size_t epoch)
+{
+    auto const find = [&]() -> Entry & {
+        auto const mask = entries.size() - 1;
+        auto idx = client & mask;
+
+        while (entries[idx].client != client && entries[idx].client != 0)
+            idx = (idx + 1) & mask;
+
+        return entries[idx];
+    };
+
+    if (!entries.empty())
+        if (auto &entry = find(); entry.client == client)
+            return entry.insertPositions;
+
+    // Not yet in the cache. We only rehash here, since that invalidates
+    // references to existing entries.
+    if (2 * (numEntries + 1) > entries.size())  // keeps load factor <= 1/2
+        rehash(epoch);
+
+    auto &entry = find();
+    entry.client = client;
+    numEntries++;
+
+    return entry.insertPositions;
+}
+
 void SwapStar::updateRemovalCosts(Route *R1, CostEvaluator const &costEvaluator)
 {
+    auto &costs = removalCosts[R1->idx];
+    costs.resize(R1->size() + 1);
+
     for (Node *U = n(R1->depot); !U->isDepot(); U = n(U))
     {
         auto twData
-            = TWS::merge(data.durationMatrix(), p(U)->twBefore, n(U)->twAfter);
+            = TWS::merge(data.durations(), p(U)->twBefore, n(U)->twAfter);
+
+        auto const seqData = SS::merge(
+            p(U)->seqBefore, R1->seqBetween(U->position + 1, R1->size()));
 
         Distance const deltaDist = data.dist(p(U)->client, n(U)->client)
                                    - data.dist(p(U)->client, U->client)
                                    - data.dist(U->client, n(U)->client);
 
-        removalCosts(R1->idx, U->client)
+        costs[U->position]
             = static_cast<Cost>(deltaDist)
               + costEvaluator.twPenalty(twData.totalTimeWarp())
-              - costEvaluator.twPenalty(R1->timeWarp());
+              - costEvaluator.twPenalty(R1->timeWarp())
+              + costEvaluator.sequencePenalty(seqData.violations())
+              - costEvaluator.sequencePenalty(R1->sequenceViolations());
     }
 }
 
 void SwapStar::updateInsertionCost(Route *R,
                                    Node *U,
-                                   CostEvaluator const &costEvaluator)
+                                   CostEvaluator const &costEvaluator,
+                                   ThreeBest &insertPositions)
 {
-    auto &insertPositions = cache(R->idx, U->client);
-
     insertPositions = {};
-    insertPositions.shouldUpdate = false;
-
-    // Insert cost of U just after the depot (0 -> U -> ...)
-    auto twData = TWS::merge(
-        data.durationMatrix(), R->depot->twBefore, U->tw, n(R->depot)->twAfter);
+    insertPositions.epoch = epochs[R->idx];
 
-    Distance deltaDist = data.dist(0, U->client)
-                         + data.dist(U->client, n(R->depot)->client)
-                         - data.dist(0, n(R->depot)->client);
+    auto &snapshot = snapshots[R->idx];
+    if (snapshotEpochs[R->idx] != epochs[R->idx])
+    {
+        snapshot.load(*R);
+        snapshotEpochs[R->idx] = epochs[R->idx];
+    }
 
-    Cost deltaCost = static_cast<Cost>(deltaDist)
-                     + costEvaluator.twPenalty(twData.totalTimeWarp())
-                     - costEvaluator.twPenalty(R->timeWarp());
+    snapshot.insertions(U, insertions);
 
-    insertPositions.maybeAdd(deltaCost, R->depot);
+    auto const twPenalty = costEvaluator.twPenalty(R->timeWarp());
+    auto const seqPenalty
+        = costEvaluator.sequencePenalty(R->sequenceViolations());
 
-    for (Node *V = n(R->depot); !V->isDepot(); V = n(V))
+    // Insert cost of U just after V (V -> U -> ...), starting with V being the
+    // depot at position 0.
+    Node *V = R->depot;
+    for (size_t pos = 0; pos != snapshot.size(); ++pos, V = n(V))
     {
-        // Insert cost of U just after V (V -> U -> ...)
-        twData = TWS::merge(
-            data.durationMatrix(), V->twBefore, U->tw, n(V)->twAfter);
-
-        deltaDist = data.dist(V->client, U->client)
-                    + data.dist(U->client, n(V)->client)
-                    - data.dist(V->client, n(V)->client);
+        Distance const deltaDist = insertions.distTo[pos]
+                                   + insertions.distFrom[pos]
+                                   - snapshot.distAt(pos);
 
-        deltaCost = static_cast<Cost>(deltaDist)
-                    + costEvaluator.twPenalty(twData.totalTimeWarp())
-                    - costEvaluator.twPenalty(R->timeWarp());
+        Cost const deltaCost
+            = static_cast<Cost>(deltaDist)
+              + costEvaluator.twPenalty(insertions.timeWarp[pos]) - twPenalty
+              + costEvaluator.sequencePenalty(insertions.violations[pos])
+              - seqPenalty;
 
         insertPositions.maybeAdd(deltaCost, V);
     }
@@ -64,10 +138,11 @@ void SwapStar::updateInsertionCost(Route *R,
 std::pair<Cost, Node *> SwapStar::getBestInsertPoint(
     Node *U, Node *V, CostEvaluator const &costEvaluator)
 {
-    auto &best_ = cache(V->route->idx, U->client);
+    auto const epoch = epochs[V->route->idx];
+    auto &best_ = cache[V->route->idx].get(U->client, epoch);
 
-    if (best_.shouldUpdate)  // then we first update the insert positions
-        updateInsertionCost(V->route, U, costEvaluator);
+    if (best_.epoch != epoch)  // then we first update the insert positions
+        updateInsertionCost(V->route, U, costEvaluator, best_);
 
     for (size_t idx = 0; idx != 3; ++idx)  // only OK if V is not adjacent
         if (best_.locs[idx] && best_.locs[idx] != V && n(best_.locs[idx]) != V)
@@ -75,22 +150,65 @@ std::pair<Cost, Node *> SwapStar::getBestInsertPoint(
 
     // As a fallback option, we consider inserting in the place of V
     auto const twData = TWS::merge(
-        data.durationMatrix(), p(V)->twBefore, U->tw, n(V)->twAfter);
+        data.durations(), p(V)->twBefore, U->tw, n(V)->twAfter);
+
+    auto const *route = V->route;
+    auto const seqData
+        = SS::merge(p(V)->seqBefore,
+                    U->seq,
+                    route->seqBetween(V->position + 1, route->size()));
 
     Distance const deltaDist = data.dist(p(V)->client, U->client)
                                + data.dist(U->client, n(V)->client)
                                - data.dist(p(V)->client, n(V)->client);
-    Cost const deltaCost = static_cast<Cost>(deltaDist)
-                           + costEvaluator.twPenalty(twData.totalTimeWarp())
-                           - costEvaluator.twPenalty(V->route->timeWarp());
+    Cost const deltaCost
+        = static_cast<Cost>(deltaDist)
+          + costEvaluator.twPenalty(twData.totalTimeWarp())
+          - costEvaluator.twPenalty(route->timeWarp())
+          + costEvaluator.sequencePenalty(seqData.violations())
+          - costEvaluator.sequencePenalty(route->sequenceViolations());
 
     return std::make_pair(deltaCost, p(V));
 }
 
+Store SwapStar::storesAfterSwap(Node *U, Node *V) const
+{
+    auto const *route = U->route;
+    auto const pos = U->position;
+    auto const vStore = data.clientStore(V->client);
+
+    auto stores = route->storeCount() - route->storesOnlyBetween(pos, pos);
+    if (!route->visitsStoreOutside(vStore, pos, pos))
+        stores += 1;
+
+    return stores;
+}
+
+SequenceSegment SwapStar::seqAfterSwap(Node *U, Node *V, Node *VAfter) const
+{
+    auto const *route = U->route;
+    auto const posU = U->position;
+    auto const posVAfter = VAfter->position;
+
+    if (posVAfter < posU)
+        return SS::merge(VAfter->seqBefore,
+                         V->seq,
+                         route->seqBetween(posVAfter + 1, posU - 1),
+                         route->seqBetween(posU + 1, route->size()));
+
+    return SS::merge(p(U)->seqBefore,
+                     route->seqBetween(posU + 1, posVAfter),
+                     V->seq,
+                     route->seqBetween(posVAfter + 1, route->size()));
+}
+
 void SwapStar::init(Solution const &solution)
 {
     LocalSearchOperator<Route>::init(solution);
-    std::fill(updated.begin(), updated.end(), true);
+
+    // Every route may have changed, so all cached data is now stale.
+    for (auto &epoch : epochs)
+        epoch++;
 }
 
 Cost SwapStar::evaluate(Route *routeU,
@@ -99,48 +217,32 @@ Cost SwapStar::evaluate(Route *routeU,
 {
     best = {};
 
-    if (updated[routeV->idx])
-    {
-        updateRemovalCosts(routeV, costEvaluator);
-        updated[routeV->idx] = false;
-
-        for (size_t idx = 1; idx != data.numClients() + 1; ++idx)
-            cache(routeV->idx, idx).shouldUpdate = true;
-    }
-
-    if (updated[routeU->idx])
-    {
-        updateRemovalCosts(routeU, costEvaluator);
-        updated[routeV->idx] = false;
-
-        for (size_t idx = 1; idx != data.numClients() + 1; ++idx)
-            cache(routeU->idx, idx).shouldUpdate = true;
-    }
+    for (auto *route : {routeU, routeV})
+        if (removalEpochs[route->idx] != epochs[route->idx])
+        {
+            updateRemovalCosts(route, costEvaluator);
+            removalEpochs[route->idx] = epochs[route->idx];
+        }
 
     for (Node *U = n(routeU->depot); !U->isDepot(); U = n(U))
         for (Node *V = n(routeV->depot); !V->isDepot(); V = n(V))
         {
-            //if (checkSalvageSequenceConstraint(U, V)) {
-            //    return std::numeric_limits<Cost>::max() / 1000;
-            //}
-
             Cost deltaCost = 0;
 
-            auto const uWeightDemand = data.client(U->client).demandWeight;
-            auto const vWeightDemand = data.client(V->client).demandWeight;
+            auto const uWeightDemand = data.demandWeight(U->client);
+            auto const vWeightDemand = data.demandWeight(V->client);
             auto const weightDiff = uWeightDemand - vWeightDemand;
 
-            auto const uVolumeDemand = data.client(U->client).demandVolume;
-            auto const vVolumeDemand = data.client(V->client).demandVolume;
+            auto const uVolumeDemand = data.demandVolume(U->client);
+            auto const vVolumeDemand = data.demandVolume(V->client);
             auto const volumeDiff = uVolumeDemand - vVolumeDemand;
 
-            auto const uSalvageDemand = data.client(U->client).demandSalvage;
-            auto const vSalvageDemand = data.client(V->client).demandSalvage;
+            auto const uSalvageDemand = data.demandSalvage(U->client);
+            auto const vSalvageDemand = data.demandSalvage(V->client);
             auto const salvageDiff = uSalvageDemand - vSalvageDemand;
 
-            auto const uStores = routeU->storeCount();
-            auto const vStores = routeV->storeCount();
-            auto const storesDiff = uStores - vStores;
+            auto const uStores = storesAfterSwap(U, V);
+            auto const vStores = storesAfterSwap(V, U);
 
             deltaCost += costEvaluator.weightPenalty(routeU->weight() - weightDiff,
                                                    data.weightCapacity());
@@ -148,7 +250,7 @@ Cost SwapStar::evaluate(Route *routeU,
                                                    data.volumeCapacity());
             deltaCost += costEvaluator.salvagePenalty(routeU->salvage() - salvageDiff,
                                                    data.salvageCapacity());
-            deltaCost += costEvaluator.storesPenalty(routeU->storeCount() - storesDiff,
+            deltaCost += costEvaluator.storesPenalty(uStores,
                                                    data.routeStoreLimit());
 
             deltaCost -= costEvaluator.weightPenalty(routeU->weight(),
@@ -166,7 +268,7 @@ Cost SwapStar::evaluate(Route *routeU,
                                                    data.volumeCapacity());
             deltaCost += costEvaluator.salvagePenalty(routeV->salvage() + salvageDiff,
                                                    data.salvageCapacity());
-            deltaCost += costEvaluator.storesPenalty(routeV->storeCount() + storesDiff,
+            deltaCost += costEvaluator.storesPenalty(vStores,
                                                    data.routeStoreLimit());
 
             deltaCost -= costEvaluator.weightPenalty(routeV->weight(),
@@ -178,8 +280,11 @@ Cost SwapStar::evaluate(Route *routeU,
             deltaCost -= costEvaluator.storesPenalty(routeV->storeCount(),
                                                    data.routeStoreLimit());
 
-            deltaCost += removalCosts(routeU->idx, U->client);
-            deltaCost += removalCosts(routeV->idx, V->client);
+            deltaCost += removalCosts[routeU->idx][U->position];
+            deltaCost += removalCosts[routeV->idx][V->position];
+
+            if (orderIndex)
+                deltaCost += orderIndex->swapCost(U, V, costEvaluator);
 
             if (deltaCost >= 0)  // an early filter on many moves, before doing
                 continue;        // costly work determining insertion points
@@ -245,7 +350,7 @@ Cost SwapStar::evaluate(Route *routeU,
     if (best.VAfter->position + 1 == best.U->position)
     {
         // Special case
-        auto uTWS = TWS::merge(data.durationMatrix(),
+        auto uTWS = TWS::merge(data.durations(),
                                best.VAfter->twBefore,
                                best.V->tw,
                                n(best.U)->twAfter);
@@ -255,7 +360,7 @@ Cost SwapStar::evaluate(Route *routeU,
     else if (best.VAfter->position < best.U->position)
     {
         auto uTWS = TWS::merge(
-            data.durationMatrix(),
+            data.durations(),
             best.VAfter->twBefore,
             best.V->tw,
             routeU->twBetween(best.VAfter->position + 1, best.U->position - 1),
@@ -266,7 +371,7 @@ Cost SwapStar::evaluate(Route *routeU,
     else
     {
         auto uTWS = TWS::merge(
-            data.durationMatrix(),
+            data.durations(),
             p(best.U)->twBefore,
             routeU->twBetween(best.U->position + 1, best.VAfter->position),
             best.V->tw,
@@ -278,7 +383,7 @@ Cost SwapStar::evaluate(Route *routeU,
     if (best.UAfter->position + 1 == best.V->position)
     {
         // Special case
-        auto vTWS = TWS::merge(data.durationMatrix(),
+        auto vTWS = TWS::merge(data.durations(),
                                best.UAfter->twBefore,
                                best.U->tw,
                                n(best.V)->twAfter);
@@ -288,7 +393,7 @@ Cost SwapStar::evaluate(Route *routeU,
     else if (best.UAfter->position < best.V->position)
     {
         auto vTWS = TWS::merge(
-            data.durationMatrix(),
+            data.durations(),
             best.UAfter->twBefore,
             best.U->tw,
             routeV->twBetween(best.UAfter->position + 1, best.V->position - 1),
@@ -299,7 +404,7 @@ Cost SwapStar::evaluate(Route *routeU,
     else
     {
         auto vTWS = TWS::merge(
-            data.durationMatrix(),
+            data.durations(),
             p(best.V)->twBefore,
             routeV->twBetween(best.V->position + 1, best.UAfter->position),
             best.U->tw,
@@ -311,15 +416,14 @@ Cost SwapStar::evaluate(Route *routeU,
     deltaCost -= costEvaluator.twPenalty(routeU->timeWarp());
     deltaCost -= costEvaluator.twPenalty(routeV->timeWarp());
 
-    auto const uWeightDemand = data.client(best.U->client).demandWeight;
-    auto const vWeightDemand = data.client(best.V->client).demandWeight;
-    auto const uVolumeDemand = data.client(best.U->client).demandVolume;
-    auto const vVolumeDemand = data.client(best.V->client).demandVolume;
-    auto const uSalvageDemand = data.client(best.U->client).demandSalvage;
-    auto const vSalvageDemand = data.client(best.V->client).demandSalvage;
-    auto const uStores = routeU->storeCount();
-    auto const vStores = routeV->storeCount();
-
+    auto const uWeightDemand = data.demandWeight(best.U->client);
+    auto const vWeightDemand = data.demandWeight(best.V->client);
+    auto const uVolumeDemand = data.demandVolume(best.U->client);
+    auto const vVolumeDemand = data.demandVolume(best.V->client);
+    auto const uSalvageDemand = data.demandSalvage(best.U->client);
+    auto const vSalvageDemand = data.demandSalvage(best.V->client);
+    auto const uStores = storesAfterSwap(best.U, best.V);
+    auto const vStores = storesAfterSwap(best.V, best.U);
 
     deltaCost += costEvaluator.weightPenalty(routeU->weight() - uWeightDemand + vWeightDemand,
                                            data.weightCapacity());
@@ -327,8 +431,7 @@ Cost SwapStar::evaluate(Route *routeU,
                                            data.volumeCapacity());
     deltaCost += costEvaluator.salvagePenalty(routeU->salvage() - uSalvageDemand + vSalvageDemand,
                                            data.salvageCapacity());
-    deltaCost += costEvaluator.storesPenalty(routeU->storeCount() - uStores + vStores,
-                                           data.routeStoreLimit());
+    deltaCost += costEvaluator.storesPenalty(uStores, data.routeStoreLimit());
 
     deltaCost
         -= costEvaluator.weightPenalty(routeU->weight(), data.weightCapacity());
@@ -345,8 +448,7 @@ Cost SwapStar::evaluate(Route *routeU,
                                            data.volumeCapacity());
     deltaCost += costEvaluator.salvagePenalty(routeV->salvage() + uSalvageDemand - vSalvageDemand,
                                            data.salvageCapacity());
-    deltaCost += costEvaluator.storesPenalty(routeV->storeCount() + uStores - vStores,
-                                           data.routeStoreLimit());
+    deltaCost += costEvaluator.storesPenalty(vStores, data.routeStoreLimit());
 
     deltaCost
         -= costEvaluator.weightPenalty(routeV->weight(), data.weightCapacity());
@@ -357,38 +459,20 @@ Cost SwapStar::evaluate(Route *routeU,
     deltaCost
         -= costEvaluator.storesPenalty(routeV->storeCount(), data.routeStoreLimit());
 
+    auto const uSeq = seqAfterSwap(best.U, best.V, best.VAfter);
+    auto const vSeq = seqAfterSwap(best.V, best.U, best.UAfter);
+
+    deltaCost += costEvaluator.sequencePenalty(uSeq.violations());
+    deltaCost += costEvaluator.sequencePenalty(vSeq.violations());
+    deltaCost -= costEvaluator.sequencePenalty(routeU->sequenceViolations());
+    deltaCost -= costEvaluator.sequencePenalty(routeV->sequenceViolations());
+
+    if (orderIndex)
+        deltaCost += orderIndex->swapCost(best.U, best.V, costEvaluator);
+
     return deltaCost;
 }
 
-//bool SwapStar::checkSalvageSequenceConstraint(Node *U, Node *V) const
-//{
-//    // These sequences should violate the constraint
-//    // S-B
-//    // S-D
-//    // B-B
-//    // B-D
-//    bool uIsClientDelivery = (data.client(U->client).demandWeight || data.client(U->client).demandVolume);
-//    bool uIsClientSalvage = (data.client(U->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool uIsBoth = uIsClientDelivery && uIsClientSalvage;
-//
-//    bool vIsClientDelivery = (data.client(V->client).demandWeight || data.client(V->client).demandVolume);
-//    bool vIsClientSalvage = (data.client(V->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool vIsBoth = vIsClientDelivery && vIsClientSalvage;
-//
-//    bool nextUClientDelivery = (data.client(n(U)->client).demandWeight || data.client(n(U)->client).demandVolume);
-//    bool nextVClientDelivery = (data.client(n(V)->client).demandWeight || data.client(n(V)->client).demandVolume);
-//
-//    // S-B or S-D
-//    if (uIsClientSalvage && !uIsBoth && ((vIsClientDelivery || vIsBoth) || nextVClientDelivery))
-//        return true;
-//
-//    // B-B or B-D
-//    if (uIsBoth && ((vIsBoth || vIsClientDelivery) || nextUClientDelivery))
-//        return true;
-//
-//    return false;
-//}
-
 void SwapStar::apply([[maybe_unused]] Route *U, [[maybe_unused]] Route *V) const
 {
     if (best.U && best.UAfter && best.V && best.VAfter)
@@ -398,4 +482,9 @@ void SwapStar::apply([[maybe_unused]] Route *U, [[maybe_unused]] Route *V) const
     }
 }
 
-void SwapStar::update(Route *U) { updated[U->idx] = true; }
+void SwapStar::update(Route *U) { epochs[U->idx]++; }
+
+std::unique_ptr<LocalSearchOperator<Route>> SwapStar::clone() const
+{
+    return std::make_unique<SwapStar>(data);
+}
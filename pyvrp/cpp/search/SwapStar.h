@@ -2,8 +2,9 @@
 #define PYVRP_SWAPSTAR_H
 
 #include "LocalSearchOperator.h"
-#include "Matrix.h"
 #include "Measure.h"
+#include "RouteSnapshot.h"
+#include "SequenceSegment.h"
 
 #include <array>
 #include <limits>
@@ -24,7 +25,7 @@ class SwapStar : public LocalSearchOperator<Route>
 {
     struct ThreeBest  // stores three best SWAP* insertion points
     {
-        bool shouldUpdate = true;
+        size_t epoch = 0;  // route epoch at computation; epochs start at 1
         std::array<Cost, 3> costs = {std::numeric_limits<Cost>::max(),
                                      std::numeric_limits<Cost>::max(),
                                      std::numeric_limits<Cost>::max()};
@@ -59,6 +60,44 @@ class SwapStar : public LocalSearchOperator<Route>
         }
     };
 
+    // Stores the three best insertion points in a single route, for each
+    // client (of another route) that was evaluated against the route. This is
+    // a small open-addressing hash table keyed on the client, so memory grows
+    // with the number of clients that are actually evaluated against the
+    // route, rather than with the total number of clients. Entries are stamped
+    // with the route epoch they were computed at, and are stale once the route
+    // epoch has moved on. Stale entries are only removed when the table would
+    // otherwise grow. The capacity is bounded: when the table is full of
+    // current entries, it is cleared.
+    class InsertionCache
+    {
+        // Both must be powers of two.
+        static constexpr size_t MIN_CAPACITY = 16;
+        static constexpr size_t MAX_CAPACITY = 1024;
+
+        struct Entry
+        {
+            size_t client = 0;  // the depot is never cached, so 0 is empty
+            ThreeBest insertPositions;
+        };
+
+        std::vector<Entry> entries;  // empty, or power-of-two size
+        size_t numEntries = 0;
+
+        // Rebuilds the table with only the entries of the given epoch, and
+        // room for at least as many new entries.
+        void rehash(size_t epoch);
+
+    public:
+        /**
+         * Returns the insertion points for the given client. These must first
+         * be updated when their epoch differs from the given (current) route
+         * epoch. Adding a client invalidates references to the insertion
+         * points of other clients.
+         */
+        ThreeBest &get(size_t client, size_t epoch);
+    };
+
     struct BestMove  // tracks the best SWAP* move
     {
         Cost cost = 0;
@@ -73,21 +112,43 @@ class SwapStar : public LocalSearchOperator<Route>
     // Updates the removal costs of clients in the given route
     void updateRemovalCosts(Route *R1, CostEvaluator const &costEvaluator);
 
-    // Updates the cache storing the three best positions in the given route for
-    // the passed-in node (client).
-    void
-    updateInsertionCost(Route *R, Node *U, CostEvaluator const &costEvaluator);
+    // Updates the given three best positions in the given route for the
+    // passed-in node (client).
+    void updateInsertionCost(Route *R,
+                             Node *U,
+                             CostEvaluator const &costEvaluator,
+                             ThreeBest &insertPositions);
 
     // Gets the delta cost and reinsert point for U in the route of V, assuming
     // V is removed.
     inline std::pair<Cost, Node *>
     getBestInsertPoint(Node *U, Node *V, CostEvaluator const &costEvaluator);
 
-//    bool checkSalvageSequenceConstraint(Node *U, Node *V) const;
+    // Returns the number of distinct stores on U's route when U is replaced by
+    // V.
+    [[nodiscard]] inline Store storesAfterSwap(Node *U, Node *V) const;
 
-    Matrix<ThreeBest> cache;
-    Matrix<Cost> removalCosts;
-    std::vector<bool> updated;
+    // Returns the sequence data of U's route when U is removed from it, and V
+    // is inserted after VAfter.
+    [[nodiscard]] inline SequenceSegment
+    seqAfterSwap(Node *U, Node *V, Node *VAfter) const;
+
+    // Modification counter of each route. This is incremented whenever the
+    // route changes, which invalidates all cached data of the route at once.
+    std::vector<size_t> epochs;
+
+    // Insertion points and removal costs of each route. The removal costs are
+    // indexed by client position in the route, and were computed at the given
+    // route epochs.
+    std::vector<InsertionCache> cache;
+    std::vector<std::vector<Cost>> removalCosts;
+    std::vector<size_t> removalEpochs;
+
+    // Snapshots of each route, used to compute insertion points, and the route
+    // epochs at which these were taken.
+    std::vector<RouteSnapshot> snapshots;
+    std::vector<size_t> snapshotEpochs;
+    RouteSnapshot::Insertions insertions;  // scratch space
 
     BestMove best;
 
@@ -99,13 +160,19 @@ public:
 
     void apply(Route *U, Route *V) const override;
 
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Route>>
+    clone() const override;
+
     void update(Route *U) override;
 
     explicit SwapStar(ProblemData const &data)
         : LocalSearchOperator<Route>(data),
-          cache(data.numVehicles(), data.numClients() + 1),
-          removalCosts(data.numVehicles(), data.numClients() + 1),
-          updated(data.numVehicles(), true)
+          epochs(data.numVehicles(), 1),
+          cache(data.numVehicles()),
+          removalCosts(data.numVehicles()),
+          removalEpochs(data.numVehicles(), 0),
+          snapshots(data.numVehicles(), RouteSnapshot(data)),
+          snapshotEpochs(data.numVehicles(), 0)
     {
     }
 };
@@ -1,19 +1,19 @@
 #include "TwoOpt.h"
 
 #include "Route.h"
+#include "SequenceSegment.h"
 #include "TimeWindowSegment.h"
+#include "Trace.h"
 
+#include <algorithm>
+
+using SS = SequenceSegment;
 using TWS = TimeWindowSegment;
 
 Cost TwoOpt::evalWithinRoute(Node *U,
                              Node *V,
                              CostEvaluator const &costEvaluator) const
 {
-
-//    if (checkSalvageSequenceConstraint(U, V)) {
-//        return std::numeric_limits<Cost>::max() / 1000;
-//    }
-
     if (U->position + 1 >= V->position)
         return 0;
 
@@ -26,6 +26,15 @@ Cost TwoOpt::evalWithinRoute(Node *U,
 
     Cost deltaCost = static_cast<Cost>(deltaDist);
 
+    auto const *route = U->route;
+    auto const seq = SS::merge(
+        U->seqBefore,
+        route->seqBetween(U->position + 1, V->position).reversed(),
+        route->seqBetween(V->position + 1, route->size()));
+
+    deltaCost += costEvaluator.sequencePenalty(seq.violations());
+    deltaCost -= costEvaluator.sequencePenalty(route->sequenceViolations());
+
     if (!U->route->hasTimeWarp() && deltaCost >= 0)
         return deltaCost;
 
@@ -33,11 +42,11 @@ Cost TwoOpt::evalWithinRoute(Node *U,
     auto *itRoute = V;
     while (itRoute != U)
     {
-        tws = TWS::merge(data.durationMatrix(), tws, itRoute->tw);
+        tws = TWS::merge(data.durations(), tws, itRoute->tw);
         itRoute = p(itRoute);
     }
 
-    tws = TWS::merge(data.durationMatrix(), tws, n(V)->twAfter);
+    tws = TWS::merge(data.durations(), tws, n(V)->twAfter);
 
     deltaCost += costEvaluator.twPenalty(tws.totalTimeWarp());
     deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
@@ -49,11 +58,7 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
                                Node *V,
                                CostEvaluator const &costEvaluator) const
 {
-    std::cout << "Enter evalBetweenRoutes" << std::endl;
-
-//    if (checkSalvageSequenceConstraint(U, V)) {
-//        return std::numeric_limits<Cost>::max() / 1000;
-//    }
+    PYVRP_TRACE(OPERATOR, DEBUG, "Enter evalBetweenRoutes");
 
     Distance const current = data.dist(U->client, n(U)->client)
                             + data.dist(V->client, n(V)->client);
@@ -62,17 +67,35 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
 
     Cost deltaCost = static_cast<Cost>(proposed - current);
 
+    // Exchanging the route suffixes changes the order splits. Evaluating that
+    // takes time linear in the suffix lengths. A move can only decrease the
+    // order split penalty when some order already spans too many routes, so
+    // otherwise we defer this until we know the move might be improving.
+    auto const ordersDelta = [&]() {
+        return orderIndex->exchangeCost(U->route,
+                                        U->position + 1,
+                                        U->route->size(),
+                                        V->route,
+                                        V->position + 1,
+                                        V->route->size(),
+                                        costEvaluator);
+    };
+
+    bool const ordersFirst = orderIndex && orderIndex->excess() > 0;
+    if (ordersFirst)
+        deltaCost += ordersDelta();
+
     if (U->route->isFeasible() && V->route->isFeasible() && deltaCost >= 0)
         return deltaCost;
 
     auto const uTWS
-        = TWS::merge(data.durationMatrix(), U->twBefore, n(V)->twAfter);
+        = TWS::merge(data.durations(), U->twBefore, n(V)->twAfter);
 
     deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
     deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
     auto const vTWS
-        = TWS::merge(data.durationMatrix(), V->twBefore, n(U)->twAfter);
+        = TWS::merge(data.durations(), V->twBefore, n(U)->twAfter);
 
     deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
     deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
@@ -80,7 +103,6 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
     auto const deltaWeight = U->cumulatedWeight - V->cumulatedWeight;
     auto const deltaVolume = U->cumulatedVolume - V->cumulatedVolume;
     auto const deltaSalvage = U->cumulatedSalvage - V->cumulatedSalvage;
-    auto const deltaStores = U->cumulatedStores - V->cumulatedStores;
 
     deltaCost += costEvaluator.weightPenalty(U->route->weight() - deltaWeight,
                                            data.weightCapacity());
@@ -88,8 +110,6 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
                                            data.volumeCapacity());
     deltaCost += costEvaluator.salvagePenalty(U->route->salvage() - deltaSalvage,
                                            data.salvageCapacity());
-    deltaCost += costEvaluator.storesPenalty(U->route->stores() - deltaStores,
-                                           data.routeStoreLimit());
 
     deltaCost
         -= costEvaluator.weightPenalty(U->route->weight(), data.weightCapacity());
@@ -97,8 +117,6 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
         -= costEvaluator.volumePenalty(U->route->volume(), data.volumeCapacity());
     deltaCost
         -= costEvaluator.salvagePenalty(U->route->salvage(), data.salvageCapacity());
-    deltaCost
-        -= costEvaluator.storesPenalty(U->route->stores(), data.routeStoreLimit());
 
     deltaCost += costEvaluator.weightPenalty(V->route->weight() + deltaWeight,
                                            data.weightCapacity());
@@ -106,8 +124,6 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
                                            data.volumeCapacity());
     deltaCost += costEvaluator.salvagePenalty(V->route->salvage() + deltaSalvage,
                                            data.salvageCapacity());
-    deltaCost += costEvaluator.storesPenalty(V->route->stores() + deltaStores,
-                                           data.routeStoreLimit());
 
     deltaCost
         -= costEvaluator.weightPenalty(V->route->weight(), data.weightCapacity());
@@ -117,39 +133,66 @@ Cost TwoOpt::evalBetweenRoutes(Node *U,
         -= costEvaluator.salvagePenalty(V->route->salvage(), data.salvageCapacity());
     deltaCost
         -= costEvaluator.storesPenalty(V->route->stores(), data.routeStoreLimit());
+    deltaCost
+        -= costEvaluator.storesPenalty(U->route->stores(), data.routeStoreLimit());
+
+    auto const uSeq = SS::merge(
+        U->seqBefore, V->route->seqBetween(V->position + 1, V->route->size()));
+    auto const vSeq = SS::merge(
+        V->seqBefore, U->route->seqBetween(U->position + 1, U->route->size()));
+
+    deltaCost += costEvaluator.sequencePenalty(uSeq.violations());
+    deltaCost += costEvaluator.sequencePenalty(vSeq.violations());
+    deltaCost -= costEvaluator.sequencePenalty(U->route->sequenceViolations());
+    deltaCost -= costEvaluator.sequencePenalty(V->route->sequenceViolations());
+
+    // The new routes are U's prefix followed by V's suffix, and V's prefix
+    // followed by U's suffix. Counting the distinct stores in these exactly
+    // takes time linear in the suffix lengths, so we first check whether the
+    // move can be improving using the lower bound on the number of stores
+    // given by the largest of the two parts.
+    auto const *routeU = U->route;
+    auto const *routeV = V->route;
+
+    auto const uPrefix = routeU->storesBetween(1, U->position);
+    auto const uSuffix = routeU->storesBetween(U->position + 1, routeU->size());
+    auto const vPrefix = routeV->storesBetween(1, V->position);
+    auto const vSuffix = routeV->storesBetween(V->position + 1, routeV->size());
+
+    auto const storesLB
+        = costEvaluator.storesPenalty(std::max(uPrefix, vSuffix),
+                                      data.routeStoreLimit())
+          + costEvaluator.storesPenalty(std::max(vPrefix, uSuffix),
+                                        data.routeStoreLimit());
+
+    if (deltaCost + storesLB >= 0)
+        return deltaCost + storesLB;
+
+    auto const uStores
+        = uPrefix
+          + routeV->storesBetweenIf(
+              V->position + 1, routeV->size(), [&](Store store) {
+                  auto const first = routeU->firstStoreVisit(store);
+                  return first == 0 || first > U->position;
+              });
+
+    auto const vStores
+        = vPrefix
+          + routeU->storesBetweenIf(
+              U->position + 1, routeU->size(), [&](Store store) {
+                  auto const first = routeV->firstStoreVisit(store);
+                  return first == 0 || first > V->position;
+              });
+
+    deltaCost += costEvaluator.storesPenalty(uStores, data.routeStoreLimit());
+    deltaCost += costEvaluator.storesPenalty(vStores, data.routeStoreLimit());
+
+    if (orderIndex && !ordersFirst && deltaCost < 0)
+        deltaCost += ordersDelta();
 
     return deltaCost;
 }
 
-//bool TwoOpt::checkSalvageSequenceConstraint(Node *U, Node *V) const
-//{
-//    // These sequences should violate the constraint
-//    // S-B
-//    // S-D
-//    // B-B
-//    // B-D
-//    bool uIsClientDelivery = (data.client(U->client).demandWeight || data.client(U->client).demandVolume);
-//    bool uIsClientSalvage = (data.client(U->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool uIsBoth = uIsClientDelivery && uIsClientSalvage;
-//
-//    bool vIsClientDelivery = (data.client(V->client).demandWeight || data.client(V->client).demandVolume);
-//    bool vIsClientSalvage = (data.client(V->client).demandSalvage != Measure<MeasureType::SALVAGE>(0));
-//    bool vIsBoth = vIsClientDelivery && vIsClientSalvage;
-//
-//    bool nextUClientDelivery = (data.client(n(U)->client).demandWeight || data.client(n(U)->client).demandVolume);
-//    bool nextVClientDelivery = (data.client(n(V)->client).demandWeight || data.client(n(V)->client).demandVolume);
-//
-//    // S-B or S-D
-//    if (uIsClientSalvage && !uIsBoth && ((vIsClientDelivery || vIsBoth) || nextVClientDelivery))
-//        return true;
-//
-//    // B-B or B-D
-//    if (uIsBoth && ((vIsBoth || vIsClientDelivery) || nextUClientDelivery))
-//        return true;
-//
-//    return false;
-//}
-
 void TwoOpt::applyWithinRoute(Node *U, Node *V) const
 {
     auto *itRoute = V;
@@ -205,3 +248,8 @@ void TwoOpt::apply(Node *U, Node *V) const
     else
         applyBetweenRoutes(U, V);
 }
+
+std::unique_ptr<LocalSearchOperator<Node>> TwoOpt::clone() const
+{
+    return std::make_unique<TwoOpt>(data);
+}
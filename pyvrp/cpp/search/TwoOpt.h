@@ -21,9 +21,6 @@ class TwoOpt : public LocalSearchOperator<Node>
                            Node *V,
                            CostEvaluator const &costEvaluator) const;
 
-//    bool checkSalvageSequenceConstraint(Node *U, 
-//                                        Node *V) const;
-
     void applyWithinRoute(Node *U, Node *V) const;
 
     void applyBetweenRoutes(Node *U, Node *V) const;
@@ -33,6 +30,9 @@ public:
     evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Node *U, Node *V) const override;
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Node>>
+    clone() const override;
 };
 
 #endif  // PYVRP_TWOOPT_H
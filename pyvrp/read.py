@@ -10,7 +10,7 @@ import vrplib
 from pyvrp.constants import MAX_USER_VALUE
 from pyvrp.exceptions import ScalingWarning
 
-from ._ProblemData import Client, ProblemData
+from ._ProblemData import Client, DistanceOracle, ProblemData
 
 _Routes = List[List[int]]
 _RoundingFunc = Callable[[np.ndarray], np.ndarray]
@@ -48,6 +48,7 @@ def read(
     where: Union[str, pathlib.Path],
     instance_format: str = "vrplib",
     round_func: Union[str, _RoundingFunc] = no_rounding,
+    on_demand: bool = False,
 ) -> ProblemData:
     """
     Reads the VRPLIB file at the given location, and returns a ProblemData
@@ -70,6 +71,13 @@ def read(
             * ``'trunc1'`` or ``'dimacs'`` scale and truncate to the nearest
               decimal;
             * ``'none'`` does no rounding. This is the default.
+    on_demand, optional
+        When set, no distance and duration matrices are computed. Instead,
+        the returned data computes distances and durations on demand from the
+        node coordinates, with a :class:`~pyvrp._ProblemData.DistanceOracle`.
+        The values are exactly those that would otherwise be stored. This
+        requires Euclidean edge weights (``EUC_2D``), and ``round_func`` to
+        be one of the named rounding functions above. Default False.
 
     Returns
     -------
@@ -85,7 +93,28 @@ def read(
             f" or one of {ROUND_FUNCS.keys()}."
         )
 
-    instance = vrplib.read_instance(where, instance_format=instance_format)
+    instance = vrplib.read_instance(
+        where,
+        instance_format=instance_format,
+        compute_edge_weights=not on_demand,
+    )
+
+    if on_demand:
+        is_euclidean = instance_format == "solomon" or (
+            instance.get("edge_weight_type") == "EUC_2D"
+        )
+
+        if not is_euclidean or "node_coord" not in instance:
+            raise ValueError("on_demand requires EUC_2D node coordinates.")
+
+        funcs = ROUND_FUNCS.items()
+        names = [name for name, func in funcs if func is round_func]
+
+        if not names:
+            raise ValueError(
+                "on_demand requires round_func to be one of "
+                f"{ROUND_FUNCS.keys()}."
+            )
 
     # A priori checks
     if "dimension" in instance:
@@ -114,7 +143,14 @@ def read(
     stop_limit: int = instance.get("stop_limit", _INT_MAX)
     client_route_limit: int = instance.get("client_route_limit", _INT_MAX)
 
-    distances: np.ndarray = round_func(instance["edge_weight"]/10).astype(int)
+    if on_demand:
+        # Only the largest distance is needed here, for the scaling check
+        # below. It is at most the diagonal of the coordinates' bounding box.
+        extent = np.ptp(instance["node_coord"], axis=0)
+        diagonal = np.array([np.hypot(*extent)])
+        distances = round_func(diagonal / 10).astype(int)
+    else:
+        distances = round_func(instance["edge_weight"] / 10).astype(int)
 
     if "weight_demand" in instance:
         weight_demands: np.ndarray = instance["weight_demand"]
@@ -223,6 +259,25 @@ def read(
         """
         warn(msg, ScalingWarning)
 
+    if on_demand:
+        oracle = DistanceOracle(
+            instance["node_coord"][:, 0],
+            instance["node_coord"][:, 1],
+            round_func=names[0],
+            durations="time_window" in instance,
+        )
+
+        return ProblemData(
+            clients,
+            num_vehicles,
+            weight_capacity,
+            volume_capacity,
+            salvage_capacity,
+            client_route_limit,
+            stop_limit,
+            distance_oracle=oracle,
+        )
+
     return ProblemData(
         clients,
         num_vehicles,
@@ -1,4 +1,5 @@
-from typing import List
+from dataclasses import dataclass, fields
+from typing import Dict, List, Union
 
 from pyvrp._CostEvaluator import CostEvaluator
 from pyvrp._ProblemData import ProblemData
@@ -6,16 +7,74 @@ from pyvrp._Solution import Solution
 from pyvrp._XorShift128 import XorShift128
 
 from ._LocalSearch import LocalSearch as _LocalSearch
+from ._Neighbourhood import Neighbourhood
 
 Neighbours = List[List[int]]
 
 
+@dataclass
+class OperatorStatistics:
+    """
+    Counters that track how a local search operator performs.
+
+    Attributes
+    ----------
+    num_evaluations
+        Number of moves the operator evaluated.
+    num_improving
+        Number of evaluated moves that were improving.
+    num_applied
+        Number of moves that were applied.
+    evaluation_ticks
+        Time spent evaluating moves, in CPU timestamp counter ticks. This is
+        only measured when the extensions are compiled with operator timing
+        enabled, and zero otherwise.
+    total_delta
+        Sum of the cost deltas of the applied moves.
+    """
+
+    num_evaluations: int = 0
+    num_improving: int = 0
+    num_applied: int = 0
+    evaluation_ticks: int = 0
+    total_delta: float = 0
+
+    @property
+    def avg_delta(self) -> float:
+        """
+        Average cost delta of the applied moves, or zero if no moves were
+        applied.
+        """
+        if self.num_applied == 0:
+            return 0
+
+        return self.total_delta / self.num_applied
+
+    def __iadd__(self, other: "OperatorStatistics") -> "OperatorStatistics":
+        for field in fields(self):
+            value = getattr(self, field.name) + getattr(other, field.name)
+            setattr(self, field.name, value)
+
+        return self
+
+
 class LocalSearch:
     """
     Local search method. This search method explores a granular neighbourhood
     in a very efficient manner using user-provided node and route operators.
     This quickly results in much improved solutions.
 
+    .. note::
+
+       The :meth:`~search` and :meth:`~intensify` methods release the GIL
+       while the search runs. Local search objects, their operators, and
+       their random number generator are not thread-safe: give each thread
+       its own. Data and cost evaluator objects are immutable, and may be
+       shared between threads. To improve many solutions in parallel, use
+       :meth:`~search_batch`, :meth:`~intensify_batch`, or :meth:`~run_batch`
+       instead: these give each thread its own copy of the search state and
+       operators internally.
+
     Parameters
     ----------
     data
@@ -23,15 +82,22 @@ class LocalSearch:
     rng
         Random number generator.
     neighbours
-        List of lists that defines the local search neighbourhood.
+        List of lists, or Neighbourhood object, that defines the local search
+        neighbourhood.
     """
 
     def __init__(
-        self, data: ProblemData, rng: XorShift128, neighbours: Neighbours
+        self,
+        data: ProblemData,
+        rng: XorShift128,
+        neighbours: Union[Neighbours, Neighbourhood],
     ):
         self._ls = _LocalSearch(data, neighbours)
         self._rng = rng
 
+        self._node_ops: List[str] = []
+        self._route_ops: List[str] = []
+
     def add_node_operator(self, op):
         """
         Adds a node operator to this local search object. The node operator
@@ -43,6 +109,7 @@ class LocalSearch:
             The node operator to add to this local search object.
         """
         self._ls.add_node_operator(op)
+        self._node_ops.append(type(op).__name__)
 
     def add_route_operator(self, op):
         """
@@ -56,8 +123,9 @@ class LocalSearch:
             The route operator to add to this local search object.
         """
         self._ls.add_route_operator(op)
+        self._route_ops.append(type(op).__name__)
 
-    def set_neighbours(self, neighbours: Neighbours):
+    def set_neighbours(self, neighbours: Union[Neighbours, Neighbourhood]):
         """
         Convenience method to replace the current granular neighbourhood used
         by the local search object.
@@ -65,7 +133,8 @@ class LocalSearch:
         Parameters
         ----------
         neighbours
-            A new granular neighbourhood.
+            A new granular neighbourhood, as a list of lists or a
+            Neighbourhood object.
         """
         self._ls.set_neighbours(neighbours)
 
@@ -80,6 +149,55 @@ class LocalSearch:
         """
         return self._ls.get_neighbours()
 
+    def get_neighbourhood(self) -> Neighbourhood:
+        """
+        Returns the granular neighbourhood currently used by the local search,
+        in the compact format it is stored in.
+
+        Returns
+        -------
+        Neighbourhood
+            The current granular neighbourhood.
+        """
+        return self._ls.get_neighbourhood()
+
+    def statistics(self) -> Dict[str, OperatorStatistics]:
+        """
+        Returns the statistics collected for each operator since this object
+        was created, or since the last call to :meth:`~reset_statistics`.
+
+        Returns
+        -------
+        dict
+            Statistics for each operator, keyed by the operator's class name.
+            Statistics of operators of the same class are summed. The entries
+            ``"insert"`` and ``"remove"`` track inserting clients that are not
+            in the solution, and removing optional clients from the solution.
+        """
+        stats = self._ls.statistics()
+        result: Dict[str, OperatorStatistics] = {}
+
+        def add(name: str, op_stats: dict):
+            result.setdefault(name, OperatorStatistics())
+            result[name] += OperatorStatistics(**op_stats)
+
+        for name, op_stats in zip(self._node_ops, stats["node_operators"]):
+            add(name, op_stats)
+
+        for name, op_stats in zip(self._route_ops, stats["route_operators"]):
+            add(name, op_stats)
+
+        add("insert", stats["insert"])
+        add("remove", stats["remove"])
+
+        return result
+
+    def reset_statistics(self):
+        """
+        Resets the statistics of all operators to zero.
+        """
+        self._ls.reset_statistics()
+
     def run(
         self,
         solution: Solution,
@@ -130,6 +248,59 @@ class LocalSearch:
                 solution = new_solution
             return solution
 
+    def run_batch(
+        self,
+        solutions: List[Solution],
+        cost_evaluator: CostEvaluator,
+        should_intensify: List[bool],
+        num_threads: int = 0,
+    ) -> List[Solution]:
+        """
+        Batch version of :meth:`~run`, that improves all given solutions in
+        parallel. First, :meth:`~search_batch` is applied to all solutions.
+        Thereafter, :meth:`~intensify_batch` is applied to those solutions for
+        which ``should_intensify`` is true, and the intensified solution is
+        kept if it is better.
+
+        Parameters
+        ----------
+        solutions
+            The solutions to improve through local search.
+        cost_evaluator
+            Cost evaluator to use.
+        should_intensify
+            Whether to apply :meth:`~intensify` to each solution. Must have the
+            same length as ``solutions``.
+        num_threads
+            Number of threads to use. Defaults to one per hardware thread.
+
+        Returns
+        -------
+        list
+            The improved solutions, in the same order as the given ones.
+        """
+        if len(should_intensify) != len(solutions):
+            msg = "Expected one should_intensify value per solution."
+            raise ValueError(msg)
+
+        solutions = self.search_batch(solutions, cost_evaluator, num_threads)
+
+        indices = [idx for idx, flag in enumerate(should_intensify) if flag]
+        intensified = self.intensify_batch(
+            [solutions[idx] for idx in indices],
+            cost_evaluator,
+            num_threads=num_threads,
+        )
+
+        for idx, new_solution in zip(indices, intensified):
+            current_cost = cost_evaluator.penalised_cost(solutions[idx])
+            new_cost = cost_evaluator.penalised_cost(new_solution)
+
+            if new_cost < current_cost:
+                solutions[idx] = new_solution
+
+        return solutions
+
     def intensify(
         self,
         solution: Solution,
@@ -154,7 +325,10 @@ class LocalSearch:
             considered: only those route pairs that share some overlap when
             considering their center's angle from the depot are evaluted.
             This parameter controls the amount of overlap needed before two
-            routes are evaluated.
+            routes are evaluated: routes whose circle sectors are at most this
+            many degrees apart are also evaluated. A tolerance of 360 degrees
+            evaluates all route pairs. Each route is paired with the other
+            routes in order of the distance between the routes' centroids.
 
         Raises
         ------
@@ -201,3 +375,75 @@ class LocalSearch:
         """
         self._ls.shuffle(self._rng)
         return self._ls.search(solution, cost_evaluator)
+
+    def intensify_batch(
+        self,
+        solutions: List[Solution],
+        cost_evaluator: CostEvaluator,
+        overlap_tolerance_degrees: int = 0,
+        num_threads: int = 0,
+    ) -> List[Solution]:
+        """
+        Applies :meth:`~intensify` to each of the given solutions, in
+        parallel. Each thread uses its own copy of the search state and route
+        operators. All solutions are intensified with the same evaluation
+        order.
+
+        Parameters
+        ----------
+        solutions
+            The solutions to improve.
+        cost_evaluator
+            Cost evaluator to use.
+        overlap_tolerance_degrees
+            See :meth:`~intensify`.
+        num_threads
+            Number of threads to use. Defaults to one per hardware thread.
+
+        Raises
+        ------
+        RuntimeError
+            When this method is called before registering route operators.
+
+        Returns
+        -------
+        list
+            The improved solutions, in the same order as the given ones.
+        """
+        self._ls.shuffle(self._rng)
+        return self._ls.intensify_batch(
+            solutions, cost_evaluator, overlap_tolerance_degrees, num_threads
+        )
+
+    def search_batch(
+        self,
+        solutions: List[Solution],
+        cost_evaluator: CostEvaluator,
+        num_threads: int = 0,
+    ) -> List[Solution]:
+        """
+        Applies :meth:`~search` to each of the given solutions, in parallel.
+        Each thread uses its own copy of the search state and node operators.
+        All solutions are searched with the same evaluation order.
+
+        Parameters
+        ----------
+        solutions
+            The solutions to improve.
+        cost_evaluator
+            Cost evaluator to use.
+        num_threads
+            Number of threads to use. Defaults to one per hardware thread.
+
+        Raises
+        ------
+        RuntimeError
+            When this method is called before registering node operators.
+
+        Returns
+        -------
+        list
+            The improved solutions, in the same order as the given ones.
+        """
+        self._ls.shuffle(self._rng)
+        return self._ls.search_batch(solutions, cost_evaluator, num_threads)
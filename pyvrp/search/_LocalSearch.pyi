@@ -1,23 +1,43 @@
-from typing import List
+from typing import Dict, List, Union, overload
 
 from pyvrp._CostEvaluator import CostEvaluator
 from pyvrp._ProblemData import ProblemData
 from pyvrp._Solution import Solution
 from pyvrp._XorShift128 import XorShift128
 
+from ._Neighbourhood import Neighbourhood
+
 Neighbours = List[List[int]]
+OperatorStatisticsDict = Dict[str, Union[int, float]]
 
 class LocalSearch:
+    @overload
     def __init__(
         self,
         data: ProblemData,
         neighbours: Neighbours,
     ) -> None: ...
+    @overload
+    def __init__(
+        self,
+        data: ProblemData,
+        neighbours: Neighbourhood,
+    ) -> None: ...
     def add_node_operator(self, op) -> None: ...
     def add_route_operator(self, op) -> None: ...
+    @overload
     def set_neighbours(self, neighbours: Neighbours) -> None: ...
+    @overload
+    def set_neighbours(self, neighbours: Neighbourhood) -> None: ...
     def get_neighbours(self) -> Neighbours: ...
+    def get_neighbourhood(self) -> Neighbourhood: ...
     def shuffle(self, rng: XorShift128) -> None: ...
+    def statistics(
+        self,
+    ) -> Dict[
+        str, Union[OperatorStatisticsDict, List[OperatorStatisticsDict]]
+    ]: ...
+    def reset_statistics(self) -> None: ...
     def intensify(
         self,
         solution: Solution,
@@ -27,6 +47,19 @@ class LocalSearch:
     def search(
         self, solution: Solution, cost_evaluator: CostEvaluator
     ) -> Solution: ...
+    def intensify_batch(
+        self,
+        solutions: List[Solution],
+        cost_evaluator: CostEvaluator,
+        overlap_tolerance_degrees: int = 0,
+        num_threads: int = 0,
+    ) -> List[Solution]: ...
+    def search_batch(
+        self,
+        solutions: List[Solution],
+        cost_evaluator: CostEvaluator,
+        num_threads: int = 0,
+    ) -> List[Solution]: ...
     def solHasValidSequences(
         self, solution: Solution
     ) -> bool: ...
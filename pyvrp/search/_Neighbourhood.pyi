@@ -0,0 +1,34 @@
+from typing import List, overload
+
+from pyvrp._ProblemData import ProblemData
+
+class Neighbourhood:
+    @overload
+    def __init__(self, neighbours: List[List[int]]) -> None: ...
+    @overload
+    def __init__(self, offsets: List[int], indices: List[int]) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, client: int) -> List[int]: ...
+    def num_neighbours(self) -> int: ...
+    def offsets(self) -> List[int]: ...
+    def indices(self) -> List[int]: ...
+    def to_lists(self) -> List[List[int]]: ...
+
+class NeighbourhoodParams:
+    def __init__(
+        self,
+        weight_wait_time: float = 0.2,
+        weight_time_warp: float = 1.0,
+        nb_granular: int = 40,
+        symmetric_proximity: bool = True,
+        symmetric_neighbours: bool = False,
+        include_same_store: bool = False,
+        include_same_order: bool = False,
+        num_candidates: int = 0,
+    ) -> None: ...
+
+def compute_neighbourhood(
+    data: ProblemData,
+    params: NeighbourhoodParams,
+    num_threads: int = 0,
+) -> Neighbourhood: ...
@@ -0,0 +1,26 @@
+from pyvrp import ProblemData
+
+class Node:
+    def __init__(self, data: ProblemData, client: int) -> None: ...
+    @property
+    def client(self) -> int: ...
+    @property
+    def position(self) -> int: ...
+    def is_depot(self) -> bool: ...
+
+class Route:
+    def __init__(self, data: ProblemData, idx: int = 0) -> None: ...
+    @property
+    def idx(self) -> int: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, position: int) -> Node: ...
+    def append(self, node: Node) -> None: ...
+    def insert(self, position: int, node: Node) -> None: ...
+    def remove(self, position: int) -> None: ...
+    def update(self) -> None: ...
+    def store_count(self) -> int: ...
+    def stores_between(self, start: int, end: int) -> int: ...
+    def stores_only_between(self, start: int, end: int) -> int: ...
+    def visits_store_outside(
+        self, store: int, start: int, end: int
+    ) -> bool: ...
@@ -1,4 +1,4 @@
-from .LocalSearch import LocalSearch
+from .LocalSearch import LocalSearch, OperatorStatistics
 from ._Exchange import (
     Exchange10,
     Exchange11,
@@ -14,7 +14,13 @@ from ._MoveTwoClientsReversed import MoveTwoClientsReversed
 from ._RelocateStar import RelocateStar
 from ._SwapStar import SwapStar
 from ._TwoOpt import TwoOpt
-from .neighbourhood import NeighbourhoodParams, Neighbours, compute_neighbours
+from .neighbourhood import (
+    Neighbourhood,
+    NeighbourhoodParams,
+    Neighbours,
+    compute_neighbourhood,
+    compute_neighbours,
+)
 
 NODE_OPERATORS = [
     Exchange10,
@@ -1,12 +1,14 @@
 from __future__ import annotations
 
-from dataclasses import dataclass
+from dataclasses import asdict, dataclass
 from typing import List
 
-import numpy as np
-
 from pyvrp._ProblemData import ProblemData
 
+from ._Neighbourhood import Neighbourhood
+from ._Neighbourhood import NeighbourhoodParams as _NeighbourhoodParams
+from ._Neighbourhood import compute_neighbourhood as _compute_neighbourhood
+
 Neighbours = List[List[int]]
 
 
@@ -36,11 +38,29 @@ class NeighbourhoodParams:
         Whether to symmetrise the neighbourhood structure. This ensures that
         when edge :math:`(i, j)` is in, then so is :math:`(j, i)`. Note that
         this is *not* the same as ``symmetric_proximity``.
+    include_same_store
+        Whether to include all other clients of the same store in each
+        client's neighbourhood, in addition to the ``nb_granular`` nearest
+        clients. Clients with the default store index -1 do not share a store.
+    include_same_order
+        Whether to include all other clients of the same order in each
+        client's neighbourhood, in addition to the ``nb_granular`` nearest
+        clients.
+    num_candidates
+        When positive, proximity is only calculated between each client and
+        the ``num_candidates`` clients nearest to it by Euclidean distance
+        between their coordinates. These are found using a k-d tree, which
+        avoids calculating the proximity between all pairs of clients. This
+        gives the same neighbourhood as the default of zero, which considers
+        all clients, when each client's nearest clients by proximity are among
+        its candidates. That is typically the case when the instance's
+        distances are Euclidean, and the time windows are not too tight.
 
     Raises
     ------
     ValueError
-        When ``nb_granular`` is non-positive.
+        When ``nb_granular`` is non-positive, or ``num_candidates`` is positive
+        but smaller than ``nb_granular``.
     """
 
     weight_wait_time: float = 0.2
@@ -48,17 +68,36 @@ class NeighbourhoodParams:
     nb_granular: int = 40
     symmetric_proximity: bool = True
     symmetric_neighbours: bool = False
+    include_same_store: bool = False
+    include_same_order: bool = False
+    num_candidates: int = 0
 
     def __post_init__(self):
         if self.nb_granular <= 0:
             raise ValueError("nb_granular <= 0 not understood.")
 
+        if 0 < self.num_candidates < self.nb_granular:
+            raise ValueError("num_candidates < nb_granular not understood.")
 
-def compute_neighbours(
-    data: ProblemData, params: NeighbourhoodParams = NeighbourhoodParams()
-) -> Neighbours:
+
+def compute_neighbourhood(
+    data: ProblemData,
+    params: NeighbourhoodParams = NeighbourhoodParams(),
+    num_threads: int = 0,
+) -> Neighbourhood:
     """
-    Computes neighbours defining the neighbourhood for a problem instance.
+    Computes the granular neighbourhood for a problem instance. Each client's
+    neighbourhood contains the ``nb_granular`` other clients with the smallest
+    proximity, which is based on Vidal et al. (2013) [1]_. Ties are broken by
+    client index. The neighbours of each client are sorted by proximity, or by
+    client index when the neighbourhood is symmetrised.
+
+    The neighbourhood is computed natively and in parallel, and is stored in a
+    compact format. Proximities are computed one client at a time, so the
+    memory used is linear in the size of the neighbourhood, rather than
+    quadratic in the number of clients. The time needed is quadratic in the
+    number of clients, unless ``params.num_candidates`` is set, in which case
+    it is :math:`O(n \\log n)`. For very large instances, that is much faster.
 
     Parameters
     ----------
@@ -66,100 +105,45 @@ def compute_neighbours(
         ProblemData for which to compute the neighbourhood.
     params
         NeighbourhoodParams that define how the neighbourhood is computed.
+    num_threads
+        Number of threads to use. Defaults to the number of hardware threads
+        when zero.
 
     Returns
     -------
-    Neighbours
-        A list of list of integers representing the neighbours for each client.
-        The first element represents the depot and is an empty list.
-    """
-    proximity = _compute_proximity(
-        data,
-        params.weight_wait_time,
-        params.weight_time_warp,
-    )
+    Neighbourhood
+        The neighbourhood structure. This can be passed to the
+        :class:`~pyvrp.search.LocalSearch.LocalSearch` directly.
 
-    if params.symmetric_proximity:
-        proximity = np.minimum(proximity, proximity.T)
-
-    n = len(proximity)
-    k = min(params.nb_granular, n - 2)  # excl. depot and self
-
-    np.fill_diagonal(proximity, np.inf)  # cannot be in own neighbourhood
-    proximity[0, :] = np.inf  # depot has no neighbours
-    proximity[:, 0] = np.inf  # clients do not neighbour depot
-
-    top_k = np.argsort(proximity, axis=1, kind="stable")[1:, :k]  # excl. depot
-
-    if not params.symmetric_neighbours:
-        return [[]] + top_k.tolist()
-
-    # Construct a symmetric adjacency matrix and return the adjacent clients
-    # as the neighbourhood structure.
-    adj = np.zeros_like(proximity, dtype=bool)
-    rows = np.expand_dims(np.arange(1, n), axis=1)
-    adj[rows, top_k] = True
-    adj = adj | adj.transpose()
-
-    return [np.flatnonzero(row).tolist() for row in adj]
+    References
+    ----------
+    .. [1] Vidal, T., Crainic, T. G., Gendreau, M., and Prins, C. (2013). A
+           hybrid genetic algorithm with adaptive diversity management for a
+           large class of vehicle routing problems with time-windows.
+           *Computers & Operations Research*, 40(1), 475 - 489.
+    """
+    cpp_params = _NeighbourhoodParams(**asdict(params))
+    return _compute_neighbourhood(data, cpp_params, num_threads)
 
 
-def _compute_proximity(
-    data: ProblemData, weight_wait_time: float, weight_time_warp: float
-) -> np.ndarray[float]:
+def compute_neighbours(
+    data: ProblemData, params: NeighbourhoodParams = NeighbourhoodParams()
+) -> Neighbours:
     """
-    Computes proximity for neighborhood. Proximity is based on Vidal et al.
-    (2013).
+    Computes neighbours defining the neighbourhood for a problem instance. See
+    :func:`~compute_neighbourhood` for details.
 
     Parameters
     ----------
     data
-        ProblemData for which to compute proximity.
+        ProblemData for which to compute the neighbourhood.
     params
-        NeighbourhoodParams that define how proximity is computed.
+        NeighbourhoodParams that define how the neighbourhood is computed.
 
     Returns
     -------
-    np.ndarray[float]
-        A numpy array of size n x n where n = data.num_clients containing
-        the proximities values between all clients (depot excluded).
-
-    References
-    ----------
-    .. [1] Vidal, T., Crainic, T. G., Gendreau, M., and Prins, C. (2013). A
-           hybrid genetic algorithm with adaptive diversity management for a
-           large class of vehicle routing problems with time-windows.
-           *Computers & Operations Research*, 40(1), 475 - 489.
+    Neighbours
+        A list of list of integers representing the neighbours for each client.
+        The first element represents the depot and is an empty list.
     """
-    dim = data.num_clients + 1
-    clients = [data.client(idx) for idx in range(dim)]
-
-    earliest = np.array([client.tw_early for client in clients])
-    latest = np.array([client.tw_late for client in clients])
-    service = np.array([client.service_duration for client in clients])
-    prizes = np.array([client.prize for client in clients])
-    durations = np.array(
-        [[data.duration(i, j) for j in range(dim)] for i in range(dim)],
-        dtype=float,
-    )
-
-    min_wait_time = np.maximum(
-        earliest[None, :] - durations - service[:, None] - latest[:, None], 0
-    )
-
-    min_time_warp = np.maximum(
-        earliest[:, None] + service[:, None] + durations - latest[None, :],
-        0,
-    )
-
-    distances = np.array(
-        [[data.dist(i, j) for j in range(dim)] for i in range(dim)],
-        dtype=float,
-    )
-
-    return (
-        distances
-        + weight_wait_time * min_wait_time
-        + weight_time_warp * min_time_warp
-        - prizes[None, :]
-    )
+    return compute_neighbourhood(data, params).to_lists()
@@ -1,3 +1,5 @@
+from concurrent.futures import ThreadPoolExecutor
+
 from numpy.testing import assert_, assert_equal, assert_raises
 from pytest import mark
 
@@ -8,6 +10,8 @@ from pyvrp.search import (
     LocalSearch,
     NeighbourhoodParams,
     Neighbours,
+    SwapStar,
+    compute_neighbourhood,
     compute_neighbours,
 )
 from pyvrp.search._LocalSearch import LocalSearch as cpp_LocalSearch
@@ -211,3 +215,165 @@ def test_cpp_shuffle_results_in_different_solution():
     ls.shuffle(rng)
     improved3 = ls.search(sol, cost_evaluator)
     assert_(improved3 != improved1)
+
+
+def test_operator_statistics():
+    data = read("data/OkSmall.txt")
+    rng = XorShift128(seed=42)
+    cost_evaluator = CostEvaluator(20, 6)
+
+    ls = LocalSearch(data, rng, compute_neighbours(data))
+    ls.add_node_operator(Exchange10(data))
+    ls.add_node_operator(Exchange11(data))
+
+    # Nothing has been evaluated yet, so all counters should be zero.
+    stats = ls.statistics()
+    expected = {"Exchange10", "Exchange11", "insert", "remove"}
+    assert_equal(set(stats.keys()), expected)
+
+    for op_stats in stats.values():
+        assert_equal(op_stats.num_evaluations, 0)
+        assert_equal(op_stats.num_applied, 0)
+
+    sol = Solution.make_random(data, rng)
+    improved = ls.search(sol, cost_evaluator)
+
+    stats = ls.statistics()
+    assert_(stats["Exchange10"].num_evaluations > 0)
+    assert_(stats["Exchange11"].num_evaluations > 0)
+
+    # Every applied node operator move is improving, and the deltas of the
+    # applied moves sum to the total improvement in cost.
+    total_delta = 0
+    for op_stats in stats.values():
+        assert_(op_stats.num_applied <= op_stats.num_improving)
+        assert_(op_stats.num_improving <= op_stats.num_evaluations)
+        assert_(op_stats.total_delta <= 0)
+        total_delta += op_stats.total_delta
+
+    sol_cost = cost_evaluator.penalised_cost(sol)
+    improved_cost = cost_evaluator.penalised_cost(improved)
+    assert_equal(total_delta, improved_cost - sol_cost)
+
+    # After resetting, the counters should be back at zero.
+    ls.reset_statistics()
+    for op_stats in ls.statistics().values():
+        assert_equal(op_stats.num_evaluations, 0)
+        assert_equal(op_stats.total_delta, 0)
+
+
+def test_local_search_in_parallel_threads():
+    """
+    Tests that independent local search objects can run from separate threads,
+    and give the same results as when run sequentially.
+    """
+    data = read("data/RC208.txt", "solomon", round_func="trunc")
+    cost_evaluator = CostEvaluator(20, 6)
+    neighbours = compute_neighbours(data)
+
+    def improve(seed: int) -> Solution:
+        rng = XorShift128(seed=seed)
+        ls = LocalSearch(data, rng, neighbours)
+        ls.add_node_operator(Exchange10(data))
+        ls.add_node_operator(Exchange11(data))
+
+        sol = Solution.make_random(data, rng)
+        return ls.search(sol, cost_evaluator)
+
+    seeds = list(range(8))
+    sequential = [improve(seed) for seed in seeds]
+
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        parallel = list(executor.map(improve, seeds))
+
+    assert_equal(parallel, sequential)
+
+
+@mark.parametrize("num_threads", [0, 1, 3])
+def test_search_batch_same_as_sequential_search(num_threads: int):
+    """
+    Tests that the batch search gives the same results and statistics as
+    searching each solution in turn, with the same evaluation order.
+    """
+    data = read("data/RC208.txt", "solomon", round_func="trunc")
+    rng = XorShift128(seed=42)
+    cost_evaluator = CostEvaluator(20, 6)
+
+    ls = cpp_LocalSearch(data, compute_neighbours(data))
+    ls.add_node_operator(Exchange10(data))
+    ls.add_node_operator(Exchange11(data))
+    ls.shuffle(rng)
+
+    sols = [Solution.make_random(data, rng) for _ in range(8)]
+    batch = ls.search_batch(sols, cost_evaluator, num_threads)
+    batch_stats = ls.statistics()
+
+    ls.reset_statistics()
+    sequential = [ls.search(sol, cost_evaluator) for sol in sols]
+
+    assert_equal(batch, sequential)
+
+    # Evaluation ticks are not compared, since these measure time.
+    seq_stats = ls.statistics()
+    for batch_op, seq_op in zip(
+        batch_stats["node_operators"], seq_stats["node_operators"]
+    ):
+        assert_equal(batch_op["num_evaluations"], seq_op["num_evaluations"])
+        assert_equal(batch_op["num_applied"], seq_op["num_applied"])
+        assert_equal(batch_op["total_delta"], seq_op["total_delta"])
+
+    # An empty batch has nothing to improve.
+    assert_equal(ls.search_batch([], cost_evaluator, num_threads), [])
+
+
+def test_run_batch_raises_when_intensify_flags_do_not_match():
+    data = read("data/OkSmall.txt")
+    rng = XorShift128(seed=42)
+
+    ls = LocalSearch(data, rng, compute_neighbours(data))
+    ls.add_node_operator(Exchange10(data))
+
+    sols = [Solution.make_random(data, rng) for _ in range(2)]
+    with assert_raises(ValueError):
+        ls.run_batch(sols, CostEvaluator(20, 6), [True])
+
+
+@mark.parametrize(
+    ("tolerance", "evaluated"), [(0, False), (2, False), (5, True), (360, True)]
+)
+def test_intensify_overlap_tolerance_degrees(tolerance: int, evaluated: bool):
+    """
+    Tests that intensify only evaluates route pairs whose circle sectors
+    overlap, with the given tolerance in degrees.
+    """
+    data = read("data/OkSmall.txt")
+    rng = XorShift128(seed=42)
+
+    ls = LocalSearch(data, rng, compute_neighbours(data))
+    ls.add_route_operator(SwapStar(data))
+
+    # Seen from the depot, the sector of the first route is [164.8, 180.2]
+    # degrees, and that of the second [184.4, 186.4]. There is thus a gap of
+    # 4.2 degrees between them.
+    sol = Solution(data, [[1, 3], [2, 4]])
+    ls.intensify(sol, CostEvaluator(20, 6), tolerance)
+
+    num_evaluations = ls.statistics()["SwapStar"].num_evaluations
+    assert_equal(num_evaluations > 0, evaluated)
+
+
+def test_local_search_set_get_neighbourhood():
+    data = read("data/RC208.txt", "solomon", round_func="trunc")
+    rng = XorShift128(seed=42)
+
+    params = NeighbourhoodParams(nb_granular=1)
+    ls = LocalSearch(data, rng, compute_neighbourhood(data, params))
+    assert_equal(ls.get_neighbours(), compute_neighbours(data, params))
+
+    # Setting a Neighbourhood object directly should result in the same
+    # neighbours as setting its list of lists representation.
+    neighbourhood = compute_neighbourhood(data)
+    ls.set_neighbours(neighbourhood)
+    assert_equal(ls.get_neighbours(), neighbourhood.to_lists())
+    assert_equal(ls.get_neighbourhood().offsets(), neighbourhood.offsets())
+    assert_equal(ls.get_neighbourhood().indices(), neighbourhood.indices())
@@ -0,0 +1,185 @@
+import numpy as np
+from numpy.testing import assert_, assert_equal, assert_raises
+from pytest import fixture, mark
+
+from pyvrp import Client, ProblemData
+from pyvrp.search._Route import Node, Route
+
+STORES = [-1, 0, 1, 0, 2, 1, 0]  # store of each client; the depot has none
+
+
+@fixture
+def data():
+    mat = np.array([[abs(i - j) for j in range(7)] for i in range(7)])
+    return ProblemData(
+        clients=[
+            Client(x=idx, y=0, clientStore=s) for idx, s in enumerate(STORES)
+        ],
+        num_vehicles=1,
+        weight_cap=10,
+        volume_cap=10,
+        salvage_cap=10,
+        order_route_lim=10,
+        route_store_lim=10,
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+
+@fixture
+def route(data):
+    """
+    Route visiting clients 1 - 6 in order, so that stores 0, 1, 0, 2, 1, 0
+    are visited at positions 1 - 6.
+    """
+    route = Route(data)
+    for client in range(1, 7):
+        route.append(Node(data, client))
+
+    route.update()
+    return route
+
+
+def test_empty_route(data):
+    route = Route(data)
+    assert_equal(len(route), 0)
+    assert_equal(route.store_count(), 0)
+    assert_equal(route.stores_between(1, 0), 0)
+    assert_equal(route.stores_only_between(1, 0), 0)
+
+    for store in range(3):
+        assert_(not route.visits_store_outside(store, 1, 0))
+
+
+def test_route_positions(route):
+    assert_equal(len(route), 6)
+    assert_(route[0].is_depot())
+    assert_(route[7].is_depot())
+
+    for position in range(1, 7):
+        assert_equal(route[position].client, position)
+        assert_equal(route[position].position, position)
+
+    with assert_raises(IndexError):
+        route[8]
+
+
+@mark.parametrize(
+    ("start", "end", "expected"),
+    [
+        (1, 6, 3),  # full route
+        (1, 1, 1),  # prefixes
+        (1, 2, 2),
+        (1, 3, 2),
+        (4, 6, 3),  # suffixes
+        (5, 6, 2),
+        (6, 6, 1),
+        (2, 3, 2),  # middle segments
+        (3, 3, 1),
+        (3, 5, 3),
+        (4, 3, 0),  # empty segments
+        (1, 0, 0),
+        (7, 6, 0),
+    ],
+)
+def test_stores_between(route, start: int, end: int, expected: int):
+    assert_equal(route.store_count(), 3)
+    assert_equal(route.stores_between(start, end), expected)
+
+
+@mark.parametrize(
+    ("start", "end", "expected"),
+    [
+        (1, 6, 3),  # full route
+        (1, 3, 0),  # prefix: stores 0 and 1 are also visited later
+        (1, 5, 2),  # prefix: store 0 is also visited at position 6
+        (4, 6, 1),  # suffix: stores 0 and 1 are also visited earlier
+        (2, 6, 2),  # suffix: only store 0 is also visited at position 1
+        (4, 4, 1),  # middle: store 2 is only visited at position 4
+        (2, 5, 2),  # middle: store 0 is also visited at positions 1 and 6
+        (3, 3, 0),  # middle: store 0 is visited several times
+        (3, 2, 0),  # empty segments
+        (1, 0, 0),
+        (7, 6, 0),
+    ],
+)
+def test_stores_only_between(route, start: int, end: int, expected: int):
+    assert_equal(route.stores_only_between(start, end), expected)
+
+
+@mark.parametrize(
+    ("store", "start", "end", "expected"),
+    [
+        (0, 1, 6, False),  # nothing is outside the full route
+        (0, 2, 5, True),  # store 0 is also visited at positions 1 and 6
+        (0, 1, 5, True),  # prefix: store 0 is also visited at position 6
+        (0, 2, 6, True),  # suffix: store 0 is also visited at position 1
+        (1, 2, 5, False),  # store 1 is only visited at positions 2 and 5
+        (1, 1, 2, True),
+        (2, 4, 4, False),
+        (2, 1, 3, True),
+        (2, 5, 6, True),
+        (0, 4, 3, True),  # empty segments: every visit is outside
+        (2, 1, 0, True),
+    ],
+)
+def test_visits_store_outside(route, store, start, end, expected):
+    assert_equal(route.visits_store_outside(store, start, end), expected)
+
+
+def test_store_data_after_remove(route):
+    route.remove(4)  # the only visit to store 2
+    route.update()
+
+    assert_equal(len(route), 5)
+    assert_equal(route.store_count(), 2)
+    assert_equal(route.stores_between(1, 5), 2)
+    assert_equal(route.stores_between(3, 5), 2)
+    assert_equal(route.stores_only_between(1, 5), 2)
+    assert_(not route.visits_store_outside(2, 1, 0))
+
+    route.remove(1)  # one of three visits to store 0
+    route.update()
+
+    # Now stores 1, 0, 1, 0 are visited at positions 1 - 4.
+    assert_equal(route.store_count(), 2)
+    assert_equal(route.stores_between(1, 2), 2)
+    assert_equal(route.stores_only_between(1, 2), 0)
+    assert_equal(route.stores_only_between(1, 3), 1)  # store 0 is also at 4
+    assert_(route.visits_store_outside(0, 1, 3))
+    assert_(not route.visits_store_outside(0, 1, 4))
+
+
+def test_store_data_after_insert(data, route):
+    route.remove(4)
+    route.update()
+
+    route.insert(1, Node(data, 4))  # store 2, now at the start of the route
+    route.update()
+
+    assert_equal(len(route), 6)
+    assert_equal(route[1].client, 4)
+    assert_equal(route.store_count(), 3)
+    assert_equal(route.stores_between(1, 1), 1)
+    assert_equal(route.stores_only_between(1, 1), 1)
+    assert_equal(route.stores_between(2, 6), 2)
+    assert_(not route.visits_store_outside(2, 1, 1))
+    assert_(route.visits_store_outside(2, 2, 6))
+
+    route.insert(7, Node(data, 4))  # a second visit to store 2, at the end
+    route.update()
+
+    assert_equal(len(route), 7)
+    assert_equal(route.store_count(), 3)
+    assert_equal(route.stores_only_between(1, 1), 0)
+    assert_equal(route.stores_only_between(1, 6), 2)
+    assert_(route.visits_store_outside(2, 1, 6))
+    assert_(route.visits_store_outside(2, 2, 7))
+
+
+def test_insert_raises_for_node_in_route(data, route):
+    with assert_raises(ValueError):
+        route.insert(1, route[3])
+
+    with assert_raises(IndexError):
+        route.insert(8, Node(data, 4))
@@ -0,0 +1,60 @@
+from numpy.testing import assert_equal
+from pytest import mark
+
+from pyvrp import CostEvaluator, MatrixStorage, Solution, XorShift128
+from pyvrp.search import (
+    LocalSearch,
+    RelocateStar,
+    SwapStar,
+    compute_neighbours,
+)
+from pyvrp.tests.helpers import read, with_matrix_storage
+
+# The route operators evaluate insertions from a route snapshot. With dense
+# matrices, that uses the vectorised kernel on CPUs that support it. With any
+# other layout, it always uses the scalar loop.
+INSTANCES = [
+    ("data/OkSmall.txt", {}),
+    ("data/E-n22-k4.txt", {"round_func": "dimacs"}),
+    ("data/RC208.txt", {"instance_format": "solomon", "round_func": "dimacs"}),
+    ("data/p06-2-50.vrp", {"round_func": "dimacs"}),
+]
+
+
+def _intensify(data, operator, num_solutions: int = 10):
+    rng = XorShift128(seed=42)
+    ls = LocalSearch(data, rng, compute_neighbours(data))
+    ls.add_route_operator(operator(data))
+
+    cost_evaluator = CostEvaluator(
+        weight_capacity_penalty=20,
+        volume_capacity_penalty=20,
+        tw_penalty=6,
+    )
+
+    routes = []
+    for _ in range(num_solutions):
+        sol = Solution.make_random(data, rng)
+        improved = ls.intensify(sol, cost_evaluator)
+        routes.append([route.visits() for route in improved.get_routes()])
+
+    return routes
+
+
+@mark.parametrize("operator", [RelocateStar, SwapStar])
+@mark.parametrize(("where", "kwargs"), INSTANCES)
+def test_vectorised_and_scalar_insertions_agree(operator, where, kwargs):
+    """
+    Tests that the vectorised and scalar insertion kernels find the same
+    moves, by intensifying the same random solutions with the same instance
+    in a dense layout, and in an interleaved layout that forces the scalar
+    kernel. This runs in both precisions, since the test suite does.
+    """
+    dense = read(where, **kwargs)
+    interleaved = with_matrix_storage(dense, MatrixStorage.INTERLEAVED)
+
+    assert_equal(dense.matrix_storage, MatrixStorage.DENSE)
+    assert_equal(
+        _intensify(dense, operator),
+        _intensify(interleaved, operator),
+    )
@@ -1,7 +1,8 @@
+import numpy as np
 from numpy.testing import assert_, assert_equal
 from pytest import mark
 
-from pyvrp import CostEvaluator, Solution, XorShift128
+from pyvrp import Client, CostEvaluator, ProblemData, Solution, XorShift128
 from pyvrp.search import (
     Exchange11,
     LocalSearch,
@@ -73,3 +74,104 @@ def test_swap_star_on_RC208_instance(seed: int):
     current_cost = cost_evaluator.penalised_cost(sol)
     improved_cost = cost_evaluator.penalised_cost(improved_sol)
     assert_(improved_cost < current_cost)
+
+
+def _intensify(data, solutions, rng, reuse: bool):
+    """
+    Intensifies each of the given solutions with SWAP*. When ``reuse`` is set,
+    a single operator is used for all solutions, so that its cached insertion
+    points carry over between solutions and between moves. Otherwise, each
+    solution gets a fresh operator with an empty cache. The given rng is used
+    to shuffle the evaluation order, so both shuffle identically.
+    """
+    cost_evaluator = CostEvaluator(tw_penalty=6)
+    neighbours = compute_neighbours(data)
+
+    def make_local_search():
+        ls = LocalSearch(data, rng, neighbours)
+        ls.add_route_operator(SwapStar(data))
+        return ls
+
+    ls = make_local_search()
+    routes = []
+
+    for sol in solutions:
+        if not reuse:
+            ls = make_local_search()
+
+        improved = ls.intensify(
+            sol, cost_evaluator, overlap_tolerance_degrees=360
+        )
+        routes.append([route.visits() for route in improved.get_routes()])
+
+    return routes
+
+
+def test_swap_star_cache_does_not_change_moves():
+    """
+    Tests that SWAP* finds the same moves when its insertion cache is reused
+    over many solutions, as when it starts from an empty cache for each. Every
+    solution makes all cached insertion points stale, so this would not hold if
+    stale entries were ever returned.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    sols = [Solution.make_random(data, rng) for _ in range(10)]
+
+    reused = _intensify(data, sols, XorShift128(seed=1), reuse=True)
+    fresh = _intensify(data, sols, XorShift128(seed=1), reuse=False)
+    assert_equal(reused, fresh)
+
+
+def test_swap_star_on_routes_exceeding_cache_capacity():
+    """
+    Tests SWAP* on two long routes. Each route's insertion cache is then asked
+    for more clients than it can hold, so it grows, rehashes, and is cleared
+    when full. The clients lie on two parallel lines, one per route, except
+    for a few pairs that were swapped between the routes. SWAP* should swap
+    those back, both with a reused and with a fresh cache.
+    """
+    size = 600  # clients per route; well over half the cache's capacity
+    clients = [Client(x=0, y=0)]
+    clients += [Client(x=idx, y=10) for idx in range(1, size + 1)]
+    clients += [Client(x=idx, y=-10) for idx in range(1, size + 1)]
+
+    # Manhattan distances between all clients.
+    coords = np.array([(client.x, client.y) for client in clients])
+    diff = coords[:, np.newaxis, :] - coords[np.newaxis, :, :]
+    dist = np.abs(diff).sum(axis=2)
+
+    data = ProblemData(
+        clients=clients,
+        num_vehicles=2,
+        weight_cap=0,
+        volume_cap=0,
+        salvage_cap=0,
+        order_route_lim=1,
+        route_store_lim=1,
+        distance_matrix=dist,
+        duration_matrix=np.zeros_like(dist),
+    )
+
+    top = list(range(1, size + 1))
+    bottom = list(range(size + 1, 2 * size + 1))
+    for idx in [50, 200, 400]:
+        top[idx], bottom[idx] = bottom[idx], top[idx]
+
+    # The same solution twice, so that the reused cache is stale the second
+    # time around.
+    sols = 2 * [Solution(data, [top, bottom])]
+
+    reused = _intensify(data, sols, XorShift128(seed=1), reuse=True)
+    fresh = _intensify(data, sols, XorShift128(seed=1), reuse=False)
+    assert_equal(reused, fresh)
+
+    for routes in reused:
+        assert_equal(len(routes), 2)
+
+        # Each route now visits the clients of a single line again.
+        on_line = {tuple(sorted(route)) for route in routes}
+        assert_equal(
+            on_line,
+            {tuple(range(1, size + 1)), tuple(range(size + 1, 2 * size + 1))},
+        )
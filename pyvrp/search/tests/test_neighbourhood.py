@@ -4,7 +4,13 @@ import numpy as np
 from numpy.testing import assert_, assert_equal, assert_raises
 from pytest import mark
 
-from pyvrp.search import NeighbourhoodParams, compute_neighbours
+from pyvrp import Client, ProblemData
+from pyvrp.search import (
+    Neighbourhood,
+    NeighbourhoodParams,
+    compute_neighbourhood,
+    compute_neighbours,
+)
 from pyvrp.tests.helpers import read
 
 
@@ -179,3 +185,148 @@ def test_proximity_with_prizes():
     count_20 = sum(20 in n for n in neighbours)
     count_36 = sum(36 in n for n in neighbours)
     assert_(count_20 > count_36)
+
+
+@mark.parametrize("symmetric_neighbours", [True, False])
+def test_compute_neighbourhood_same_as_compute_neighbours(
+    symmetric_neighbours: bool,
+):
+    data = read("data/RC208.txt", "solomon", "trunc1")
+    params = NeighbourhoodParams(symmetric_neighbours=symmetric_neighbours)
+    neighbours = compute_neighbours(data, params)
+
+    # The number of threads used should not affect the neighbourhood.
+    for num_threads in [1, 3, 8]:
+        neighbourhood = compute_neighbourhood(data, params, num_threads)
+        assert_equal(neighbourhood.to_lists(), neighbours)
+
+
+def test_neighbourhood_csr_layout():
+    neighbourhood = Neighbourhood([[], [2, 3], [1], [1, 2]])
+
+    assert_equal(len(neighbourhood), 4)
+    assert_equal(neighbourhood.num_neighbours(), 5)
+    assert_equal(neighbourhood.offsets(), [0, 0, 2, 3, 5])
+    assert_equal(neighbourhood.indices(), [2, 3, 1, 1, 2])
+    assert_equal(neighbourhood[3], [1, 2])
+
+    # Constructing from the CSR arrays directly results in the same structure.
+    other = Neighbourhood([0, 0, 2, 3, 5], [2, 3, 1, 1, 2])
+    assert_equal(other.to_lists(), neighbourhood.to_lists())
+
+    with assert_raises(IndexError):
+        neighbourhood[4]
+
+
+@mark.parametrize(
+    "offsets,indices",
+    [
+        ([], []),  # no offsets at all
+        ([1, 1], [2]),  # does not start at zero
+        ([0, 2, 1], [1, 2]),  # decreasing offsets
+        ([0, 1], [1, 2]),  # does not end at the number of indices
+    ],
+)
+def test_neighbourhood_raises_for_invalid_csr_arrays(offsets, indices):
+    with assert_raises(ValueError):
+        Neighbourhood(offsets, indices)
+
+
+def test_neighbourhood_includes_same_store_and_order():
+    mat = np.array([[abs(i - j) for j in range(7)] for i in range(7)])
+    data = ProblemData(
+        clients=[
+            Client(x=0, y=0),
+            Client(x=1, y=0, clientOrder=0, clientStore=0),
+            Client(x=2, y=0, clientStore=1),
+            Client(x=3, y=0, clientStore=1),
+            Client(x=4, y=0),
+            Client(x=5, y=0, clientOrder=0),
+            Client(x=6, y=0, clientStore=0),
+        ],
+        num_vehicles=2,
+        weight_cap=10,
+        volume_cap=10,
+        salvage_cap=10,
+        order_route_lim=1,
+        route_store_lim=10,
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    # Only the nearest client is a neighbour by default.
+    params = NeighbourhoodParams(0, 0, nb_granular=1)
+    assert_equal(compute_neighbourhood(data, params)[1], [2])
+
+    # But client 6 shares a store with client 1, and client 5 shares an order.
+    # These are added after the nearest client, in order of proximity.
+    params = NeighbourhoodParams(0, 0, 1, include_same_store=True)
+    assert_equal(compute_neighbourhood(data, params)[1], [2, 6])
+
+    params = NeighbourhoodParams(0, 0, 1, include_same_order=True)
+    assert_equal(compute_neighbourhood(data, params)[1], [2, 5])
+
+    params = NeighbourhoodParams(
+        0, 0, 1, include_same_store=True, include_same_order=True
+    )
+    assert_equal(compute_neighbourhood(data, params)[1], [2, 5, 6])
+
+    # Client 3's nearest client is client 2, which is also its store neighbour.
+    # That client should not be included twice. Client 4 is not in a store.
+    neighbourhood = compute_neighbourhood(data, params)
+    assert_equal(neighbourhood[3], [2])
+    assert_equal(neighbourhood[4], [3])
+
+
+@mark.parametrize("nb_granular,num_candidates", [(10, 9), (40, 1)])
+def test_neighbourhood_params_raises_for_too_few_candidates(
+    nb_granular: int, num_candidates: int
+):
+    with assert_raises(ValueError):
+        NeighbourhoodParams(
+            nb_granular=nb_granular, num_candidates=num_candidates
+        )
+
+
+@mark.parametrize("symmetric_neighbours", [True, False])
+def test_candidate_neighbourhood_same_as_exact_with_enough_candidates(
+    symmetric_neighbours: bool,
+):
+    data = read("data/RC208.txt", "solomon", "trunc1")
+    exact = compute_neighbourhood(
+        data, NeighbourhoodParams(symmetric_neighbours=symmetric_neighbours)
+    )
+
+    # With one fewer candidate than there are other clients, the k-d tree is
+    # used, but all nearest clients by proximity are still among each client's
+    # candidates. So the neighbourhood should be the same as the exact one.
+    params = NeighbourhoodParams(
+        symmetric_neighbours=symmetric_neighbours,
+        num_candidates=data.num_clients - 2,
+    )
+
+    for num_threads in [1, 4]:
+        approx = compute_neighbourhood(data, params, num_threads)
+        assert_equal(approx.to_lists(), exact.to_lists())
+
+
+def test_candidate_neighbourhood_uses_nearest_clients():
+    data = read("data/RC208.txt", "solomon", "trunc1")
+    params = NeighbourhoodParams(0, 0, nb_granular=5, num_candidates=5)
+    neighbourhood = compute_neighbourhood(data, params)
+
+    def dist(first: int, second: int) -> float:
+        first_client = data.client(first)
+        second_client = data.client(second)
+        return np.hypot(
+            first_client.x - second_client.x, first_client.y - second_client.y
+        )
+
+    # There are exactly as many candidates as neighbours, so the neighbours
+    # are the clients nearest by Euclidean distance (ties broken by index).
+    clients = np.arange(1, data.num_clients + 1)
+    for client in clients:
+        others = clients[clients != client]
+        dists = [dist(client, other) for other in others]
+        nearest = others[np.argsort(dists, kind="stable")[:5]]
+        assert_equal(set(neighbourhood[client]), set(nearest))
@@ -2,9 +2,12 @@ import pathlib
 import time
 from functools import lru_cache
 
-from pyvrp import Solution
+import numpy as np
+
+from pyvrp import MatrixStorage, ProblemData, Solution
 from pyvrp.read import read as _read
 from pyvrp.read import read_solution as _read_solution
+from pyvrp.search import Exchange10, LocalSearch, compute_neighbours
 
 
 @lru_cache
@@ -43,3 +46,36 @@ def make_random_solutions(num_sols, data, rng):
     Returns a list of ``num_sols`` random solutions.
     """
     return [Solution.make_random(data, rng) for _ in range(num_sols)]
+
+
+def make_local_search(data, rng):
+    """
+    Returns a local search over the default neighbourhood, with only the
+    Exchange10 node operator.
+    """
+    ls = LocalSearch(data, rng, compute_neighbours(data))
+    ls.add_node_operator(Exchange10(data))
+    return ls
+
+
+def with_matrix_storage(data: ProblemData, storage: MatrixStorage):
+    """
+    Returns a copy of the given data that stores its distance and duration
+    matrices in the given layout.
+    """
+    dim = data.num_clients + 1
+    dist = [[data.dist(frm, to) for to in range(dim)] for frm in range(dim)]
+    dur = [[data.duration(frm, to) for to in range(dim)] for frm in range(dim)]
+
+    return ProblemData(
+        clients=[data.client(idx) for idx in range(dim)],
+        num_vehicles=data.num_vehicles,
+        weight_cap=data.weight_capacity,
+        volume_cap=data.volume_capacity,
+        salvage_cap=data.salvage_capacity,
+        order_route_lim=data.order_route_limit,
+        route_store_lim=data.route_store_limit,
+        distance_matrix=np.array(dist),
+        duration_matrix=np.array(dur),
+        matrix_storage=storage,
+    )
@@ -62,6 +62,39 @@ def test_tw_penalty():
     assert_allclose(cost_evaluator.tw_penalty(2), 8)
 
 
+def test_orders_penalty():
+    cost_evaluator = CostEvaluator(orders_penalty=3)
+
+    # No penalty while the order spans at most the limit number of routes.
+    assert_allclose(cost_evaluator.orders_penalty(1, 2), 0)
+    assert_allclose(cost_evaluator.orders_penalty(2, 2), 0)
+
+    # Penalty of 3 for each route beyond the limit.
+    assert_allclose(cost_evaluator.orders_penalty(3, 2), 3)
+    assert_allclose(cost_evaluator.orders_penalty(5, 2), 9)
+
+
+def test_sequence_penalty():
+    cost_evaluator = CostEvaluator(sequence_penalty=7)
+
+    # Penalty of 7 for each pair of clients visited out of sequence.
+    assert_allclose(cost_evaluator.sequence_penalty(0), 0)
+    assert_allclose(cost_evaluator.sequence_penalty(1), 7)
+    assert_allclose(cost_evaluator.sequence_penalty(3), 21)
+
+
+def test_positional_penalties_keep_their_order():
+    """
+    The orders and sequence penalties come after the time warp penalty, so
+    that positional calls that predate them still set the time warp penalty.
+    """
+    cost_evaluator = CostEvaluator(0, 0, 0, 0, 2, 3, 5)
+
+    assert_allclose(cost_evaluator.tw_penalty(1), 2)
+    assert_allclose(cost_evaluator.orders_penalty(3, 2), 3)
+    assert_allclose(cost_evaluator.sequence_penalty(1), 5)
+
+
 def test_cost():
     data = read("data/OkSmall.txt")
     default_cost_evaluator = CostEvaluator()
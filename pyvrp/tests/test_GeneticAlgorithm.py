@@ -91,6 +91,81 @@ def test_params_constructor_does_not_raise_when_arguments_valid(
     assert_equal(params.nb_iter_no_improvement, nb_iter_no_improvement)
 
 
+@mark.parametrize("batch_size,num_threads", [(0, 0), (-1, 0), (1, -1)])
+def test_params_constructor_throws_when_batch_arguments_invalid(
+    batch_size: int, num_threads: int
+):
+    with assert_raises(ValueError):
+        GeneticAlgorithmParams(batch_size=batch_size, num_threads=num_threads)
+
+
+def test_batch_mode_improves_best_solution():
+    """
+    Tests that the genetic algorithm also finds improving solutions when it
+    generates and improves several offspring per iteration.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    pm = PenaltyManager()
+    pop_params = PopulationParams()
+    pop = Population(bpd, params=pop_params)
+    init = make_random_solutions(pop_params.min_pop_size, data, rng)
+
+    ls = LocalSearch(data, rng, compute_neighbours(data))
+    ls.add_node_operator(Exchange10(data))
+
+    ga_params = GeneticAlgorithmParams(
+        intensify_probability=0,
+        intensify_on_best=False,
+        batch_size=4,
+        num_threads=2,
+    )
+    algo = GeneticAlgorithm(
+        data, pm, rng, pop, ls, srex, init, params=ga_params
+    )
+
+    initial_best = algo.run(MaxIterations(0)).best
+    result = algo.run(MaxIterations(10))
+
+    cost_evaluator = pm.get_cost_evaluator()
+    new_best_cost = cost_evaluator.penalised_cost(result.best)
+    initial_best_cost = cost_evaluator.penalised_cost(initial_best)
+    assert_(new_best_cost < initial_best_cost)
+    assert_equal(result.num_iterations, 10)
+
+
+@mark.parametrize("num_threads", [2, 3])
+def test_batch_mode_does_not_depend_on_number_of_threads(num_threads: int):
+    """
+    Tests that batch mode finds the same solutions regardless of the number of
+    threads, also when the local search's threads are reused over many
+    iterations.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+
+    def run(threads: int) -> Solution:
+        rng = XorShift128(seed=42)
+        pop = Population(bpd)
+        init = make_random_solutions(25, data, rng)
+
+        ls = LocalSearch(data, rng, compute_neighbours(data))
+        ls.add_node_operator(Exchange10(data))
+
+        ga_params = GeneticAlgorithmParams(
+            intensify_probability=0,
+            intensify_on_best=False,
+            batch_size=4,
+            num_threads=threads,
+        )
+        algo = GeneticAlgorithm(
+            data, PenaltyManager(), rng, pop, ls, srex, init, ga_params
+        )
+
+        return algo.run(MaxIterations(10)).best
+
+    assert_equal(run(num_threads), run(1))
+
+
 def test_raises_when_no_initial_solutions():
     """
     Tests that GeneticAlgorithm raises when no initial solutions are provided,
@@ -0,0 +1,195 @@
+import os
+from concurrent.futures import ProcessPoolExecutor
+
+from numpy.testing import assert_, assert_equal, assert_raises
+
+from pyvrp import (
+    ClientOrdering,
+    attach_instance,
+    load_instance,
+    publish_instance,
+    write_instance,
+)
+from pyvrp.tests.helpers import read
+
+
+def test_write_then_load_returns_same_instance(tmp_path):
+    data = read("data/OkSmall.txt")
+
+    where = tmp_path / "OkSmall.bin"
+    write_instance(data, where)
+    loaded = load_instance(where)
+
+    assert_equal(loaded.num_clients, data.num_clients)
+    assert_equal(loaded.num_vehicles, data.num_vehicles)
+    assert_equal(loaded.weight_capacity, data.weight_capacity)
+    assert_equal(loaded.volume_capacity, data.volume_capacity)
+    assert_equal(loaded.salvage_capacity, data.salvage_capacity)
+    assert_equal(loaded.order_route_limit, data.order_route_limit)
+    assert_equal(loaded.route_store_limit, data.route_store_limit)
+
+    fields = [
+        "x",
+        "y",
+        "demandWeight",
+        "demandVolume",
+        "demandSalvage",
+        "clientOrder",
+        "clientStore",
+        "service_duration",
+        "tw_early",
+        "tw_late",
+        "prize",
+        "required",
+    ]
+
+    for idx in range(data.num_clients + 1):
+        for field in fields:
+            expected = getattr(data.client(idx), field)
+            assert_equal(getattr(loaded.client(idx), field), expected)
+
+    for frm in range(data.num_clients + 1):
+        for to in range(data.num_clients + 1):
+            assert_equal(loaded.dist(frm, to), data.dist(frm, to))
+            assert_equal(loaded.duration(frm, to), data.duration(frm, to))
+
+
+def test_load_accepts_str_paths(tmp_path):
+    data = read("data/OkSmall.txt")
+
+    where = str(tmp_path / "OkSmall.bin")
+    write_instance(data, where)
+
+    assert_equal(load_instance(where).dist(1, 2), data.dist(1, 2))
+
+
+def test_loaded_instance_outlives_other_loads(tmp_path):
+    data = read("data/OkSmall.txt")
+
+    where = tmp_path / "OkSmall.bin"
+    write_instance(data, where)
+
+    # Each load maps the file separately, so dropping one loaded instance
+    # should not affect another.
+    first = load_instance(where)
+    second = load_instance(where)
+    del first
+
+    assert_equal(second.dist(1, 2), data.dist(1, 2))
+
+
+def test_raises_missing_file(tmp_path):
+    with assert_raises(RuntimeError):
+        load_instance(tmp_path / "does not exist.bin")
+
+
+def test_raises_invalid_file(tmp_path):
+    data = read("data/OkSmall.txt")
+
+    where = tmp_path / "OkSmall.bin"
+    write_instance(data, where)
+    contents = where.read_bytes()
+
+    # Empty file, which does not even contain a header.
+    where.write_bytes(b"")
+    with assert_raises(RuntimeError):
+        load_instance(where)
+
+    # Not an instance file: the magic string at the start does not match.
+    where.write_bytes(b"X" + contents[1:])
+    with assert_raises(RuntimeError):
+        load_instance(where)
+
+    # Truncated file, which is smaller than the header says it should be.
+    where.write_bytes(contents[:-1])
+    with assert_raises(RuntimeError):
+        load_instance(where)
+
+    # The original contents are still fine.
+    where.write_bytes(contents)
+    assert_equal(load_instance(where).num_clients, data.num_clients)
+
+
+def test_load_keeps_original_ids_of_renumbered_instance(tmp_path):
+    data = read("data/OkSmall.txt").renumbered(ClientOrdering.HILBERT)
+
+    where = tmp_path / "OkSmall.bin"
+    write_instance(data, where)
+    loaded = load_instance(where)
+
+    for idx in range(data.num_clients + 1):
+        assert_equal(loaded.original_id(idx), data.original_id(idx))
+        assert_equal(loaded.internal_id(idx), data.internal_id(idx))
+
+
+def _segment_name(suffix: str) -> str:
+    # Segment names are shared by all processes on the machine, so they should
+    # be unique to this test process.
+    return f"pyvrp-test-{os.getpid()}-{suffix}"
+
+
+def _attached_distance(name: str, frm: int, to: int) -> int:
+    return attach_instance(name).dist(frm, to)
+
+
+def test_attach_returns_published_instance():
+    data = read("data/OkSmall.txt").renumbered(ClientOrdering.MORTON)
+    segment = publish_instance(data, _segment_name("same"))
+    attached = attach_instance(segment.name)
+
+    assert_equal(segment.name, _segment_name("same"))
+    assert_(segment.size > 0)
+
+    assert_equal(attached.num_clients, data.num_clients)
+    assert_equal(attached.num_vehicles, data.num_vehicles)
+    assert_equal(attached.weight_capacity, data.weight_capacity)
+
+    for frm in range(data.num_clients + 1):
+        assert_equal(attached.client(frm).x, data.client(frm).x)
+        assert_equal(attached.original_id(frm), data.original_id(frm))
+
+        for to in range(data.num_clients + 1):
+            assert_equal(attached.dist(frm, to), data.dist(frm, to))
+            assert_equal(attached.duration(frm, to), data.duration(frm, to))
+
+
+def test_attach_from_other_processes():
+    data = read("data/OkSmall.txt")
+    segment = publish_instance(data, _segment_name("processes"))
+
+    with ProcessPoolExecutor(max_workers=2) as executor:
+        args = [(segment.name, frm, 1) for frm in range(data.num_clients + 1)]
+        dists = list(executor.map(_attached_distance, *zip(*args)))
+
+    assert_equal(dists, [data.dist(frm, 1) for frm in range(len(dists))])
+
+
+def test_attached_instance_outlives_published_segment():
+    data = read("data/OkSmall.txt")
+    segment = publish_instance(data, _segment_name("outlives"))
+    attached = attach_instance(segment.name)
+
+    # Destroying the published segment removes its name, so no new process
+    # can attach to it. But the instance that is already attached stays valid.
+    del segment
+    assert_equal(attached.dist(1, 2), data.dist(1, 2))
+
+    if os.name != "nt":  # on Windows, the name lives as long as any mapping
+        with assert_raises(RuntimeError):
+            attach_instance(_segment_name("outlives"))
+
+
+def test_publish_raises_when_name_is_taken():
+    data = read("data/OkSmall.txt")
+    segment = publish_instance(data, _segment_name("taken"))
+
+    with assert_raises(RuntimeError):
+        publish_instance(data, segment.name)
+
+    # The failed attempt should not have affected the existing segment.
+    assert_equal(attach_instance(segment.name).dist(1, 2), data.dist(1, 2))
+
+
+def test_attach_raises_missing_segment():
+    with assert_raises(RuntimeError):
+        attach_instance(_segment_name("does-not-exist"))
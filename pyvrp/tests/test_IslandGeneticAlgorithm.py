@@ -0,0 +1,105 @@
+import pytest
+from numpy.testing import assert_, assert_equal, assert_raises
+
+from pyvrp import (
+    GeneticAlgorithmParams,
+    IslandGeneticAlgorithm,
+    IslandModelParams,
+    Solution,
+    XorShift128,
+)
+from pyvrp.stop import MaxIterations
+from pyvrp.tests.helpers import (
+    make_local_search,
+    make_random_solutions,
+    read,
+    read_solution,
+)
+
+
+@pytest.mark.parametrize(
+    ("num_islands", "migration_interval"),
+    [
+        (0, 1),  # num_islands < 1
+        (-1, 1),  # num_islands < 1
+        (1, 0),  # migration_interval < 1
+    ],
+)
+def test_params_constructor_throws_when_arguments_invalid(
+    num_islands: int, migration_interval: int
+):
+    with assert_raises(ValueError):
+        IslandModelParams(num_islands, migration_interval)
+
+
+def test_raises_when_no_initial_solutions():
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    ls = make_local_search(data, rng)
+
+    with assert_raises(ValueError):
+        IslandGeneticAlgorithm(data, rng, ls, [])
+
+
+def test_best_initial_solution():
+    """
+    Tests that the island model starts from the best initial solution, and
+    that it does not return anything worse than that.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    ls = make_local_search(data, rng)
+
+    bks = Solution(data, read_solution("data/RC208.sol"))
+    init = [bks] + make_random_solutions(24, data, rng)
+
+    algo = IslandGeneticAlgorithm(data, rng, ls, init)
+    result = algo.run(MaxIterations(0))
+
+    assert_equal(algo.num_islands, IslandModelParams().num_islands)
+    assert_equal(result.best.distance(), bks.distance())
+    assert_(result.best.is_feasible())
+
+
+@pytest.mark.parametrize("num_islands", [1, 3])
+def test_best_solution_improves_with_more_iterations(num_islands: int):
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    init = make_random_solutions(25, data, rng)
+    ls = make_local_search(data, rng)
+
+    params = GeneticAlgorithmParams(
+        collect_statistics=True,
+        intensify_probability=0,
+        intensify_on_best=False,
+    )
+    island_params = IslandModelParams(num_islands, migration_interval=5)
+    algo = IslandGeneticAlgorithm(data, rng, ls, init, params, island_params)
+
+    result = algo.run(MaxIterations(25))
+    assert_(result.best.is_feasible())
+
+    # The best solution is at least as good as the best feasible initial
+    # solution, if there is any.
+    feas_init = [sol.distance() for sol in init if sol.is_feasible()]
+    assert_(result.cost() <= min(feas_init, default=float("inf")))
+
+    # The first island runs exactly 25 iterations. The other islands run
+    # concurrently, and their number of iterations thus varies.
+    assert_(result.num_iterations >= 25)
+
+    # Each island's local search statistics are collected as well.
+    stats = result.stats.operator_stats["Exchange10"]
+    assert_(stats.num_evaluations > 0)
+
+
+def test_raises_when_callback_interval_is_zero():
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    init = make_random_solutions(25, data, rng)
+    ls = make_local_search(data, rng)
+
+    algo = IslandGeneticAlgorithm(data, rng, ls, init)
+
+    with assert_raises(ValueError):
+        algo.run(MaxIterations(1), callback_interval=0)
@@ -1,4 +1,5 @@
-from numpy.testing import assert_equal, assert_raises
+import numpy as np
+from numpy.testing import assert_, assert_equal, assert_raises
 
 from pyvrp._Matrix import Matrix
 
@@ -33,6 +34,12 @@ def test_data_constructor_throws():
     with assert_raises(ValueError):
         Matrix([[1, 2], [1, 2, 3]])  # second row longer than first
 
+    with assert_raises(ValueError):
+        Matrix(np.arange(4))  # one-dimensional, not a matrix
+
+    with assert_raises(ValueError):
+        Matrix(np.zeros((2, 2, 2)))  # three-dimensional, not a matrix
+
 
 def test_element_access():
     mat = Matrix(10)
@@ -46,3 +53,59 @@ def test_element_access():
     assert_equal(mat[1, 1], 1 + 1)  # several elements
     assert_equal(mat[2, 1], 2 + 1)
     assert_equal(mat[1, 2], 1 + 2)
+
+
+def test_buffer_protocol():
+    mat = Matrix([[1, 2, 3], [4, 5, 6]])
+
+    # The matrix exposes its elements as a buffer, so it can be viewed as a
+    # NumPy array without copying.
+    arr = np.asarray(mat)
+    assert_equal(arr.shape, (2, 3))
+    assert_equal(arr, [[1, 2, 3], [4, 5, 6]])
+
+    # The array is a view, so changes to the matrix should be visible in it.
+    mat[1, 2] = 10
+    assert_equal(arr[1, 2], 10)
+
+
+def test_array_constructor_shares_contiguous_int32_arrays():
+    arr = np.array([[1, 2], [3, 4]], dtype=np.int32)
+    mat = Matrix(arr)
+    assert_equal(mat[1, 0], 3)
+
+    # Contiguous arrays of the right type are borrowed, not copied, so both
+    # share the same memory.
+    arr[1, 0] = 5
+    assert_equal(mat[1, 0], 5)
+
+    mat[0, 1] = 7
+    assert_equal(arr[0, 1], 7)
+
+    # The matrix keeps the array alive, even when the array is no longer
+    # referenced elsewhere.
+    del arr
+    assert_equal(mat.max(), 7)
+
+
+def test_array_constructor_converts_other_arrays():
+    # This array has a different element type, and is not contiguous. The
+    # matrix is constructed from a converted copy.
+    arr = np.arange(16, dtype=np.int64).reshape(4, 4)[:, ::2]
+    mat = Matrix(arr)
+
+    assert_equal(mat.num_rows, 4)
+    assert_equal(mat.num_cols, 2)
+    assert_equal(np.asarray(mat), arr)
+
+    arr[0, 0] = 100
+    assert_equal(mat[0, 0], 0)
+
+    # Read-only arrays are also copied, since the matrix may be modified.
+    read_only = np.zeros((2, 2), dtype=np.int32)
+    read_only.flags.writeable = False
+
+    mat = Matrix(read_only)
+    mat[0, 0] = 1
+    assert_(not np.shares_memory(np.asarray(mat), read_only))
+    assert_equal(read_only[0, 0], 0)
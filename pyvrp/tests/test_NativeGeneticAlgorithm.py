@@ -0,0 +1,144 @@
+from numpy.testing import assert_, assert_equal, assert_raises
+
+from pyvrp import (
+    GeneticAlgorithmParams,
+    NativeGeneticAlgorithm,
+    PenaltyParams,
+    PopulationParams,
+    Solution,
+    XorShift128,
+)
+from pyvrp.stop import MaxIterations
+from pyvrp.tests.helpers import (
+    make_local_search,
+    make_random_solutions,
+    read,
+    read_solution,
+)
+
+
+def test_raises_when_no_initial_solutions():
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    ls = make_local_search(data, rng)
+
+    with assert_raises(ValueError):
+        NativeGeneticAlgorithm(data, rng, ls, [])
+
+
+def test_best_initial_solution():
+    """
+    Tests that the native algorithm returns the best initial solution when no
+    iterations are run.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    ls = make_local_search(data, rng)
+
+    bks = Solution(data, read_solution("data/RC208.sol"))
+    init = [bks] + make_random_solutions(24, data, rng)
+
+    algo = NativeGeneticAlgorithm(data, rng, ls, init)
+    result = algo.run(MaxIterations(0))
+
+    assert_equal(result.best, bks)
+    assert_equal(result.num_iterations, 0)
+
+
+def test_best_solution_improves_with_more_iterations():
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    pop_params = PopulationParams()
+    init = make_random_solutions(pop_params.min_pop_size, data, rng)
+    ls = make_local_search(data, rng)
+
+    params = GeneticAlgorithmParams(
+        intensify_probability=0, intensify_on_best=False
+    )
+    algo = NativeGeneticAlgorithm(
+        data, rng, ls, init, params, population_params=pop_params
+    )
+
+    initial_best = algo.run(MaxIterations(0)).best
+    new_best = algo.run(MaxIterations(25)).best
+
+    cost_evaluator = algo.cost_evaluator
+    new_best_cost = cost_evaluator.penalised_cost(new_best)
+    initial_best_cost = cost_evaluator.penalised_cost(initial_best)
+    assert_(new_best_cost < initial_best_cost)
+    assert_(new_best.is_feasible())
+
+
+def test_penalises_store_limit_excess():
+    """
+    Tests that the native algorithm passes the initial stores penalty on to
+    its cost evaluator, so that solutions exceeding a route's store limit are
+    penalised.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    init = make_random_solutions(5, data, rng)
+    ls = make_local_search(data, rng)
+
+    params = PenaltyParams(init_stores_penalty=7)
+    algo = NativeGeneticAlgorithm(data, rng, ls, init, penalty_params=params)
+
+    # Two stores on a route that may only visit one store.
+    assert_equal(algo.cost_evaluator.load_stores_penalty(2, 1), 7)
+
+
+def test_callbacks_are_called_every_interval():
+    """
+    Tests that the stopping criterion and progress callback are only called
+    once every callback interval iterations.
+    """
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    init = make_random_solutions(25, data, rng)
+    ls = make_local_search(data, rng)
+
+    params = GeneticAlgorithmParams(
+        intensify_probability=0, intensify_on_best=False
+    )
+    algo = NativeGeneticAlgorithm(data, rng, ls, init, params)
+
+    progress = []
+    result = algo.run(MaxIterations(3), progress.append, callback_interval=5)
+
+    # MaxIterations counts calls, which happen once every five iterations,
+    # so the algorithm stops after three blocks of five iterations.
+    assert_equal(result.num_iterations, 15)
+    assert_equal([p.num_iterations for p in progress], [0, 5, 10, 15])
+
+    for prev, curr in zip(progress, progress[1:]):
+        assert_(curr.best_cost <= prev.best_cost)
+        assert_(curr.runtime >= prev.runtime)
+
+    with assert_raises(ValueError):
+        algo.run(MaxIterations(1), callback_interval=0)
+
+
+def test_collects_statistics():
+    data = read("data/RC208.txt", "solomon", "dimacs")
+    rng = XorShift128(seed=42)
+    init = make_random_solutions(25, data, rng)
+    ls = make_local_search(data, rng)
+
+    params = GeneticAlgorithmParams(
+        collect_statistics=True, intensify_probability=0
+    )
+    algo = NativeGeneticAlgorithm(data, rng, ls, init, params)
+    result = algo.run(MaxIterations(10))
+
+    stats = result.stats
+    assert_equal(stats.num_iterations, 10)
+    assert_equal(len(stats.runtimes), 10)
+    assert_equal(len(stats.feas_stats), 10)
+    assert_equal(len(stats.infeas_stats), 10)
+    assert_(stats.operator_stats["Exchange10"].num_evaluations > 0)
+
+    # The population is never larger than its maximum size.
+    pop_params = PopulationParams()
+    for feas, infeas in zip(stats.feas_stats, stats.infeas_stats):
+        assert_(feas.size <= pop_params.max_pop_size)
+        assert_(infeas.size <= pop_params.max_pop_size)
@@ -1,7 +1,15 @@
-from numpy.testing import assert_equal, assert_raises
+import numpy as np
+from numpy.testing import assert_, assert_equal, assert_raises
 from pytest import mark
 
-from pyvrp import PenaltyManager, PenaltyParams
+from pyvrp import (
+    Client,
+    CostEvaluator,
+    PenaltyManager,
+    PenaltyParams,
+    ProblemData,
+    Solution,
+)
 
 
 @mark.parametrize(
@@ -245,3 +253,45 @@ def test_does_not_update_penalties_before_sufficient_registrations():
 
     pm.register_time_feasible(True)
     assert_equal(pm.get_cost_evaluator().tw_penalty(1), 2)
+
+
+def test_store_limit_violations_are_penalised():
+    # Each client belongs to a different store, and each route may visit only
+    # one store. So a route visiting all three clients visits two stores too
+    # many.
+    clients = [Client(x=0, y=0)]
+    clients += [Client(x=1, y=1, clientStore=idx) for idx in range(3)]
+
+    data = ProblemData(
+        clients=clients,
+        num_vehicles=1,
+        weight_cap=10,
+        volume_cap=10,
+        salvage_cap=0,
+        order_route_lim=10,
+        route_store_lim=1,
+        distance_matrix=np.zeros((4, 4), dtype=int),
+        duration_matrix=np.zeros((4, 4), dtype=int),
+    )
+
+    sol = Solution(data, [[1, 2, 3]])
+    assert_(sol.excess_stores() > 0)
+    assert_(not sol.is_feasible())
+
+    params = PenaltyParams(init_stores_penalty=7, repair_booster=3)
+    pm = PenaltyManager(params)
+    unpenalised = CostEvaluator().penalised_cost(sol)
+
+    cost_evaluator = pm.get_cost_evaluator()
+    assert_equal(cost_evaluator.load_stores_penalty(2, 1), 7)
+    assert_equal(
+        cost_evaluator.penalised_cost(sol) - unpenalised,
+        7 * sol.excess_stores(),
+    )
+
+    booster = pm.get_booster_cost_evaluator()
+    assert_equal(booster.load_stores_penalty(2, 1), 21)
+    assert_equal(
+        booster.penalised_cost(sol) - unpenalised,
+        21 * sol.excess_stores(),
+    )
@@ -1,9 +1,23 @@
 import numpy as np
 from numpy.random import default_rng
-from numpy.testing import assert_, assert_allclose, assert_raises
+from numpy.testing import (
+    assert_,
+    assert_allclose,
+    assert_equal,
+    assert_raises,
+    assert_raises_regex,
+)
 from pytest import mark
 
-from pyvrp import Client, ProblemData
+from pyvrp import (
+    Client,
+    ClientClass,
+    ClientOrdering,
+    DistanceOracle,
+    MatrixStorage,
+    ProblemData,
+)
+from pyvrp.read import ROUND_FUNCS
 from pyvrp.tests.helpers import read
 
 
@@ -88,6 +102,47 @@ def test_centroid():
     assert_allclose(centroid[1], np.mean(y))
 
 
+@mark.parametrize(
+    ("weight", "volume", "salvage", "expected"),
+    [
+        (0, 0, 0, ClientClass.NONE),
+        (1, 0, 0, ClientClass.DELIVERY),  # any nonzero weight or volume
+        (0, 1, 0, ClientClass.DELIVERY),
+        (2, 3, 0, ClientClass.DELIVERY),
+        (0, 0, 1, ClientClass.SALVAGE),  # only a salvage demand of one
+        (0, 0, 2, ClientClass.NONE),
+        (1, 0, 1, ClientClass.BOTH),
+        (0, 1, 1, ClientClass.BOTH),
+        (1, 0, 2, ClientClass.DELIVERY),
+        (0, 1, 2, ClientClass.DELIVERY),
+    ],
+)
+def test_client_class(weight: int, volume: int, salvage: int, expected):
+    mat = np.zeros((2, 2), dtype=int)
+    client = Client(
+        x=1,
+        y=1,
+        demandWeight=weight,
+        demandVolume=volume,
+        demandSalvage=salvage,
+    )
+
+    data = ProblemData(
+        clients=[Client(x=0, y=0), client],
+        num_vehicles=1,
+        weight_cap=10,
+        volume_cap=10,
+        salvage_cap=10,
+        order_route_lim=10,
+        route_store_lim=10,
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    assert_equal(data.client_class(0), ClientClass.NONE)  # depot
+    assert_equal(data.client_class(1), expected)
+
+
 def test_matrix_access():
     """
     Tests that the ``duration()`` and ``dist()`` methods correctly index the
@@ -115,3 +170,275 @@ def test_matrix_access():
         for to in range(size):
             assert_allclose(dur_mat[frm, to], data.duration(frm, to))
             assert_allclose(dist_mat[frm, to], data.dist(frm, to))
+
+
+@mark.parametrize("convert", [np.asarray, np.ascontiguousarray, list])
+def test_matrices_from_arrays_and_lists(convert):
+    """
+    The matrices can be given as NumPy arrays of any numeric type, or as lists
+    of lists. The resulting problem data should be the same in each case.
+    """
+    gen = default_rng(seed=42)
+    size = 4
+
+    dist_mat = gen.integers(500, size=(size, size))
+    dur_mat = gen.integers(500, size=(size, size))
+
+    data = ProblemData(
+        clients=[Client(x=0, y=0) for _ in range(size)],
+        num_vehicles=1,
+        weight_cap=1,
+        volume_cap=1,
+        salvage_cap=0,
+        order_route_lim=1,
+        route_store_lim=1,
+        distance_matrix=convert(dist_mat.astype(np.int32)),
+        duration_matrix=convert(dur_mat.T),  # int64, and not contiguous
+    )
+
+    for frm in range(size):
+        for to in range(size):
+            assert_allclose(data.dist(frm, to), dist_mat[frm, to])
+            assert_allclose(data.duration(frm, to), dur_mat[to, frm])
+
+
+@mark.parametrize(
+    "shape",
+    [
+        (2, 3),  # matrix is not square
+        (3, 3),  # matrix is square, but too small
+        (5, 5),  # matrix is square, but too large
+        (16,),  # not a matrix
+    ],
+)
+def test_raises_for_invalid_matrix_dimensions(shape):
+    clients = [Client(x=0, y=0) for _ in range(4)]
+    valid = np.zeros((4, 4), dtype=int)
+
+    with assert_raises(ValueError):
+        ProblemData(
+            clients=clients,
+            num_vehicles=1,
+            weight_cap=1,
+            volume_cap=1,
+            salvage_cap=0,
+            order_route_lim=1,
+            route_store_lim=1,
+            distance_matrix=np.zeros(shape, dtype=int),
+            duration_matrix=valid,
+        )
+
+
+def _make_data(dist_mat, dur_mat, storage=MatrixStorage.DENSE):
+    return ProblemData(
+        clients=[Client(x=0, y=0) for _ in range(len(dist_mat))],
+        num_vehicles=1,
+        weight_cap=1,
+        volume_cap=1,
+        salvage_cap=0,
+        order_route_lim=1,
+        route_store_lim=1,
+        distance_matrix=dist_mat,
+        duration_matrix=dur_mat,
+        matrix_storage=storage,
+    )
+
+
+@mark.parametrize(
+    "storage",
+    [
+        MatrixStorage.DENSE,
+        MatrixStorage.SYMMETRIC,
+        MatrixStorage.COMPACT_16,
+        MatrixStorage.COMPACT_32,
+        MatrixStorage.INTERLEAVED,
+    ],
+)
+def test_matrix_storage_does_not_change_values(storage):
+    """
+    All matrix storage layouts should return exactly the same distances and
+    durations.
+    """
+    gen = default_rng(seed=42)
+    size = 6
+
+    # Symmetric matrices of multiples of ten, so that all layouts apply, and
+    # the compact layouts use a common factor other than one.
+    dist_mat = 10 * gen.integers(500, size=(size, size))
+    dist_mat = dist_mat + dist_mat.T
+    dur_mat = 10 * gen.integers(500, size=(size, size))
+    dur_mat = dur_mat + dur_mat.T
+
+    data = _make_data(dist_mat, dur_mat, storage)
+    assert_(data.matrix_storage == storage)
+
+    for frm in range(size):
+        for to in range(size):
+            assert_allclose(data.dist(frm, to), dist_mat[frm, to])
+            assert_allclose(data.duration(frm, to), dur_mat[frm, to])
+
+
+def test_matrix_storage_raises_when_values_do_not_fit():
+    symmetric = np.array([[0, 1], [1, 0]])
+    asymmetric = np.array([[0, 1], [2, 0]])
+    large = np.array([[0, 100_001], [100_000, 0]])  # exceeds 16 bits
+    negative = np.array([[0, -1], [-1, 0]])
+
+    with assert_raises(ValueError):
+        _make_data(asymmetric, symmetric, MatrixStorage.SYMMETRIC)
+
+    with assert_raises(ValueError):
+        _make_data(symmetric, large, MatrixStorage.COMPACT_16)
+
+    # Negative values are rejected up front, with an error that names the
+    # layout that was asked for.
+    with assert_raises_regex(ValueError, "COMPACT"):
+        _make_data(negative, symmetric, MatrixStorage.COMPACT_32)
+
+    # These layouts store any value, and the 32-bit layout fits the large one.
+    _make_data(asymmetric, large, MatrixStorage.INTERLEAVED)
+    _make_data(symmetric, large, MatrixStorage.COMPACT_32)
+
+
+def _make_on_demand_data(oracle):
+    return ProblemData(
+        clients=[Client(x=0, y=0) for _ in range(len(oracle))],
+        num_vehicles=1,
+        weight_cap=1,
+        volume_cap=1,
+        salvage_cap=0,
+        order_route_lim=1,
+        route_store_lim=1,
+        distance_oracle=oracle,
+    )
+
+
+@mark.parametrize("round_func", ["none", "round", "trunc", "trunc1"])
+@mark.parametrize("cache_rows", [0, 2, 64])
+def test_distance_oracle_matches_read(round_func, cache_rows):
+    """
+    Distances computed on demand should be exactly those that read() computes
+    from the same coordinates, with or without the oracle's row cache.
+    """
+    gen = default_rng(seed=42)
+    coords = gen.uniform(0, 10_000, size=(10, 2))
+
+    # This is how vrplib computes Euclidean edge weights, and how read() then
+    # rounds them.
+    diff = coords[:, np.newaxis, :] - coords
+    edge_weight = np.sqrt(np.sum(diff**2, axis=-1))
+    expected = ROUND_FUNCS[round_func](edge_weight / 10).astype(int)
+
+    oracle = DistanceOracle(
+        coords[:, 0], coords[:, 1], round_func, cache_rows=cache_rows
+    )
+    data = _make_on_demand_data(oracle)
+    assert_(data.matrix_storage == MatrixStorage.ON_DEMAND)
+
+    for frm in range(len(coords)):
+        for to in range(len(coords)):
+            assert_equal(data.dist(frm, to), expected[frm, to])
+            assert_equal(data.duration(frm, to), expected[frm, to])
+
+
+def test_distance_oracle_durations_can_be_zero():
+    oracle = DistanceOracle([0, 3], [0, 4], divisor=1, durations=False)
+    data = _make_on_demand_data(oracle)
+
+    assert_equal(data.dist(0, 1), 5)
+    assert_equal(data.duration(0, 1), 0)
+
+
+def test_distance_oracle_raises_for_invalid_data():
+    with assert_raises(ValueError):  # coordinates differ in size
+        DistanceOracle([0, 1], [0])
+
+    with assert_raises(ValueError):  # divisor must be positive
+        DistanceOracle([0, 1], [0, 1], divisor=0)
+
+    with assert_raises(ValueError):  # unknown rounding function
+        DistanceOracle([0, 1], [0, 1], round_func="floor")
+
+    with assert_raises(ValueError):  # oracle does not cover all clients
+        ProblemData(
+            clients=[Client(x=0, y=0) for _ in range(3)],
+            num_vehicles=1,
+            weight_cap=1,
+            volume_cap=1,
+            salvage_cap=0,
+            order_route_lim=1,
+            route_store_lim=1,
+            distance_oracle=DistanceOracle([0, 1], [0, 1]),
+        )
+
+    with assert_raises(ValueError):  # on demand storage requires an oracle
+        _make_data([[0, 1], [1, 0]], [[0, 1], [1, 0]], MatrixStorage.ON_DEMAND)
+
+
+@mark.parametrize("ordering", [ClientOrdering.HILBERT, ClientOrdering.MORTON])
+def test_renumbered_permutes_clients_and_matrices(ordering):
+    data = read("data/OkSmall.txt")
+    renumbered = data.renumbered(ordering)
+
+    assert_equal(renumbered.num_clients, data.num_clients)
+    assert_equal(renumbered.original_id(0), 0)  # depot stays at index zero
+
+    for idx in range(data.num_clients + 1):
+        # Original and internal ids should be inverses of each other, and the
+        # renumbered client should be the original client at that id.
+        orig = renumbered.original_id(idx)
+        assert_equal(renumbered.internal_id(orig), idx)
+        assert_equal(renumbered.client(idx).x, data.client(orig).x)
+        assert_equal(renumbered.client(idx).y, data.client(orig).y)
+
+    for frm in range(data.num_clients + 1):
+        for to in range(data.num_clients + 1):
+            orig_frm = renumbered.original_id(frm)
+            orig_to = renumbered.original_id(to)
+            assert_equal(
+                renumbered.dist(frm, to), data.dist(orig_frm, orig_to)
+            )
+            assert_equal(
+                renumbered.duration(frm, to),
+                data.duration(orig_frm, orig_to),
+            )
+
+
+def test_renumbered_orders_clients_along_curve():
+    """
+    On a line, both curves visit the clients in order of their position. So
+    clients that are given in reverse order should be renumbered in reverse.
+    """
+    clients = [Client(x=0, y=0)]
+    clients += [Client(x=10 - idx, y=0) for idx in range(10)]
+    size = len(clients)
+
+    data = ProblemData(
+        clients=clients,
+        num_vehicles=1,
+        weight_cap=1,
+        volume_cap=1,
+        salvage_cap=0,
+        order_route_lim=1,
+        route_store_lim=1,
+        distance_matrix=np.zeros((size, size), dtype=int),
+        duration_matrix=np.zeros((size, size), dtype=int),
+    )
+
+    for ordering in [ClientOrdering.HILBERT, ClientOrdering.MORTON]:
+        renumbered = data.renumbered(ordering)
+        ids = [renumbered.original_id(idx) for idx in range(size)]
+        assert_equal(ids, [0, *range(size - 1, 0, -1)])
+
+        # Renumbering again composes with the earlier renumbering: ids still
+        # refer to the original data.
+        twice = renumbered.renumbered(ordering)
+        assert_equal([twice.original_id(idx) for idx in range(size)], ids)
+
+
+def test_original_ids_are_identity_when_not_renumbered():
+    data = read("data/OkSmall.txt")
+
+    for idx in range(data.num_clients + 1):
+        assert_equal(data.original_id(idx), idx)
+        assert_equal(data.internal_id(idx), idx)
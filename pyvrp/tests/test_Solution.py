@@ -4,7 +4,14 @@ import numpy as np
 from numpy.testing import assert_, assert_allclose, assert_equal, assert_raises
 from pytest import mark
 
-from pyvrp import Client, ProblemData, Route, Solution, XorShift128
+from pyvrp import (
+    Client,
+    ClientOrdering,
+    ProblemData,
+    Route,
+    Solution,
+    XorShift128,
+)
 from pyvrp.tests.helpers import read
 
 
@@ -255,6 +262,85 @@ def test_time_warp_for_a_very_constrained_problem(dist_mat):
     )
 
 
+def test_excess_orders():
+    mat = np.zeros((5, 5), dtype=int)
+    data = ProblemData(
+        clients=[
+            Client(x=0, y=0),
+            Client(x=1, y=0, clientOrder=0),
+            Client(x=2, y=0, clientOrder=0),
+            Client(x=3, y=0, clientOrder=0),
+            Client(x=4, y=0, clientOrder=1),
+        ],
+        num_vehicles=3,
+        weight_cap=10,
+        volume_cap=10,
+        salvage_cap=10,
+        order_route_lim=1,
+        route_store_lim=10,
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    # Order 0 is visited on a single route, which is within the limit.
+    sol = Solution(data, [[1, 2, 3], [4]])
+    assert_equal(sol.excess_orders(), 0)
+    assert_(not sol.has_excess_orders())
+
+    # Now order 0 spans three routes, which is two more than the limit. Order
+    # 1 still spans only a single route.
+    sol = Solution(data, [[1, 4], [2], [3]])
+    assert_equal(sol.excess_orders(), 2)
+    assert_(sol.has_excess_orders())
+    assert_(not sol.is_feasible())
+
+
+def test_sequence_violations():
+    mat = np.zeros((5, 5), dtype=int)
+    data = ProblemData(
+        clients=[
+            Client(x=0, y=0),
+            Client(x=1, y=0, demandWeight=1),  # delivery
+            Client(x=2, y=0, demandWeight=1, demandSalvage=1),  # both
+            Client(x=3, y=0, demandSalvage=1),  # salvage
+            Client(x=4, y=0, demandSalvage=1),  # salvage
+        ],
+        num_vehicles=3,
+        weight_cap=10,
+        volume_cap=10,
+        salvage_cap=10,
+        order_route_lim=1,
+        route_store_lim=10,
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    # Deliveries first, then either a single both client, or any number of
+    # salvage clients: these routes are all in sequence.
+    sol = Solution(data, [[1, 2], [3, 4]])
+    assert_equal(sol.sequence_violations(), 0)
+    assert_(not sol.has_sequence_violations())
+
+    sol = Solution(data, [[1, 3, 4], [2]])
+    assert_equal(sol.sequence_violations(), 0)
+
+    # The both client is followed by two salvage clients, which violates the
+    # sequence twice.
+    sol = Solution(data, [[1, 2, 3, 4]])
+    assert_equal(sol.sequence_violations(), 2)
+    assert_(sol.has_sequence_violations())
+    assert_(not sol.is_feasible())
+
+    # Each salvage client now precedes the delivery and both client, and the
+    # both client precedes the delivery.
+    sol = Solution(data, [[3, 4, 2, 1]])
+    assert_equal(sol.sequence_violations(), 5)
+
+    routes = sol.get_routes()
+    assert_equal(routes[0].sequence_violations(), 5)
+    assert_(routes[0].has_sequence_violations())
+
+
 # TODO test all time warp cases
 
 
@@ -352,3 +438,34 @@ def test_route_centroid():
         x_center, y_center = route.centroid()
         assert_equal(x_center, x[route].mean())
         assert_equal(y_center, y[route].mean())
+
+
+def test_original_routes_report_original_ids():
+    data = read("data/OkSmall.txt")
+
+    # Without renumbering, the original routes are just the routes.
+    sol = Solution(data, [[1, 2], [3, 4]])
+    assert_equal(sol.original_routes(), [[1, 2], [3, 4]])
+
+    renumbered = data.renumbered(ClientOrdering.HILBERT)
+    routes = [
+        [renumbered.internal_id(client) for client in route]
+        for route in [[1, 2], [3, 4]]
+    ]
+    sol = Solution(renumbered, routes)
+
+    # The routes visit internal ids, but the original routes and the string
+    # representation report the ids of the original data.
+    expected = [
+        [renumbered.original_id(client) for client in route]
+        for route in sol.get_routes()
+    ]
+    assert_equal(sol.original_routes(), expected)
+    assert_equal(sol.original_routes(), [[1, 2], [3, 4]])
+
+    lines = [line for line in str(sol).splitlines() if "Route" in line]
+    assert_equal(lines, ["Route #1: 1 2 ", "Route #2: 3 4 "])
+
+    # The renumbered solution has the same cost as in the original data.
+    original = Solution(data, sol.original_routes())
+    assert_equal(sol.distance(), original.distance())